@@ -23,13 +23,23 @@
 #include "gdal.h"
 #include "gdal_alg.h"
 #include "cpl_conv.h"
+#include "cpl_error_internal.h"
+#include "cpl_multiproc.h"
 #include "cpl_string.h"
 #include "ogr_api.h"
 #include "ogr_srs_api.h"
 #include "ogr_geometry.h"
 
+#include <atomic>
 #include <climits>
+#include <condition_variable>
+#include <functional>
+#include <iterator>
 #include <limits>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <vector>
 
 static CPLErr OGRPolygonContourWriter(double dfLevelMin, double dfLevelMax,
                                       const OGRMultiPolygon &multipoly,
@@ -215,6 +225,355 @@ struct GDALRingAppender
     void *data_;
 };
 
+/************************************************************************/
+/*                         GDALStripLineWriter                          */
+/*                                                                      */
+/*      Line writer of a horizontal strip of the raster. Lines ending   */
+/*      on the first or last line of pixel centers of the strip may     */
+/*      continue in the adjacent strip, and are kept to be stitched     */
+/*      once all strips are processed. The others are written.          */
+/************************************************************************/
+
+namespace
+{
+struct GDALContourFragment
+{
+    double level = 0;
+    marching_squares::LineString ls{};
+    bool frontOnSeam = false;
+    bool backOnSeam = false;
+};
+
+struct GDALStripLineWriter
+{
+    CPL_DISALLOW_COPY_ASSIGN(GDALStripLineWriter)
+
+    GDALStripLineWriter(GDALRingAppender &appender, std::mutex &mutex,
+                        double topSeamY, double bottomSeamY)
+        : appender_(appender), mutex_(mutex), topSeamY_(topSeamY),
+          bottomSeamY_(bottomSeamY)
+    {
+    }
+
+    void addLine(double level, marching_squares::LineString &ls, bool closed)
+    {
+        const bool frontOnSeam = !closed && isOnSeam(ls.front());
+        const bool backOnSeam = !closed && isOnSeam(ls.back());
+        if (frontOnSeam || backOnSeam)
+        {
+            fragments_.push_back(GDALContourFragment());
+            auto &fragment = fragments_.back();
+            fragment.level = level;
+            fragment.ls = std::move(ls);
+            fragment.frontOnSeam = frontOnSeam;
+            fragment.backOnSeam = backOnSeam;
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            appender_.addLine(level, ls, closed);
+        }
+    }
+
+    std::vector<GDALContourFragment> fragments_{};
+
+  private:
+    GDALRingAppender &appender_;
+    std::mutex &mutex_;
+    // NaN if there is no adjacent strip.
+    const double topSeamY_;
+    const double bottomSeamY_;
+
+    bool isOnSeam(const marching_squares::Point &p) const
+    {
+        return p.y == topSeamY_ || p.y == bottomSeamY_;
+    }
+};
+}  // namespace
+
+/************************************************************************/
+/*                     GDALStitchContourFragments()                     */
+/*                                                                      */
+/*      Join the contour fragments sharing an end point on a seam, and  */
+/*      write the resulting lines.                                      */
+/************************************************************************/
+
+static void
+GDALStitchContourFragments(std::vector<GDALContourFragment> &fragments,
+                           GDALRingAppender &appender)
+{
+    using marching_squares::LineString;
+    using marching_squares::Point;
+
+    // (level, x, y) of an end point on a seam -> 2 * fragment index + 1 if
+    // this is the back of the fragment, or + 0 if this is its front.
+    std::map<std::tuple<double, double, double>, std::vector<size_t>> ends;
+    for (size_t i = 0; i < fragments.size(); i++)
+    {
+        const auto &fragment = fragments[i];
+        if (fragment.frontOnSeam)
+            ends[std::make_tuple(fragment.level, fragment.ls.front().x,
+                                 fragment.ls.front().y)]
+                .push_back(2 * i);
+        if (fragment.backOnSeam)
+            ends[std::make_tuple(fragment.level, fragment.ls.back().x,
+                                 fragment.ls.back().y)]
+                .push_back(2 * i + 1);
+    }
+
+    std::vector<bool> used(fragments.size());
+    constexpr size_t NONE = std::numeric_limits<size_t>::max();
+    const auto takeFragmentAt = [&ends, &used](double level, const Point &p)
+    {
+        const auto it = ends.find(std::make_tuple(level, p.x, p.y));
+        if (it != ends.end())
+        {
+            for (const size_t end : it->second)
+            {
+                if (!used[end / 2])
+                {
+                    used[end / 2] = true;
+                    return end;
+                }
+            }
+        }
+        return NONE;
+    };
+
+    for (size_t i = 0; i < fragments.size(); i++)
+    {
+        if (used[i])
+            continue;
+        used[i] = true;
+        const double level = fragments[i].level;
+        LineString ls = std::move(fragments[i].ls);
+
+        bool closed = false;
+        // Extend the line at its back, then at its front.
+        for (size_t end = takeFragmentAt(level, ls.back()); end != NONE;
+             end = takeFragmentAt(level, ls.back()))
+        {
+            LineString &other = fragments[end / 2].ls;
+            if (end % 2 == 0)
+            {
+                other.pop_front();
+            }
+            else
+            {
+                other.pop_back();
+                other.reverse();
+            }
+            ls.splice(ls.end(), other);
+            if (ls.front() == ls.back())
+            {
+                closed = true;
+                break;
+            }
+        }
+        for (size_t end = closed ? NONE : takeFragmentAt(level, ls.front());
+             end != NONE; end = takeFragmentAt(level, ls.front()))
+        {
+            LineString &other = fragments[end / 2].ls;
+            if (end % 2 == 0)
+            {
+                other.pop_front();
+                other.reverse();
+            }
+            else
+            {
+                other.pop_back();
+            }
+            ls.splice(ls.begin(), other);
+            if (ls.front() == ls.back())
+            {
+                closed = true;
+                break;
+            }
+        }
+
+        appender.addLine(level, ls, closed);
+    }
+}
+
+/************************************************************************/
+/*                     GDALContourGenerateStrips()                      */
+/*                                                                      */
+/*      Generate contour lines by processing horizontal strips of the   */
+/*      raster concurrently, and stitching the lines crossing strip     */
+/*      boundaries.                                                     */
+/************************************************************************/
+
+static bool GDALContourGenerateStrips(
+    GDALRasterBandH hBand, bool useNoData, double noDataValue,
+    marching_squares::FixedLevelRangeIterator &levels,
+    GDALRingAppender &appender, int nStripYSize, int nThreads,
+    GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    using namespace marching_squares;
+
+    const int nXSize = GDALGetRasterBandXSize(hBand);
+    const int nYSize = GDALGetRasterBandYSize(hBand);
+    const int nStrips = (nYSize + nStripYSize - 1) / nStripYSize;
+    nThreads = std::min(nThreads, nStrips);
+    CPLDebug("CONTOUR", "Processing %d strips of %d lines with %d threads",
+             nStrips, nStripYSize, nThreads);
+
+    std::vector<std::vector<GDALContourFragment>> fragmentsPerStrip(nStrips);
+    std::mutex ioMutex;
+    std::mutex writerMutex;
+
+    // Shared between the worker threads and the calling thread.
+    std::atomic<int> nextStrip{0};
+    std::atomic<bool> stop{false};
+    std::mutex mutex;
+    std::condition_variable cv;
+    int stripsDone = 0;
+    bool ok = true;
+
+    // Errors of the workers are emitted again by the calling thread, so that
+    // they reach its error handler.
+    std::vector<CPLErrorHandlerAccumulatorStruct> errors;
+    const CPLStringList threadLocalConfigOptions(
+        CPLGetThreadLocalConfigOptions());
+
+    const auto processStrip = [&](int iStrip)
+    {
+        const int nYOff = iStrip * nStripYSize;
+        const int nYEnd = std::min(nYOff + nStripYSize, nYSize);
+        const double NaN = std::numeric_limits<double>::quiet_NaN();
+        GDALStripLineWriter lineWriter(
+            appender, writerMutex, nYOff > 0 ? nYOff - .5 : NaN,
+            nYEnd < nYSize ? nYEnd - .5 : NaN);
+        {
+            SegmentMerger<GDALStripLineWriter, FixedLevelRangeIterator> writer(
+                lineWriter, levels, /* polygonize */ false);
+            ContourGenerator<decltype(writer), FixedLevelRangeIterator> cg(
+                nXSize, nYSize, useNoData, noDataValue, writer, levels);
+
+            std::vector<double> line(nXSize);
+            const auto readLine = [hBand, nXSize, &line, &ioMutex](int iLine)
+            {
+                std::lock_guard<std::mutex> lock(ioMutex);
+                if (GDALRasterIO(hBand, GF_Read, 0, iLine, nXSize, 1, &line[0],
+                                 nXSize, 1, GDT_Float64, 0, 0) != CE_None)
+                {
+                    CPLDebug("CONTOUR", "failed fetch %d %d", iLine, nXSize);
+                    return false;
+                }
+                return true;
+            };
+
+            if (nYOff > 0)
+            {
+                if (!readLine(nYOff - 1))
+                    return false;
+                cg.startAtLine(nYOff, &line[0]);
+            }
+            for (int iLine = nYOff; iLine < nYEnd && !stop; iLine++)
+            {
+                if (!readLine(iLine))
+                    return false;
+                cg.feedLine(&line[0]);
+            }
+        }
+        fragmentsPerStrip[iStrip] = std::move(lineWriter.fragments_);
+        return true;
+    };
+
+    std::function<void()> worker = [&]()
+    {
+        const CPLStringList threadLocalConfigOptionsBackup(
+            CPLGetThreadLocalConfigOptions());
+        CPLSetThreadLocalConfigOptions(threadLocalConfigOptions.List());
+        std::vector<CPLErrorHandlerAccumulatorStruct> workerErrors;
+        CPLInstallErrorHandlerAccumulator(workerErrors);
+        while (!stop)
+        {
+            const int iStrip = nextStrip++;
+            if (iStrip >= nStrips)
+                break;
+            bool stripOk = false;
+            try
+            {
+                stripOk = processStrip(iStrip);
+            }
+            catch (const std::exception &e)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined, "%s", e.what());
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            ++stripsDone;
+            if (!stripOk)
+            {
+                ok = false;
+                stop = true;
+            }
+            cv.notify_one();
+        }
+        CPLUninstallErrorHandlerAccumulator();
+        CPLSetThreadLocalConfigOptions(threadLocalConfigOptionsBackup.List());
+
+        std::lock_guard<std::mutex> lock(mutex);
+        errors.insert(errors.end(), workerErrors.begin(), workerErrors.end());
+    };
+
+    // Dedicated threads rather than the global thread pool, as the I/O done
+    // in the workers could need it.
+    const auto workerFunc = [](void *pData)
+    { (*static_cast<std::function<void()> *>(pData))(); };
+    std::vector<CPLJoinableThread *> threads;
+    for (int i = 0; i < nThreads; i++)
+    {
+        auto hThread = CPLCreateJoinableThread(workerFunc, &worker);
+        if (hThread == nullptr)
+            break;
+        threads.push_back(hThread);
+    }
+
+    if (threads.empty())
+    {
+        worker();
+    }
+    else
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (stripsDone < nStrips && !stop)
+        {
+            cv.wait(lock);
+            const double dfComplete =
+                0.95 * stripsDone / static_cast<double>(nStrips);
+            lock.unlock();
+            if (!stop &&
+                !pfnProgress(dfComplete, "Processing strips", pProgressArg))
+            {
+                stop = true;
+            }
+            lock.lock();
+            if (stop)
+                ok = false;
+        }
+    }
+    for (auto hThread : threads)
+        CPLJoinThread(hThread);
+    for (const auto &error : errors)
+        CPLError(error.type, error.no, "%s", error.msg.c_str());
+    if (!ok)
+        return false;
+
+    std::vector<GDALContourFragment> fragments;
+    for (auto &stripFragments : fragmentsPerStrip)
+    {
+        std::move(stripFragments.begin(), stripFragments.end(),
+                  std::back_inserter(fragments));
+        stripFragments.clear();
+    }
+    GDALStitchContourFragments(fragments, appender);
+
+    pfnProgress(1.0, "", pProgressArg);
+    return true;
+}
+
 /************************************************************************/
 /* ==================================================================== */
 /*                   Additional C Callable Functions                    */
@@ -558,6 +917,20 @@ mode.
  * A negative value means a single transaction. The function takes care of
  * issuing the starting transaction and committing the final one.
  *
+ *   NUM_THREADS=num|ALL_CPUS
+ *
+ * (GDAL >= 3.11) Number of threads used to process horizontal strips of the
+ * raster concurrently, in line contouring mode. Defaults to 1. The
+ * GDAL_NUM_THREADS configuration option is not taken into account. Contour
+ * lines crossing strip boundaries are joined once all strips are processed,
+ * so lines are not written in the same order, and do not get the same IDs,
+ * as with a single thread.
+ *
+ *   STRIP_HEIGHT=num
+ *
+ * (GDAL >= 3.11) Height in lines of the strips processed independently in line
+ * contouring mode. Defaults to a value derived from NUM_THREADS.
+ *
  * @return CE_None on success or CE_Failure if an error occurs.
  */
 CPLErr GDALContourGenerateEx(GDALRasterBandH hBand, void *hLayer,
@@ -663,6 +1036,25 @@ CPLErr GDALContourGenerateEx(GDALRasterBandH hBand, void *hLayer,
 
     bool polygonize = CPLFetchBool(options, "POLYGONIZE", false);
 
+    // Not defaulting to GDAL_NUM_THREADS, as the order of the features
+    // depends on it.
+    const char *pszThreads = CSLFetchNameValueDef(options, "NUM_THREADS", "1");
+    const int nThreads = std::max(1, std::min(128, EQUAL(pszThreads, "ALL_CPUS")
+                                                       ? CPLGetNumCPUs()
+                                                       : atoi(pszThreads)));
+    const int nYSize = GDALGetRasterBandYSize(hBand);
+    opt = CSLFetchNameValue(options, "STRIP_HEIGHT");
+    int nStripYSize = opt ? atoi(opt) : 0;
+    if (nStripYSize <= 0 && nThreads > 1)
+        nStripYSize =
+            std::max(256, (nYSize + 4 * nThreads - 1) / (4 * nThreads));
+    const bool useStrips = nStripYSize > 0 && nStripYSize < nYSize;
+    if (useStrips && polygonize)
+    {
+        CPLDebug("CONTOUR", "Strip processing is not available in polygonal "
+                            "contouring mode");
+    }
+
     using namespace marching_squares;
 
     OGRContourWriterInfo oCWI;
@@ -855,12 +1247,21 @@ CPLErr GDALContourGenerateEx(GDALRasterBandH hBand, void *hLayer,
                 fixedLevels.erase(uniqueIt, fixedLevels.end());
                 FixedLevelRangeIterator levels(
                     &fixedLevels[0], fixedLevels.size(), dfMinimum, dfMaximum);
-                SegmentMerger<GDALRingAppender, FixedLevelRangeIterator> writer(
-                    appender, levels, /* polygonize */ false);
-                ContourGeneratorFromRaster<decltype(writer),
-                                           FixedLevelRangeIterator>
-                    cg(hBand, useNoData, noDataValue, writer, levels);
-                ok = cg.process(pfnProgress, pProgressArg);
+                if (useStrips)
+                {
+                    ok = GDALContourGenerateStrips(
+                        hBand, useNoData, noDataValue, levels, appender,
+                        nStripYSize, nThreads, pfnProgress, pProgressArg);
+                }
+                else
+                {
+                    SegmentMerger<GDALRingAppender, FixedLevelRangeIterator>
+                        writer(appender, levels, /* polygonize */ false);
+                    ContourGeneratorFromRaster<decltype(writer),
+                                               FixedLevelRangeIterator>
+                        cg(hBand, useNoData, noDataValue, writer, levels);
+                    ok = cg.process(pfnProgress, pProgressArg);
+                }
             }
         }
     }
@@ -16,11 +16,16 @@
 #include "gdal_alg_priv.h"
 
 #include <climits>
+#include <cmath>
+#include <condition_variable>
 #include <cstddef>
 #include <cstdlib>
 #include <cstring>
 #include <cfloat>
 #include <limits>
+#include <memory>
+#include <mutex>
+#include <utility>
 #include <vector>
 #include <algorithm>
 
@@ -29,9 +34,11 @@
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
 #include "gdal_priv_templates.hpp"
+#include "gdal_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_core.h"
 #include "ogr_feature.h"
@@ -1427,6 +1434,551 @@ static CPLErr GDALRasterizeGeometriesInternal(
     return eErr;
 }
 
+/************************************************************************/
+/*                 GDALCreateRasterizeLayerTransformer()                */
+/************************************************************************/
+
+// Create a transformer from the georeferenced coordinates of the layer to
+// the pixel/line coordinates of the raster. Note that each layer can be
+// georeferenced separately.
+static void *GDALCreateRasterizeLayerTransformer(GDALDataset *poDS,
+                                                 OGRLayer *poLayer)
+{
+    char *pszProjection = nullptr;
+
+    OGRSpatialReference *poSRS = poLayer->GetSpatialRef();
+    if (!poSRS)
+    {
+        CPLError(CE_Warning, CPLE_AppDefined,
+                 "Failed to fetch spatial reference on layer %s "
+                 "to build transformer, assuming matching coordinate "
+                 "systems.",
+                 poLayer->GetLayerDefn()->GetName());
+    }
+    else
+    {
+        poSRS->exportToWkt(&pszProjection);
+    }
+
+    char **papszTransformerOptions = nullptr;
+    if (pszProjection != nullptr)
+        papszTransformerOptions = CSLSetNameValue(papszTransformerOptions,
+                                                  "SRC_SRS", pszProjection);
+    double adfGeoTransform[6] = {};
+    if (poDS->GetGeoTransform(adfGeoTransform) != CE_None &&
+        poDS->GetGCPCount() == 0 && poDS->GetMetadata("RPC") == nullptr)
+    {
+        papszTransformerOptions = CSLSetNameValue(
+            papszTransformerOptions, "DST_METHOD", "NO_GEOTRANSFORM");
+    }
+
+    void *pTransformArg = GDALCreateGenImgProjTransformer2(
+        nullptr, GDALDataset::ToHandle(poDS), papszTransformerOptions);
+
+    CPLFree(pszProjection);
+    CSLDestroy(papszTransformerOptions);
+    return pTransformArg;
+}
+
+/************************************************************************/
+/*                      GDALRasterizeTileSize()                         */
+/************************************************************************/
+
+// Size of the tiles processed concurrently by the multi-threaded
+// implementation: aligned on blocks when they are of reasonable size.
+static int GDALRasterizeTileSize(int nBlockSize, int nRasterSize)
+{
+    int nTileSize = nBlockSize;
+    if (nTileSize <= 0 || nTileSize > 1024)
+        nTileSize = 512;
+    else
+    {
+        while (nTileSize < 256)
+            nTileSize *= 2;
+    }
+    return std::min(nTileSize, nRasterSize);
+}
+
+/************************************************************************/
+/*                     GDALRasterizeGetTileExtent()                     */
+/************************************************************************/
+
+// Compute the range of tiles intersected by the extent in pixel space of the
+// vertices of a geometry, with a margin of one pixel for ALL_TOUCHED and
+// lines ending on tile edges. panExtent receives the first and last tile
+// indices in both dimensions, with an empty range if the geometry is
+// outside of the raster.
+static void GDALRasterizeGetTileExtent(
+    const OGRGeometry *poGeom, GDALTransformerFunc pfnTransformer,
+    void *pTransformArg, int nRasterXSize, int nRasterYSize, int nTileXSize,
+    int nTileYSize, std::vector<double> &aPointX, std::vector<double> &aPointY,
+    int *panExtent)
+{
+    std::vector<double> aPointVariant;
+    std::vector<int> aPartSize;
+    aPointX.clear();
+    aPointY.clear();
+    GDALCollectRingsFromGeometry(poGeom, aPointX, aPointY, aPointVariant,
+                                 aPartSize, GBV_UserBurnValue);
+    if (pfnTransformer != nullptr && !aPointX.empty())
+    {
+        std::vector<int> anSuccess(aPointX.size());
+        pfnTransformer(pTransformArg, FALSE, static_cast<int>(aPointX.size()),
+                       aPointX.data(), aPointY.data(), nullptr,
+                       anSuccess.data());
+    }
+
+    double dfMinX = HUGE_VAL;
+    double dfMinY = HUGE_VAL;
+    double dfMaxX = -HUGE_VAL;
+    double dfMaxY = -HUGE_VAL;
+    for (size_t i = 0; i < aPointX.size(); i++)
+    {
+        if (std::isfinite(aPointX[i]) && std::isfinite(aPointY[i]))
+        {
+            dfMinX = std::min(dfMinX, aPointX[i]);
+            dfMinY = std::min(dfMinY, aPointY[i]);
+            dfMaxX = std::max(dfMaxX, aPointX[i]);
+            dfMaxY = std::max(dfMaxY, aPointY[i]);
+        }
+    }
+
+    if (dfMinX > nRasterXSize + 1 || dfMaxX < -1 ||
+        dfMinY > nRasterYSize + 1 || dfMaxY < -1)
+    {
+        panExtent[0] = 0;
+        panExtent[1] = 0;
+        panExtent[2] = -1;
+        panExtent[3] = -1;
+        return;
+    }
+
+    const auto ToTile = [](double dfVal, int nTileSize, int nRasterSize)
+    {
+        const int nTiles = DIV_ROUND_UP(nRasterSize, nTileSize);
+        const double dfTile = std::floor(dfVal / nTileSize);
+        return static_cast<int>(
+            std::max(0.0, std::min<double>(dfTile, nTiles - 1)));
+    };
+    panExtent[0] = ToTile(dfMinX - 1, nTileXSize, nRasterXSize);
+    panExtent[1] = ToTile(dfMinY - 1, nTileYSize, nRasterYSize);
+    panExtent[2] = ToTile(dfMaxX + 1, nTileXSize, nRasterXSize);
+    panExtent[3] = ToTile(dfMaxY + 1, nTileYSize, nRasterYSize);
+}
+
+/************************************************************************/
+/*                   GDALRasterizeLayersMultiThreaded()                 */
+/************************************************************************/
+
+namespace
+{
+struct GDALRasterizeLayerItem
+{
+    std::unique_ptr<OGRGeometry> poGeom{};
+    double dfAttrValue = 0;
+};
+
+struct GDALRasterizeTile
+{
+    int nXOff = 0;
+    int nYOff = 0;
+    int nXSize = 0;
+    int nYSize = 0;
+    // Range in the (tile, item) array of the items intersecting the tile
+    size_t nFirst = 0;
+    size_t nLast = 0;
+    std::vector<GByte> abyBuffer{};
+};
+
+// Pool of transformers, so that each concurrent job uses its own one.
+class GDALRasterizeTransformerPool
+{
+    std::mutex m_oMutex{};
+    std::condition_variable m_oCV{};
+    void *m_pTransformArg = nullptr;
+    std::vector<void *> m_apFree{};
+    std::vector<void *> m_apClones{};
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALRasterizeTransformerPool)
+
+  public:
+    explicit GDALRasterizeTransformerPool(void *pTransformArg)
+        : m_pTransformArg(pTransformArg)
+    {
+        if (pTransformArg)
+            m_apFree.push_back(pTransformArg);
+    }
+
+    ~GDALRasterizeTransformerPool()
+    {
+        for (void *pArg : m_apClones)
+            GDALDestroyTransformer(pArg);
+    }
+
+    void *Acquire()
+    {
+        if (m_pTransformArg == nullptr)
+            return nullptr;
+        std::unique_lock<std::mutex> oLock(m_oMutex);
+        if (m_apFree.empty())
+        {
+            void *pArg = GDALCloneTransformer(m_pTransformArg);
+            if (pArg != nullptr)
+            {
+                m_apClones.push_back(pArg);
+                return pArg;
+            }
+            // Wait for another job to release its transformer
+            m_oCV.wait(oLock, [this] { return !m_apFree.empty(); });
+        }
+        void *pArg = m_apFree.back();
+        m_apFree.pop_back();
+        return pArg;
+    }
+
+    void Release(void *pArg)
+    {
+        if (pArg == nullptr)
+            return;
+        {
+            std::lock_guard<std::mutex> oLock(m_oMutex);
+            m_apFree.push_back(pArg);
+        }
+        m_oCV.notify_one();
+    }
+};
+}  // namespace
+
+// Tile-parallel implementation of GDALRasterizeLayers(). Features are read
+// by batches; the geometries of a batch are binned into the tiles their
+// pixel extent intersects, and the tiles are then rasterized concurrently on
+// the global thread pool. Raster I/O is done by the calling thread only.
+// Within a tile, geometries are burnt in feature order, so that the result
+// is the same as the one of the serial implementation, whatever the merge
+// algorithm.
+static CPLErr GDALRasterizeLayersMultiThreaded(
+    GDALDataset *poDS, int nBandCount, int *panBandList, int nLayerCount,
+    OGRLayerH *pahLayers, GDALTransformerFunc pfnTransformer,
+    void *pTransformArg, double *padfLayerBurnValues,
+    const char *pszBurnAttribute, int bAllTouched,
+    GDALBurnValueSrc eBurnValueSource, GDALRasterMergeAlg eMergeAlg,
+    CPLWorkerThreadPool *poThreadPool, int nThreads,
+    GDALProgressFunc pfnProgress, void *pProgressArg)
+{
+    GDALRasterBand *poBand = poDS->GetRasterBand(panBandList[0]);
+    const GDALDataType eType = poBand->GetRasterDataType();
+    const int nDTSize = GDALGetDataTypeSizeBytes(eType);
+    const int nRasterXSize = poDS->GetRasterXSize();
+    const int nRasterYSize = poDS->GetRasterYSize();
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+    const int nTileXSize = GDALRasterizeTileSize(nBlockXSize, nRasterXSize);
+    const int nTileYSize = GDALRasterizeTileSize(nBlockYSize, nRasterYSize);
+    const int nTilesX = DIV_ROUND_UP(nRasterXSize, nTileXSize);
+    const int nTilesY = DIV_ROUND_UP(nRasterYSize, nTileYSize);
+    const size_t nTileBytes = static_cast<size_t>(nTileXSize) * nTileYSize *
+                              nBandCount * nDTSize;
+    CPLDebug("GDAL", "Rasterizer operating on %d x %d tiles of %d x %d "
+             "pixels with %d threads.",
+             nTilesX, nTilesY, nTileXSize, nTileYSize, nThreads);
+
+    // Memory budget for the geometries of a batch of features. The larger,
+    // the less times the tiles need to be read and written.
+    const GIntBig nBatchMaxBytes =
+        std::max<GIntBig>(GDALGetCacheMax64(), 64 * 1024 * 1024);
+    // Number of tiles processed concurrently
+    const size_t nWaveSize = static_cast<size_t>(nThreads) * 2;
+
+    auto poJobQueue = poThreadPool->CreateJobQueue();
+    CPLErr eErr = CE_None;
+
+    pfnProgress(0.0, nullptr, pProgressArg);
+
+    for (int iLayer = 0; iLayer < nLayerCount && eErr == CE_None; iLayer++)
+    {
+        OGRLayer *poLayer = reinterpret_cast<OGRLayer *>(pahLayers[iLayer]);
+
+        if (!poLayer)
+        {
+            CPLError(CE_Warning, CPLE_AppDefined,
+                     "Layer element number %d is NULL, skipping.", iLayer);
+            continue;
+        }
+
+        const GIntBig nLayerFeatureCount = poLayer->GetFeatureCount(FALSE);
+        if (nLayerFeatureCount == 0)
+            continue;
+
+        int iBurnField = -1;
+        const double *padfBurnValues = nullptr;
+        if (pszBurnAttribute)
+        {
+            iBurnField =
+                poLayer->GetLayerDefn()->GetFieldIndex(pszBurnAttribute);
+            if (iBurnField == -1)
+            {
+                CPLError(CE_Warning, CPLE_AppDefined,
+                         "Failed to find field %s on layer %s, skipping.",
+                         pszBurnAttribute, poLayer->GetLayerDefn()->GetName());
+                continue;
+            }
+        }
+        else
+        {
+            padfBurnValues = padfLayerBurnValues + iLayer * nBandCount;
+        }
+
+        GDALTransformerFunc pfnLayerTransformer = pfnTransformer;
+        void *pLayerTransformArg = pTransformArg;
+        if (pfnLayerTransformer == nullptr)
+        {
+            pLayerTransformArg =
+                GDALCreateRasterizeLayerTransformer(poDS, poLayer);
+            pfnLayerTransformer = GDALGenImgProjTransform;
+            if (pLayerTransformArg == nullptr)
+                return CE_Failure;
+        }
+
+        {
+            GDALRasterizeTransformerPool oTransformers(pLayerTransformArg);
+            std::vector<GDALRasterizeLayerItem> aoItems;
+            std::vector<std::pair<size_t, size_t>> anTileItems;
+            std::vector<GDALRasterizeTile> aoTiles;
+            GIntBig nFeaturesDone = 0;
+
+            poLayer->ResetReading();
+            bool bEOF = false;
+            while (!bEOF && eErr == CE_None)
+            {
+                /* ------------------------------------------------------ */
+                /*      Read the next batch of features.                  */
+                /* ------------------------------------------------------ */
+                aoItems.clear();
+                GIntBig nBatchBytes = 0;
+                while (nBatchBytes < nBatchMaxBytes)
+                {
+                    std::unique_ptr<OGRFeature> poFeat(
+                        poLayer->GetNextFeature());
+                    if (!poFeat)
+                    {
+                        bEOF = true;
+                        break;
+                    }
+                    GDALRasterizeLayerItem oItem;
+                    oItem.poGeom.reset(poFeat->StealGeometry());
+                    if (!oItem.poGeom || oItem.poGeom->IsEmpty())
+                        continue;
+                    if (pszBurnAttribute)
+                        oItem.dfAttrValue =
+                            poFeat->GetFieldAsDouble(iBurnField);
+                    nBatchBytes += oItem.poGeom->WkbSize();
+                    aoItems.push_back(std::move(oItem));
+                }
+                const size_t nItems = aoItems.size();
+                nFeaturesDone += static_cast<GIntBig>(nItems);
+                if (nItems == 0)
+                    continue;
+
+                /* ------------------------------------------------------ */
+                /*      Compute the tiles intersected by each geometry,   */
+                /*      from the extent of its vertices in pixel space.   */
+                /* ------------------------------------------------------ */
+                std::vector<int> anTileExtents(nItems * 4);
+                const size_t nItemsPerJob =
+                    DIV_ROUND_UP(nItems, static_cast<size_t>(nThreads));
+                for (size_t iStart = 0; iStart < nItems;
+                     iStart += nItemsPerJob)
+                {
+                    const size_t iEnd = std::min(nItems, iStart + nItemsPerJob);
+                    poJobQueue->SubmitJob(
+                        [&, iStart, iEnd]()
+                        {
+                            void *pArg = oTransformers.Acquire();
+                            std::vector<double> aPointX;
+                            std::vector<double> aPointY;
+                            for (size_t i = iStart; i < iEnd; i++)
+                            {
+                                GDALRasterizeGetTileExtent(
+                                    aoItems[i].poGeom.get(),
+                                    pfnLayerTransformer, pArg, nRasterXSize,
+                                    nRasterYSize, nTileXSize, nTileYSize,
+                                    aPointX, aPointY, &anTileExtents[i * 4]);
+                            }
+                            oTransformers.Release(pArg);
+                        });
+                }
+                poJobQueue->WaitCompletion();
+
+                /* ------------------------------------------------------ */
+                /*      Bin the geometries into tiles, keeping feature    */
+                /*      order within each tile.                           */
+                /* ------------------------------------------------------ */
+                anTileItems.clear();
+                for (size_t i = 0; i < nItems; i++)
+                {
+                    const int *panExtent = &anTileExtents[i * 4];
+                    for (int iTileY = panExtent[1]; iTileY <= panExtent[3];
+                         iTileY++)
+                    {
+                        for (int iTileX = panExtent[0];
+                             iTileX <= panExtent[2]; iTileX++)
+                        {
+                            anTileItems.emplace_back(
+                                static_cast<size_t>(iTileY) * nTilesX + iTileX,
+                                i);
+                        }
+                    }
+                }
+                std::sort(anTileItems.begin(), anTileItems.end());
+
+                aoTiles.clear();
+                for (size_t i = 0; i < anTileItems.size();)
+                {
+                    GDALRasterizeTile oTile;
+                    const size_t nTile = anTileItems[i].first;
+                    oTile.nXOff =
+                        static_cast<int>(nTile % nTilesX) * nTileXSize;
+                    oTile.nYOff =
+                        static_cast<int>(nTile / nTilesX) * nTileYSize;
+                    oTile.nXSize =
+                        std::min(nTileXSize, nRasterXSize - oTile.nXOff);
+                    oTile.nYSize =
+                        std::min(nTileYSize, nRasterYSize - oTile.nYOff);
+                    oTile.nFirst = i;
+                    while (i < anTileItems.size() &&
+                           anTileItems[i].first == nTile)
+                        ++i;
+                    oTile.nLast = i;
+                    aoTiles.push_back(std::move(oTile));
+                }
+
+                /* ------------------------------------------------------ */
+                /*      Process the tiles by waves: the next wave is      */
+                /*      read while the current one is rasterized.         */
+                /* ------------------------------------------------------ */
+                const auto ReadTile = [&](GDALRasterizeTile &oTile)
+                {
+                    try
+                    {
+                        oTile.abyBuffer.resize(nTileBytes);
+                    }
+                    catch (const std::exception &)
+                    {
+                        CPLError(CE_Failure, CPLE_OutOfMemory,
+                                 "Cannot allocate tile buffer");
+                        return CE_Failure;
+                    }
+                    return poDS->RasterIO(
+                        GF_Read, oTile.nXOff, oTile.nYOff, oTile.nXSize,
+                        oTile.nYSize, oTile.abyBuffer.data(), oTile.nXSize,
+                        oTile.nYSize, eType, nBandCount, panBandList, 0, 0,
+                        0, nullptr);
+                };
+
+                for (size_t i = 0;
+                     i < std::min(nWaveSize, aoTiles.size()) &&
+                     eErr == CE_None;
+                     i++)
+                {
+                    eErr = ReadTile(aoTiles[i]);
+                }
+
+                for (size_t iWave = 0;
+                     iWave < aoTiles.size() && eErr == CE_None;
+                     iWave += nWaveSize)
+                {
+                    const size_t iWaveEnd =
+                        std::min(aoTiles.size(), iWave + nWaveSize);
+                    for (size_t iTile = iWave; iTile < iWaveEnd; iTile++)
+                    {
+                        poJobQueue->SubmitJob(
+                            [&, iTile]()
+                            {
+                                GDALRasterizeTile &oTile = aoTiles[iTile];
+                                void *pArg = oTransformers.Acquire();
+                                std::vector<double> adfAttrValues(nBandCount);
+                                for (size_t i = oTile.nFirst; i < oTile.nLast;
+                                     i++)
+                                {
+                                    const auto &oItem =
+                                        aoItems[anTileItems[i].second];
+                                    const double *padfValues = padfBurnValues;
+                                    if (pszBurnAttribute)
+                                    {
+                                        std::fill(adfAttrValues.begin(),
+                                                  adfAttrValues.end(),
+                                                  oItem.dfAttrValue);
+                                        padfValues = adfAttrValues.data();
+                                    }
+                                    gv_rasterize_one_shape(
+                                        oTile.abyBuffer.data(), oTile.nXOff,
+                                        oTile.nYOff, oTile.nXSize,
+                                        oTile.nYSize, nBandCount, eType, 0, 0,
+                                        0, bAllTouched, oItem.poGeom.get(),
+                                        GDT_Float64, padfValues, nullptr,
+                                        eBurnValueSource, eMergeAlg,
+                                        pfnLayerTransformer, pArg);
+                                }
+                                oTransformers.Release(pArg);
+                            });
+                    }
+
+                    // Read the next wave while this one is processed
+                    const size_t iNextWaveEnd =
+                        std::min(aoTiles.size(), iWaveEnd + nWaveSize);
+                    for (size_t iTile = iWaveEnd;
+                         iTile < iNextWaveEnd && eErr == CE_None; iTile++)
+                    {
+                        eErr = ReadTile(aoTiles[iTile]);
+                    }
+
+                    poJobQueue->WaitCompletion();
+
+                    for (size_t iTile = iWave;
+                         iTile < iWaveEnd && eErr == CE_None; iTile++)
+                    {
+                        auto &oTile = aoTiles[iTile];
+                        eErr = poDS->RasterIO(
+                            GF_Write, oTile.nXOff, oTile.nYOff, oTile.nXSize,
+                            oTile.nYSize, oTile.abyBuffer.data(),
+                            oTile.nXSize, oTile.nYSize, eType, nBandCount,
+                            panBandList, 0, 0, 0, nullptr);
+                        oTile.abyBuffer = std::vector<GByte>();
+                    }
+
+                    double dfLayerProgress =
+                        nLayerFeatureCount > 0
+                            ? (static_cast<double>(nFeaturesDone) - nItems +
+                               static_cast<double>(nItems) * iWaveEnd /
+                                   aoTiles.size()) /
+                                  static_cast<double>(nLayerFeatureCount)
+                            : 0.0;
+                    dfLayerProgress = std::min(1.0, dfLayerProgress);
+                    if (eErr == CE_None &&
+                        !pfnProgress((iLayer + dfLayerProgress) / nLayerCount,
+                                     "", pProgressArg))
+                    {
+                        CPLError(CE_Failure, CPLE_UserInterrupt,
+                                 "User terminated");
+                        eErr = CE_Failure;
+                    }
+                }
+                // Make sure that no job is still pending on error
+                poJobQueue->WaitCompletion();
+            }
+        }
+
+        if (pfnTransformer == nullptr)
+            GDALDestroyTransformer(pLayerTransformArg);
+    }
+
+    if (eErr == CE_None)
+        pfnProgress(1.0, "", pProgressArg);
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                        GDALRasterizeLayers()                         */
 /************************************************************************/
@@ -1482,6 +2034,14 @@ static CPLErr GDALRasterizeGeometriesInternal(
  * <li>"MERGE_ALG": May be REPLACE (the default) or ADD.  REPLACE results in
  * overwriting of value, while ADD adds the new value to the existing raster,
  * suitable for heatmaps for instance.</li>
+ * <li>"NUM_THREADS": (GDAL >= 3.11) Number of threads, or ALL_CPUS, used to
+ * rasterize the output raster by tiles concurrently. Defaults to 1. The
+ * GDAL_NUM_THREADS configuration option is not used, as that mode reads and
+ * writes the output raster by tiles rather than in chunks of lines, so it
+ * has to be requested explicitly. Geometries are binned once into the tiles
+ * they intersect, and burnt in feature order within each tile, so the result
+ * is the same as with a single thread. CHUNKYSIZE is ignored in that mode.
+ * Only used if pfnTransformer is NULL, or if pTransformArg is NULL.</li>
  * </ul>
  * @param pfnProgress the progress function to report completion.
  * @param pProgressArg callback data for progress function.
@@ -1527,6 +2087,38 @@ CPLErr GDALRasterizeLayers(GDALDatasetH hDS, int nBandCount, int *panBandList,
         return CE_Failure;
     }
 
+    const char *pszBurnAttribute = CSLFetchNameValue(papszOptions, "ATTRIBUTE");
+
+    /* -------------------------------------------------------------------- */
+    /*      Use the tile-parallel implementation if several threads are     */
+    /*      requested. A transformer passed by the caller cannot be         */
+    /*      cloned safely, so only its absence or a stateless one are       */
+    /*      supported.                                                      */
+    /* -------------------------------------------------------------------- */
+    // Not defaulting to GDAL_NUM_THREADS, as the tiled mode accesses the
+    // output raster differently.
+    const char *pszThreads =
+        CSLFetchNameValueDef(papszOptions, "NUM_THREADS", "1");
+    const int nThreads = std::max(1, std::min(128, EQUAL(pszThreads, "ALL_CPUS")
+                                                       ? CPLGetNumCPUs()
+                                                       : atoi(pszThreads)));
+    if (nThreads > 1)
+    {
+        if (pfnTransformer != nullptr && pTransformArg != nullptr)
+        {
+            CPLDebug("GDAL", "Rasterizer: NUM_THREADS ignored as a "
+                             "transformer is provided.");
+        }
+        else if (auto poThreadPool = GDALGetGlobalThreadPool(nThreads))
+        {
+            return GDALRasterizeLayersMultiThreaded(
+                poDS, nBandCount, panBandList, nLayerCount, pahLayers,
+                pfnTransformer, pTransformArg, padfLayerBurnValues,
+                pszBurnAttribute, bAllTouched, eBurnValueSource, eMergeAlg,
+                poThreadPool, nThreads, pfnProgress, pProgressArg);
+        }
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Establish a chunksize to operate on.  The larger the chunk      */
     /*      size the less times we need to make a pass through all the      */
@@ -1583,7 +2175,6 @@ CPLErr GDALRasterizeLayers(GDALDatasetH hDS, int nBandCount, int *panBandList,
     /*      geometries.                                                     */
     /* ==================================================================== */
     CPLErr eErr = CE_None;
-    const char *pszBurnAttribute = CSLFetchNameValue(papszOptions, "ATTRIBUTE");
 
     pfnProgress(0.0, nullptr, pProgressArg);
 
@@ -1639,41 +2230,9 @@ CPLErr GDALRasterizeLayers(GDALDatasetH hDS, int nBandCount, int *panBandList,
 
         if (pfnTransformer == nullptr)
         {
-            char *pszProjection = nullptr;
             bNeedToFreeTransformer = true;
-
-            OGRSpatialReference *poSRS = poLayer->GetSpatialRef();
-            if (!poSRS)
-            {
-                CPLError(CE_Warning, CPLE_AppDefined,
-                         "Failed to fetch spatial reference on layer %s "
-                         "to build transformer, assuming matching coordinate "
-                         "systems.",
-                         poLayer->GetLayerDefn()->GetName());
-            }
-            else
-            {
-                poSRS->exportToWkt(&pszProjection);
-            }
-
-            char **papszTransformerOptions = nullptr;
-            if (pszProjection != nullptr)
-                papszTransformerOptions = CSLSetNameValue(
-                    papszTransformerOptions, "SRC_SRS", pszProjection);
-            double adfGeoTransform[6] = {};
-            if (poDS->GetGeoTransform(adfGeoTransform) != CE_None &&
-                poDS->GetGCPCount() == 0 && poDS->GetMetadata("RPC") == nullptr)
-            {
-                papszTransformerOptions = CSLSetNameValue(
-                    papszTransformerOptions, "DST_METHOD", "NO_GEOTRANSFORM");
-            }
-
-            pTransformArg = GDALCreateGenImgProjTransformer2(
-                nullptr, hDS, papszTransformerOptions);
+            pTransformArg = GDALCreateRasterizeLayerTransformer(poDS, poLayer);
             pfnTransformer = GDALGenImgProjTransform;
-
-            CPLFree(pszProjection);
-            CSLDestroy(papszTransformerOptions);
             if (pTransformArg == nullptr)
             {
                 CPLFree(pabyChunkBuf);
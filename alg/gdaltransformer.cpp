@@ -37,6 +37,7 @@
 #include "cpl_vsi.h"
 #include "gdal.h"
 #include "gdal_priv.h"
+#include "gdalsse_priv.h"
 #include "ogr_core.h"
 #include "ogr_spatialref.h"
 #include "ogr_srs_api.h"
@@ -2816,6 +2817,67 @@ void GDALDestroyGenImgProjTransformer(void *hTransformArg)
     CPLFree(psInfo);
 }
 
+/************************************************************************/
+/*                     GDALApplyGeoTransformBatch()                     */
+/************************************************************************/
+
+// Apply a geotransform in place to the points whose panSuccess[] is set.
+// Runs of 4 valid points are processed with SIMD registers, with the same
+// sequence of operations as the scalar code so that results are identical.
+
+static void GDALApplyGeoTransformBatch(const double *padfGeoTransform,
+                                       int nPointCount, double *padfX,
+                                       double *padfY, const int *panSuccess)
+{
+    const auto ApplyOne = [padfGeoTransform, padfX, padfY](int i)
+    {
+        const double dfNewX = padfGeoTransform[0] +
+                              padfX[i] * padfGeoTransform[1] +
+                              padfY[i] * padfGeoTransform[2];
+        const double dfNewY = padfGeoTransform[3] +
+                              padfX[i] * padfGeoTransform[4] +
+                              padfY[i] * padfGeoTransform[5];
+
+        padfX[i] = dfNewX;
+        padfY[i] = dfNewY;
+    };
+
+    const auto gt0 = XMMReg4Double::Load1ValHighAndLow(padfGeoTransform + 0);
+    const auto gt1 = XMMReg4Double::Load1ValHighAndLow(padfGeoTransform + 1);
+    const auto gt2 = XMMReg4Double::Load1ValHighAndLow(padfGeoTransform + 2);
+    const auto gt3 = XMMReg4Double::Load1ValHighAndLow(padfGeoTransform + 3);
+    const auto gt4 = XMMReg4Double::Load1ValHighAndLow(padfGeoTransform + 4);
+    const auto gt5 = XMMReg4Double::Load1ValHighAndLow(padfGeoTransform + 5);
+
+    int i = 0;
+    for (; i + 3 < nPointCount; i += 4)
+    {
+        if (panSuccess[i] && panSuccess[i + 1] && panSuccess[i + 2] &&
+            panSuccess[i + 3])
+        {
+            const auto x = XMMReg4Double::Load4Val(padfX + i);
+            const auto y = XMMReg4Double::Load4Val(padfY + i);
+            const auto newX = gt0 + x * gt1 + y * gt2;
+            const auto newY = gt3 + x * gt4 + y * gt5;
+            newX.Store4Val(padfX + i);
+            newY.Store4Val(padfY + i);
+        }
+        else
+        {
+            for (int j = i; j < i + 4; j++)
+            {
+                if (panSuccess[j])
+                    ApplyOne(j);
+            }
+        }
+    }
+    for (; i < nPointCount; i++)
+    {
+        if (panSuccess[i])
+            ApplyOne(i);
+    }
+}
+
 /************************************************************************/
 /*                      GDALGenImgProjTransform()                       */
 /************************************************************************/
@@ -2878,21 +2940,8 @@ int GDALGenImgProjTransform(void *pTransformArgIn, int bDstToSrc,
     }
     else
     {
-        for (int i = 0; i < nPointCount; i++)
-        {
-            if (!panSuccess[i])
-                continue;
-
-            const double dfNewX = padfGeoTransform[0] +
-                                  padfX[i] * padfGeoTransform[1] +
-                                  padfY[i] * padfGeoTransform[2];
-            const double dfNewY = padfGeoTransform[3] +
-                                  padfX[i] * padfGeoTransform[4] +
-                                  padfY[i] * padfGeoTransform[5];
-
-            padfX[i] = dfNewX;
-            padfY[i] = dfNewY;
-        }
+        GDALApplyGeoTransformBatch(padfGeoTransform, nPointCount, padfX, padfY,
+                                   panSuccess);
     }
 
     /* -------------------------------------------------------------------- */
@@ -2929,21 +2978,8 @@ int GDALGenImgProjTransform(void *pTransformArgIn, int bDstToSrc,
     }
     else
     {
-        for (int i = 0; i < nPointCount; i++)
-        {
-            if (!panSuccess[i])
-                continue;
-
-            const double dfNewX = padfGeoTransform[0] +
-                                  padfX[i] * padfGeoTransform[1] +
-                                  padfY[i] * padfGeoTransform[2];
-            const double dfNewY = padfGeoTransform[3] +
-                                  padfX[i] * padfGeoTransform[4] +
-                                  padfY[i] * padfGeoTransform[5];
-
-            padfX[i] = dfNewX;
-            padfY[i] = dfNewY;
-        }
+        GDALApplyGeoTransformBatch(padfGeoTransform, nPointCount, padfX, padfY,
+                                   panSuccess);
     }
 
     return TRUE;
@@ -4137,6 +4173,34 @@ static int GDALApproxTransformInternal(void *pCBData, int bDstToSrc,
     /*      NOTE: the above comment is not true: gdalwarp uses approximator */
     /*      also to compute the source pixel of each target pixel.          */
     /* -------------------------------------------------------------------- */
+#ifndef check_error
+    // Interpolate whole runs of points with SIMD registers. This evaluates
+    // the same expressions as the loop below, so results are identical.
+    const double dfX0 = x[0];
+    const auto x0 = XMMReg4Double::Load1ValHighAndLow(&dfX0);
+    const auto xStart = XMMReg4Double::Load1ValHighAndLow(xSMETransformed);
+    const auto yStart = XMMReg4Double::Load1ValHighAndLow(ySMETransformed);
+    const auto zStart = XMMReg4Double::Load1ValHighAndLow(zSMETransformed);
+    const auto deltaX = XMMReg4Double::Load1ValHighAndLow(&dfDeltaX);
+    const auto deltaY = XMMReg4Double::Load1ValHighAndLow(&dfDeltaY);
+    const auto deltaZ = XMMReg4Double::Load1ValHighAndLow(&dfDeltaZ);
+    int iVec = 0;
+    for (; iVec + 3 < nPoints; iVec += 4)
+    {
+        const auto dist = XMMReg4Double::Load4Val(x + iVec) - x0;
+        (xStart + deltaX * dist).Store4Val(x + iVec);
+        (yStart + deltaY * dist).Store4Val(y + iVec);
+        (zStart + deltaZ * dist).Store4Val(z + iVec);
+    }
+    for (; iVec < nPoints; iVec++)
+    {
+        const double dfDist = (x[iVec] - dfX0);
+        x[iVec] = xSMETransformed[0] + dfDeltaX * dfDist;
+        y[iVec] = ySMETransformed[0] + dfDeltaY * dfDist;
+        z[iVec] = zSMETransformed[0] + dfDeltaZ * dfDist;
+    }
+    std::fill(panSuccess, panSuccess + nPoints, TRUE);
+#else
     for (int i = nPoints - 1; i >= 0; i--)
     {
 #ifdef check_error
@@ -4162,6 +4226,7 @@ static int GDALApproxTransformInternal(void *pCBData, int bDstToSrc,
 #endif
         panSuccess[i] = TRUE;
     }
+#endif
 
     return TRUE;
 }
@@ -1184,6 +1184,15 @@ CPLErr GDALWarpDstAlphaMasker(void *pMaskFuncArg, int nBandCount,
  * set the number of threads to use to parallelize the computation part of the
  * warping. If not set, computation will be done in a single thread.</li>
  *
+ * <li>NUM_CHUNK_THREADS: (GDAL >= 3.11) Can be set to a numeric value or
+ * ALL_CPUS to set the number of chunks processed concurrently by
+ * GDALWarpOperation::ChunkAndWarpMulti(). Defaults to 2, that is one chunk
+ * being read or written while another one is warped. With greater values,
+ * the warping of several chunks runs in parallel, each in a single thread, and
+ * the warp memory limit is shared among them. Writes are done in chunk order
+ * when STREAMABLE_OUTPUT is set. Ignored when the transformer cannot be
+ * cloned or when chunk processors are set.</li>
+ *
  * <li>STREAMABLE_OUTPUT: (GDAL >= 2.0) This defaults to FALSE, but may
  * be set to TRUE typically when writing to a streamed file. The
  * gdalwarp utility automatically sets this option when writing to
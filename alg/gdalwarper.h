@@ -532,6 +532,9 @@ class CPL_DLL GDALWarpOperation
                                     int nDstYSize);
     void CollectChunkList(int nDstXOff, int nDstYOff, int nDstXSize,
                           int nDstYSize);
+    CPLErr ChunkAndWarpMultiScheduled(
+        const std::vector<void *> &apTransformerArgs, int nDstXOff,
+        int nDstYOff, int nDstXSize, int nDstYSize);
     void ReportTiming(const char *);
 
   public:
@@ -21,10 +21,13 @@
 #include <cstring>
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 #include "cpl_config.h"
 #include "cpl_conv.h"
@@ -1070,6 +1073,241 @@ static void ChunkThreadMain(void *pThreadData)
     }
 }
 
+/************************************************************************/
+/*                        GDALWarpChunkScheduler                        */
+/************************************************************************/
+
+namespace
+{
+
+struct GDALWarpChunkWorker;
+
+// State shared by the worker threads of ChunkAndWarpMultiScheduled()
+struct GDALWarpChunkScheduler
+{
+    GDALWarpOperation *poOperation = nullptr;
+    const GDALWarpChunk *pasChunkList = nullptr;
+    int nChunkCount = 0;
+    CPLMutex *hIOMutex = nullptr;
+    bool bOrderedWrites = false;
+    GDALProgressFunc pfnProgress = nullptr;
+    void *pProgressArg = nullptr;
+
+    // Index of the next chunk to be picked up by a worker.
+    std::atomic<int> nNextChunk{0};
+
+    // Members below are protected by oMutex.
+    std::mutex oMutex{};
+    std::condition_variable oCV{};
+    int nNextChunkToWrite = 0;
+    bool bStop = false;
+    CPLErr eErr = CE_None;
+    double dfTotalPixels = 0;
+    double dfDonePixels = 0;
+    double dfLastProgress = 0;
+    std::vector<double> adfInFlightPixels{};
+};
+
+// Per-thread state of a worker of ChunkAndWarpMultiScheduled()
+struct GDALWarpChunkWorker
+{
+    GDALWarpChunkScheduler *poScheduler = nullptr;
+    int iWorker = 0;
+    // Clone of the transformer of the warp options, used by the kernel.
+    void *pTransformerArg = nullptr;
+    CPLJoinableThread *hThread = nullptr;
+
+    int iChunk = -1;
+    double dfChunkPixels = 0;
+    bool bIOHeld = false;
+    bool bWriteTurnTaken = false;
+
+    bool NeedsWriteTurn() const
+    {
+        return poScheduler->bOrderedWrites && !bWriteTurnTaken;
+    }
+
+    bool AcquireIOForWrite();
+    void FinishChunk(CPLErr eErr);
+};
+
+}  // namespace
+
+// Worker of the calling thread, if it runs a chunk of a scheduled warp.
+static thread_local GDALWarpChunkWorker *tlsChunkWorker = nullptr;
+
+static GDALWarpChunkWorker *
+GetChunkWorker(const GDALWarpOperation *poOperation)
+{
+    // Nested warping operations (warped VRT sources, ...) must not see the
+    // worker of the operation that reads them.
+    if (tlsChunkWorker &&
+        tlsChunkWorker->poScheduler->poOperation == poOperation)
+        return tlsChunkWorker;
+    return nullptr;
+}
+
+/************************************************************************/
+/*                 GDALWarpChunkWorker::AcquireIOForWrite()             */
+/************************************************************************/
+
+// Wait until the chunks before this one have been written, if the writes
+// must be ordered, and acquire the IO mutex.
+bool GDALWarpChunkWorker::AcquireIOForWrite()
+{
+    if (poScheduler->bOrderedWrites)
+    {
+        std::unique_lock<std::mutex> oLock(poScheduler->oMutex);
+        poScheduler->oCV.wait(oLock,
+                              [this]
+                              {
+                                  return poScheduler->bStop ||
+                                         poScheduler->nNextChunkToWrite ==
+                                             iChunk;
+                              });
+        if (poScheduler->bStop)
+            return false;
+    }
+    bWriteTurnTaken = true;
+
+    if (!CPLAcquireMutex(poScheduler->hIOMutex, 600.0))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Failed to acquire IOMutex in WarpRegion().");
+        return false;
+    }
+    bIOHeld = true;
+    return true;
+}
+
+/************************************************************************/
+/*                    GDALWarpChunkWorker::FinishChunk()                */
+/************************************************************************/
+
+void GDALWarpChunkWorker::FinishChunk(CPLErr eErr)
+{
+    if (eErr == CE_None && NeedsWriteTurn())
+    {
+        // Nothing was written, but the next chunks must not overtake us.
+        std::unique_lock<std::mutex> oLock(poScheduler->oMutex);
+        poScheduler->oCV.wait(oLock,
+                              [this]
+                              {
+                                  return poScheduler->bStop ||
+                                         poScheduler->nNextChunkToWrite ==
+                                             iChunk;
+                              });
+    }
+
+    {
+        std::lock_guard<std::mutex> oLock(poScheduler->oMutex);
+        if (eErr != CE_None)
+        {
+            poScheduler->bStop = true;
+            if (poScheduler->eErr == CE_None)
+                poScheduler->eErr = eErr;
+        }
+        else if (poScheduler->nNextChunkToWrite == iChunk)
+        {
+            poScheduler->nNextChunkToWrite = iChunk + 1;
+        }
+        poScheduler->dfDonePixels += dfChunkPixels;
+        poScheduler->adfInFlightPixels[iWorker] = 0;
+    }
+    poScheduler->oCV.notify_all();
+}
+
+/************************************************************************/
+/*                        ChunkWorkerProgress()                         */
+/************************************************************************/
+
+// Progress function given to the kernel of each chunk, which reports the
+// progress of the whole warp to the user progress function.
+static int CPL_STDCALL ChunkWorkerProgress(double dfComplete,
+                                           const char * /* pszMessage */,
+                                           void *pProgressArg)
+{
+    auto poWorker = static_cast<GDALWarpChunkWorker *>(pProgressArg);
+    auto poScheduler = poWorker->poScheduler;
+
+    std::lock_guard<std::mutex> oLock(poScheduler->oMutex);
+    poScheduler->adfInFlightPixels[poWorker->iWorker] =
+        dfComplete * poWorker->dfChunkPixels;
+    double dfPixels = poScheduler->dfDonePixels;
+    for (const double dfInFlight : poScheduler->adfInFlightPixels)
+        dfPixels += dfInFlight;
+    const double dfProgress =
+        std::min(1.0, dfPixels / poScheduler->dfTotalPixels);
+    if (dfProgress <= poScheduler->dfLastProgress)
+        return TRUE;
+    poScheduler->dfLastProgress = dfProgress;
+    if (!poScheduler->pfnProgress(dfProgress, "", poScheduler->pProgressArg))
+    {
+        poScheduler->bStop = true;
+        poScheduler->oCV.notify_all();
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/************************************************************************/
+/*                          ChunkWorkerMain()                           */
+/************************************************************************/
+
+static void ChunkWorkerMain(void *pThreadData)
+
+{
+    auto poWorker = static_cast<GDALWarpChunkWorker *>(pThreadData);
+    auto poScheduler = poWorker->poScheduler;
+
+    tlsChunkWorker = poWorker;
+    while (true)
+    {
+        const int iChunk = poScheduler->nNextChunk++;
+        if (iChunk >= poScheduler->nChunkCount)
+            break;
+        {
+            std::lock_guard<std::mutex> oLock(poScheduler->oMutex);
+            if (poScheduler->bStop)
+                break;
+        }
+
+        const GDALWarpChunk *pasChunkInfo = poScheduler->pasChunkList + iChunk;
+        poWorker->iChunk = iChunk;
+        poWorker->dfChunkPixels =
+            pasChunkInfo->dsx * static_cast<double>(pasChunkInfo->dsy);
+        poWorker->bIOHeld = false;
+        poWorker->bWriteTurnTaken = false;
+
+        CPLErr eErr = CE_None;
+        if (!CPLAcquireMutex(poScheduler->hIOMutex, 600.0))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Failed to acquire IOMutex in WarpRegion().");
+            eErr = CE_Failure;
+        }
+        else
+        {
+            poWorker->bIOHeld = true;
+            eErr = poScheduler->poOperation->WarpRegion(
+                pasChunkInfo->dx, pasChunkInfo->dy, pasChunkInfo->dsx,
+                pasChunkInfo->dsy, pasChunkInfo->sx, pasChunkInfo->sy,
+                pasChunkInfo->ssx, pasChunkInfo->ssy, pasChunkInfo->sExtraSx,
+                pasChunkInfo->sExtraSy, 0.0, 1.0);
+        }
+        if (poWorker->bIOHeld)
+        {
+            CPLReleaseMutex(poScheduler->hIOMutex);
+            poWorker->bIOHeld = false;
+        }
+
+        poWorker->FinishChunk(eErr);
+        if (eErr != CE_None)
+            break;
+    }
+    tlsChunkWorker = nullptr;
+}
+
 /************************************************************************/
 /*                         ChunkAndWarpMulti()                          */
 /************************************************************************/
@@ -1086,6 +1324,13 @@ static void ChunkThreadMain(void *pThreadData)
  * internally this method uses multiple threads to interleave input/output
  * for one region while the processing is being done for another.
  *
+ * When the NUM_CHUNK_THREADS warping option is set to a value greater than 2,
+ * that many chunks are processed concurrently instead: the reading and
+ * writing of chunks remain serialized, but the transformation and warping
+ * of several chunks run in parallel, each in a single thread and with its
+ * own copy of the transformer. The warp memory limit is then shared among
+ * the chunks in flight.
+ *
  * @param nDstXOff X offset to window of destination data to be produced.
  * @param nDstYOff Y offset to window of destination data to be produced.
  * @param nDstXSize Width of output window on destination file to be produced.
@@ -1104,6 +1349,41 @@ CPLErr GDALWarpOperation::ChunkAndWarpMulti(int nDstXOff, int nDstYOff,
     CPLReleaseMutex(hIOMutex);
     CPLReleaseMutex(hWarpMutex);
 
+    /* -------------------------------------------------------------------- */
+    /*      Use the scheduler processing several chunks concurrently if     */
+    /*      requested, and if the transformer can be cloned for each of     */
+    /*      them. Chunk processors are not assumed to be thread-safe.       */
+    /* -------------------------------------------------------------------- */
+    const char *pszChunkThreads =
+        CSLFetchNameValueDef(psOptions->papszWarpOptions, "NUM_CHUNK_THREADS",
+                             "2");
+    int nChunkThreads = EQUAL(pszChunkThreads, "ALL_CPUS")
+                            ? CPLGetNumCPUs()
+                            : atoi(pszChunkThreads);
+    nChunkThreads = std::min(nChunkThreads, 128);
+    if (nChunkThreads > 2 && psOptions->pfnPreWarpChunkProcessor == nullptr &&
+        psOptions->pfnPostWarpChunkProcessor == nullptr)
+    {
+        std::vector<void *> apTransformerArgs;
+        for (int i = 0; i < nChunkThreads; ++i)
+        {
+            void *pTransformerArg =
+                GDALCloneTransformer(psOptions->pTransformerArg);
+            if (pTransformerArg == nullptr)
+                break;
+            apTransformerArgs.push_back(pTransformerArg);
+        }
+        if (static_cast<int>(apTransformerArgs.size()) == nChunkThreads)
+        {
+            return ChunkAndWarpMultiScheduled(apTransformerArgs, nDstXOff,
+                                              nDstYOff, nDstXSize, nDstYSize);
+        }
+        CPLDebug("WARP", "Transformer cannot be cloned. "
+                         "Ignoring NUM_CHUNK_THREADS");
+        for (void *pTransformerArg : apTransformerArgs)
+            GDALDestroyTransformer(pTransformerArg);
+    }
+
     CPLCond *hCond = CPLCreateCond();
     CPLMutex *hCondMutex = CPLCreateMutex();
     CPLReleaseMutex(hCondMutex);
@@ -1233,6 +1513,100 @@ CPLErr GDALWarpOperation::ChunkAndWarpMulti(int nDstXOff, int nDstYOff,
     return eErr;
 }
 
+/************************************************************************/
+/*                     ChunkAndWarpMultiScheduled()                     */
+/************************************************************************/
+
+// Implementation of ChunkAndWarpMulti() with NUM_CHUNK_THREADS > 2.
+// Each worker thread picks the next pending chunk, reads its source (and
+// destination) data under the IO mutex, runs the kernel with its own
+// transformer, and writes its result under the IO mutex. Writes are done in
+// chunk order when the output must be streamable. This method takes
+// ownership of the transformers in apTransformerArgs, one per worker.
+
+CPLErr GDALWarpOperation::ChunkAndWarpMultiScheduled(
+    const std::vector<void *> &apTransformerArgs, int nDstXOff, int nDstYOff,
+    int nDstXSize, int nDstYSize)
+{
+    /* -------------------------------------------------------------------- */
+    /*      Collect the list of chunks to operate on, so that the chunks    */
+    /*      in flight fit together in the warp memory limit.                */
+    /* -------------------------------------------------------------------- */
+    const int nWorkers = static_cast<int>(apTransformerArgs.size());
+    const double dfWarpMemoryLimit = psOptions->dfWarpMemoryLimit;
+    psOptions->dfWarpMemoryLimit = dfWarpMemoryLimit / nWorkers;
+    CollectChunkList(nDstXOff, nDstYOff, nDstXSize, nDstYSize);
+    psOptions->dfWarpMemoryLimit = dfWarpMemoryLimit;
+
+    GDALWarpChunkScheduler oScheduler;
+    oScheduler.poOperation = this;
+    oScheduler.pasChunkList = pasChunkList;
+    oScheduler.nChunkCount = pasChunkList ? nChunkListCount : 0;
+    oScheduler.hIOMutex = hIOMutex;
+    oScheduler.bOrderedWrites = CPLFetchBool(psOptions->papszWarpOptions,
+                                             "STREAMABLE_OUTPUT", false);
+    oScheduler.pfnProgress = psOptions->pfnProgress;
+    oScheduler.pProgressArg = psOptions->pProgressArg;
+    oScheduler.dfTotalPixels = static_cast<double>(nDstXSize) * nDstYSize;
+    oScheduler.adfInFlightPixels.resize(nWorkers);
+
+    /* -------------------------------------------------------------------- */
+    /*      Launch the workers, and wait for them to complete.              */
+    /* -------------------------------------------------------------------- */
+    const int nThreads = std::min(nWorkers, oScheduler.nChunkCount);
+    CPLDebug("WARP", "Processing %d chunks with %d threads",
+             oScheduler.nChunkCount, nThreads);
+
+    std::vector<GDALWarpChunkWorker> aoWorkers(nWorkers);
+    for (int i = 0; i < nWorkers; ++i)
+    {
+        aoWorkers[i].poScheduler = &oScheduler;
+        aoWorkers[i].iWorker = i;
+        aoWorkers[i].pTransformerArg = apTransformerArgs[i];
+    }
+
+    CPLErr eErr = CE_None;
+    for (int i = 0; i < nThreads; ++i)
+    {
+        aoWorkers[i].hThread =
+            CPLCreateJoinableThread(ChunkWorkerMain, &aoWorkers[i]);
+        if (aoWorkers[i].hThread == nullptr)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "CPLCreateJoinableThread() failed in "
+                     "ChunkAndWarpMulti()");
+            {
+                std::lock_guard<std::mutex> oLock(oScheduler.oMutex);
+                oScheduler.bStop = true;
+            }
+            oScheduler.oCV.notify_all();
+            eErr = CE_Failure;
+            break;
+        }
+    }
+
+    for (auto &oWorker : aoWorkers)
+    {
+        if (oWorker.hThread)
+            CPLJoinThread(oWorker.hThread);
+        GDALDestroyTransformer(oWorker.pTransformerArg);
+    }
+
+    if (eErr == CE_None)
+        eErr = oScheduler.eErr;
+    if (eErr == CE_None && oScheduler.bStop)
+    {
+        // Interrupted by the progress function
+        eErr = CE_Failure;
+    }
+
+    WipeChunkList();
+
+    psOptions->pfnProgress(1.0, "", psOptions->pProgressArg);
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                         GDALChunkAndWarpMulti()                      */
 /************************************************************************/
@@ -1650,6 +2024,19 @@ CPLErr GDALWarpOperation::WarpRegion(
         psOptions->eWorkingDataType, nSrcXOff, nSrcYOff, nSrcXSize, nSrcYSize,
         dfSrcXExtraSize, dfSrcYExtraSize, dfProgressBase, dfProgressScale);
 
+    /* -------------------------------------------------------------------- */
+    /*      When no warping was done, wait for our turn to write the output */
+    /*      data of a chunk of a scheduled warp.                            */
+    /* -------------------------------------------------------------------- */
+    GDALWarpChunkWorker *poWorker = GetChunkWorker(this);
+    if (eErr == CE_None && poWorker != nullptr && poWorker->NeedsWriteTurn())
+    {
+        CPLReleaseMutex(hIOMutex);
+        poWorker->bIOHeld = false;
+        if (!poWorker->AcquireIOForWrite())
+            eErr = CE_Failure;
+    }
+
     /* -------------------------------------------------------------------- */
     /*      Write the output data back to disk if all went well.            */
     /* -------------------------------------------------------------------- */
@@ -1853,6 +2240,17 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
     oWK.papszWarpOptions = psOptions->papszWarpOptions;
     oWK.psThreadData = psThreadData;
 
+    // Chunks warped concurrently by ChunkAndWarpMultiScheduled() each run
+    // the kernel in a single thread, with their own transformer.
+    GDALWarpChunkWorker *poWorker = GetChunkWorker(this);
+    if (poWorker != nullptr)
+    {
+        oWK.pTransformerArg = poWorker->pTransformerArg;
+        oWK.pfnProgress = ChunkWorkerProgress;
+        oWK.pProgress = poWorker;
+        oWK.psThreadData = nullptr;
+    }
+
     oWK.padfDstNoDataReal = psOptions->padfDstNoDataReal;
 
     /* -------------------------------------------------------------------- */
@@ -2246,7 +2644,11 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
     if (hIOMutex != nullptr)
     {
         CPLReleaseMutex(hIOMutex);
-        if (!CPLAcquireMutex(hWarpMutex, 600.0))
+        if (poWorker != nullptr)
+        {
+            poWorker->bIOHeld = false;
+        }
+        else if (!CPLAcquireMutex(hWarpMutex, 600.0))
         {
             CPLError(CE_Failure, CPLE_AppDefined,
                      "Failed to acquire WarpMutex in WarpRegion().");
@@ -2280,7 +2682,12 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
     /* -------------------------------------------------------------------- */
     /*      Release Warp Mutex, and acquire io mutex.                       */
     /* -------------------------------------------------------------------- */
-    if (hIOMutex != nullptr)
+    if (poWorker != nullptr)
+    {
+        if (!poWorker->AcquireIOForWrite())
+            return CE_Failure;
+    }
+    else if (hIOMutex != nullptr)
     {
         CPLReleaseMutex(hWarpMutex);
         if (!CPLAcquireMutex(hIOMutex, 600.0))
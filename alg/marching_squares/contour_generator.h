@@ -40,6 +40,20 @@ class ContourGenerator
         std::fill(previousLine_.begin(), previousLine_.end(), NaN);
     }
 
+    // Start the generation at line firstLineIdx, previousLine being the
+    // content of the line above it, or nullptr if there is none. This is used
+    // to process a horizontal strip of the raster independently: the segments
+    // on the line shared by two consecutive strips are computed identically.
+    void startAtLine(size_t firstLineIdx, const double *previousLine)
+    {
+        lineIdx_ = firstLineIdx;
+        if (previousLine != nullptr)
+            std::copy(previousLine, previousLine + width_,
+                      previousLine_.begin());
+        else
+            std::fill(previousLine_.begin(), previousLine_.end(), NaN);
+    }
+
     CPLErr feedLine(const double *line)
     {
         if (lineIdx_ <= height_)
@@ -19,9 +19,13 @@
 #include <string.h>
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
 #include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <utility>
 #include <vector>
 
@@ -31,6 +35,8 @@
 #include "ogr_core.h"
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
+#include "cpl_multiproc.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
@@ -66,47 +72,59 @@ static CPLErr GPMaskImageData(GDALRasterBandH hMaskBand, GByte *pabyMaskLine,
 }
 
 /************************************************************************/
-/*                           GDALPolygonizeT()                          */
+/*                            GPReadLine()                              */
+/*                                                                      */
+/*      Read a line of the source band, masked by the mask band.        */
 /************************************************************************/
 
-template <class DataType, class EqualityTest>
-static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
-                              GDALRasterBandH hMaskBand, OGRLayerH hOutLayer,
-                              int iPixValField, char **papszOptions,
-                              GDALProgressFunc pfnProgress, void *pProgressArg,
-                              GDALDataType eDT)
+template <class DataType>
+static CPLErr GPReadLine(GDALRasterBandH hSrcBand, GDALRasterBandH hMaskBand,
+                         GDALDataType eDT, int iY, int nXSize,
+                         DataType *panLineVal, GByte *pabyMaskLine,
+                         std::mutex *poIOMutex)
 
 {
-    VALIDATE_POINTER1(hSrcBand, "GDALPolygonize", CE_Failure);
-    VALIDATE_POINTER1(hOutLayer, "GDALPolygonize", CE_Failure);
+    std::unique_lock<std::mutex> oLock;
+    if (poIOMutex)
+        oLock = std::unique_lock<std::mutex>(*poIOMutex);
 
-    if (pfnProgress == nullptr)
-        pfnProgress = GDALDummyProgress;
+    CPLErr eErr = GDALRasterIO(hSrcBand, GF_Read, 0, iY, nXSize, 1,
+                               panLineVal, nXSize, 1, eDT, 0, 0);
+    if (eErr == CE_None && hMaskBand != nullptr)
+        eErr = GPMaskImageData(hMaskBand, pabyMaskLine, iY, nXSize,
+                               panLineVal);
+    return eErr;
+}
 
-    const int nConnectedness =
-        CSLFetchNameValue(papszOptions, "8CONNECTED") ? 8 : 4;
+/************************************************************************/
+/*                          GPPolygonizeStrip()                         */
+/*                                                                      */
+/*      Polygonize the nStripYSize lines starting at line nYOff of the  */
+/*      source band, as if they were a whole raster. If set,            */
+/*      oRowCallback is called once each line has been traced, with     */
+/*      the arms and final polygon ids of its pixels.                   */
+/************************************************************************/
 
-    /* -------------------------------------------------------------------- */
-    /*      Confirm our output layer will support feature creation.         */
-    /* -------------------------------------------------------------------- */
-    if (!OGR_L_TestCapability(hOutLayer, OLCSequentialWrite))
-    {
-        CPLError(CE_Failure, CPLE_AppDefined,
-                 "Output feature layer does not appear to support creation "
-                 "of features in GDALPolygonize().");
-        return CE_Failure;
-    }
+using GPRowCallback =
+    std::function<void(int iRow, const TwoArm *paoArms, const GInt32 *panIds,
+                       const void *panVal)>;
 
+template <class DataType, class EqualityTest, class Receiver>
+static CPLErr GPPolygonizeStrip(GDALRasterBandH hSrcBand,
+                                GDALRasterBandH hMaskBand, GDALDataType eDT,
+                                int nConnectedness, int nYOff, int nStripYSize,
+                                Receiver &oReceiver,
+                                const GPRowCallback &oRowCallback,
+                                std::mutex *poIOMutex,
+                                const std::atomic<bool> *pbStop,
+                                GDALProgressFunc pfnProgress,
+                                void *pProgressArg)
+
+{
     /* -------------------------------------------------------------------- */
     /*      Allocate working buffers.                                       */
     /* -------------------------------------------------------------------- */
     const int nXSize = GDALGetRasterBandXSize(hSrcBand);
-    const int nYSize = GDALGetRasterBandYSize(hSrcBand);
-    if (nXSize > std::numeric_limits<int>::max() - 2)
-    {
-        CPLError(CE_Failure, CPLE_AppDefined, "Too wide raster");
-        return CE_Failure;
-    }
 
     DataType *panLastLineVal =
         static_cast<DataType *>(VSI_MALLOC2_VERBOSE(sizeof(DataType), nXSize));
@@ -131,41 +149,6 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
         return CE_Failure;
     }
 
-    /* -------------------------------------------------------------------- */
-    /*      Get the geotransform, if there is one, so we can convert the    */
-    /*      vectors into georeferenced coordinates.                         */
-    /* -------------------------------------------------------------------- */
-    double adfGeoTransform[6] = {0.0, 1.0, 0.0, 0.0, 0.0, 1.0};
-    bool bGotGeoTransform = false;
-    const char *pszDatasetForGeoRef =
-        CSLFetchNameValue(papszOptions, "DATASET_FOR_GEOREF");
-    if (pszDatasetForGeoRef)
-    {
-        GDALDatasetH hSrcDS = GDALOpen(pszDatasetForGeoRef, GA_ReadOnly);
-        if (hSrcDS)
-        {
-            bGotGeoTransform =
-                GDALGetGeoTransform(hSrcDS, adfGeoTransform) == CE_None;
-            GDALClose(hSrcDS);
-        }
-    }
-    else
-    {
-        GDALDatasetH hSrcDS = GDALGetBandDataset(hSrcBand);
-        if (hSrcDS)
-            bGotGeoTransform =
-                GDALGetGeoTransform(hSrcDS, adfGeoTransform) == CE_None;
-    }
-    if (!bGotGeoTransform)
-    {
-        adfGeoTransform[0] = 0;
-        adfGeoTransform[1] = 1;
-        adfGeoTransform[2] = 0;
-        adfGeoTransform[3] = 0;
-        adfGeoTransform[4] = 0;
-        adfGeoTransform[5] = 1;
-    }
-
     /* -------------------------------------------------------------------- */
     /*      The first pass over the raster is only used to build up the     */
     /*      polygon id map so we will know in advance what polygons are     */
@@ -176,14 +159,10 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
 
     CPLErr eErr = CE_None;
 
-    for (int iY = 0; eErr == CE_None && iY < nYSize; iY++)
+    for (int iY = 0; eErr == CE_None && iY < nStripYSize; iY++)
     {
-        eErr = GDALRasterIO(hSrcBand, GF_Read, 0, iY, nXSize, 1, panThisLineVal,
-                            nXSize, 1, eDT, 0, 0);
-
-        if (eErr == CE_None && hMaskBand != nullptr)
-            eErr = GPMaskImageData(hMaskBand, pabyMaskLine, iY, nXSize,
-                                   panThisLineVal);
+        eErr = GPReadLine(hSrcBand, hMaskBand, eDT, nYOff + iY, nXSize,
+                          panThisLineVal, pabyMaskLine, poIOMutex);
 
         if (eErr != CE_None)
             break;
@@ -211,8 +190,13 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
         /*      Report progress, and support interrupts. */
         /* --------------------------------------------------------------------
          */
-        if (!pfnProgress(0.10 * ((iY + 1) / static_cast<double>(nYSize)), "",
-                         pProgressArg))
+        if (pbStop && *pbStop)
+        {
+            eErr = CE_Failure;
+        }
+        else if (!pfnProgress(
+                     0.10 * ((iY + 1) / static_cast<double>(nStripYSize)), "",
+                     pProgressArg))
         {
             CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
             eErr = CE_Failure;
@@ -234,9 +218,7 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
     GDALRasterPolygonEnumeratorT<DataType, EqualityTest> oSecondEnum(
         nConnectedness);
 
-    OGRPolygonWriter<DataType> oPolygonWriter{hOutLayer, iPixValField,
-                                              adfGeoTransform};
-    Polygonizer<GInt32, DataType> oPolygonizer{-1, &oPolygonWriter};
+    Polygonizer<GInt32, DataType> oPolygonizer{-1, &oReceiver};
     TwoArm *paoLastLineArm =
         static_cast<TwoArm *>(VSI_CALLOC_VERBOSE(sizeof(TwoArm), nXSize + 2));
     TwoArm *paoThisLineArm =
@@ -258,20 +240,17 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
     /*      Second pass during which we will actually collect polygon       */
     /*      edges as geometries.                                            */
     /* ==================================================================== */
-    for (int iY = 0; eErr == CE_None && iY < nYSize + 1; iY++)
+    for (int iY = 0; eErr == CE_None && iY < nStripYSize + 1; iY++)
     {
         /* --------------------------------------------------------------------
          */
         /*      Read the image data. */
         /* --------------------------------------------------------------------
          */
-        if (iY < nYSize)
+        if (iY < nStripYSize)
         {
-            eErr = GDALRasterIO(hSrcBand, GF_Read, 0, iY, nXSize, 1,
-                                panThisLineVal, nXSize, 1, eDT, 0, 0);
-            if (eErr == CE_None && hMaskBand != nullptr)
-                eErr = GPMaskImageData(hMaskBand, pabyMaskLine, iY, nXSize,
-                                       panThisLineVal);
+            eErr = GPReadLine(hSrcBand, hMaskBand, eDT, nYOff + iY, nXSize,
+                              panThisLineVal, pabyMaskLine, poIOMutex);
         }
 
         if (eErr != CE_None)
@@ -283,7 +262,7 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
         /*      the same thing done in the first pass above). */
         /* --------------------------------------------------------------------
          */
-        if (iY == nYSize)
+        if (iY == nStripYSize)
         {
             for (int iX = 0; iX < nXSize; iX++)
                 panThisLineId[iX] =
@@ -307,7 +286,7 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
         if (eErr != CE_None)
             continue;
 
-        if (iY < nYSize)
+        if (iY < nStripYSize)
         {
             for (int iX = 0; iX < nXSize; iX++)
             {
@@ -328,7 +307,10 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
             }
             else
             {
-                eErr = oPolygonWriter.getErr();
+                eErr = oReceiver.getErr();
+                if (eErr == CE_None && oRowCallback)
+                    oRowCallback(iY, paoThisLineArm, panLastLineId,
+                                 panThisLineVal);
             }
         }
         else
@@ -341,7 +323,7 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
             }
             else
             {
-                eErr = oPolygonWriter.getErr();
+                eErr = oReceiver.getErr();
             }
         }
 
@@ -363,8 +345,13 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
         /*      Report progress, and support interrupts. */
         /* --------------------------------------------------------------------
          */
-        if (!pfnProgress(0.10 + 0.90 * ((iY + 1) / static_cast<double>(nYSize)),
-                         "", pProgressArg))
+        if (pbStop && *pbStop)
+        {
+            eErr = CE_Failure;
+        }
+        else if (!pfnProgress(0.10 + 0.90 * ((iY + 1) /
+                                             static_cast<double>(nStripYSize)),
+                              "", pProgressArg))
         {
             CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
             eErr = CE_Failure;
@@ -385,6 +372,581 @@ static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
     return eErr;
 }
 
+/************************************************************************/
+/*                        GPStripPolygonReceiver                        */
+/*                                                                      */
+/*      Receiver of the polygons of a strip. Polygons that do not       */
+/*      touch the top or bottom line of the strip are complete and      */
+/*      directly written to the output layer. The others are kept in    */
+/*      pixel coordinates, to be merged with the polygons of the        */
+/*      adjacent strips.                                                */
+/************************************************************************/
+
+namespace
+{
+template <class DataType>
+class GPStripPolygonReceiver final : public PolygonReceiver<DataType>
+{
+  public:
+    struct Piece
+    {
+        std::unique_ptr<OGRPolygon> poGeom{};
+        DataType nValue{};
+    };
+
+    // Index in m_aoPieces of the polygon of each pixel of the top and
+    // bottom lines of the strip, or -1.
+    std::vector<int> m_anTopPieces{};
+    std::vector<int> m_anBottomPieces{};
+    std::vector<DataType> m_anTopValues{};
+    std::vector<DataType> m_anBottomValues{};
+    std::vector<Piece> m_aoPieces{};
+
+    GPStripPolygonReceiver(OGRLayerH hOutLayer, int iPixValField,
+                           double *padfGeoTransform, int nYOff,
+                           std::mutex &oLayerMutex)
+        : m_oWriter(hOutLayer, iPixValField, padfGeoTransform,
+                    static_cast<IndexType>(nYOff)),
+          m_nYOff(static_cast<IndexType>(nYOff)), m_oLayerMutex(oLayerMutex)
+    {
+    }
+
+    void receive(RPolygon *poPolygon, DataType nPolygonCellValue) override
+    {
+        const auto oIter = m_oSeamPolygons.find(poPolygon);
+        if (oIter == m_oSeamPolygons.end())
+        {
+            std::lock_guard<std::mutex> oLock(m_oLayerMutex);
+            m_oWriter.receive(poPolygon, nPolygonCellValue);
+            return;
+        }
+
+        static const double adfPixelGeoTransform[6] = {0, 1, 0, 0, 0, 1};
+        auto &oPiece = m_aoPieces[oIter->second];
+        oPiece.poGeom = std::make_unique<OGRPolygon>();
+        oPiece.nValue = nPolygonCellValue;
+        if (!RPolygonToOGRPolygon(poPolygon, adfPixelGeoTransform, m_nYOff,
+                                  oPiece.poGeom.get()))
+            m_eErr = CE_Failure;
+        // The RPolygon is destroyed after that call, and its address may
+        // be reused.
+        m_oSeamPolygons.erase(oIter);
+    }
+
+    void RecordSeamLine(const TwoArm *paoArms, const GInt32 *panIds,
+                        const DataType *panVal, int nXSize, bool bTop)
+    {
+        auto &anPieces = bTop ? m_anTopPieces : m_anBottomPieces;
+        auto &anValues = bTop ? m_anTopValues : m_anBottomValues;
+        anPieces.resize(nXSize);
+        anValues.assign(panVal, panVal + nXSize);
+        for (int iX = 0; iX < nXSize; iX++)
+        {
+            if (panIds[iX] < 0)
+            {
+                anPieces[iX] = -1;
+                continue;
+            }
+            const auto oRes = m_oSeamPolygons.emplace(
+                paoArms[iX + 1].poPolyInside,
+                static_cast<int>(m_aoPieces.size()));
+            if (oRes.second)
+                m_aoPieces.emplace_back();
+            anPieces[iX] = oRes.first->second;
+        }
+    }
+
+    CPLErr getErr()
+    {
+        return m_eErr != CE_None ? m_eErr : m_oWriter.getErr();
+    }
+
+  private:
+    OGRPolygonWriter<DataType> m_oWriter;
+    IndexType m_nYOff;
+    std::mutex &m_oLayerMutex;
+    std::map<const RPolygon *, int> m_oSeamPolygons{};
+    CPLErr m_eErr = CE_None;
+
+    CPL_DISALLOW_COPY_ASSIGN(GPStripPolygonReceiver)
+};
+}  // namespace
+
+/************************************************************************/
+/*                      GPRemoveCollinearPoints()                       */
+/*                                                                      */
+/*      Remove the intermediate points of horizontal and vertical       */
+/*      edges of a ring in pixel coordinates, as left by the merging    */
+/*      of polygons across strip boundaries.                            */
+/************************************************************************/
+
+static void GPRemoveCollinearPoints(OGRLinearRing *poRing)
+{
+    // Closed ring, so the last point is the first one
+    const int nPoints = poRing->getNumPoints() - 1;
+    if (nPoints < 4)
+        return;
+
+    std::vector<OGRRawPoint> aoPoints;
+    aoPoints.reserve(nPoints + 1);
+    for (int i = 0; i < nPoints; i++)
+    {
+        const int iPrev = (i + nPoints - 1) % nPoints;
+        const int iNext = (i + 1) % nPoints;
+        const double dfX = poRing->getX(i);
+        const double dfY = poRing->getY(i);
+        if ((poRing->getX(iPrev) == dfX && poRing->getX(iNext) == dfX) ||
+            (poRing->getY(iPrev) == dfY && poRing->getY(iNext) == dfY))
+        {
+            continue;
+        }
+        aoPoints.emplace_back(dfX, dfY);
+    }
+    if (aoPoints.size() < 3)
+        return;
+    aoPoints.push_back(aoPoints.front());
+    poRing->setPoints(static_cast<int>(aoPoints.size()), aoPoints.data());
+}
+
+/************************************************************************/
+/*                         GPWriteMergedPolygon()                       */
+/*                                                                      */
+/*      Write a polygon in pixel coordinates, resulting from the        */
+/*      merge of polygons across strip boundaries, to the output layer. */
+/************************************************************************/
+
+static CPLErr GPWriteMergedPolygon(OGRLayer *poOutLayer, int iPixValField,
+                                   const double *padfGeoTransform,
+                                   std::unique_ptr<OGRPolygon> poPolygon,
+                                   bool bRemoveCollinearPoints, double dfValue)
+{
+    for (auto *poRing : *poPolygon)
+    {
+        if (bRemoveCollinearPoints)
+            GPRemoveCollinearPoints(poRing);
+        for (int i = 0; i < poRing->getNumPoints(); i++)
+        {
+            const double dfCol = poRing->getX(i);
+            const double dfRow = poRing->getY(i);
+            poRing->setPoint(i,
+                             padfGeoTransform[0] + dfCol * padfGeoTransform[1] +
+                                 dfRow * padfGeoTransform[2],
+                             padfGeoTransform[3] + dfCol * padfGeoTransform[4] +
+                                 dfRow * padfGeoTransform[5]);
+        }
+    }
+
+    OGRFeature oFeature(poOutLayer->GetLayerDefn());
+    oFeature.SetGeometryDirectly(poPolygon.release());
+    if (iPixValField >= 0)
+        oFeature.SetField(iPixValField, dfValue);
+    return poOutLayer->CreateFeature(&oFeature) == OGRERR_NONE ? CE_None
+                                                               : CE_Failure;
+}
+
+/************************************************************************/
+/*                         GPPolygonizeStrips()                         */
+/*                                                                      */
+/*      Tiled mode: polygonize strips of lines independently and        */
+/*      concurrently, streaming the polygons completed within a strip   */
+/*      to the output layer, and then merge the polygons that cross     */
+/*      strip boundaries.                                               */
+/*                                                                      */
+/*      Only 4 connectedness is supported: with 8 connectedness, parts  */
+/*      of a polygon touching at a corner across a strip boundary       */
+/*      would be written as distinct polygons.                          */
+/************************************************************************/
+
+template <class DataType, class EqualityTest>
+static CPLErr
+GPPolygonizeStrips(GDALRasterBandH hSrcBand, GDALRasterBandH hMaskBand,
+                   OGRLayerH hOutLayer, int iPixValField, GDALDataType eDT,
+                   double *padfGeoTransform, int nStripYSize, int nThreads,
+                   GDALProgressFunc pfnProgress, void *pProgressArg)
+
+{
+    const int nXSize = GDALGetRasterBandXSize(hSrcBand);
+    const int nYSize = GDALGetRasterBandYSize(hSrcBand);
+    const int nStrips = DIV_ROUND_UP(nYSize, nStripYSize);
+    nThreads = std::min(nThreads, nStrips);
+    CPLDebug("GDAL", "Polygonizing %d strips of %d lines with %d threads",
+             nStrips, nStripYSize, nThreads);
+
+    std::vector<std::unique_ptr<GPStripPolygonReceiver<DataType>>> apoStrips(
+        nStrips);
+    std::mutex oIOMutex;
+    std::mutex oLayerMutex;
+
+    // Shared between the worker threads and the calling thread.
+    std::atomic<int> nNextStrip{0};
+    std::atomic<bool> bStop{false};
+    std::mutex oMutex;
+    std::condition_variable oCV;
+    int nStripsDone = 0;
+    CPLErr eErr = CE_None;
+
+    // Errors of the workers are emitted again by the calling thread, so that
+    // they reach its error handler.
+    std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors;
+    const CPLStringList aosThreadLocalConfigOptions(
+        CPLGetThreadLocalConfigOptions());
+
+    std::function<void()> oWorker = [&]()
+    {
+        const CPLStringList aosTLConfigOptionsBackup(
+            CPLGetThreadLocalConfigOptions());
+        CPLSetThreadLocalConfigOptions(aosThreadLocalConfigOptions.List());
+        std::vector<CPLErrorHandlerAccumulatorStruct> aoWorkerErrors;
+        CPLInstallErrorHandlerAccumulator(aoWorkerErrors);
+        while (!bStop)
+        {
+            const int iStrip = nNextStrip++;
+            if (iStrip >= nStrips)
+                break;
+            const int nYOff = iStrip * nStripYSize;
+            const int nThisStripYSize = std::min(nStripYSize, nYSize - nYOff);
+            auto poReceiver =
+                std::make_unique<GPStripPolygonReceiver<DataType>>(
+                    hOutLayer, iPixValField, padfGeoTransform, nYOff,
+                    oLayerMutex);
+            auto poReceiverPtr = poReceiver.get();
+            const GPRowCallback oRowCallback =
+                [poReceiverPtr, iStrip, nStrips, nThisStripYSize,
+                 nXSize](int iRow, const TwoArm *paoArms, const GInt32 *panIds,
+                         const void *panVal)
+            {
+                if (iRow == 0 && iStrip > 0)
+                    poReceiverPtr->RecordSeamLine(
+                        paoArms, panIds, static_cast<const DataType *>(panVal),
+                        nXSize, /* bTop = */ true);
+                if (iRow == nThisStripYSize - 1 && iStrip < nStrips - 1)
+                    poReceiverPtr->RecordSeamLine(
+                        paoArms, panIds, static_cast<const DataType *>(panVal),
+                        nXSize, /* bTop = */ false);
+            };
+            const CPLErr eStripErr =
+                GPPolygonizeStrip<DataType, EqualityTest>(
+                    hSrcBand, hMaskBand, eDT, /* nConnectedness = */ 4,
+                    nYOff, nThisStripYSize, *poReceiver, oRowCallback,
+                    &oIOMutex, &bStop, GDALDummyProgress, nullptr);
+
+            std::lock_guard<std::mutex> oLock(oMutex);
+            apoStrips[iStrip] = std::move(poReceiver);
+            ++nStripsDone;
+            if (eStripErr != CE_None && eErr == CE_None)
+            {
+                eErr = eStripErr;
+                bStop = true;
+            }
+            oCV.notify_one();
+        }
+        CPLUninstallErrorHandlerAccumulator();
+        CPLSetThreadLocalConfigOptions(aosTLConfigOptionsBackup.List());
+
+        std::lock_guard<std::mutex> oLock(oMutex);
+        aoErrors.insert(aoErrors.end(), aoWorkerErrors.begin(),
+                        aoWorkerErrors.end());
+    };
+
+    // Dedicated threads rather than the global thread pool, as the I/O done
+    // in the workers could need it.
+    const auto WorkerFunc = [](void *pData)
+    { (*static_cast<std::function<void()> *>(pData))(); };
+    std::vector<CPLJoinableThread *> ahThreads;
+    for (int i = 0; i < nThreads; i++)
+    {
+        auto hThread = CPLCreateJoinableThread(WorkerFunc, &oWorker);
+        if (hThread == nullptr)
+            break;
+        ahThreads.push_back(hThread);
+    }
+
+    if (ahThreads.empty())
+    {
+        oWorker();
+    }
+    else
+    {
+        std::unique_lock<std::mutex> oLock(oMutex);
+        while (nStripsDone < nStrips && !bStop)
+        {
+            oCV.wait(oLock);
+            const double dfComplete =
+                0.9 * nStripsDone / static_cast<double>(nStrips);
+            oLock.unlock();
+            if (!bStop && !pfnProgress(dfComplete, "", pProgressArg))
+            {
+                CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+                bStop = true;
+            }
+            oLock.lock();
+            if (bStop && eErr == CE_None)
+                eErr = CE_Failure;
+        }
+    }
+    for (auto hThread : ahThreads)
+        CPLJoinThread(hThread);
+    for (const auto &oError : aoErrors)
+        CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+    if (eErr != CE_None)
+        return eErr;
+
+    /* -------------------------------------------------------------------- */
+    /*      Group the polygons that touch across strip boundaries.          */
+    /* -------------------------------------------------------------------- */
+    std::vector<size_t> anFirstPiece(nStrips + 1);
+    for (int iStrip = 0; iStrip < nStrips; iStrip++)
+        anFirstPiece[iStrip + 1] =
+            anFirstPiece[iStrip] + apoStrips[iStrip]->m_aoPieces.size();
+    std::vector<size_t> anParent(anFirstPiece[nStrips]);
+    for (size_t i = 0; i < anParent.size(); i++)
+        anParent[i] = i;
+    const auto Find = [&anParent](size_t i)
+    {
+        while (anParent[i] != i)
+        {
+            anParent[i] = anParent[anParent[i]];
+            i = anParent[i];
+        }
+        return i;
+    };
+
+    EqualityTest eq;
+    for (int iStrip = 0; iStrip + 1 < nStrips; iStrip++)
+    {
+        const auto &oAbove = *(apoStrips[iStrip]);
+        const auto &oBelow = *(apoStrips[iStrip + 1]);
+        for (int iX = 0; iX < nXSize; iX++)
+        {
+            if (oAbove.m_anBottomPieces[iX] < 0 ||
+                oBelow.m_anTopPieces[iX] < 0 ||
+                !eq(oAbove.m_anBottomValues[iX], oBelow.m_anTopValues[iX]))
+                continue;
+            const size_t iRootAbove =
+                Find(anFirstPiece[iStrip] + oAbove.m_anBottomPieces[iX]);
+            const size_t iRootBelow =
+                Find(anFirstPiece[iStrip + 1] + oBelow.m_anTopPieces[iX]);
+            if (iRootAbove != iRootBelow)
+                anParent[std::max(iRootAbove, iRootBelow)] =
+                    std::min(iRootAbove, iRootBelow);
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Merge the polygons of each group, and write them.               */
+    /* -------------------------------------------------------------------- */
+    std::vector<std::pair<size_t, size_t>> anGroups;
+    anGroups.reserve(anParent.size());
+    for (int iStrip = 0; iStrip < nStrips; iStrip++)
+    {
+        for (size_t i = 0; i < apoStrips[iStrip]->m_aoPieces.size(); i++)
+        {
+            const size_t iPiece = anFirstPiece[iStrip] + i;
+            anGroups.emplace_back(Find(iPiece), iPiece);
+        }
+    }
+    std::sort(anGroups.begin(), anGroups.end());
+
+    const auto GetPiece = [&apoStrips, &anFirstPiece](size_t iPiece)
+        -> typename GPStripPolygonReceiver<DataType>::Piece &
+    {
+        const auto iStrip = static_cast<size_t>(
+            std::upper_bound(anFirstPiece.begin(), anFirstPiece.end(),
+                             iPiece) -
+            anFirstPiece.begin() - 1);
+        return apoStrips[iStrip]->m_aoPieces[iPiece - anFirstPiece[iStrip]];
+    };
+
+    OGRLayer *poOutLayer = OGRLayer::FromHandle(hOutLayer);
+    for (size_t i = 0; eErr == CE_None && i < anGroups.size();)
+    {
+        size_t iEnd = i + 1;
+        while (iEnd < anGroups.size() &&
+               anGroups[iEnd].first == anGroups[i].first)
+            ++iEnd;
+
+        // The value of the polygon is the one of its bottom-most part, as
+        // in the non-tiled mode.
+        auto &oLastPiece = GetPiece(anGroups[iEnd - 1].second);
+        const double dfValue = static_cast<double>(oLastPiece.nValue);
+        if (iEnd == i + 1)
+        {
+            eErr = GPWriteMergedPolygon(poOutLayer, iPixValField,
+                                        padfGeoTransform,
+                                        std::move(oLastPiece.poGeom),
+                                        /* bRemoveCollinearPoints = */ false,
+                                        dfValue);
+        }
+        else
+        {
+            OGRMultiPolygon oParts;
+            for (size_t j = i; j < iEnd; j++)
+            {
+                oParts.addGeometryDirectly(
+                    GetPiece(anGroups[j].second).poGeom.release());
+            }
+            std::unique_ptr<OGRGeometry> poUnion(oParts.UnionCascaded());
+            if (!poUnion)
+            {
+                eErr = CE_Failure;
+                break;
+            }
+            if (wkbFlatten(poUnion->getGeometryType()) == wkbPolygon)
+            {
+                eErr = GPWriteMergedPolygon(
+                    poOutLayer, iPixValField, padfGeoTransform,
+                    std::unique_ptr<OGRPolygon>(poUnion.release()->toPolygon()),
+                    /* bRemoveCollinearPoints = */ true, dfValue);
+            }
+            else if (wkbFlatten(poUnion->getGeometryType()) == wkbMultiPolygon)
+            {
+                auto poMP = std::unique_ptr<OGRMultiPolygon>(
+                    poUnion.release()->toMultiPolygon());
+                while (eErr == CE_None && poMP->getNumGeometries() > 0)
+                {
+                    eErr = GPWriteMergedPolygon(
+                        poOutLayer, iPixValField, padfGeoTransform,
+                        std::unique_ptr<OGRPolygon>(
+                            poMP->stealGeometry(0)->toPolygon()),
+                        /* bRemoveCollinearPoints = */ true, dfValue);
+                }
+            }
+        }
+
+        i = iEnd;
+        if (eErr == CE_None &&
+            !pfnProgress(0.9 + 0.1 * i / static_cast<double>(anGroups.size()),
+                         "", pProgressArg))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+        }
+    }
+
+    if (eErr == CE_None)
+        pfnProgress(1.0, "", pProgressArg);
+
+    return eErr;
+}
+
+/************************************************************************/
+/*                           GDALPolygonizeT()                          */
+/************************************************************************/
+
+template <class DataType, class EqualityTest>
+static CPLErr GDALPolygonizeT(GDALRasterBandH hSrcBand,
+                              GDALRasterBandH hMaskBand, OGRLayerH hOutLayer,
+                              int iPixValField, char **papszOptions,
+                              GDALProgressFunc pfnProgress, void *pProgressArg,
+                              GDALDataType eDT)
+
+{
+    VALIDATE_POINTER1(hSrcBand, "GDALPolygonize", CE_Failure);
+    VALIDATE_POINTER1(hOutLayer, "GDALPolygonize", CE_Failure);
+
+    if (pfnProgress == nullptr)
+        pfnProgress = GDALDummyProgress;
+
+    const int nConnectedness =
+        CSLFetchNameValue(papszOptions, "8CONNECTED") ? 8 : 4;
+
+    /* -------------------------------------------------------------------- */
+    /*      Confirm our output layer will support feature creation.         */
+    /* -------------------------------------------------------------------- */
+    if (!OGR_L_TestCapability(hOutLayer, OLCSequentialWrite))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Output feature layer does not appear to support creation "
+                 "of features in GDALPolygonize().");
+        return CE_Failure;
+    }
+
+    const int nXSize = GDALGetRasterBandXSize(hSrcBand);
+    const int nYSize = GDALGetRasterBandYSize(hSrcBand);
+    if (nXSize > std::numeric_limits<int>::max() - 2)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Too wide raster");
+        return CE_Failure;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Get the geotransform, if there is one, so we can convert the    */
+    /*      vectors into georeferenced coordinates.                         */
+    /* -------------------------------------------------------------------- */
+    double adfGeoTransform[6] = {0.0, 1.0, 0.0, 0.0, 0.0, 1.0};
+    bool bGotGeoTransform = false;
+    const char *pszDatasetForGeoRef =
+        CSLFetchNameValue(papszOptions, "DATASET_FOR_GEOREF");
+    if (pszDatasetForGeoRef)
+    {
+        GDALDatasetH hSrcDS = GDALOpen(pszDatasetForGeoRef, GA_ReadOnly);
+        if (hSrcDS)
+        {
+            bGotGeoTransform =
+                GDALGetGeoTransform(hSrcDS, adfGeoTransform) == CE_None;
+            GDALClose(hSrcDS);
+        }
+    }
+    else
+    {
+        GDALDatasetH hSrcDS = GDALGetBandDataset(hSrcBand);
+        if (hSrcDS)
+            bGotGeoTransform =
+                GDALGetGeoTransform(hSrcDS, adfGeoTransform) == CE_None;
+    }
+    if (!bGotGeoTransform)
+    {
+        adfGeoTransform[0] = 0;
+        adfGeoTransform[1] = 1;
+        adfGeoTransform[2] = 0;
+        adfGeoTransform[3] = 0;
+        adfGeoTransform[4] = 0;
+        adfGeoTransform[5] = 1;
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Tiled mode, if requested.                                       */
+    /* -------------------------------------------------------------------- */
+    const char *pszThreads =
+        CSLFetchNameValueDef(papszOptions, "NUM_THREADS", "1");
+    const int nThreads = std::max(1, std::min(128, EQUAL(pszThreads, "ALL_CPUS")
+                                                       ? CPLGetNumCPUs()
+                                                       : atoi(pszThreads)));
+    const char *pszStripHeight =
+        CSLFetchNameValue(papszOptions, "STRIP_HEIGHT");
+    int nStripYSize = pszStripHeight ? atoi(pszStripHeight) : 0;
+    if (nStripYSize <= 0 && nThreads > 1)
+        nStripYSize = std::max(256, DIV_ROUND_UP(nYSize, 4 * nThreads));
+    if (nStripYSize > 0 && nStripYSize < nYSize)
+    {
+        if (nConnectedness == 8)
+        {
+            CPLDebug("GDAL", "GDALPolygonize(): tiled mode not available "
+                             "with 8CONNECTED. Processing the raster as a "
+                             "whole.");
+        }
+        else if (OGRGeometryFactory::haveGEOS())
+        {
+            return GPPolygonizeStrips<DataType, EqualityTest>(
+                hSrcBand, hMaskBand, hOutLayer, iPixValField, eDT,
+                adfGeoTransform, nStripYSize, nThreads, pfnProgress,
+                pProgressArg);
+        }
+        else
+        {
+            CPLError(CE_Warning, CPLE_NotSupported,
+                     "GDALPolygonize(): tiled mode requires GEOS support. "
+                     "Processing the raster as a whole.");
+        }
+    }
+
+    OGRPolygonWriter<DataType> oPolygonWriter{hOutLayer, iPixValField,
+                                              adfGeoTransform};
+    return GPPolygonizeStrip<DataType, EqualityTest>(
+        hSrcBand, hMaskBand, eDT, nConnectedness, 0, nYSize, oPolygonWriter,
+        GPRowCallback(), nullptr, nullptr, pfnProgress, pProgressArg);
+}
+
 /******************************************************************************/
 /*                          GDALFloatEquals()                                 */
 /* Code from:                                                                 */
@@ -487,6 +1049,15 @@ GBool GDALFloatEquals(float A, float B)
  * <li>DATASET_FOR_GEOREF=dataset_name: Name of a dataset from which to read
  * the geotransform. This useful if hSrcBand has no related dataset, which is
  * typical for mask bands.</li>
+ * <li>NUM_THREADS=number_of_threads|ALL_CPUS: (GDAL >= 3.11) Number of
+ * threads used to polygonize strips of the raster concurrently. Defaults to
+ * 1. When greater than 1, the tiled mode is used.</li>
+ * <li>STRIP_HEIGHT=number_of_lines: (GDAL >= 3.11) Height of the strips of
+ * the tiled mode, in which strips are polygonized independently and the
+ * polygons crossing strip boundaries are merged at the end. This bounds the
+ * memory used for the polygons being built. Polygons are not written in the
+ * same order as in the non-tiled mode. Requires GEOS. Not available with
+ * 8CONNECTED=8, in which case the raster is processed as a whole.</li>
  * </ul>
  * @param pfnProgress callback for reporting algorithm progress matching the
  * GDALProgressFunc() semantics.  May be NULL.
@@ -561,6 +1132,15 @@ CPLErr CPL_STDCALL GDALPolygonize(GDALRasterBandH hSrcBand,
  * <li>DATASET_FOR_GEOREF=dataset_name: Name of a dataset from which to read
  * the geotransform. This useful if hSrcBand has no related dataset, which is
  * typical for mask bands.</li>
+ * <li>NUM_THREADS=number_of_threads|ALL_CPUS: (GDAL >= 3.11) Number of
+ * threads used to polygonize strips of the raster concurrently. Defaults to
+ * 1. When greater than 1, the tiled mode is used.</li>
+ * <li>STRIP_HEIGHT=number_of_lines: (GDAL >= 3.11) Height of the strips of
+ * the tiled mode, in which strips are polygonized independently and the
+ * polygons crossing strip boundaries are merged at the end. This bounds the
+ * memory used for the polygons being built. Polygons are not written in the
+ * same order as in the non-tiled mode. Requires GEOS. Not available with
+ * 8CONNECTED=8, in which case the raster is processed as a whole.</li>
  * </ul>
  * @param pfnProgress callback for reporting algorithm progress matching the
  * GDALProgressFunc() semantics.  May be NULL.
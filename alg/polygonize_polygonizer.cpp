@@ -441,39 +441,27 @@ bool Polygonizer<PolyIdType, DataType>::processLine(
     }
 }
 
-template <typename DataType>
-OGRPolygonWriter<DataType>::OGRPolygonWriter(OGRLayerH hOutLayer,
-                                             int iPixValField,
-                                             double *padfGeoTransform)
-    : PolygonReceiver<DataType>(), poOutLayer_(OGRLayer::FromHandle(hOutLayer)),
-      iPixValField_(iPixValField), padfGeoTransform_(padfGeoTransform)
-{
-    poFeature_ = std::make_unique<OGRFeature>(poOutLayer_->GetLayerDefn());
-    poPolygon_ = new OGRPolygon();
-    poFeature_->SetGeometryDirectly(poPolygon_);
-}
-
-template <typename DataType>
-void OGRPolygonWriter<DataType>::receive(RPolygon *poPolygon,
-                                         DataType nPolygonCellValue)
+bool RPolygonToOGRPolygon(const RPolygon *poPolygon,
+                          const double *padfGeoTransform, IndexType nRowOffset,
+                          OGRPolygon *poOGRPolygon)
 {
     std::vector<bool> oAccessedArc(poPolygon->oArcs.size(), false);
-    double *padfGeoTransform = padfGeoTransform_;
 
-    OGRLinearRing *poFirstRing = poPolygon_->getExteriorRing();
-    if (poFirstRing && poPolygon_->getNumInteriorRings() == 0)
+    OGRLinearRing *poFirstRing = poOGRPolygon->getExteriorRing();
+    if (poFirstRing && poOGRPolygon->getNumInteriorRings() == 0)
     {
         poFirstRing->empty();
     }
     else
     {
         poFirstRing = nullptr;
-        poPolygon_->empty();
+        poOGRPolygon->empty();
     }
 
-    auto AddRingToPolygon =
-        [this, &poPolygon, &oAccessedArc,
-         padfGeoTransform](std::size_t iFirstArcIndex, OGRLinearRing *poRing)
+    auto AddRingToPolygon = [poOGRPolygon, &poPolygon, &oAccessedArc,
+                             padfGeoTransform,
+                             nRowOffset](std::size_t iFirstArcIndex,
+                                         OGRLinearRing *poRing)
     {
         std::unique_ptr<OGRLinearRing> poNewRing;
         if (!poRing)
@@ -482,8 +470,8 @@ void OGRPolygonWriter<DataType>::receive(RPolygon *poPolygon,
             poRing = poNewRing.get();
         }
 
-        auto AddArcToRing =
-            [&poPolygon, poRing, padfGeoTransform](std::size_t iArcIndex)
+        auto AddArcToRing = [&poPolygon, poRing, padfGeoTransform,
+                             nRowOffset](std::size_t iArcIndex)
         {
             const auto &oArc = poPolygon->oArcs[iArcIndex];
             const bool bArcFollowRighthand = oArc.bFollowRighthand;
@@ -501,13 +489,15 @@ void OGRPolygonWriter<DataType>::receive(RPolygon *poPolygon,
                     (*oArc.poArc)[bArcFollowRighthand
                                       ? i
                                       : (nArcPointCount - i - 1)];
+                const double dfRow =
+                    static_cast<double>(oPixel[0]) + nRowOffset;
 
                 const double dfX = padfGeoTransform[0] +
                                    oPixel[1] * padfGeoTransform[1] +
-                                   oPixel[0] * padfGeoTransform[2];
+                                   dfRow * padfGeoTransform[2];
                 const double dfY = padfGeoTransform[3] +
                                    oPixel[1] * padfGeoTransform[4] +
-                                   oPixel[0] * padfGeoTransform[5];
+                                   dfRow * padfGeoTransform[5];
 
                 poRing->setPoint(nDstPointIdx, dfX, dfY);
                 ++nDstPointIdx;
@@ -538,7 +528,7 @@ void OGRPolygonWriter<DataType>::receive(RPolygon *poPolygon,
         poRing->closeRings();
 
         if (poNewRing)
-            poPolygon_->addRingDirectly(poNewRing.release());
+            poOGRPolygon->addRingDirectly(poNewRing.release());
         return true;
     };
 
@@ -548,12 +538,38 @@ void OGRPolygonWriter<DataType>::receive(RPolygon *poPolygon,
         {
             if (!AddRingToPolygon(i, poFirstRing))
             {
-                eErr_ = CE_Failure;
-                return;
+                return false;
             }
             poFirstRing = nullptr;
         }
     }
+    return true;
+}
+
+template <typename DataType>
+OGRPolygonWriter<DataType>::OGRPolygonWriter(OGRLayerH hOutLayer,
+                                             int iPixValField,
+                                             double *padfGeoTransform,
+                                             IndexType nRowOffset)
+    : PolygonReceiver<DataType>(), poOutLayer_(OGRLayer::FromHandle(hOutLayer)),
+      iPixValField_(iPixValField), padfGeoTransform_(padfGeoTransform),
+      nRowOffset_(nRowOffset)
+{
+    poFeature_ = std::make_unique<OGRFeature>(poOutLayer_->GetLayerDefn());
+    poPolygon_ = new OGRPolygon();
+    poFeature_->SetGeometryDirectly(poPolygon_);
+}
+
+template <typename DataType>
+void OGRPolygonWriter<DataType>::receive(RPolygon *poPolygon,
+                                         DataType nPolygonCellValue)
+{
+    if (!RPolygonToOGRPolygon(poPolygon, padfGeoTransform_, nRowOffset_,
+                              poPolygon_))
+    {
+        eErr_ = CE_Failure;
+        return;
+    }
 
     // Create the feature object
     poFeature_->SetFID(OGRNullFID);
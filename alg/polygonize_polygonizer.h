@@ -177,6 +177,15 @@ template <typename PolyIdType, typename DataType> class Polygonizer
                      IndexType nCols);
 };
 
+/**
+ * Convert a raster polygon object to an OGR polygon, whose existing rings
+ * are reused or discarded. Grid positions are shifted by nRowOffset rows
+ * before applying the geotransform.
+ */
+bool RPolygonToOGRPolygon(const RPolygon *poPolygon,
+                          const double *padfGeoTransform, IndexType nRowOffset,
+                          OGRPolygon *poOGRPolygon);
+
 /**
  * Write raster polygon object to OGR layer.
  */
@@ -186,6 +195,7 @@ class OGRPolygonWriter : public PolygonReceiver<DataType>
     OGRLayer *poOutLayer_ = nullptr;
     int iPixValField_;
     double *padfGeoTransform_;
+    IndexType nRowOffset_;
     std::unique_ptr<OGRFeature> poFeature_{};
     OGRPolygon *poPolygon_ =
         nullptr;  // = poFeature_->GetGeometryRef(), owned by poFeature
@@ -194,7 +204,7 @@ class OGRPolygonWriter : public PolygonReceiver<DataType>
 
   public:
     OGRPolygonWriter(OGRLayerH hOutLayer, int iPixValField,
-                     double *padfGeoTransform);
+                     double *padfGeoTransform, IndexType nRowOffset = 0);
 
     OGRPolygonWriter(const OGRPolygonWriter<DataType> &) = delete;
 
@@ -49,6 +49,8 @@ struct GDALContourOptions
     std::string aosDestFilename;
     std::string aosSrcFilename;
     GIntBig nGroupTransactions = 100 * 1000;
+    std::string osNumThreads;
+    int nStripHeight = 0;
 };
 
 /************************************************************************/
@@ -172,6 +174,19 @@ GDALContourAppOptionsGetParser(GDALContourOptions *psOptions)
             })
         .help(_("Group <n> features per transaction."));
 
+    argParser->add_argument("-nt")
+        .metavar("<n>|ALL_CPUS")
+        .store_into(psOptions->osNumThreads)
+        .help(_("Number of threads used to process horizontal strips of the "
+                "raster in line contouring mode."));
+
+    argParser->add_argument("-strip_height")
+        .metavar("<lines>")
+        .scan<'i', int>()
+        .store_into(psOptions->nStripHeight)
+        .help(_("Height in lines of the strips processed independently in "
+                "line contouring mode."));
+
     argParser->add_quiet_argument(&psOptions->bQuiet);
 
     argParser->add_argument("src_filename")
@@ -532,6 +547,16 @@ MAIN_START(argc, argv)
         options = CSLAppendPrintf(options, "COMMIT_INTERVAL=" CPL_FRMT_GIB,
                                   sOptions.nGroupTransactions);
     }
+    if (!sOptions.osNumThreads.empty())
+    {
+        options = CSLAppendPrintf(options, "NUM_THREADS=%s",
+                                  sOptions.osNumThreads.c_str());
+    }
+    if (sOptions.nStripHeight > 0)
+    {
+        options =
+            CSLAppendPrintf(options, "STRIP_HEIGHT=%d", sOptions.nStripHeight);
+    }
 
     CPLErr eErr =
         GDALContourGenerateEx(hBand, hLayer, options, pfnProgress, nullptr);
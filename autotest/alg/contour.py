@@ -446,3 +446,86 @@ cellsize     1
     f = lyr.GetNextFeature()
     assert f["ELEV"] == 3
     ogrtest.check_feature_geometry(f, "LINESTRING (1.5 0.0,1.5 0.5,1.5 1.5,1.5 2.0)")
+
+
+###############################################################################
+# Test processing the raster in strips, possibly with several threads
+
+
+@pytest.mark.parametrize(
+    "options",
+    [
+        ["STRIP_HEIGHT=1"],
+        ["STRIP_HEIGHT=3", "NUM_THREADS=4"],
+        ["STRIP_HEIGHT=7", "NUM_THREADS=4", "NODATA=1"],
+    ],
+)
+def test_contour_strips(input_tif, options):
+
+    ds = gdal.Open(input_tif)
+    nodata_options = [x for x in options if x.startswith("NODATA=")]
+
+    def contour(options):
+        ogr_ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+        lyr = ogr_ds.CreateLayer("contour", geom_type=ogr.wkbLineString)
+        lyr.CreateField(ogr.FieldDefn("ID", ogr.OFTInteger))
+        lyr.CreateField(ogr.FieldDefn("ELEV", ogr.OFTReal))
+        assert (
+            gdal.ContourGenerateEx(
+                ds.GetRasterBand(1),
+                lyr,
+                options=["LEVEL_INTERVAL=4", "ID_FIELD=0", "ELEV_FIELD=1"]
+                + options,
+            )
+            == gdal.CE_None
+        )
+        lines = []
+        for f in lyr:
+            geom = f.GetGeometryRef()
+            lines.append((f["ELEV"], geom.GetPointCount(), geom.Length()))
+        return sorted(lines)
+
+    ref_lines = contour(nodata_options)
+    lines = contour(options)
+
+    assert len(lines) == len(ref_lines)
+    for line, ref_line in zip(lines, ref_lines):
+        assert line[0] == ref_line[0]
+        assert line[1] == ref_line[1]
+        assert line[2] == pytest.approx(ref_line[2], rel=1e-12)
+
+
+###############################################################################
+# Test that GDAL_NUM_THREADS does not enable the processing in strips, which
+# would change the order and IDs of the features
+
+
+def test_contour_strips_not_enabled_by_gdal_num_threads():
+
+    # Tall enough for several strips of the default height
+    size = 600
+    ds = gdal.GetDriverByName("MEM").Create("", size, size, 1, gdal.GDT_Float32)
+    values = [(i % size + i // size) % 97 for i in range(size * size)]
+    ds.WriteRaster(0, 0, size, size, struct.pack("f" * (size * size), *values))
+
+    def contour():
+        ogr_ds = ogr.GetDriverByName("Memory").CreateDataSource("")
+        lyr = ogr_ds.CreateLayer("contour", geom_type=ogr.wkbLineString)
+        lyr.CreateField(ogr.FieldDefn("ID", ogr.OFTInteger))
+        lyr.CreateField(ogr.FieldDefn("ELEV", ogr.OFTReal))
+        assert (
+            gdal.ContourGenerateEx(
+                ds.GetRasterBand(1),
+                lyr,
+                options=["LEVEL_INTERVAL=10", "ID_FIELD=0", "ELEV_FIELD=1"],
+            )
+            == gdal.CE_None
+        )
+        return [
+            (f["ID"], f["ELEV"], f.GetGeometryRef().ExportToWkt()) for f in lyr
+        ]
+
+    ref_features = contour()
+    with gdaltest.config_option("GDAL_NUM_THREADS", "4"):
+        features = contour()
+    assert features == ref_features
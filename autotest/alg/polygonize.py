@@ -428,3 +428,86 @@ def test_polygonize_8():
         wkt
         == "POLYGON ((1 4,1 3,0 3,0 1,1 1,1 0,3 0,3 1,4 1,4 3,3 3,3 4,1 4),(1 3,3 3,3 1,1 1,1 3))"
     )
+
+
+###############################################################################
+# Test the tiled mode against the non-tiled one.
+
+
+@pytest.mark.require_geos
+@pytest.mark.parametrize(
+    "options",
+    [
+        ["STRIP_HEIGHT=7"],
+        ["STRIP_HEIGHT=5", "NUM_THREADS=4"],
+        ["STRIP_HEIGHT=1", "NUM_THREADS=4"],
+    ],
+)
+def test_polygonize_tiled(options):
+
+    src_ds = gdal.Open("data/polygonize_check_area.tif")
+    src_band = src_ds.GetRasterBand(1)
+
+    mem_drv = ogr.GetDriverByName("Memory")
+    mem_ds = mem_drv.CreateDataSource("out")
+
+    def polygonize(name, options):
+        mem_layer = mem_ds.CreateLayer(name, None, ogr.wkbPolygon)
+        mem_layer.CreateField(ogr.FieldDefn("DN", ogr.OFTInteger))
+        result = gdal.Polygonize(
+            src_band, src_band.GetMaskBand(), mem_layer, 0, options
+        )
+        assert result == 0, "Polygonize failed"
+
+        dn_area = defaultdict(float)
+        for feature in mem_layer:
+            geom = feature.GetGeometryRef()
+            dn_area[feature.GetField("DN")] += geom.GetArea()
+        return mem_layer.GetFeatureCount(), dn_area
+
+    ref_count, ref_dn_area = polygonize("ref", [])
+    count, dn_area = polygonize("tiled", options)
+
+    assert count == ref_count
+    assert dn_area.keys() == ref_dn_area.keys()
+    for key, value in ref_dn_area.items():
+        assert dn_area[key] == pytest.approx(value, rel=1e-10)
+
+
+###############################################################################
+# Test that 8CONNECTED ignores the tiled mode, as polygons touching at a
+# corner across strip boundaries would not be merged.
+
+
+@pytest.mark.require_geos
+@pytest.mark.parametrize(
+    "filename,options",
+    [
+        ("data/polygonize_in_5.grd", ["STRIP_HEIGHT=2"]),
+        ("data/polygonize_check_area.tif", ["STRIP_HEIGHT=5", "NUM_THREADS=4"]),
+    ],
+)
+def test_polygonize_tiled_8connected(filename, options):
+
+    src_ds = gdal.Open(filename)
+    src_band = src_ds.GetRasterBand(1)
+
+    mem_drv = ogr.GetDriverByName("Memory")
+    mem_ds = mem_drv.CreateDataSource("out")
+
+    def polygonize(name, options):
+        mem_layer = mem_ds.CreateLayer(name, None, ogr.wkbPolygon)
+        mem_layer.CreateField(ogr.FieldDefn("DN", ogr.OFTInteger))
+        result = gdal.Polygonize(
+            src_band, None, mem_layer, 0, ["8CONNECTED=8"] + options
+        )
+        assert result == 0, "Polygonize failed"
+        return [(f.GetField("DN"), f.GetGeometryRef().Clone()) for f in mem_layer]
+
+    ref = polygonize("ref", [])
+    got = polygonize("tiled", options)
+
+    assert len(got) == len(ref)
+    for (dn, geom), (ref_dn, ref_geom) in zip(got, ref):
+        assert dn == ref_dn
+        assert geom.Equals(ref_geom), (geom.ExportToWkt(), ref_geom.ExportToWkt())
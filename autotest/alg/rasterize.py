@@ -998,3 +998,76 @@ def test_rasterize_bugfix_gh8918(wkt):
     )
 
     assert target_ds.GetRasterBand(1).Checksum() == 36
+
+
+###############################################################################
+# Check that the tile-parallel implementation gives the same result as the
+# serial one.
+
+
+@pytest.mark.parametrize(
+    "options",
+    [
+        [],
+        ["MERGE_ALG=ADD"],
+        ["ALL_TOUCHED=YES"],
+        ["MERGE_ALG=ADD", "ALL_TOUCHED=YES"],
+        ["ATTRIBUTE=val"],
+    ],
+)
+def test_rasterize_layer_num_threads(options):
+
+    import random
+
+    sr_wkt = 'LOCAL_CS["arbitrary"]'
+    sr = osr.SpatialReference(sr_wkt)
+
+    rast_ogr_ds = ogr.GetDriverByName("Memory").CreateDataSource("wrk")
+    lyr = rast_ogr_ds.CreateLayer("poly", srs=sr)
+    lyr.CreateField(ogr.FieldDefn("val", ogr.OFTInteger))
+
+    # Overlapping polygons, lines and points, some of them crossing tile
+    # boundaries or partly outside of the raster
+    rnd = random.Random(0)
+    for i in range(300):
+        x = rnd.uniform(-50, 1550)
+        y = rnd.uniform(-50, 1250)
+        w = rnd.uniform(0.5, 400)
+        h = rnd.uniform(0.5, 400)
+        kind = i % 3
+        if kind == 0:
+            wkt = "POLYGON((%f %f,%f %f,%f %f,%f %f))" % (
+                x,
+                y,
+                x + w,
+                y + h / 3,
+                x + w / 2,
+                y + h,
+                x,
+                y,
+            )
+        elif kind == 1:
+            wkt = "LINESTRING(%f %f,%f %f,%f %f)" % (x, y, x + w, y, x, y + h)
+        else:
+            wkt = "POINT(%f %f)" % (x, y)
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f["val"] = i % 7 + 1
+        f.SetGeometryDirectly(ogr.CreateGeometryFromWkt(wkt))
+        lyr.CreateFeature(f)
+
+    def rasterize(num_threads):
+        ds = gdal.GetDriverByName("MEM").Create("", 1500, 1200, 2, gdal.GDT_Byte)
+        ds.SetGeoTransform((0, 1, 0, 1200, 0, -1))
+        ds.SetProjection(sr_wkt)
+        gdal.RasterizeLayer(
+            ds,
+            [1, 2],
+            lyr,
+            burn_values=[1, 2],
+            options=options + ["NUM_THREADS=%d" % num_threads],
+        )
+        return ds.ReadRaster()
+
+    ref = rasterize(1)
+    assert ref != b"\x00" * len(ref)
+    assert rasterize(4) == ref
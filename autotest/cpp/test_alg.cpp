@@ -12,6 +12,9 @@
  ****************************************************************************/
 
 #include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
 
 #include "gdal_unit_test.h"
 
@@ -505,4 +508,157 @@ TEST_F(test_alg, GDALIsLineOfSightVisible_through_mountain)
                                          nullptr, nullptr, nullptr));
 }
 
+// Check that two doubles are identical, NaN being equal to NaN
+static void ExpectSameDouble(double dfVal, double dfExpected, int i)
+{
+    if (std::isnan(dfExpected))
+        EXPECT_TRUE(std::isnan(dfVal)) << i;
+    else
+        EXPECT_EQ(dfVal, dfExpected) << i;
+}
+
+// Test that geotransforms applied by GDALGenImgProjTransform() to several
+// points at once, which processes them by groups of 4, give the same result
+// as when applied to each point alone
+TEST_F(test_alg, GDALGenImgProjTransform_geotransform_batch)
+{
+    const double adfSrcGT[6] = {440720.5, 60.25, 0.125, 3751320.75, -0.5,
+                                -60.125};
+    const double adfDstGT[6] = {-1000.5, 30.5, -0.25, 2000.25, 0.75, -30.25};
+    void *hTransformArg = GDALCreateGenImgProjTransformer3(
+        nullptr, adfSrcGT, nullptr, adfDstGT);
+    ASSERT_TRUE(hTransformArg != nullptr);
+
+    const double dfNaN = std::numeric_limits<double>::quiet_NaN();
+    const double dfInf = std::numeric_limits<double>::infinity();
+    for (int nPoints = 1; nPoints <= 13; ++nPoints)
+    {
+        std::vector<double> adfX(nPoints);
+        std::vector<double> adfY(nPoints);
+        std::vector<double> adfZ(nPoints);
+        for (int i = 0; i < nPoints; ++i)
+        {
+            adfX[i] = 0.5 + 3.25 * i;
+            adfY[i] = 10.75 - 1.5 * i;
+        }
+        // Special values, in the SIMD groups and in the scalar tail. HUGE_VAL
+        // marks a failed point, which the transformer leaves untouched.
+        if (nPoints > 1)
+            adfX[1] = dfNaN;
+        if (nPoints > 2)
+            adfY[2] = -dfInf;
+        if (nPoints > 6)
+            adfX[6] = HUGE_VAL;
+        if (nPoints > 9)
+            adfY[nPoints - 1] = dfNaN;
+        if (nPoints > 10)
+            adfX[nPoints - 2] = dfInf;
+
+        for (const int bDstToSrc : {FALSE, TRUE})
+        {
+            std::vector<double> adfXBatch(adfX);
+            std::vector<double> adfYBatch(adfY);
+            std::vector<double> adfZBatch(adfZ);
+            std::vector<int> anSuccessBatch(nPoints);
+            EXPECT_TRUE(GDALGenImgProjTransform(
+                hTransformArg, bDstToSrc, nPoints, adfXBatch.data(),
+                adfYBatch.data(), adfZBatch.data(), anSuccessBatch.data()));
+
+            for (int i = 0; i < nPoints; ++i)
+            {
+                double dfX = adfX[i];
+                double dfY = adfY[i];
+                double dfZ = adfZ[i];
+                int bSuccess = FALSE;
+                GDALGenImgProjTransform(hTransformArg, bDstToSrc, 1, &dfX,
+                                        &dfY, &dfZ, &bSuccess);
+                EXPECT_EQ(anSuccessBatch[i], bSuccess) << i;
+                ExpectSameDouble(adfXBatch[i], dfX, i);
+                ExpectSameDouble(adfYBatch[i], dfY, i);
+            }
+        }
+    }
+
+    GDALDestroyGenImgProjTransformer(hTransformArg);
+}
+
+// Affine transformer, used as the base of an approximate transformer whose
+// interpolation must then be accepted on whole lines
+static int AffineTransform(void *, int, int nPointCount, double *x, double *y,
+                           double *z, int *panSuccess)
+{
+    for (int i = 0; i < nPointCount; ++i)
+    {
+        const double dfX = x[i];
+        x[i] = 100.25 + 0.3 * dfX + 0.7 * y[i];
+        y[i] = 50.5 - 0.2 * dfX + 0.1 * y[i];
+        z[i] = z[i] + 0.5 * dfX;
+        panSuccess[i] = TRUE;
+    }
+    return TRUE;
+}
+
+// Test that the interpolation of GDALApproxTransform(), which processes
+// points by groups of 4, gives the same result as the scalar formula
+TEST_F(test_alg, GDALApproxTransform_interpolation_batch)
+{
+    void *hTransformArg =
+        GDALCreateApproxTransformer(AffineTransform, nullptr, 0.125);
+    ASSERT_TRUE(hTransformArg != nullptr);
+
+    const double dfNaN = std::numeric_limits<double>::quiet_NaN();
+    const double dfInf = std::numeric_limits<double>::infinity();
+    // Only lines of more than 5 points are interpolated
+    for (int nPoints = 6; nPoints <= 19; ++nPoints)
+    {
+        const int nMiddle = (nPoints - 1) / 2;
+        std::vector<double> adfX(nPoints);
+        std::vector<double> adfY(nPoints, 20.5);
+        std::vector<double> adfZ(nPoints, 1.25);
+        for (int i = 0; i < nPoints; ++i)
+            adfX[i] = 10.5 + 3.25 * i;
+        // Special values on points that are only interpolated, that is
+        // neither the first, middle nor last one
+        adfX[1] = dfNaN;
+        adfX[nMiddle + 1] = dfInf;
+        if (nPoints - 2 > nMiddle + 1)
+            adfX[nPoints - 2] = -dfInf;
+
+        // Expected result, with the expressions of the scalar code
+        double adfSME_X[2] = {adfX[0], adfX[nPoints - 1]};
+        double adfSME_Y[2] = {adfY[0], adfY[nPoints - 1]};
+        double adfSME_Z[2] = {adfZ[0], adfZ[nPoints - 1]};
+        int anSMESuccess[2] = {FALSE, FALSE};
+        AffineTransform(nullptr, FALSE, 2, adfSME_X, adfSME_Y, adfSME_Z,
+                        anSMESuccess);
+        const double dfDeltaX =
+            (adfSME_X[1] - adfSME_X[0]) / (adfX[nPoints - 1] - adfX[0]);
+        const double dfDeltaY =
+            (adfSME_Y[1] - adfSME_Y[0]) / (adfX[nPoints - 1] - adfX[0]);
+        const double dfDeltaZ =
+            (adfSME_Z[1] - adfSME_Z[0]) / (adfX[nPoints - 1] - adfX[0]);
+
+        std::vector<double> adfXApprox(adfX);
+        std::vector<double> adfYApprox(adfY);
+        std::vector<double> adfZApprox(adfZ);
+        std::vector<int> anSuccess(nPoints);
+        EXPECT_TRUE(GDALApproxTransform(hTransformArg, FALSE, nPoints,
+                                        adfXApprox.data(), adfYApprox.data(),
+                                        adfZApprox.data(), anSuccess.data()));
+        for (int i = 0; i < nPoints; ++i)
+        {
+            const double dfDist = adfX[i] - adfX[0];
+            EXPECT_TRUE(anSuccess[i]) << i;
+            ExpectSameDouble(adfXApprox[i], adfSME_X[0] + dfDeltaX * dfDist,
+                             i);
+            ExpectSameDouble(adfYApprox[i], adfSME_Y[0] + dfDeltaY * dfDist,
+                             i);
+            ExpectSameDouble(adfZApprox[i], adfSME_Z[0] + dfDeltaZ * dfDist,
+                             i);
+        }
+    }
+
+    GDALDestroyApproxTransformer(hTransformArg);
+}
+
 }  // namespace
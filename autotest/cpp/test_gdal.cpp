@@ -12,14 +12,17 @@
 
 #include "gdal_unit_test.h"
 
+#include "cpl_compressor.h"
 #include "gdal_alg.h"
 #include "gdal_priv.h"
 #include "gdal_utils.h"
 #include "gdal_priv_templates.hpp"
+#include "gdal_thread_pool.h"
 #include "gdal.h"
 #include "tilematrixset.hpp"
 #include "gdalcachedpixelaccessor.h"
 
+#include <algorithm>
 #include <limits>
 #include <string>
 
@@ -708,6 +711,113 @@ TEST_F(test_gdal, GDALSwapWords_unaligned_buffers)
     GDALSwapWords(abyBuffer, 4, 2, 9);
 }
 
+// Test that the SIMD code paths of GDALCopyWords() (AVX2 when available
+// at runtime, SSE2 otherwise), which are only used for packed buffers, give
+// the same results as the generic code used when the source has a stride.
+TEST_F(test_gdal, GDALCopyWords_packed_vs_strided)
+{
+    const size_t anLengths[] = {0, 1, 7, 8, 15, 16, 17, 33};
+    const std::pair<GDALDataType, GDALDataType> aeTypes[] = {
+        {GDT_Byte, GDT_UInt16},    {GDT_Byte, GDT_Int16},
+        {GDT_Byte, GDT_Float32},   {GDT_UInt16, GDT_Byte},
+        {GDT_UInt16, GDT_Float32}, {GDT_Int16, GDT_Float32},
+        {GDT_Float32, GDT_Byte},   {GDT_Float32, GDT_Int16},
+        {GDT_Float32, GDT_UInt16}};
+    // Special, rounding and out of range values, converted to the source
+    // type first, and shifted so that each one goes through each lane.
+    const double adfValues[] = {std::numeric_limits<double>::quiet_NaN(),
+                                std::numeric_limits<double>::infinity(),
+                                -std::numeric_limits<double>::infinity(),
+                                -1e10,
+                                -32768.6,
+                                -32768.5,
+                                -32767.5,
+                                -256,
+                                -1.5,
+                                -0.5,
+                                -0.49,
+                                0,
+                                0.49,
+                                0.5,
+                                1.5,
+                                2.5,
+                                127.5,
+                                254.5,
+                                255,
+                                255.5,
+                                256,
+                                32767.4,
+                                32767.5,
+                                65534.5,
+                                65535.5,
+                                65536,
+                                1e10};
+    const size_t nValues = CPL_ARRAYSIZE(adfValues);
+
+    for (const auto &[eSrcType, eDstType] : aeTypes)
+    {
+        const int nSrcSize = GDALGetDataTypeSizeBytes(eSrcType);
+        const int nDstSize = GDALGetDataTypeSizeBytes(eDstType);
+        for (const size_t nLen : anLengths)
+        {
+            for (size_t iShift = 0; iShift < nValues; ++iShift)
+            {
+                std::vector<double> adfSrc(std::max<size_t>(1, nLen));
+                for (size_t i = 0; i < nLen; ++i)
+                    adfSrc[i] = adfValues[(i + iShift) % nValues];
+
+                std::vector<GByte> abySrc(adfSrc.size() * nSrcSize);
+                GDALCopyWords64(adfSrc.data(), GDT_Float64, sizeof(double),
+                                abySrc.data(), eSrcType, nSrcSize, nLen);
+                std::vector<GByte> abySrcStrided(abySrc.size() * 2);
+                GDALCopyWords64(abySrc.data(), eSrcType, nSrcSize,
+                                abySrcStrided.data(), eSrcType, 2 * nSrcSize,
+                                nLen);
+
+                // Room for a few more words, that must be left untouched
+                std::vector<GByte> abyDst((nLen + 8) * nDstSize, 0xCD);
+                std::vector<GByte> abyRef(abyDst);
+                GDALCopyWords64(abySrc.data(), eSrcType, nSrcSize,
+                                abyDst.data(), eDstType, nDstSize, nLen);
+                GDALCopyWords64(abySrcStrided.data(), eSrcType, 2 * nSrcSize,
+                                abyRef.data(), eDstType, nDstSize, nLen);
+
+                for (size_t i = 0; i < nLen; ++i)
+                {
+                    if (memcmp(abyDst.data() + i * nDstSize,
+                               abyRef.data() + i * nDstSize, nDstSize) != 0)
+                    {
+                        double dfDst = 0;
+                        double dfRef = 0;
+                        GDALCopyWords(abyDst.data() + i * nDstSize, eDstType,
+                                      0, &dfDst, GDT_Float64, 0, 1);
+                        GDALCopyWords(abyRef.data() + i * nDstSize, eDstType,
+                                      0, &dfRef, GDT_Float64, 0, 1);
+                        ADD_FAILURE() << GDALGetDataTypeName(eSrcType) << " -> "
+                                      << GDALGetDataTypeName(eDstType)
+                                      << ", length " << nLen << ", index " << i
+                                      << ", source value " << adfSrc[i]
+                                      << ": got " << dfDst << ", expected "
+                                      << dfRef;
+                        break;
+                    }
+                }
+                for (size_t i = nLen * nDstSize; i < abyDst.size(); ++i)
+                {
+                    if (abyDst[i] != 0xCD)
+                    {
+                        ADD_FAILURE() << GDALGetDataTypeName(eSrcType) << " -> "
+                                      << GDALGetDataTypeName(eDstType)
+                                      << ", length " << nLen
+                                      << ": written past the last word";
+                        break;
+                    }
+                }
+            }
+        }
+    }
+}
+
 // Test ARE_REAL_EQUAL()
 TEST_F(test_gdal, ARE_REAL_EQUAL)
 {
@@ -4777,4 +4887,646 @@ TEST_F(test_gdal, ReadRaster)
     }
 }
 
+// Test GDALDataset::RasterIOBatch()
+TEST_F(test_gdal, RasterIOBatch)
+{
+    GDALDriver *poGTiffDriver =
+        GetGDALDriverManager()->GetDriverByName("GTiff");
+    if (!poGTiffDriver)
+    {
+        GTEST_SKIP() << "GTiff driver missing";
+    }
+
+    const char *pszFilename = "/vsimem/test_RasterIOBatch.tif";
+    {
+        auto poDS = std::unique_ptr<GDALDataset>(poGTiffDriver->Create(
+            pszFilename, 64, 64, 2, GDT_Byte, nullptr));
+        ASSERT_TRUE(poDS != nullptr);
+        std::vector<GByte> abyData(64 * 64);
+        for (int i = 0; i < 64 * 64; ++i)
+            abyData[i] = static_cast<GByte>(i % 64);
+        ASSERT_EQ(poDS->GetRasterBand(1)->RasterIO(
+                      GF_Write, 0, 0, 64, 64, abyData.data(), 64, 64, GDT_Byte,
+                      0, 0, nullptr),
+                  CE_None);
+        ASSERT_EQ(poDS->GetRasterBand(2)->Fill(255), CE_None);
+        const int nOvrFactor = 2;
+        ASSERT_EQ(poDS->BuildOverviews("NEAREST", 1, &nOvrFactor, 0, nullptr,
+                                       nullptr, nullptr, nullptr),
+                  CE_None);
+    }
+
+    for (const int nOpenFlags : {GDAL_OF_RASTER, GDAL_OF_THREAD_SAFE})
+    {
+        auto poDS = std::unique_ptr<GDALDataset>(GDALDataset::Open(
+            pszFilename, GDAL_OF_RASTER | nOpenFlags, nullptr, nullptr,
+            nullptr));
+        ASSERT_TRUE(poDS != nullptr);
+
+        constexpr int N_WINDOWS = 16;
+        std::vector<std::vector<GByte>> aabyBuffers(N_WINDOWS);
+        std::vector<GDALDataset::RasterIOWindow> aoWindows;
+        std::atomic<int> nCallbacks = 0;
+        for (int i = 0; i < N_WINDOWS; ++i)
+        {
+            GDALDataset::RasterIOWindow oWindow;
+            // Odd windows are read from the overview, with band 2 first
+            oWindow.nOvrLevel = (i % 2) ? 0 : -1;
+            oWindow.nXOff = i;
+            oWindow.nYOff = i;
+            oWindow.nXSize = 8;
+            oWindow.nYSize = 4;
+            aabyBuffers[i].resize(2 * 8 * 4);
+            oWindow.pData = aabyBuffers[i].data();
+            oWindow.nBufXSize = 8;
+            oWindow.nBufYSize = 4;
+            oWindow.eBufType = GDT_Byte;
+            if (i % 2)
+                oWindow.anBandMap = {2, 1};
+            oWindow.oCompletionCallback = [&nCallbacks](CPLErr eErr)
+            {
+                EXPECT_EQ(eErr, CE_None);
+                ++nCallbacks;
+            };
+            aoWindows.push_back(std::move(oWindow));
+        }
+
+        const char *const apszOptions[] = {"NUM_THREADS=4", nullptr};
+        auto aoFutures =
+            poDS->RasterIOBatch(std::move(aoWindows), apszOptions);
+        ASSERT_EQ(aoFutures.size(), static_cast<size_t>(N_WINDOWS));
+        for (auto &oFuture : aoFutures)
+            EXPECT_EQ(oFuture.get(), CE_None);
+        EXPECT_EQ(nCallbacks.load(), N_WINDOWS);
+
+        for (int i = 0; i < N_WINDOWS; ++i)
+        {
+            const bool bOvr = (i % 2) != 0;
+            GDALRasterBand *poBand = poDS->GetRasterBand(1);
+            if (bOvr)
+                poBand = poBand->GetOverview(0);
+            std::vector<GByte> abyExpected(8 * 4);
+            ASSERT_EQ(poBand->RasterIO(GF_Read, i, i, 8, 4, abyExpected.data(),
+                                       8, 4, GDT_Byte, 0, 0, nullptr),
+                      CE_None);
+            const GByte *pabyBand1 = aabyBuffers[i].data() + (bOvr ? 32 : 0);
+            const GByte *pabyBand2 = aabyBuffers[i].data() + (bOvr ? 0 : 32);
+            for (int j = 0; j < 8 * 4; ++j)
+            {
+                EXPECT_EQ(pabyBand1[j], abyExpected[j]) << i;
+                EXPECT_EQ(pabyBand2[j], 255) << i;
+            }
+        }
+
+        // Invalid overview level
+        GDALDataset::RasterIOWindow oWindow;
+        oWindow.nOvrLevel = 1;
+        oWindow.nXSize = 1;
+        oWindow.nYSize = 1;
+        GByte abyBuffer[2] = {0, 0};
+        oWindow.pData = abyBuffer;
+        oWindow.nBufXSize = 1;
+        oWindow.nBufYSize = 1;
+        std::vector<GDALDataset::RasterIOWindow> aoInvalidWindows;
+        aoInvalidWindows.push_back(std::move(oWindow));
+        CPLErrorStateBackuper oBackuper(CPLQuietErrorHandler);
+        auto aoInvalidFutures =
+            poDS->RasterIOBatch(std::move(aoInvalidWindows));
+        ASSERT_EQ(aoInvalidFutures.size(), 1U);
+        EXPECT_EQ(aoInvalidFutures[0].get(), CE_Failure);
+    }
+
+    VSIUnlink(pszFilename);
+}
+
+// Test that RasterIOBatch() reads at most NUM_THREADS windows at the same
+// time, and that an error in one window does not affect the others and is
+// reported to the caller
+TEST_F(test_gdal, RasterIOBatch_num_threads_and_error)
+{
+    // Thread-safe band recording the maximum number of concurrent reads, and
+    // failing on a given line.
+    class ConcurrencyBand final : public GDALRasterBand
+    {
+      public:
+        std::atomic<int> m_nActive{0};
+        std::atomic<int> m_nMaxActive{0};
+        int m_nFailAtLine;
+
+        ConcurrencyBand(int nSize, int nFailAtLine) : m_nFailAtLine(nFailAtLine)
+        {
+            nRasterXSize = nSize;
+            nRasterYSize = nSize;
+            nBlockXSize = nSize;
+            nBlockYSize = 1;
+            eDataType = GDT_Byte;
+        }
+
+      protected:
+        CPLErr IReadBlock(int, int, void *) override
+        {
+            return CE_Failure;
+        }
+
+        CPLErr IRasterIO(GDALRWFlag, int, int nYOff, int nXSize, int nYSize,
+                         void *pData, int, int, GDALDataType, GSpacing,
+                         GSpacing, GDALRasterIOExtraArg *) override
+        {
+            const int nActive = ++m_nActive;
+            int nMaxActive = m_nMaxActive;
+            while (nActive > nMaxActive &&
+                   !m_nMaxActive.compare_exchange_weak(nMaxActive, nActive))
+            {
+            }
+            CPLSleep(0.01);
+            --m_nActive;
+            if (nYOff == m_nFailAtLine)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined, "read error");
+                return CE_Failure;
+            }
+            memset(pData, static_cast<GByte>(nYOff),
+                   static_cast<size_t>(nXSize) * nYSize);
+            return CE_None;
+        }
+    };
+
+    class ConcurrencyDataset final : public GDALDataset
+    {
+      public:
+        ConcurrencyDataset(int nSize, int nFailAtLine)
+        {
+            nOpenFlags = GDAL_OF_RASTER | GDAL_OF_THREAD_SAFE;
+            nRasterXSize = nSize;
+            nRasterYSize = nSize;
+            SetBand(1, std::make_unique<ConcurrencyBand>(nSize, nFailAtLine));
+        }
+    };
+
+    constexpr int N_WINDOWS = 16;
+    constexpr int FAIL_AT_LINE = 5;
+    ConcurrencyDataset oDS(N_WINDOWS, FAIL_AT_LINE);
+    ASSERT_TRUE(oDS.IsThreadSafe(GDAL_OF_RASTER));
+    // Make sure the global thread pool has more threads than requested
+    GDALGetGlobalThreadPool(8);
+
+    std::vector<GByte> abyBuffer(N_WINDOWS * 4);
+    std::vector<GDALDataset::RasterIOWindow> aoWindows;
+    for (int i = 0; i < N_WINDOWS; ++i)
+    {
+        GDALDataset::RasterIOWindow oWindow;
+        oWindow.nYOff = i;
+        oWindow.nXSize = 4;
+        oWindow.nYSize = 1;
+        oWindow.pData = abyBuffer.data() + i * 4;
+        oWindow.nBufXSize = 4;
+        oWindow.nBufYSize = 1;
+        aoWindows.push_back(std::move(oWindow));
+    }
+
+    const char *const apszOptions[] = {"NUM_THREADS=2", nullptr};
+    std::vector<std::future<CPLErr>> aoFutures;
+    {
+        CPLErrorStateBackuper oBackuper(CPLQuietErrorHandler);
+        aoFutures = oDS.RasterIOBatch(std::move(aoWindows), apszOptions);
+        ASSERT_EQ(aoFutures.size(), static_cast<size_t>(N_WINDOWS));
+        for (int i = 0; i < N_WINDOWS; ++i)
+        {
+            CPLErrorReset();
+            EXPECT_EQ(aoFutures[i].get(),
+                      i == FAIL_AT_LINE ? CE_Failure : CE_None)
+                << i;
+            // Errors of the worker threads are emitted again in this one
+            EXPECT_STREQ(CPLGetLastErrorMsg(),
+                         i == FAIL_AT_LINE ? "read error" : "")
+                << i;
+        }
+    }
+    for (int i = 0; i < N_WINDOWS; ++i)
+    {
+        if (i != FAIL_AT_LINE)
+        {
+            EXPECT_EQ(abyBuffer[i * 4 + 3], i);
+        }
+    }
+    const auto poBand =
+        cpl::down_cast<ConcurrencyBand *>(oDS.GetRasterBand(1));
+    EXPECT_LE(poBand->m_nMaxActive.load(), 2);
+    EXPECT_GE(poBand->m_nMaxActive.load(), 1);
+}
+
+// Test the PIPELINE option of GDALDatasetCopyWholeRaster(), and the
+// GDAL_COPY_WHOLE_RASTER_PIPELINE configuration option
+TEST_F(test_gdal, GDALDatasetCopyWholeRaster_pipeline)
+{
+    // Destination band writing directly into a buffer, which fails when
+    // writing at or after a given line, or when it does not see a thread-local
+    // configuration option set by the calling thread.
+    class DirectWriteBand final : public GDALRasterBand
+    {
+      public:
+        std::vector<GByte> m_abyData;
+        int m_nFailAtLine;
+
+        DirectWriteBand(int nXSize, int nYSize, int nFailAtLine)
+            : m_abyData(static_cast<size_t>(nXSize) * nYSize),
+              m_nFailAtLine(nFailAtLine)
+        {
+            nRasterXSize = nXSize;
+            nRasterYSize = nYSize;
+            nBlockXSize = nXSize;
+            nBlockYSize = 1;
+            eDataType = GDT_Byte;
+        }
+
+      protected:
+        CPLErr IReadBlock(int, int, void *) override
+        {
+            return CE_Failure;
+        }
+
+        CPLErr IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff, int nXSize,
+                         int nYSize, void *pData, int nBufXSize, int nBufYSize,
+                         GDALDataType eBufType, GSpacing nPixelSpace,
+                         GSpacing nLineSpace, GDALRasterIOExtraArg *) override
+        {
+            if (eRWFlag != GF_Write || nXSize != nBufXSize ||
+                nYSize != nBufYSize)
+                return CE_Failure;
+            if (!CPLTestBool(CPLGetConfigOption("TEST_PIPELINE", "NO")))
+            {
+                CPLError(CE_Failure, CPLE_AppDefined, "TEST_PIPELINE not set");
+                return CE_Failure;
+            }
+            if (nYOff + nYSize > m_nFailAtLine)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined, "write error");
+                return CE_Failure;
+            }
+            for (int iY = 0; iY < nYSize; ++iY)
+            {
+                GDALCopyWords(static_cast<GByte *>(pData) + iY * nLineSpace,
+                              eBufType, static_cast<int>(nPixelSpace),
+                              &m_abyData[static_cast<size_t>(nYOff + iY) *
+                                             nRasterXSize +
+                                         nXOff],
+                              GDT_Byte, 1, nXSize);
+            }
+            return CE_None;
+        }
+    };
+
+    class DirectWriteDataset final : public GDALDataset
+    {
+      public:
+        DirectWriteDataset(int nXSize, int nYSize, int nBandsIn,
+                           int nFailAtLine)
+        {
+            eAccess = GA_Update;
+            nRasterXSize = nXSize;
+            nRasterYSize = nYSize;
+            for (int i = 1; i <= nBandsIn; ++i)
+                SetBand(i, std::make_unique<DirectWriteBand>(nXSize, nYSize,
+                                                             nFailAtLine));
+        }
+    };
+
+    constexpr int nXSize = 1000;
+    constexpr int nYSize = 1501;
+    constexpr int nBands = 3;
+    GDALDatasetUniquePtr poSrcDS(
+        GDALDriver::FromHandle(GDALGetDriverByName("MEM"))
+            ->Create("", nXSize, nYSize, nBands, GDT_Byte, nullptr));
+    std::vector<GByte> abyData(static_cast<size_t>(nXSize) * nYSize * nBands);
+    for (size_t i = 0; i < abyData.size(); ++i)
+        abyData[i] = static_cast<GByte>((i * 37 + i / 251) & 0xff);
+    ASSERT_EQ(poSrcDS->RasterIO(GF_Write, 0, 0, nXSize, nYSize, abyData.data(),
+                                nXSize, nYSize, GDT_Byte, nBands, nullptr, 0,
+                                0, 0, nullptr),
+              CE_None);
+
+    // Force many swaths
+    CPLConfigOptionSetter oSwathSize("GDAL_SWATH_SIZE", "1000000", false);
+    // Only set as a thread-local option, which the writer thread of the
+    // pipelined mode must see as well.
+    CPLSetThreadLocalConfigOption("TEST_PIPELINE", "YES");
+
+    for (const char *pszInterleave : {"BAND", "PIXEL"})
+    {
+        // CONFIG: enabled through GDAL_COPY_WHOLE_RASTER_PIPELINE
+        for (const char *pszPipeline : {"NO", "YES", "CONFIG"})
+        {
+            const bool bConfig = EQUAL(pszPipeline, "CONFIG");
+            CPLConfigOptionSetter oPipeline("GDAL_COPY_WHOLE_RASTER_PIPELINE",
+                                            bConfig ? "YES" : nullptr, false);
+            CPLStringList aosOptions;
+            aosOptions.SetNameValue("INTERLEAVE", pszInterleave);
+            if (!bConfig)
+                aosOptions.SetNameValue("PIPELINE", pszPipeline);
+
+            DirectWriteDataset oDstDS(nXSize, nYSize, nBands, nYSize);
+            EXPECT_EQ(GDALDatasetCopyWholeRaster(
+                          poSrcDS.get(), &oDstDS, aosOptions.List(), nullptr,
+                          nullptr),
+                      CE_None)
+                << pszInterleave << " " << pszPipeline;
+            for (int i = 0; i < nBands; ++i)
+            {
+                const auto poBand = cpl::down_cast<DirectWriteBand *>(
+                    oDstDS.GetRasterBand(i + 1));
+                EXPECT_TRUE(std::equal(
+                    poBand->m_abyData.begin(), poBand->m_abyData.end(),
+                    abyData.begin() + static_cast<size_t>(i) * nXSize * nYSize))
+                    << pszInterleave << " " << pszPipeline;
+            }
+
+            // Write error in the middle of the copy
+            DirectWriteDataset oFailingDstDS(nXSize, nYSize, nBands,
+                                             nYSize / 2);
+            CPLErrorReset();
+            {
+                CPLErrorStateBackuper oBackuper(CPLQuietErrorHandler);
+                EXPECT_EQ(GDALDatasetCopyWholeRaster(
+                              poSrcDS.get(), &oFailingDstDS, aosOptions.List(),
+                              nullptr, nullptr),
+                          CE_Failure)
+                    << pszInterleave << " " << pszPipeline;
+            }
+        }
+    }
+
+    CPLSetThreadLocalConfigOption("TEST_PIPELINE", nullptr);
+}
+
+// Test the compressed block cache (GDAL_COMPRESSED_CACHE_MAX)
+TEST_F(test_gdal, compressed_block_cache)
+{
+    if (!CPLGetCompressor("lz4") && !CPLGetCompressor("zstd"))
+    {
+        GTEST_SKIP() << "lz4 and zstd not available";
+    }
+
+    // Band counting its block reads, with a direct write path bypassing the
+    // block cache, as the MEM driver does.
+    class CountingBand final : public GDALRasterBand
+    {
+      public:
+        std::vector<GByte> m_abyData;
+        int m_nBlockReads = 0;
+
+        CountingBand(GDALDataset *poDSIn, int nSize, int nBlockSize)
+            : m_abyData(static_cast<size_t>(nSize) * nSize)
+        {
+            poDS = poDSIn;
+            nBand = 1;
+            eAccess = GA_Update;
+            nRasterXSize = nSize;
+            nRasterYSize = nSize;
+            nBlockXSize = nBlockSize;
+            nBlockYSize = nBlockSize;
+            eDataType = GDT_Byte;
+        }
+
+        GByte GetBlockValue(int nXBlockOff, int nYBlockOff)
+        {
+            GDALRasterBlock *poBlock =
+                GetLockedBlockRef(nXBlockOff, nYBlockOff);
+            if (!poBlock)
+                return 0;
+            const GByte *pabyBlock =
+                static_cast<const GByte *>(poBlock->GetDataRef());
+            const GByte nVal = pabyBlock[0];
+            for (int i = 0; i < nBlockXSize * nBlockYSize; ++i)
+            {
+                if (pabyBlock[i] != nVal)
+                {
+                    poBlock->DropLock();
+                    return 0;
+                }
+            }
+            poBlock->DropLock();
+            return nVal;
+        }
+
+      protected:
+        CPLErr IReadBlock(int nXBlockOff, int nYBlockOff, void *pData) override
+        {
+            ++m_nBlockReads;
+            for (int iY = 0; iY < nBlockYSize; ++iY)
+            {
+                memcpy(static_cast<GByte *>(pData) + iY * nBlockXSize,
+                       &m_abyData[static_cast<size_t>(nYBlockOff * nBlockYSize +
+                                                      iY) *
+                                      nRasterXSize +
+                                  nXBlockOff * nBlockXSize],
+                       nBlockXSize);
+            }
+            return CE_None;
+        }
+
+        CPLErr IWriteBlock(int nXBlockOff, int nYBlockOff, void *pData) override
+        {
+            for (int iY = 0; iY < nBlockYSize; ++iY)
+            {
+                memcpy(&m_abyData[static_cast<size_t>(nYBlockOff * nBlockYSize +
+                                                      iY) *
+                                      nRasterXSize +
+                                  nXBlockOff * nBlockXSize],
+                       static_cast<const GByte *>(pData) + iY * nBlockXSize,
+                       nBlockXSize);
+            }
+            return CE_None;
+        }
+
+        CPLErr IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff, int nXSize,
+                         int nYSize, void *pData, int nBufXSize, int nBufYSize,
+                         GDALDataType eBufType, GSpacing nPixelSpace,
+                         GSpacing nLineSpace,
+                         GDALRasterIOExtraArg *psExtraArg) override
+        {
+            if (eRWFlag == GF_Read || nXSize != nBufXSize ||
+                nYSize != nBufYSize)
+            {
+                return GDALRasterBand::IRasterIO(
+                    eRWFlag, nXOff, nYOff, nXSize, nYSize, pData, nBufXSize,
+                    nBufYSize, eBufType, nPixelSpace, nLineSpace, psExtraArg);
+            }
+            for (int iY = 0; iY < nYSize; ++iY)
+            {
+                GDALCopyWords(static_cast<GByte *>(pData) + iY * nLineSpace,
+                              eBufType, static_cast<int>(nPixelSpace),
+                              &m_abyData[static_cast<size_t>(nYOff + iY) *
+                                             nRasterXSize +
+                                         nXOff],
+                              GDT_Byte, 1, nXSize);
+            }
+            return CE_None;
+        }
+    };
+
+    class CountingDataset final : public GDALDataset
+    {
+      public:
+        CountingDataset(int nSize, int nBlockSize)
+        {
+            eAccess = GA_Update;
+            nRasterXSize = nSize;
+            nRasterYSize = nSize;
+            SetBand(1,
+                    std::make_unique<CountingBand>(this, nSize, nBlockSize));
+        }
+
+        CountingBand *GetBand()
+        {
+            return cpl::down_cast<CountingBand *>(GetRasterBand(1));
+        }
+    };
+
+    const auto EvictAll = []()
+    {
+        while (GDALRasterBlock::FlushCacheBlock())
+        {
+        }
+    };
+
+    constexpr int nSize = 128;
+    constexpr int nBlockSize = 64;
+    CPLConfigOptionSetter oMax("GDAL_COMPRESSED_CACHE_MAX", "10MB", false);
+
+    {
+        CountingDataset oDS(nSize, nBlockSize);
+        auto poBand = oDS.GetBand();
+        std::fill(poBand->m_abyData.begin(), poBand->m_abyData.end(), 1);
+
+        // Round trip: the second read is served from the compressed cache
+        EXPECT_EQ(poBand->GetBlockValue(0, 0), 1);
+        EXPECT_EQ(poBand->m_nBlockReads, 1);
+        EvictAll();
+        EXPECT_EQ(poBand->GetBlockValue(0, 0), 1);
+        EXPECT_EQ(poBand->m_nBlockReads, 1);
+
+        // Write bypassing the block cache: the compressed copy is stale
+        EvictAll();
+        std::vector<GByte> abyNew(nBlockSize * nBlockSize, 2);
+        ASSERT_EQ(poBand->RasterIO(GF_Write, 0, 0, nBlockSize, nBlockSize,
+                                   abyNew.data(), nBlockSize, nBlockSize,
+                                   GDT_Byte, 0, 0, nullptr),
+                  CE_None);
+        EXPECT_EQ(poBand->GetBlockValue(0, 0), 2);
+        EXPECT_EQ(poBand->m_nBlockReads, 2);
+
+        // Same through GDALDataset::RasterIO()
+        EvictAll();
+        std::fill(abyNew.begin(), abyNew.end(), 3);
+        ASSERT_EQ(oDS.RasterIO(GF_Write, 0, 0, nBlockSize, nBlockSize,
+                               abyNew.data(), nBlockSize, nBlockSize, GDT_Byte,
+                               1, nullptr, 0, 0, 0, nullptr),
+                  CE_None);
+        EXPECT_EQ(poBand->GetBlockValue(0, 0), 3);
+        EXPECT_EQ(poBand->m_nBlockReads, 3);
+
+        // Blocks outside of the written window are still cached
+        EXPECT_EQ(poBand->GetBlockValue(1, 1), 1);
+        EXPECT_EQ(poBand->m_nBlockReads, 4);
+        EvictAll();
+        ASSERT_EQ(oDS.RasterIO(GF_Write, 0, 0, nBlockSize, nBlockSize,
+                               abyNew.data(), nBlockSize, nBlockSize, GDT_Byte,
+                               1, nullptr, 0, 0, 0, nullptr),
+                  CE_None);
+        EXPECT_EQ(poBand->GetBlockValue(1, 1), 1);
+        EXPECT_EQ(poBand->m_nBlockReads, 4);
+
+        // Write through the block cache, then evict, then read
+        EXPECT_EQ(poBand->GetBlockValue(1, 0), 1);
+        EXPECT_EQ(poBand->m_nBlockReads, 5);
+        EvictAll();
+        {
+            GDALRasterBlock *poBlock = poBand->GetLockedBlockRef(1, 0);
+            ASSERT_NE(poBlock, nullptr);
+            EXPECT_EQ(poBand->m_nBlockReads, 5);
+            memset(poBlock->GetDataRef(), 4, nBlockSize * nBlockSize);
+            poBlock->MarkDirty();
+            poBlock->DropLock();
+        }
+        EvictAll();
+        EXPECT_EQ(poBand->m_abyData[nBlockSize], 4);
+        EXPECT_EQ(poBand->GetBlockValue(1, 0), 4);
+        EXPECT_EQ(poBand->m_nBlockReads, 6);
+
+        // Flushing the band cache forgets its compressed blocks
+        EvictAll();
+        oDS.FlushCache(false);
+        EXPECT_EQ(poBand->GetBlockValue(1, 0), 4);
+        EXPECT_EQ(poBand->m_nBlockReads, 7);
+        EvictAll();
+    }
+
+    // A new band, possibly at the same address as the previous one, must not
+    // see blocks of the destroyed band
+    {
+        CountingDataset oDS(nSize, nBlockSize);
+        auto poBand = oDS.GetBand();
+        std::fill(poBand->m_abyData.begin(), poBand->m_abyData.end(), 5);
+        EXPECT_EQ(poBand->GetBlockValue(1, 0), 5);
+        EXPECT_EQ(poBand->m_nBlockReads, 1);
+    }
+}
+
+// Test that the cascaded computation of overviews gives the same result as
+// the default one when the overview bands have another data type than the
+// source band
+TEST_F(test_gdal, GDALRegenerateOverviewsMultiBand_cascade_ovr_data_type)
+{
+    GDALDriver *poMEMDriver =
+        GDALDriver::FromHandle(GDALGetDriverByName("MEM"));
+    constexpr int SIZE = 64;
+    GDALDatasetUniquePtr poSrcDS(
+        poMEMDriver->Create("", SIZE, SIZE, 1, GDT_Float32, nullptr));
+    ASSERT_TRUE(poSrcDS != nullptr);
+    // Values with a fractional part, lost when written in the overviews
+    std::vector<float> afValues(SIZE * SIZE);
+    for (int i = 0; i < SIZE * SIZE; ++i)
+    {
+        const int nVal = ((i % SIZE) + 2 * (i / SIZE)) % 10;
+        afValues[i] = 0.45f + 0.3f * static_cast<float>(nVal);
+    }
+    GDALRasterBand *poSrcBand = poSrcDS->GetRasterBand(1);
+    ASSERT_EQ(poSrcBand->RasterIO(GF_Write, 0, 0, SIZE, SIZE, afValues.data(),
+                                  SIZE, SIZE, GDT_Float32, 0, 0, nullptr),
+              CE_None);
+
+    const auto ComputeOverviews = [&](const char *pszCascade)
+    {
+        CPLConfigOptionSetter oSetter("GDAL_OVR_CASCADE", pszCascade, false);
+        std::vector<GDALDatasetUniquePtr> apoOvrDS;
+        std::vector<GDALRasterBand *> apoOvrBands;
+        for (int nOvrSize = SIZE / 2; nOvrSize >= SIZE / 8; nOvrSize /= 2)
+        {
+            apoOvrDS.emplace_back(poMEMDriver->Create(
+                "", nOvrSize, nOvrSize, 1, GDT_Byte, nullptr));
+            apoOvrBands.push_back(apoOvrDS.back()->GetRasterBand(1));
+        }
+        GDALRasterBand **papoOvrBands = apoOvrBands.data();
+        EXPECT_EQ(GDALRegenerateOverviewsMultiBand(
+                      1, &poSrcBand, static_cast<int>(apoOvrBands.size()),
+                      &papoOvrBands, "AVERAGE", nullptr, nullptr, nullptr),
+                  CE_None);
+        std::vector<std::vector<GByte>> aabyValues;
+        for (auto *poOvrBand : apoOvrBands)
+        {
+            const int nOvrSize = poOvrBand->GetXSize();
+            aabyValues.emplace_back(nOvrSize * nOvrSize);
+            EXPECT_EQ(poOvrBand->RasterIO(GF_Read, 0, 0, nOvrSize, nOvrSize,
+                                          aabyValues.back().data(), nOvrSize,
+                                          nOvrSize, GDT_Byte, 0, 0, nullptr),
+                      CE_None);
+        }
+        return aabyValues;
+    };
+
+    const auto aabyExpected = ComputeOverviews("NO");
+    ASSERT_EQ(aabyExpected.size(), 3U);
+    EXPECT_EQ(ComputeOverviews("YES"), aabyExpected);
+}
+
 }  // namespace
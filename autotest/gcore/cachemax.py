@@ -0,0 +1,118 @@
+#!/usr/bin/env pytest
+# -*- coding: utf-8 -*-
+###############################################################################
+#
+# Project:  GDAL/OGR Test Suite
+# Purpose:  Test the raster block cache statistics and eviction.
+#
+###############################################################################
+# Copyright (c) 2026, GDAL contributors
+#
+# SPDX-License-Identifier: MIT
+###############################################################################
+
+import json
+import os
+import subprocess
+import sys
+
+import pytest
+
+pytestmark = pytest.mark.require_driver("GTiff")
+
+BLOCK_COUNT = 64
+BLOCK_SIZE = 32 * 32
+
+
+###############################################################################
+# Run a function of cachemax_subprocess.py in a new process, as the block
+# cache configuration options are only read the first time the cache is used
+
+
+def run_subprocess(function, config_options):
+
+    env = os.environ.copy()
+    env.update(config_options)
+    return json.loads(
+        subprocess.check_output(
+            [sys.executable, "cachemax_subprocess.py", function], env=env
+        ).decode("utf-8")
+    )
+
+
+###############################################################################
+# Test that hits, misses and evictions move as expected
+
+
+def test_cachemax_statistics():
+
+    snapshots = run_subprocess(
+        "statistics", {"GDAL_CACHE_STATISTICS": "YES", "GDAL_CACHEMAX": "64"}
+    )
+
+    reset = snapshots["reset"]
+    assert reset["hits"] == 0
+    assert reset["misses"] == 0
+    assert reset["evictions"] == 0
+
+    # Every tile is read once from the file
+    first = snapshots["first_read"]
+    assert first["misses"] == BLOCK_COUNT
+    assert first["bytes_read"] == BLOCK_COUNT * BLOCK_SIZE
+    assert first["evictions"] == 0
+
+    # and then served from the cache, for as many requests as the first time
+    second = snapshots["second_read"]
+    assert second["misses"] == BLOCK_COUNT
+    assert second["bytes_read"] == BLOCK_COUNT * BLOCK_SIZE
+    assert second["hits"] == 2 * first["hits"] + BLOCK_COUNT
+    assert second["evictions"] == 0
+
+    for key in ("hits", "misses", "bytes_read", "evictions"):
+        assert snapshots["band"][key] == second[key], key
+        assert snapshots["dataset"][key] == second[key], key
+    assert snapshots["band"]["lock_wait_time"] == 0
+
+    # Shrinking the cache evicts tiles, and reading again misses and evicts
+    shrunk = snapshots["shrunk"]
+    assert shrunk["evictions"] >= BLOCK_COUNT - 16
+    third = snapshots["third_read"]
+    assert third["misses"] > second["misses"]
+    assert third["evictions"] > shrunk["evictions"]
+    assert third["bytes_read"] == third["misses"] * BLOCK_SIZE
+    assert snapshots["cache_used"] <= 16 * BLOCK_SIZE
+
+
+###############################################################################
+# Test that nothing is collected by default
+
+
+def test_cachemax_statistics_disabled():
+
+    snapshots = run_subprocess("statistics", {"GDAL_CACHE_STATISTICS": "NO"})
+
+    for key in ("hits", "misses", "bytes_read", "evictions"):
+        assert snapshots["second_read"][key] == 0, key
+        assert snapshots["band"][key] == 0, key
+
+
+###############################################################################
+# Test that the CLOCK policy keeps a block used between each eviction, and
+# stays within the cache size
+
+
+def test_cachemax_clock_policy():
+
+    result = run_subprocess(
+        "clock",
+        {"GDAL_BLOCK_CACHE_POLICY": "CLOCK", "GDAL_CACHE_STATISTICS": "YES"},
+    )
+
+    assert result["max_cache_used"] <= 16 * BLOCK_SIZE
+    assert result["evictions"] > 0
+
+    # Tile 0 may only be evicted once, by the first scan that clears the
+    # flags of all the blocks read so far
+    assert result["misses"] <= BLOCK_COUNT + 1
+    assert result["hot_misses"] == 0
+    assert result["cold_misses"] == 1
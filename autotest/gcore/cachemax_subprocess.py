@@ -0,0 +1,100 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+###############################################################################
+#
+# Project:  GDAL/OGR Test Suite
+# Purpose:  Helper of cachemax.py, run in a subprocess so that the block
+#           cache configuration options read at startup can be set.
+#
+###############################################################################
+# Copyright (c) 2026, GDAL contributors
+#
+# SPDX-License-Identifier: MIT
+###############################################################################
+
+import json
+import sys
+
+from osgeo import gdal
+
+# 256x256 Byte raster made of 64 tiles of 32x32 bytes
+BLOCK_SIZE = 32 * 32
+
+
+def create_tiled(filename):
+
+    ds = gdal.GetDriverByName("GTiff").Create(
+        filename, 256, 256, options=["TILED=YES", "BLOCKXSIZE=32", "BLOCKYSIZE=32"]
+    )
+    ds.GetRasterBand(1).Fill(1)
+    ds.Close()
+
+
+def statistics():
+
+    filename = "/vsimem/cachemax_statistics.tif"
+    create_tiled(filename)
+
+    snapshots = {}
+    gdal.ResetCacheStatistics()
+    snapshots["reset"] = gdal.GetCacheStatistics()
+
+    ds = gdal.Open(filename)
+    band = ds.GetRasterBand(1)
+    band.ReadRaster()
+    snapshots["first_read"] = gdal.GetCacheStatistics()
+    band.ReadRaster()
+    snapshots["second_read"] = gdal.GetCacheStatistics()
+    snapshots["band"] = band.GetCacheStatistics()
+    snapshots["dataset"] = ds.GetCacheStatistics()
+
+    # Leave room for 16 tiles only
+    gdal.SetCacheMax(16 * BLOCK_SIZE)
+    snapshots["shrunk"] = gdal.GetCacheStatistics()
+    band.ReadRaster()
+    snapshots["third_read"] = gdal.GetCacheStatistics()
+    snapshots["cache_used"] = gdal.GetCacheUsed()
+    ds.Close()
+
+    gdal.Unlink(filename)
+    return snapshots
+
+
+def clock():
+
+    filename = "/vsimem/cachemax_clock.tif"
+    create_tiled(filename)
+
+    # Leave room for less than 16 tiles
+    gdal.SetCacheMax(16 * BLOCK_SIZE)
+    gdal.ResetCacheStatistics()
+
+    ds = gdal.Open(filename)
+    band = ds.GetRasterBand(1)
+
+    def read_tile(i):
+        band.ReadRaster((i % 8) * 32, (i // 8) * 32, 32, 32)
+        return gdal.GetCacheStatistics()["misses"]
+
+    # Read every tile once, and tile 0 again after each of them
+    max_cache_used = 0
+    read_tile(0)
+    for i in range(1, 64):
+        read_tile(i)
+        read_tile(0)
+        max_cache_used = max(max_cache_used, gdal.GetCacheUsed())
+
+    result = {"max_cache_used": max_cache_used}
+    result["misses"] = gdal.GetCacheStatistics()["misses"]
+    result["hot_misses"] = read_tile(0) - result["misses"]
+    result["cold_misses"] = read_tile(1) - result["misses"] - result["hot_misses"]
+    result["evictions"] = gdal.GetCacheStatistics()["evictions"]
+    ds.Close()
+
+    gdal.Unlink(filename)
+    return result
+
+
+if __name__ == "__main__":
+    gdal.UseExceptions()
+    print(json.dumps(globals()[sys.argv[1]]()))
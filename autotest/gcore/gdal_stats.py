@@ -926,3 +926,58 @@ def test_stats_mask_band():
     assert src_ds.GetRasterBand(1).ComputeRasterMinMax(False) == (2, 3)
     assert src_ds.GetRasterBand(1).ComputeStatistics(False) == [2, 3, 2.5, 0.5]
     assert src_ds.GetRasterBand(1).GetHistogram(False) == [0, 0, 1, 1] + ([0] * 252)
+
+
+###############################################################################
+# Test that computations with several threads, where blocks are decoded by
+# the worker threads, give the same results as with a single thread
+
+
+@pytest.mark.parametrize(
+    "datatype", [gdal.GDT_Byte, gdal.GDT_UInt16, gdal.GDT_Float32]
+)
+@pytest.mark.parametrize("nodata", [None, 0])
+@pytest.mark.parametrize("approx_ok", [False, True])
+@pytest.mark.require_driver("GTiff")
+def test_stats_multithreaded(tmp_vsimem, datatype, nodata, approx_ok):
+
+    filename = str(tmp_vsimem / "test_stats_multithreaded.tif")
+    src_ds = gdal.GetDriverByName("MEM").Create("", 500, 500, 1, datatype)
+    src_ds.WriteRaster(
+        0,
+        0,
+        500,
+        500,
+        bytes((i * 7 + i // 500) % 251 for i in range(500 * 500)),
+        buf_type=gdal.GDT_Byte,
+    )
+    if nodata is not None:
+        src_ds.GetRasterBand(1).SetNoDataValue(nodata)
+    gdal.GetDriverByName("GTiff").CreateCopy(
+        filename,
+        src_ds,
+        options=["TILED=YES", "BLOCKXSIZE=32", "BLOCKYSIZE=32", "COMPRESS=DEFLATE"],
+    )
+
+    def compute(num_threads):
+        with gdaltest.config_options(
+            {"GDAL_NUM_THREADS": num_threads, "GDAL_PAM_ENABLED": "NO"}
+        ):
+            ds = gdal.Open(filename)
+            band = ds.GetRasterBand(1)
+            minmax = band.ComputeRasterMinMax(approx_ok)
+            hist = band.GetHistogram(approx_ok=approx_ok)
+            stats = band.ComputeStatistics(approx_ok)
+            return minmax, hist, stats
+
+    minmax_1, hist_1, stats_1 = compute("1")
+    minmax_4, hist_4, stats_4 = compute("4")
+    assert minmax_4 == minmax_1
+    assert hist_4 == hist_1
+    assert sum(hist_1) > 0
+    assert stats_4[0:2] == stats_1[0:2]
+    if datatype == gdal.GDT_Float32:
+        # Partial sums are merged in a different order
+        assert stats_4[2:] == pytest.approx(stats_1[2:], rel=1e-10)
+    else:
+        assert stats_4 == stats_1
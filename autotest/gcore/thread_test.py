@@ -597,3 +597,79 @@ def test_thread_safe_GetGCPs():
         for t in threads:
             t.join()
         assert res[0]
+
+
+@pytest.mark.parametrize("cache_size", ["1", "2", "UNLIMITED"])
+def test_thread_safe_dataset_cache_size(cache_size):
+
+    with gdaltest.config_option("GDAL_THREAD_SAFE_DATASET_CACHE_SIZE", cache_size):
+        tab_ds = [
+            gdal.OpenEx(
+                "data/byte.tif" if (i % 2) == 0 else "data/utmsmall.tif",
+                gdal.OF_RASTER | gdal.OF_THREAD_SAFE,
+            )
+            for i in range(6)
+        ]
+
+        res = [True]
+
+        def check():
+            for _ in range(5):
+                for i, ds in enumerate(tab_ds):
+                    if ds.GetRasterBand(1).Checksum() != (
+                        4672 if (i % 2) == 0 else 50054
+                    ):
+                        res[0] = False
+
+        threads = [threading.Thread(target=check) for i in range(2)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        assert res[0]
+
+
+def test_thread_safe_share_blocks(tmp_vsimem):
+
+    filename = str(tmp_vsimem / "tiled.tif")
+    src_ds = gdal.Open("data/utmsmall.tif")
+    gdal.Translate(
+        filename,
+        src_ds,
+        options="-co TILED=YES -co BLOCKXSIZE=16 -co BLOCKYSIZE=16 -outsize 300 200",
+    )
+
+    def read(share_blocks):
+        with gdaltest.config_option(
+            "GDAL_THREAD_SAFE_DATASET_SHARE_BLOCKS", share_blocks
+        ):
+            ds = gdal.OpenEx(filename, gdal.OF_RASTER | gdal.OF_THREAD_SAFE)
+        band = ds.GetRasterBand(1)
+        return (
+            ds,
+            band.Checksum(),
+            band.ReadRaster(5, 7, 41, 23),
+            ds.ReadRaster(5, 7, 41, 23, buf_type=gdal.GDT_Float32),
+            band.ReadRaster(0, 0, 300, 200, 150, 100),
+        )
+
+    _, *ref = read("NO")
+    ds, *got = read("YES")
+    assert got == ref
+
+    # Concurrent readers of the same blocks
+    band = ds.GetRasterBand(1)
+    expected = ref[1]
+    res = [True]
+
+    def check():
+        for _ in range(200):
+            if band.ReadRaster(5, 7, 41, 23) != expected:
+                res[0] = False
+
+    threads = [threading.Thread(target=check) for i in range(4)]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    assert res[0]
@@ -2951,3 +2951,42 @@ def test_tiff_ovr_JXL_ALPHA_DISTANCE_OVERVIEW(tmp_vsimem):
     assert ds.GetRasterBand(4).Checksum() != cs4
     del ds
     gdal.Unlink(tmpfilename + ".ovr")
+
+
+###############################################################################
+# Test that computing all overview levels in a single pass gives the same
+# result as computing each level from the one written just before.
+
+
+@pytest.mark.parametrize("resampling", ["average", "gauss", "lanczos", "mode"])
+@pytest.mark.parametrize("nodata", [None, 0])
+def test_tiff_ovr_cascade(tmp_vsimem, resampling, nodata):
+
+    tmpfilename = str(tmp_vsimem / "test_tiff_ovr_cascade.tif")
+
+    def build_overviews(cascade):
+        gdal.Translate(
+            tmpfilename,
+            "data/rgbsmall.tif",
+            options=gdal.TranslateOptions(
+                creationOptions=["INTERLEAVE=PIXEL", "BLOCKYSIZE=8"],
+                noData=nodata,
+            ),
+        )
+        ds = gdal.Open(tmpfilename, gdal.GA_Update)
+        with gdaltest.config_option("GDAL_OVR_CASCADE", cascade):
+            ds.BuildOverviews(resampling, [2, 4, 8])
+        ret = [
+            [
+                ds.GetRasterBand(i + 1).GetOverview(j).Checksum()
+                for j in range(ds.GetRasterBand(1).GetOverviewCount())
+            ]
+            for i in range(ds.RasterCount)
+        ]
+        del ds
+        gdal.Unlink(tmpfilename)
+        return ret
+
+    expected = build_overviews("NO")
+    assert len(expected[0]) == 3
+    assert build_overviews("YES") == expected
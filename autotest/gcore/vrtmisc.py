@@ -1088,3 +1088,56 @@ def test_vrt_read_netcdf():
             xml_data = xml.read()
             # print(xml_data)
             assert 'NETCDF:"alldatatypes.nc":ubyte_var' in xml_data
+
+
+###############################################################################
+# Test the DATASET_POOL_STATISTICS metadata domain with more sources than
+# GDAL_MAX_DATASET_POOL_SIZE
+
+
+@pytest.mark.require_driver("GTiff")
+def test_vrtmisc_dataset_pool_statistics(tmp_vsimem):
+
+    sources = ""
+    for i in range(5):
+        src_filename = str(tmp_vsimem / f"src{i}.tif")
+        src_ds = gdal.GetDriverByName("GTiff").Create(src_filename, 10, 10)
+        src_ds.GetRasterBand(1).Fill(i + 1)
+        src_ds.Close()
+        sources += f"""
+    <SimpleSource>
+      <SourceFilename relativeToVRT="0">{src_filename}</SourceFilename>
+      <SourceBand>1</SourceBand>
+      <SrcRect xOff="0" yOff="0" xSize="10" ySize="10" />
+      <DstRect xOff="{i * 10}" yOff="0" xSize="10" ySize="10" />
+    </SimpleSource>"""
+
+    vrt = f"""<VRTDataset rasterXSize="50" rasterYSize="10">
+  <VRTRasterBand dataType="Byte" band="1">{sources}
+  </VRTRasterBand>
+</VRTDataset>"""
+
+    with gdaltest.config_option("GDAL_MAX_DATASET_POOL_SIZE", "2"):
+        ds = gdal.Open(vrt)
+
+    stats = ds.GetMetadata_Dict("DATASET_POOL_STATISTICS")
+    if stats.get("MAX_SIZE") != "2":
+        pytest.skip("dataset pool already created by another dataset")
+    assert int(stats["CURRENT_SIZE"]) <= 2
+    assert int(stats["OPENED_DATASETS"]) <= 2
+    assert int(stats["MISSES"]) >= 5
+    assert int(stats["EVICTIONS"]) >= 3
+
+    # The 2 sources left in the pool are the last ones, so reading the
+    # sources in order has to reopen at least the first 3
+    expected = b"".join(bytes([i + 1]) * 10 for i in range(5)) * 10
+    assert ds.ReadRaster() == expected
+
+    new_stats = ds.GetMetadata_Dict("DATASET_POOL_STATISTICS")
+    assert new_stats["MAX_SIZE"] == "2"
+    assert int(new_stats["CURRENT_SIZE"]) <= 2
+    assert int(new_stats["OPENED_DATASETS"]) <= 2
+    assert int(new_stats["MISSES"]) >= int(stats["MISSES"]) + 3
+    assert int(new_stats["EVICTIONS"]) >= int(stats["EVICTIONS"]) + 3
+    assert int(new_stats["HITS"]) >= int(stats["HITS"])
+    ds = None
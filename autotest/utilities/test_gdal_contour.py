@@ -633,3 +633,40 @@ def test_gdal_contour_gt(gdal_contour_path, tmp_path, gt):
         expected_heights = [75, 76, 81, 112, 243, 441]
 
         assert lyr.GetFeatureCount() == len(expected_heights)
+
+
+###############################################################################
+# Test -nt and -strip_height
+
+
+@pytest.mark.parametrize("nt", ["1", "4", "ALL_CPUS"])
+def test_gdal_contour_nt(gdal_contour_path, tmp_path, nt):
+
+    ref_shp = str(tmp_path / "ref.shp")
+    gdaltest.runexternal(
+        gdal_contour_path + f" -a elev -i 50 ../gdrivers/data/n43.tif {ref_shp}"
+    )
+
+    contour_shp = str(tmp_path / "contour.shp")
+    _, err = gdaltest.runexternal_out_and_err(
+        gdal_contour_path
+        + f" -a elev -i 50 -nt {nt} -strip_height 16 ../gdrivers/data/n43.tif {contour_shp}"
+    )
+    assert err == ""
+
+    def get_lines(filename):
+        ds = ogr.Open(filename)
+        lines = []
+        for f in ds.GetLayer(0):
+            geom = f.GetGeometryRef()
+            lines.append((f["elev"], geom.GetPointCount(), geom.Length()))
+        return sorted(lines)
+
+    # Lines split at strip boundaries are joined back
+    ref_lines = get_lines(ref_shp)
+    lines = get_lines(contour_shp)
+    assert len(lines) == len(ref_lines)
+    for line, ref_line in zip(lines, ref_lines):
+        assert line[0] == ref_line[0]
+        assert line[1] == ref_line[1]
+        assert line[2] == pytest.approx(ref_line[2], rel=1e-12)
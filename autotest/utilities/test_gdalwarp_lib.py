@@ -4420,3 +4420,28 @@ def test_gdalwarp_lib_cubic_multiband_uint16_4sample_optim():
         4689,
         5007,
     ]
+
+
+###############################################################################
+# Test ChunkAndWarpMulti() with more than 2 chunks in flight
+
+
+@pytest.mark.parametrize("streamable", [False, True])
+def test_gdalwarp_lib_multi_num_chunk_threads(streamable):
+
+    src_ds = gdal.Open("../gdrivers/data/small_world.tif")
+    # Fixed XSCALE/YSCALE so that the result does not depend on chunking
+    options = "-f MEM -t_srs EPSG:3857 -r bilinear -wo XSCALE=1 -wo YSCALE=1"
+    if streamable:
+        options += " -wo STREAMABLE_OUTPUT=YES"
+
+    ref_ds = gdal.Warp("", src_ds, options=options)
+
+    out_ds = gdal.Warp(
+        "",
+        src_ds,
+        options=options + " -multi -wo NUM_CHUNK_THREADS=4 -wm 100KB",
+    )
+    assert [out_ds.GetRasterBand(i + 1).Checksum() for i in range(3)] == [
+        ref_ds.GetRasterBand(i + 1).Checksum() for i in range(3)
+    ]
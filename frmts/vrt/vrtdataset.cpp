@@ -198,6 +198,13 @@ char **VRTDataset::GetMetadata(const char *pszDomain)
         m_papszXMLVRTMetadata[1] = nullptr;
         return m_papszXMLVRTMetadata;
     }
+    else if (pszDomain != nullptr &&
+             EQUAL(pszDomain, "DATASET_POOL_STATISTICS"))
+    {
+        // Statistics of the pool of source datasets, shared by all VRTs
+        m_aosDatasetPoolStatistics = GDALGetDatasetPoolStatistics();
+        return m_aosDatasetPoolStatistics.List();
+    }
 
     return GDALDataset::GetMetadata(pszDomain);
 }
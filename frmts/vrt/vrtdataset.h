@@ -264,6 +264,7 @@ class CPL_DLL VRTDataset CPL_NON_FINAL : public GDALDataset
     std::vector<int> m_anOverviewFactors{};
 
     char **m_papszXMLVRTMetadata = nullptr;
+    CPLStringList m_aosDatasetPoolStatistics{};
 
     VRTMapSharedResources m_oMapSharedSources{};
     std::shared_ptr<VRTGroup> m_poRootGroup{};
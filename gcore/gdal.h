@@ -2289,6 +2289,41 @@ GIntBig CPL_DLL CPL_STDCALL GDALGetCacheUsed64(void);
 
 int CPL_DLL CPL_STDCALL GDALFlushCacheBlock(void);
 
+/** Statistics of the raster block cache.
+ *
+ * Only collected when the GDAL_CACHE_STATISTICS configuration option is set
+ * to YES or DUMP.
+ *
+ * @since GDAL 3.11
+ */
+typedef struct
+{
+    /** Number of block requests served from the cache */
+    GIntBig nHits;
+    /** Number of block requests that were not found in the cache */
+    GIntBig nMisses;
+    /** Number of bytes of blocks read from the driver on cache misses */
+    GIntBig nBytesRead;
+    /** Number of blocks evicted from the cache to make room for others */
+    GIntBig nEvictions;
+    /** Number of dirty blocks written back to their band */
+    GIntBig nDirtyFlushes;
+    /** Cumulated time, in seconds, spent waiting for the global cache lock.
+     * Not available per band or dataset. */
+    double dfLockWaitTime;
+    /** Number of cache misses served by decompressing a block from the
+     * compressed cache (GDAL_COMPRESSED_CACHE_MAX), without reading it from
+     * the driver. Those are also counted in nMisses. */
+    GIntBig nCompressedHits;
+} GDALCacheStatistics;
+
+void CPL_DLL GDALGetCacheStatistics(GDALCacheStatistics *psStats);
+void CPL_DLL GDALResetCacheStatistics(void);
+void CPL_DLL GDALGetRasterBandCacheStatistics(GDALRasterBandH hBand,
+                                              GDALCacheStatistics *psStats);
+void CPL_DLL GDALDatasetGetCacheStatistics(GDALDatasetH hDS,
+                                           GDALCacheStatistics *psStats);
+
 /* ==================================================================== */
 /*      GDAL virtual memory                                             */
 /* ==================================================================== */
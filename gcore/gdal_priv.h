@@ -54,9 +54,12 @@ class GDALRelationship;
 
 #include <stdarg.h>
 
+#include <atomic>
 #include <cmath>
 #include <complex>
 #include <cstdint>
+#include <functional>
+#include <future>
 #include <iterator>
 #include <limits>
 #include <map>
@@ -749,6 +752,50 @@ class CPL_DLL GDALDataset : public GDALMajorObject
                      int nLineSpace, int nBandSpace, char **papszOptions);
     virtual void EndAsyncReader(GDALAsyncReader *poARIO);
 
+    /** Window of a RasterIOBatch() request.
+     * @since GDAL 3.11
+     */
+    struct RasterIOWindow
+    {
+        /** Overview level to read from, or -1 for the full resolution level.
+         * Offsets and sizes are expressed in the pixel space of that level.
+         */
+        int nOvrLevel = -1;
+        /** Pixel offset of the top left corner of the window */
+        int nXOff = 0;
+        /** Line offset of the top left corner of the window */
+        int nYOff = 0;
+        /** Width of the window in pixels */
+        int nXSize = 0;
+        /** Height of the window in lines */
+        int nYSize = 0;
+        /** Buffer into which the window is read */
+        void *pData = nullptr;
+        /** Width of the buffer in pixels */
+        int nBufXSize = 0;
+        /** Height of the buffer in lines */
+        int nBufYSize = 0;
+        /** Data type of the buffer */
+        GDALDataType eBufType = GDT_Byte;
+        /** Bands to read, 1-based. All bands if empty */
+        std::vector<int> anBandMap{};
+        /** Pixel spacing in the buffer, or 0 for the default */
+        GSpacing nPixelSpace = 0;
+        /** Line spacing in the buffer, or 0 for the default */
+        GSpacing nLineSpace = 0;
+        /** Band spacing in the buffer, or 0 for the default */
+        GSpacing nBandSpace = 0;
+        /** Resampling method, when the buffer and window sizes differ */
+        GDALRIOResampleAlg eResampleAlg = GRIORA_NearestNeighbour;
+        /** Optional callback, called with the status of the read once it is
+         * completed, possibly from another thread. */
+        std::function<void(CPLErr)> oCompletionCallback{};
+    };
+
+    virtual std::vector<std::future<CPLErr>>
+    RasterIOBatch(std::vector<RasterIOWindow> aoWindows,
+                  CSLConstList papszOptions = nullptr);
+
     //! @cond Doxygen_Suppress
     struct RawBinaryLayout
     {
@@ -1224,8 +1271,12 @@ class CPL_DLL GDALRasterBlock
 
     bool bMustDetach;
 
+    // Set by Touch() with the CLOCK cache policy, cleared on eviction scans.
+    volatile int nRecentlyUsed;
+
     CPL_INTERNAL void Detach_unlocked(void);
     CPL_INTERNAL void Touch_unlocked(void);
+    CPL_INTERNAL bool GiveSecondChance_unlocked(void);
 
     CPL_INTERNAL void RecycleFor(int nXOffIn, int nYOffIn);
 
@@ -1346,6 +1397,29 @@ class CPL_DLL GDALRasterBlock
     /* Should only be called by GDALDestroyDriverManager() */
     //! @cond Doxygen_Suppress
     CPL_INTERNAL static void DestroyRBMutex();
+
+    CPL_INTERNAL static void RecordHit(GDALRasterBand *poBand);
+    CPL_INTERNAL static void RecordMiss(GDALRasterBand *poBand,
+                                        GIntBig nBytesRead,
+                                        bool bFromCompressedCache = false);
+    CPL_INTERNAL static void AddBandStatistics(GDALRasterBand *poBand,
+                                               GDALCacheStatistics *psStats);
+
+    CPL_INTERNAL static void InitCompressedCache();
+    CPL_INTERNAL static void RefreshCompressedCache();
+    CPL_INTERNAL static GUInt64 GetCompressedCacheGeneration();
+    CPL_INTERNAL static void StoreCompressed(GDALRasterBlock *poBlock,
+                                             GUInt64 nGeneration);
+    CPL_INTERNAL static bool FetchCompressed(GDALRasterBand *poBand,
+                                             int nXBlockOff, int nYBlockOff,
+                                             void *pData, size_t nSize);
+    CPL_INTERNAL static void DropCompressed(GDALRasterBand *poBand,
+                                            int nXBlockOff, int nYBlockOff);
+    CPL_INTERNAL static void DropCompressed(GDALRasterBand *poBand, int nXOff,
+                                            int nYOff, int nXSize, int nYSize);
+    CPL_INTERNAL static void DropCompressed(GDALRasterBand *poBand);
+    CPL_INTERNAL static void ForgetCompressed(GDALRasterBand *poBand);
+    CPL_INTERNAL static void DestroyCompressedCache();
     //! @endcond
 
   private:
@@ -1407,6 +1481,21 @@ class CPL_DLL GDALColorTable
 //! This manages how a raster band store its cached block.
 // only used by GDALRasterBand implementation.
 
+/** Counters of the block cache, see GDALCacheStatistics */
+struct GDALBlockCacheCounters
+{
+    std::atomic<GIntBig> nHits{0};
+    std::atomic<GIntBig> nMisses{0};
+    std::atomic<GIntBig> nBytesRead{0};
+    std::atomic<GIntBig> nEvictions{0};
+    std::atomic<GIntBig> nDirtyFlushes{0};
+    std::atomic<GIntBig> nLockWaitNanoSec{0};
+    std::atomic<GIntBig> nCompressedHits{0};
+
+    void Reset();
+    void AddTo(GDALCacheStatistics *psStats) const;
+};
+
 class GDALAbstractBandBlockCache
 {
     // List of blocks that can be freed or recycled, and its lock
@@ -1460,6 +1549,9 @@ class GDALAbstractBandBlockCache
         return m_nDirtyBlocks > 0;
     }
 
+    /** Statistics of the blocks of this band */
+    GDALBlockCacheCounters m_oCounters{};
+
     virtual bool Init() = 0;
     virtual bool IsInitOK() = 0;
     virtual CPLErr FlushCache() = 0;
@@ -4483,6 +4575,7 @@ void GDALNullifyOpenDatasetsList();
 CPLMutex **GDALGetphDMMutex();
 CPLMutex **GDALGetphDLMutex();
 void GDALNullifyProxyPoolSingleton();
+CPLStringList CPL_DLL GDALGetDatasetPoolStatistics();
 void GDALSetResponsiblePIDForCurrentThread(GIntBig responsiblePID);
 GIntBig GDALGetResponsiblePIDForCurrentThread();
 
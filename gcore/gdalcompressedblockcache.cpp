@@ -0,0 +1,570 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  Second tier of the raster block cache, holding compressed copies
+ *           of clean blocks evicted from the main block cache.
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#include "cpl_port.h"
+#include "gdal_priv.h"
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "cpl_compressor.h"
+#include "cpl_conv.h"
+#include "cpl_error.h"
+#include "cpl_string.h"
+
+//! @cond Doxygen_Suppress
+
+namespace
+{
+
+/************************************************************************/
+/*                      GDALCompressedBlockCache                        */
+/************************************************************************/
+
+class GDALCompressedBlockCache
+{
+  public:
+    static GDALCompressedBlockCache &Get();
+
+    bool Refresh();
+
+    // Called when GDAL_COMPRESSED_CACHE_MAX/_CODEC are set, possibly while
+    // the configuration mutex is held, so only flag the change.
+    void SetConfigChanged()
+    {
+        m_bConfigChanged.store(true, std::memory_order_relaxed);
+    }
+
+    void RefreshIfConfigChanged()
+    {
+        if (m_bConfigChanged.load(std::memory_order_relaxed) &&
+            m_bConfigChanged.exchange(false))
+            Refresh();
+    }
+
+    bool MayHaveEntries() const
+    {
+        return m_bEnabled.load(std::memory_order_relaxed) ||
+               m_nEntryCount.load(std::memory_order_relaxed) > 0;
+    }
+
+    GUInt64 GetGeneration() const
+    {
+        return m_nGeneration.load(std::memory_order_acquire);
+    }
+
+    void Store(GDALRasterBand *poBand, int nXBlockOff, int nYBlockOff,
+               const void *pData, size_t nSize, GUInt64 nGeneration);
+    bool Fetch(GDALRasterBand *poBand, int nXBlockOff, int nYBlockOff,
+               void *pData, size_t nSize);
+    void Invalidate(GDALRasterBand *poBand, int nXBlockMin, int nYBlockMin,
+                    int nXBlockMax, int nYBlockMax);
+    void Forget(GDALRasterBand *poBand);
+    void Clear();
+
+  private:
+    // Key ordered by band first, so that all the blocks of a band are
+    // contiguous in the map.
+    using Key = std::tuple<std::uintptr_t, int, int>;
+
+    struct Entry
+    {
+        Key oKey{};
+        std::vector<GByte> abyData{};
+    };
+
+    std::mutex m_oMutex{};
+    std::atomic<bool> m_bEnabled{false};
+    std::atomic<bool> m_bConfigChanged{true};
+    std::string m_osConfigMax{};
+    std::string m_osConfigCodec{};
+    const CPLCompressor *m_poCompressor = nullptr;
+    const CPLCompressor *m_poDecompressor = nullptr;
+    CPLStringList m_aosCompressorOptions{};
+    size_t m_nMaxSize = 0;
+    size_t m_nUsed = 0;
+    std::atomic<size_t> m_nEntryCount{0};
+    // Most recently stored blocks first
+    std::list<Entry> m_oLRU{};
+    std::map<Key, std::list<Entry>::iterator> m_oMap{};
+
+    // Incremented on each invalidation. A block evicted from the main cache
+    // is only stored if its band has not been invalidated since the
+    // eviction started, as it may otherwise hold pixels that have been
+    // overwritten in the meantime.
+    std::atomic<GUInt64> m_nGeneration{0};
+    GUInt64 m_nConfigGeneration = 0;
+    std::map<std::uintptr_t, GUInt64> m_oBandInvalidations{};
+
+    GDALCompressedBlockCache() = default;
+
+    static Key MakeKey(GDALRasterBand *poBand, int nXBlockOff, int nYBlockOff)
+    {
+        return Key(reinterpret_cast<std::uintptr_t>(poBand), nXBlockOff,
+                   nYBlockOff);
+    }
+
+    void ConfigureUnlocked(const char *pszMax, const char *pszCodec);
+    void EraseUnlocked(std::map<Key, std::list<Entry>::iterator>::iterator oIt);
+    void ClearUnlocked();
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALCompressedBlockCache)
+};
+
+/************************************************************************/
+/*                         ConfigureUnlocked()                          */
+/************************************************************************/
+
+void GDALCompressedBlockCache::ConfigureUnlocked(const char *pszMax,
+                                                 const char *pszCodec)
+{
+    ClearUnlocked();
+    // Writes are not tracked while the cache is disabled, so refuse blocks
+    // whose eviction started before now.
+    m_nConfigGeneration = ++m_nGeneration;
+    m_bEnabled = false;
+    m_poCompressor = nullptr;
+    m_poDecompressor = nullptr;
+    m_aosCompressorOptions.Clear();
+    m_nMaxSize = 0;
+
+    GIntBig nMax = 0;
+    bool bUnitSpecified = false;
+    if (CPLParseMemorySize(pszMax, &nMax, &bUnitSpecified) != CE_None)
+    {
+        CPLError(CE_Failure, CPLE_NotSupported,
+                 "Invalid value for GDAL_COMPRESSED_CACHE_MAX. "
+                 "Disabling compressed block cache.");
+        return;
+    }
+    if (!bUnitSpecified && nMax < 100000)
+    {
+        // Assume MB, as for GDAL_CACHEMAX
+        nMax *= 1024 * 1024;
+    }
+    if (nMax <= 0)
+        return;
+
+    const char *const apszDefaultCodecs[] = {"lz4", "zstd"};
+    for (const char *pszCandidate : apszDefaultCodecs)
+    {
+        const char *pszId = pszCodec ? pszCodec : pszCandidate;
+        m_poCompressor = CPLGetCompressor(pszId);
+        m_poDecompressor = CPLGetDecompressor(pszId);
+        if (m_poCompressor && m_poDecompressor)
+        {
+            // Favor speed over compression ratio
+            if (EQUAL(pszId, "zstd"))
+                m_aosCompressorOptions.SetNameValue("LEVEL", "1");
+            else if (EQUAL(pszId, "deflate"))
+                m_aosCompressorOptions.SetNameValue("LEVEL", "1");
+            break;
+        }
+        m_poCompressor = nullptr;
+        m_poDecompressor = nullptr;
+        if (pszCodec)
+            break;
+    }
+    if (!m_poCompressor)
+    {
+        CPLError(CE_Warning, CPLE_NotSupported,
+                 "GDAL_COMPRESSED_CACHE_CODEC=%s is not available. "
+                 "Disabling compressed block cache.",
+                 pszCodec ? pszCodec : "lz4");
+        return;
+    }
+    m_nMaxSize = static_cast<size_t>(
+        std::min<GIntBig>(nMax, std::numeric_limits<GIntBig>::max() / 2));
+    m_bEnabled = true;
+    CPLDebug("GDAL", "Compressed block cache: %s, " CPL_FRMT_GIB " MB",
+             m_poCompressor->pszId, nMax / (1024 * 1024));
+}
+
+/************************************************************************/
+/*                                Get()                                 */
+/************************************************************************/
+
+GDALCompressedBlockCache &GDALCompressedBlockCache::Get()
+{
+    static GDALCompressedBlockCache oCache;
+    return oCache;
+}
+
+/************************************************************************/
+/*                              Refresh()                               */
+/************************************************************************/
+
+// Take into account changes of GDAL_COMPRESSED_CACHE_MAX and
+// GDAL_COMPRESSED_CACHE_CODEC since the last call. Returns whether the
+// cache is enabled.
+bool GDALCompressedBlockCache::Refresh()
+{
+    const char *pszMax = CPLGetConfigOption("GDAL_COMPRESSED_CACHE_MAX", "0");
+    const char *pszCodec =
+        CPLGetConfigOption("GDAL_COMPRESSED_CACHE_CODEC", nullptr);
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+    if (!pszCodec)
+        pszCodec = "";
+    if (m_osConfigMax != pszMax || m_osConfigCodec != pszCodec)
+    {
+        m_osConfigMax = pszMax;
+        m_osConfigCodec = pszCodec;
+        ConfigureUnlocked(pszMax, pszCodec[0] ? pszCodec : nullptr);
+    }
+    return m_bEnabled;
+}
+
+/************************************************************************/
+/*                           EraseUnlocked()                            */
+/************************************************************************/
+
+void GDALCompressedBlockCache::EraseUnlocked(
+    std::map<Key, std::list<Entry>::iterator>::iterator oIt)
+{
+    m_nUsed -= oIt->second->abyData.size();
+    m_oLRU.erase(oIt->second);
+    m_oMap.erase(oIt);
+    m_nEntryCount = m_oMap.size();
+}
+
+/************************************************************************/
+/*                           ClearUnlocked()                            */
+/************************************************************************/
+
+void GDALCompressedBlockCache::ClearUnlocked()
+{
+    m_oMap.clear();
+    m_oLRU.clear();
+    m_nUsed = 0;
+    m_nEntryCount = 0;
+}
+
+/************************************************************************/
+/*                               Store()                                */
+/************************************************************************/
+
+void GDALCompressedBlockCache::Store(GDALRasterBand *poBand, int nXBlockOff,
+                                     int nYBlockOff, const void *pData,
+                                     size_t nSize, GUInt64 nGeneration)
+{
+    const CPLCompressor *poCompressor;
+    CPLStringList aosOptions;
+    size_t nMaxSize;
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        if (!m_bEnabled)
+            return;
+        poCompressor = m_poCompressor;
+        aosOptions = m_aosCompressorOptions;
+        nMaxSize = m_nMaxSize;
+    }
+
+    // Compress outside of the lock in a per-thread scratch buffer
+    thread_local std::vector<GByte> abyScratch;
+    size_t nCompressedSize = 0;
+    if (!poCompressor->pfnFunc(pData, nSize, nullptr, &nCompressedSize,
+                               aosOptions.List(), poCompressor->user_data))
+        return;
+    try
+    {
+        abyScratch.resize(nCompressedSize);
+    }
+    catch (const std::exception &)
+    {
+        return;
+    }
+    void *pCompressed = abyScratch.data();
+    if (!poCompressor->pfnFunc(pData, nSize, &pCompressed, &nCompressedSize,
+                               aosOptions.List(), poCompressor->user_data))
+        return;
+
+    // Blocks that do not compress well are cheaper to read again
+    if (nCompressedSize > nSize - nSize / 8 || nCompressedSize > nMaxSize)
+        return;
+
+    Entry oEntry;
+    oEntry.oKey = MakeKey(poBand, nXBlockOff, nYBlockOff);
+    try
+    {
+        oEntry.abyData.assign(abyScratch.begin(),
+                              abyScratch.begin() + nCompressedSize);
+    }
+    catch (const std::exception &)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+    // The configuration may have changed while we were compressing
+    if (!m_bEnabled || m_poCompressor != poCompressor ||
+        nGeneration < m_nConfigGeneration)
+        return;
+    const auto oInvalidationIt =
+        m_oBandInvalidations.find(std::get<0>(oEntry.oKey));
+    if (oInvalidationIt != m_oBandInvalidations.end() &&
+        oInvalidationIt->second > nGeneration)
+    {
+        // The band has been written since the block was evicted
+        return;
+    }
+    auto oIt = m_oMap.find(oEntry.oKey);
+    if (oIt != m_oMap.end())
+        EraseUnlocked(oIt);
+    m_nUsed += nCompressedSize;
+    m_oLRU.push_front(std::move(oEntry));
+    m_oMap[m_oLRU.front().oKey] = m_oLRU.begin();
+    while (m_nUsed > m_nMaxSize)
+        EraseUnlocked(m_oMap.find(m_oLRU.back().oKey));
+    m_nEntryCount = m_oMap.size();
+}
+
+/************************************************************************/
+/*                               Fetch()                                */
+/************************************************************************/
+
+bool GDALCompressedBlockCache::Fetch(GDALRasterBand *poBand, int nXBlockOff,
+                                     int nYBlockOff, void *pData, size_t nSize)
+{
+    std::vector<GByte> abyCompressed;
+    const CPLCompressor *poDecompressor;
+    {
+        std::lock_guard<std::mutex> oLock(m_oMutex);
+        auto oIt = m_oMap.find(MakeKey(poBand, nXBlockOff, nYBlockOff));
+        if (oIt == m_oMap.end())
+            return false;
+        // The block goes back to the main cache, so we can forget it
+        abyCompressed = std::move(oIt->second->abyData);
+        m_nUsed -= abyCompressed.size();
+        m_oLRU.erase(oIt->second);
+        m_oMap.erase(oIt);
+        m_nEntryCount = m_oMap.size();
+        poDecompressor = m_poDecompressor;
+    }
+
+    size_t nOutSize = nSize;
+    return poDecompressor->pfnFunc(abyCompressed.data(), abyCompressed.size(),
+                                   &pData, &nOutSize, nullptr,
+                                   poDecompressor->user_data) &&
+           nOutSize == nSize;
+}
+
+/************************************************************************/
+/*                            Invalidate()                              */
+/************************************************************************/
+
+// Forget the blocks of a band within an (inclusive) range of block
+// offsets, and prevent stores of blocks of that band whose eviction started
+// before that call.
+void GDALCompressedBlockCache::Invalidate(GDALRasterBand *poBand,
+                                          int nXBlockMin, int nYBlockMin,
+                                          int nXBlockMax, int nYBlockMax)
+{
+    const auto nBand = reinterpret_cast<std::uintptr_t>(poBand);
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+    m_oBandInvalidations[nBand] = ++m_nGeneration;
+
+    auto oIt = m_oMap.lower_bound(MakeKey(poBand, nXBlockMin, INT_MIN));
+    while (oIt != m_oMap.end() && std::get<0>(oIt->first) == nBand &&
+           std::get<1>(oIt->first) <= nXBlockMax)
+    {
+        auto oNext = std::next(oIt);
+        const int nYBlockOff = std::get<2>(oIt->first);
+        if (nYBlockOff >= nYBlockMin && nYBlockOff <= nYBlockMax)
+            EraseUnlocked(oIt);
+        oIt = oNext;
+    }
+}
+
+/************************************************************************/
+/*                               Forget()                               */
+/************************************************************************/
+
+// Forget everything about a band that is being destroyed, so that nothing
+// is served to another band allocated later at the same address.
+void GDALCompressedBlockCache::Forget(GDALRasterBand *poBand)
+{
+    const auto nBand = reinterpret_cast<std::uintptr_t>(poBand);
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+    m_oBandInvalidations.erase(nBand);
+    auto oIt = m_oMap.lower_bound(MakeKey(poBand, INT_MIN, INT_MIN));
+    while (oIt != m_oMap.end() && std::get<0>(oIt->first) == nBand)
+    {
+        auto oNext = std::next(oIt);
+        EraseUnlocked(oIt);
+        oIt = oNext;
+    }
+}
+
+/************************************************************************/
+/*                               Clear()                                */
+/************************************************************************/
+
+void GDALCompressedBlockCache::Clear()
+{
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+    ClearUnlocked();
+    m_oBandInvalidations.clear();
+}
+
+}  // namespace
+
+/************************************************************************/
+/*               GDALRasterBlock::InitCompressedCache()                 */
+/************************************************************************/
+
+// Called once, when the block cache is initialized. Later changes of
+// GDAL_COMPRESSED_CACHE_MAX/_CODEC are applied by RefreshCompressedCache().
+void GDALRasterBlock::InitCompressedCache()
+{
+    CPLSubscribeToSetConfigOption(
+        [](const char *pszKey, const char *, bool, void *)
+        {
+            if (EQUAL(pszKey, "GDAL_COMPRESSED_CACHE_MAX") ||
+                EQUAL(pszKey, "GDAL_COMPRESSED_CACHE_CODEC"))
+            {
+                GDALCompressedBlockCache::Get().SetConfigChanged();
+            }
+        },
+        nullptr);
+    GDALCompressedBlockCache::Get().RefreshIfConfigChanged();
+}
+
+/************************************************************************/
+/*              GDALRasterBlock::RefreshCompressedCache()               */
+/************************************************************************/
+
+// Apply configuration changes made since the previous call. Only costs an
+// atomic load otherwise. Must not be called with the block cache lock held.
+void GDALRasterBlock::RefreshCompressedCache()
+{
+    GDALCompressedBlockCache::Get().RefreshIfConfigChanged();
+}
+
+/************************************************************************/
+/*            GDALRasterBlock::GetCompressedCacheGeneration()           */
+/************************************************************************/
+
+// To be called before clean blocks are detached from their band, and passed
+// to StoreCompressed(). May be called with the block cache lock held.
+GUInt64 GDALRasterBlock::GetCompressedCacheGeneration()
+{
+    return GDALCompressedBlockCache::Get().GetGeneration();
+}
+
+/************************************************************************/
+/*                   GDALRasterBlock::StoreCompressed()                 */
+/************************************************************************/
+
+// Called when a clean block is evicted from the main cache, before its
+// memory is released or recycled. Nothing is stored if the band has been
+// written since nGeneration was retrieved.
+void GDALRasterBlock::StoreCompressed(GDALRasterBlock *poBlock,
+                                      GUInt64 nGeneration)
+{
+    auto &oCache = GDALCompressedBlockCache::Get();
+    if (!oCache.MayHaveEntries() || poBlock->GetDirty() ||
+        poBlock->GetDataRef() == nullptr)
+        return;
+    oCache.Store(poBlock->GetBand(), poBlock->GetXOff(), poBlock->GetYOff(),
+                 poBlock->GetDataRef(),
+                 static_cast<size_t>(poBlock->GetBlockSize()), nGeneration);
+}
+
+/************************************************************************/
+/*                   GDALRasterBlock::FetchCompressed()                 */
+/************************************************************************/
+
+// Fill pData with the content of a previously evicted block, if it is
+// available in the compressed cache.
+bool GDALRasterBlock::FetchCompressed(GDALRasterBand *poBand, int nXBlockOff,
+                                      int nYBlockOff, void *pData,
+                                      size_t nSize)
+{
+    auto &oCache = GDALCompressedBlockCache::Get();
+    return oCache.MayHaveEntries() &&
+           oCache.Fetch(poBand, nXBlockOff, nYBlockOff, pData, nSize);
+}
+
+/************************************************************************/
+/*                   GDALRasterBlock::DropCompressed()                  */
+/************************************************************************/
+
+// Forget the compressed copy of a block, when it is modified.
+void GDALRasterBlock::DropCompressed(GDALRasterBand *poBand, int nXBlockOff,
+                                     int nYBlockOff)
+{
+    auto &oCache = GDALCompressedBlockCache::Get();
+    if (oCache.MayHaveEntries())
+        oCache.Invalidate(poBand, nXBlockOff, nYBlockOff, nXBlockOff,
+                          nYBlockOff);
+}
+
+// Forget the compressed copies of the blocks intersecting a window of
+// pixels, after a write that may have bypassed the block cache.
+void GDALRasterBlock::DropCompressed(GDALRasterBand *poBand, int nXOff,
+                                     int nYOff, int nXSize, int nYSize)
+{
+    auto &oCache = GDALCompressedBlockCache::Get();
+    if (!oCache.MayHaveEntries() || nXSize <= 0 || nYSize <= 0)
+        return;
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+    if (nBlockXSize <= 0 || nBlockYSize <= 0)
+        return;
+    oCache.Invalidate(poBand, nXOff / nBlockXSize, nYOff / nBlockYSize,
+                      (nXOff + nXSize - 1) / nBlockXSize,
+                      (nYOff + nYSize - 1) / nBlockYSize);
+}
+
+// Forget the compressed copies of all the blocks of a band, when its cache
+// is flushed.
+void GDALRasterBlock::DropCompressed(GDALRasterBand *poBand)
+{
+    auto &oCache = GDALCompressedBlockCache::Get();
+    if (oCache.MayHaveEntries())
+        oCache.Invalidate(poBand, INT_MIN, INT_MIN, INT_MAX, INT_MAX);
+}
+
+/************************************************************************/
+/*                  GDALRasterBlock::ForgetCompressed()                 */
+/************************************************************************/
+
+// Called by the destructor of a band, once no block of it can be evicted
+// any longer.
+void GDALRasterBlock::ForgetCompressed(GDALRasterBand *poBand)
+{
+    auto &oCache = GDALCompressedBlockCache::Get();
+    if (oCache.MayHaveEntries())
+        oCache.Forget(poBand);
+}
+
+/************************************************************************/
+/*               GDALRasterBlock::DestroyCompressedCache()              */
+/************************************************************************/
+
+void GDALRasterBlock::DestroyCompressedCache()
+{
+    GDALCompressedBlockCache::Get().Clear();
+}
+
+//! @endcond
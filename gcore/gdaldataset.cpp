@@ -21,6 +21,8 @@
 #include <cstdlib>
 #include <cstring>
 #include <algorithm>
+#include <atomic>
+#include <future>
 #include <map>
 #include <mutex>
 #include <new>
@@ -30,12 +32,14 @@
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_hash_set.h"
 #include "cpl_multiproc.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
 #include "cpl_vsi_error.h"
+#include "cpl_worker_thread_pool.h"
 #include "ogr_api.h"
 #include "ogr_attrind.h"
 #include "ogr_core.h"
@@ -50,6 +54,7 @@
 #include "ogrsf_frmts.h"
 #include "ogrunionlayer.h"
 #include "ogr_swq.h"
+#include "gdal_thread_pool.h"
 
 #include "../frmts/derived/derivedlist.h"
 
@@ -2824,6 +2829,16 @@ CPLErr GDALDataset::RasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
                          nBandSpace, psExtraArg);
     }
 
+    // Drivers may write directly, without going through the block cache
+    if (eRWFlag == GF_Write)
+    {
+        for (int i = 0; i < nBandCount; ++i)
+        {
+            GDALRasterBlock::DropCompressed(GetRasterBand(panBandMap[i]),
+                                            nXOff, nYOff, nXSize, nYSize);
+        }
+    }
+
     if (bCallLeaveReadWrite)
         LeaveReadWrite();
 
@@ -4553,6 +4568,208 @@ void CPL_STDCALL GDALEndAsyncReader(GDALDatasetH hDS,
         static_cast<GDALAsyncReader *>(hAsyncReaderH));
 }
 
+/************************************************************************/
+/*                        ReadRasterIOWindow()                          */
+/************************************************************************/
+
+static CPLErr ReadRasterIOWindow(GDALDataset *poDS,
+                                 const GDALDataset::RasterIOWindow &oWindow)
+{
+    std::vector<int> anBandMap = oWindow.anBandMap;
+    if (anBandMap.empty())
+    {
+        for (int i = 1; i <= poDS->GetRasterCount(); ++i)
+            anBandMap.push_back(i);
+    }
+    const int nBandCount = static_cast<int>(anBandMap.size());
+
+    GDALRasterIOExtraArg sExtraArg;
+    INIT_RASTERIO_EXTRA_ARG(sExtraArg);
+    sExtraArg.eResampleAlg = oWindow.eResampleAlg;
+
+    if (oWindow.nOvrLevel < 0)
+    {
+        return poDS->RasterIO(GF_Read, oWindow.nXOff, oWindow.nYOff,
+                              oWindow.nXSize, oWindow.nYSize, oWindow.pData,
+                              oWindow.nBufXSize, oWindow.nBufYSize,
+                              oWindow.eBufType, nBandCount, anBandMap.data(),
+                              oWindow.nPixelSpace, oWindow.nLineSpace,
+                              oWindow.nBandSpace, &sExtraArg);
+    }
+
+    // Overviews are only reachable from bands, so read band by band.
+    const GSpacing nPixelSpace =
+        oWindow.nPixelSpace ? oWindow.nPixelSpace
+                            : GDALGetDataTypeSizeBytes(oWindow.eBufType);
+    const GSpacing nLineSpace = oWindow.nLineSpace
+                                    ? oWindow.nLineSpace
+                                    : nPixelSpace * oWindow.nBufXSize;
+    const GSpacing nBandSpace = oWindow.nBandSpace
+                                    ? oWindow.nBandSpace
+                                    : nLineSpace * oWindow.nBufYSize;
+    for (int i = 0; i < nBandCount; ++i)
+    {
+        GDALRasterBand *poBand = poDS->GetRasterBand(anBandMap[i]);
+        if (poBand == nullptr)
+            return CE_Failure;
+        GDALRasterBand *poOvrBand = poBand->GetOverview(oWindow.nOvrLevel);
+        if (poOvrBand == nullptr)
+        {
+            CPLError(CE_Failure, CPLE_IllegalArg,
+                     "RasterIOBatch(): band %d has no overview level %d",
+                     anBandMap[i], oWindow.nOvrLevel);
+            return CE_Failure;
+        }
+        if (poOvrBand->RasterIO(
+                GF_Read, oWindow.nXOff, oWindow.nYOff, oWindow.nXSize,
+                oWindow.nYSize,
+                static_cast<GByte *>(oWindow.pData) + i * nBandSpace,
+                oWindow.nBufXSize, oWindow.nBufYSize, oWindow.eBufType,
+                nPixelSpace, nLineSpace, &sExtraArg) != CE_None)
+        {
+            return CE_Failure;
+        }
+    }
+    return CE_None;
+}
+
+/************************************************************************/
+/*                           RasterIOBatch()                            */
+/************************************************************************/
+
+/**
+ * \brief Read several windows, possibly concurrently.
+ *
+ * This method is intended for callers that issue many independent small
+ * reads, such as tile servers. Each window may target a different overview
+ * level and a different set of bands. A std::future is returned for each
+ * window, in the same order, which becomes ready with the status of the read.
+ * The optional RasterIOWindow::oCompletionCallback of a window is also called
+ * with that status, before the future becomes ready.
+ *
+ * Drivers that can coalesce or overlap reads (for example by issuing
+ * multi-range requests) may override this method. The default implementation
+ * reads the windows with RasterIO() on threads of the global thread pool when
+ * the dataset is thread-safe (see IsThreadSafe(), for example when opened
+ * with GDAL_OF_THREAD_SAFE), with at most NUM_THREADS windows read at the
+ * same time. Otherwise, windows are read sequentially in the calling thread,
+ * in which case all futures are ready when this method returns.
+ *
+ * The dataset and the buffers of the windows must remain valid until all
+ * futures are ready. When windows are read on threads of the pool, the
+ * errors emitted while reading a window are collected, and emitted again
+ * with CPLError() in the thread that calls get() or wait() on its future.
+ * Those futures are deferred ones: wait_for() and wait_until() return
+ * std::future_status::deferred, and the status is only available through
+ * get() or wait().
+ *
+ * Currently supported options are:
+ * <ul>
+ * <li>NUM_THREADS=integer or ALL_CPUS: maximum number of threads to use.
+ * Defaults to the value of the GDAL_NUM_THREADS configuration option, or 1
+ * if it is not set.</li>
+ * </ul>
+ *
+ * @param aoWindows Windows to read.
+ * @param papszOptions NULL-terminated list of options, or NULL.
+ * @return one future per window.
+ * @since GDAL 3.11
+ */
+
+std::vector<std::future<CPLErr>>
+GDALDataset::RasterIOBatch(std::vector<RasterIOWindow> aoWindows,
+                           CSLConstList papszOptions)
+{
+    std::vector<std::future<CPLErr>> aoFutures;
+    aoFutures.reserve(aoWindows.size());
+
+    const char *pszNumThreads = CSLFetchNameValueDef(
+        papszOptions, "NUM_THREADS",
+        CPLGetConfigOption("GDAL_NUM_THREADS", "1"));
+    const int nThreads = EQUAL(pszNumThreads, "ALL_CPUS")
+                             ? CPLGetNumCPUs()
+                             : atoi(pszNumThreads);
+
+    const int nRunners = static_cast<int>(
+        std::min<size_t>(std::max(1, nThreads), aoWindows.size()));
+    CPLWorkerThreadPool *poPool = nullptr;
+    if (nRunners > 1 && IsThreadSafe(GDAL_OF_RASTER))
+        poPool = GDALGetGlobalThreadPool(nRunners);
+
+    auto poTasks =
+        std::make_shared<std::vector<std::packaged_task<CPLErr()>>>();
+    poTasks->reserve(aoWindows.size());
+    for (auto &oWindow : aoWindows)
+    {
+        if (!poPool)
+        {
+            poTasks->emplace_back(
+                [this, oWindow = std::move(oWindow)]()
+                {
+                    const CPLErr eErr = ReadRasterIOWindow(this, oWindow);
+                    if (oWindow.oCompletionCallback)
+                        oWindow.oCompletionCallback(eErr);
+                    return eErr;
+                });
+            aoFutures.push_back(poTasks->back().get_future());
+            continue;
+        }
+
+        // Collect the errors of the worker thread, to emit them again in
+        // the thread that consumes the future.
+        auto poErrors =
+            std::make_shared<std::vector<CPLErrorHandlerAccumulatorStruct>>();
+        poTasks->emplace_back(
+            [this, oWindow = std::move(oWindow), poErrors]()
+            {
+                CPLInstallErrorHandlerAccumulator(*poErrors);
+                const CPLErr eErr = ReadRasterIOWindow(this, oWindow);
+                CPLUninstallErrorHandlerAccumulator();
+                if (oWindow.oCompletionCallback)
+                    oWindow.oCompletionCallback(eErr);
+                return eErr;
+            });
+        aoFutures.push_back(std::async(
+            std::launch::deferred,
+            [oFuture = poTasks->back().get_future(), poErrors]() mutable
+            {
+                const CPLErr eErr = oFuture.get();
+                for (const auto &oError : *poErrors)
+                {
+                    CPLError(oError.type, oError.no, "%s",
+                             oError.msg.c_str());
+                }
+                return eErr;
+            }));
+    }
+
+    // Each runner reads windows until none is left, so that at most
+    // nRunners windows are read concurrently, even if the global thread pool
+    // has more threads.
+    auto pnNextTask = std::make_shared<std::atomic<size_t>>(0);
+    const auto Runner = [poTasks, pnNextTask]()
+    {
+        for (size_t i = (*pnNextTask)++; i < poTasks->size();
+             i = (*pnNextTask)++)
+        {
+            (*poTasks)[i]();
+        }
+    };
+    int nSubmittedRunners = 0;
+    if (poPool)
+    {
+        for (; nSubmittedRunners < nRunners; ++nSubmittedRunners)
+        {
+            if (!poPool->SubmitJob(Runner))
+                break;
+        }
+    }
+    if (nSubmittedRunners == 0)
+        Runner();
+
+    return aoFutures;
+}
+
 /************************************************************************/
 /*                       CloseDependentDatasets()                       */
 /************************************************************************/
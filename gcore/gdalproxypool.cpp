@@ -18,6 +18,11 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -95,6 +100,23 @@ class GDALDatasetPool
     GDALProxyPoolCacheEntry *firstEntry = nullptr;
     GDALProxyPoolCacheEntry *lastEntry = nullptr;
 
+    /* Protects the entries, their links and the map below. It is only held */
+    /* for short periods of time: datasets are opened and closed without */
+    /* holding it, so that threads can use distinct datasets in parallel. */
+    std::mutex m_oMutex{};
+
+    /* Entries that have a file name, indexed by file name and open options */
+    std::unordered_multimap<std::string, GDALProxyPoolCacheEntry *>
+        m_oMapEntries{};
+
+    /* Statistics, reported by GDALGetDatasetPoolStatistics() */
+    GIntBig m_nHits = 0;
+    GIntBig m_nMisses = 0;
+    GIntBig m_nEvictions = 0;
+
+    /* Dataset detached from its entry, with the PID that opened it */
+    using DatasetToClose = std::pair<GDALDataset *, GIntBig>;
+
     /* Caution : to be sure that we don't run out of entries, size must be at */
     /* least greater or equal than the maximum number of threads */
     explicit GDALDatasetPool(int maxSize, int64_t nMaxRAMUsage);
@@ -108,6 +130,14 @@ class GDALDatasetPool
                                      CSLConstList papszOpenOptions,
                                      GDALAccess eAccess, const char *pszOwner);
 
+    void MoveToFront(GDALProxyPoolCacheEntry *cur);
+    void DetachEntry(GDALProxyPoolCacheEntry *cur,
+                     std::vector<DatasetToClose> &aoDatasetsToClose);
+    GDALProxyPoolCacheEntry *
+    EvictEntryWithZeroRefCount(bool evictEntryWithOpenedDataset,
+                               std::vector<DatasetToClose> &aoDatasetsToClose);
+    static void CloseDatasets(const std::vector<DatasetToClose> &aoDatasets);
+
 #ifdef DEBUG_PROXY_POOL
     // cppcheck-suppress unusedPrivateFunction
     void ShowContent();
@@ -132,6 +162,8 @@ class GDALDatasetPool
 
     static void PreventDestroy();
     static void ForceDestroy();
+
+    static CPLStringList GetStatistics();
 };
 
 /************************************************************************/
@@ -230,140 +262,177 @@ static std::string GetFilenameAndOpenOptions(const char *pszFileName,
 }
 
 /************************************************************************/
-/*                            _RefDataset()                             */
+/*                            MoveToFront()                             */
 /************************************************************************/
 
-GDALProxyPoolCacheEntry *
-GDALDatasetPool::_RefDataset(const char *pszFileName, GDALAccess eAccess,
-                             CSLConstList papszOpenOptions, int bShared,
-                             bool bForceOpen, const char *pszOwner)
+/* Must be called with m_oMutex held */
+void GDALDatasetPool::MoveToFront(GDALProxyPoolCacheEntry *cur)
 {
-    CPLMutex **pMutex = GDALGetphDLMutex();
-    CPLMutexHolderD(pMutex);
+    if (cur == firstEntry)
+        return;
 
-    if (bInDestruction)
-        return nullptr;
+    if (cur->next)
+        cur->next->prev = cur->prev;
+    else
+        lastEntry = cur->prev;
+    cur->prev->next = cur->next;
+    cur->prev = nullptr;
+    firstEntry->prev = cur;
+    cur->next = firstEntry;
+    firstEntry = cur;
 
-    const GIntBig responsiblePID = GDALGetResponsiblePIDForCurrentThread();
+#ifdef DEBUG_PROXY_POOL
+    CheckLinks();
+#endif
+}
 
-    const auto EvictEntryWithZeroRefCount =
-        [this, responsiblePID](bool evictEntryWithOpenedDataset)
+/************************************************************************/
+/*                            DetachEntry()                             */
+/************************************************************************/
+
+/* Must be called with m_oMutex held. Empties the entry, and appends its */
+/* dataset to aoDatasetsToClose, so that the caller can close it once the */
+/* mutex is released. */
+void GDALDatasetPool::DetachEntry(
+    GDALProxyPoolCacheEntry *cur,
+    std::vector<DatasetToClose> &aoDatasetsToClose)
+{
+    if (cur->pszFileNameAndOpenOptions)
     {
-        GDALProxyPoolCacheEntry *cur = firstEntry;
-        GDALProxyPoolCacheEntry *candidate = nullptr;
-        while (cur)
+        auto oRange = m_oMapEntries.equal_range(cur->pszFileNameAndOpenOptions);
+        for (auto oIter = oRange.first; oIter != oRange.second; ++oIter)
         {
-            GDALProxyPoolCacheEntry *next = cur->next;
-
-            if (cur->refCount == 0 &&
-                (!evictEntryWithOpenedDataset || cur->nRAMUsage > 0))
+            if (oIter->second == cur)
             {
-                candidate = cur;
+                m_oMapEntries.erase(oIter);
+                break;
             }
-
-            cur = next;
         }
-        if (candidate == nullptr)
-            return false;
+        CPLFree(cur->pszFileNameAndOpenOptions);
+        cur->pszFileNameAndOpenOptions = nullptr;
+    }
 
-        nRAMUsage -= candidate->nRAMUsage;
-        candidate->nRAMUsage = 0;
+    nRAMUsage -= cur->nRAMUsage;
+    cur->nRAMUsage = 0;
 
-        CPLFree(candidate->pszFileNameAndOpenOptions);
-        candidate->pszFileNameAndOpenOptions = nullptr;
+    if (cur->poDS)
+    {
+        aoDatasetsToClose.emplace_back(cur->poDS, cur->responsiblePID);
+        cur->poDS = nullptr;
+    }
+    CPLFree(cur->pszOwner);
+    cur->pszOwner = nullptr;
+}
 
-        if (candidate->poDS)
-        {
-            /* Close by pretending we are the thread that GDALOpen'ed this */
-            /* dataset */
-            GDALSetResponsiblePIDForCurrentThread(candidate->responsiblePID);
+/************************************************************************/
+/*                     EvictEntryWithZeroRefCount()                     */
+/************************************************************************/
 
-            refCountOfDisabledRefCount++;
-            GDALClose(candidate->poDS);
-            refCountOfDisabledRefCount--;
+/* Must be called with m_oMutex held. Detaches the least recently used */
+/* entry that is not in use. If evictEntryWithOpenedDataset is false, the */
+/* entry is moved to the front of the list so that it can be recycled. */
+GDALProxyPoolCacheEntry *GDALDatasetPool::EvictEntryWithZeroRefCount(
+    bool evictEntryWithOpenedDataset,
+    std::vector<DatasetToClose> &aoDatasetsToClose)
+{
+    GDALProxyPoolCacheEntry *candidate = lastEntry;
+    while (candidate &&
+           !(candidate->refCount == 0 &&
+             (!evictEntryWithOpenedDataset || candidate->nRAMUsage > 0)))
+    {
+        candidate = candidate->prev;
+    }
+    if (candidate == nullptr)
+        return nullptr;
 
-            candidate->poDS = nullptr;
-            GDALSetResponsiblePIDForCurrentThread(responsiblePID);
-        }
-        CPLFree(candidate->pszOwner);
-        candidate->pszOwner = nullptr;
+    if (candidate->poDS)
+        ++m_nEvictions;
+    DetachEntry(candidate, aoDatasetsToClose);
 
-        if (!evictEntryWithOpenedDataset && candidate != firstEntry)
-        {
-            /* Recycle this entry for the to-be-opened dataset and */
-            /* moves it to the top of the list */
-            if (candidate->prev)
-                candidate->prev->next = candidate->next;
-
-            if (candidate->next)
-                candidate->next->prev = candidate->prev;
-            else
-            {
-                CPLAssert(candidate == lastEntry);
-                lastEntry->prev->next = nullptr;
-                lastEntry = lastEntry->prev;
-            }
-            candidate->prev = nullptr;
-            candidate->next = firstEntry;
-            firstEntry->prev = candidate;
-            firstEntry = candidate;
+    if (!evictEntryWithOpenedDataset)
+    {
+        /* Recycle this entry for the to-be-opened dataset and */
+        /* moves it to the top of the list */
+        MoveToFront(candidate);
+    }
 
-#ifdef DEBUG_PROXY_POOL
-            CheckLinks();
-#endif
-        }
+    return candidate;
+}
 
-        return true;
-    };
+/************************************************************************/
+/*                           CloseDatasets()                            */
+/************************************************************************/
 
-    GDALProxyPoolCacheEntry *cur = firstEntry;
+/* Must be called without m_oMutex held */
+void GDALDatasetPool::CloseDatasets(
+    const std::vector<DatasetToClose> &aoDatasets)
+{
+    if (aoDatasets.empty())
+        return;
+
+    const GIntBig responsiblePID = GDALGetResponsiblePIDForCurrentThread();
+    for (const auto &[poDS, nPID] : aoDatasets)
+    {
+        /* Close by pretending we are the thread that GDALOpen'ed this */
+        /* dataset */
+        GDALSetResponsiblePIDForCurrentThread(nPID);
+
+        refCountOfDisabledRefCount++;
+        GDALClose(poDS);
+        refCountOfDisabledRefCount--;
+    }
+    GDALSetResponsiblePIDForCurrentThread(responsiblePID);
+}
+
+/************************************************************************/
+/*                            _RefDataset()                             */
+/************************************************************************/
+
+GDALProxyPoolCacheEntry *
+GDALDatasetPool::_RefDataset(const char *pszFileName, GDALAccess eAccess,
+                             CSLConstList papszOpenOptions, int bShared,
+                             bool bForceOpen, const char *pszOwner)
+{
+    std::unique_lock oLock(m_oMutex);
+
+    if (bInDestruction)
+        return nullptr;
+
+    const GIntBig responsiblePID = GDALGetResponsiblePIDForCurrentThread();
 
     const std::string osFilenameAndOO =
         GetFilenameAndOpenOptions(pszFileName, papszOpenOptions);
 
-    while (cur)
+    const auto oRange = m_oMapEntries.equal_range(osFilenameAndOO);
+    for (auto oIter = oRange.first; oIter != oRange.second; ++oIter)
     {
-        GDALProxyPoolCacheEntry *next = cur->next;
+        GDALProxyPoolCacheEntry *cur = oIter->second;
 
-        if (cur->refCount >= 0 && cur->pszFileNameAndOpenOptions &&
-            osFilenameAndOO == cur->pszFileNameAndOpenOptions &&
+        if (cur->refCount >= 0 &&
             ((bShared && cur->responsiblePID == responsiblePID &&
               ((cur->pszOwner == nullptr && pszOwner == nullptr) ||
                (cur->pszOwner != nullptr && pszOwner != nullptr &&
                 strcmp(cur->pszOwner, pszOwner) == 0))) ||
              (!bShared && cur->refCount == 0)))
         {
-            if (cur != firstEntry)
-            {
-                /* Move to begin */
-                if (cur->next)
-                    cur->next->prev = cur->prev;
-                else
-                    lastEntry = cur->prev;
-                cur->prev->next = cur->next;
-                cur->prev = nullptr;
-                firstEntry->prev = cur;
-                cur->next = firstEntry;
-                firstEntry = cur;
-
-#ifdef DEBUG_PROXY_POOL
-                CheckLinks();
-#endif
-            }
-
+            MoveToFront(cur);
             cur->refCount++;
+            ++m_nHits;
             return cur;
         }
-
-        cur = next;
     }
 
     if (!bForceOpen)
         return nullptr;
 
+    ++m_nMisses;
+
+    std::vector<DatasetToClose> aoDatasetsToClose;
+    GDALProxyPoolCacheEntry *cur = nullptr;
     if (currentSize == maxSize)
     {
-        if (!EvictEntryWithZeroRefCount(false))
+        cur = EvictEntryWithZeroRefCount(false, aoDatasetsToClose);
+        if (!cur)
         {
             CPLError(
                 CE_Failure, CPLE_AppDefined,
@@ -375,8 +444,7 @@ GDALDatasetPool::_RefDataset(const char *pszFileName, GDALAccess eAccess,
             return nullptr;
         }
 
-        CPLAssert(firstEntry);
-        cur = firstEntry;
+        CPLAssert(cur == firstEntry);
     }
     else
     {
@@ -401,40 +469,46 @@ GDALDatasetPool::_RefDataset(const char *pszFileName, GDALAccess eAccess,
     cur->responsiblePID = responsiblePID;
     cur->refCount = -1;  // to mark loading of dataset in progress
     cur->nRAMUsage = 0;
+    m_oMapEntries.emplace(osFilenameAndOO, cur);
+
+    // Release mutex while closing the evicted dataset and opening the new
+    // one, so that other threads can keep using the pool meanwhile.
+    oLock.unlock();
+
+    CloseDatasets(aoDatasetsToClose);
+    aoDatasetsToClose.clear();
 
     refCountOfDisabledRefCount++;
     const int nFlag =
         ((eAccess == GA_Update) ? GDAL_OF_UPDATE : GDAL_OF_READONLY) |
         GDAL_OF_RASTER | GDAL_OF_VERBOSE_ERROR;
     CPLConfigOptionSetter oSetter("CPL_ALLOW_VSISTDIN", "NO", true);
-
-    // Release mutex while opening dataset to avoid lock contention.
-    CPLReleaseMutex(*pMutex);
     auto poDS = GDALDataset::Open(pszFileName, nFlag, nullptr, papszOpenOptions,
                                   nullptr);
-    CPLAcquireMutex(*pMutex, 1000.0);
+    refCountOfDisabledRefCount--;
 
-    cur->poDS = poDS;
-    cur->refCount = 1;
+    const int64_t nDSRAMUsage =
+        poDS ? std::max<GIntBig>(0, poDS->GetEstimatedRAMUsage()) : 0;
 
-    refCountOfDisabledRefCount--;
+    oLock.lock();
 
-    if (cur->poDS)
-    {
-        cur->nRAMUsage =
-            std::max<GIntBig>(0, cur->poDS->GetEstimatedRAMUsage());
-        nRAMUsage += cur->nRAMUsage;
-    }
+    cur->poDS = poDS;
+    cur->refCount = 1;
+    cur->nRAMUsage = nDSRAMUsage;
+    nRAMUsage += nDSRAMUsage;
 
     if (nMaxRAMUsage > 0 && cur->nRAMUsage > 0)
     {
         while (nRAMUsage > nMaxRAMUsage && nRAMUsage != cur->nRAMUsage &&
-               EvictEntryWithZeroRefCount(true))
+               EvictEntryWithZeroRefCount(true, aoDatasetsToClose))
         {
             // ok
         }
     }
 
+    oLock.unlock();
+    CloseDatasets(aoDatasetsToClose);
+
     return cur;
 }
 
@@ -447,52 +521,35 @@ void GDALDatasetPool::_CloseDatasetIfZeroRefCount(const char *pszFileName,
                                                   GDALAccess /* eAccess */,
                                                   const char *pszOwner)
 {
-    // May fix https://github.com/OSGeo/gdal/issues/4318
-    if (bInDestruction)
-        return;
-
-    GDALProxyPoolCacheEntry *cur = firstEntry;
-    GIntBig responsiblePID = GDALGetResponsiblePIDForCurrentThread();
-
-    const std::string osFilenameAndOO =
-        GetFilenameAndOpenOptions(pszFileName, papszOpenOptions);
-
-    while (cur)
+    std::vector<DatasetToClose> aoDatasetsToClose;
     {
-        GDALProxyPoolCacheEntry *next = cur->next;
-
-        if (cur->refCount == 0 && cur->pszFileNameAndOpenOptions &&
-            osFilenameAndOO == cur->pszFileNameAndOpenOptions &&
-            ((pszOwner == nullptr && cur->pszOwner == nullptr) ||
-             (pszOwner != nullptr && cur->pszOwner != nullptr &&
-              strcmp(cur->pszOwner, pszOwner) == 0)) &&
-            cur->poDS != nullptr)
-        {
-            /* Close by pretending we are the thread that GDALOpen'ed this */
-            /* dataset */
-            GDALSetResponsiblePIDForCurrentThread(cur->responsiblePID);
-
-            GDALDataset *poDS = cur->poDS;
+        std::lock_guard oLock(m_oMutex);
 
-            nRAMUsage -= cur->nRAMUsage;
-            cur->nRAMUsage = 0;
+        // May fix https://github.com/OSGeo/gdal/issues/4318
+        if (bInDestruction)
+            return;
 
-            cur->poDS = nullptr;
-            CPLFree(cur->pszFileNameAndOpenOptions);
-            cur->pszFileNameAndOpenOptions = nullptr;
-            CPLFree(cur->pszOwner);
-            cur->pszOwner = nullptr;
+        const std::string osFilenameAndOO =
+            GetFilenameAndOpenOptions(pszFileName, papszOpenOptions);
 
-            refCountOfDisabledRefCount++;
-            GDALClose(poDS);
-            refCountOfDisabledRefCount--;
+        const auto oRange = m_oMapEntries.equal_range(osFilenameAndOO);
+        for (auto oIter = oRange.first; oIter != oRange.second; ++oIter)
+        {
+            GDALProxyPoolCacheEntry *cur = oIter->second;
 
-            GDALSetResponsiblePIDForCurrentThread(responsiblePID);
-            break;
+            if (cur->refCount == 0 &&
+                ((pszOwner == nullptr && cur->pszOwner == nullptr) ||
+                 (pszOwner != nullptr && cur->pszOwner != nullptr &&
+                  strcmp(cur->pszOwner, pszOwner) == 0)) &&
+                cur->poDS != nullptr)
+            {
+                DetachEntry(cur, aoDatasetsToClose);
+                break;
+            }
         }
-
-        cur = next;
     }
+
+    CloseDatasets(aoDatasetsToClose);
 }
 
 /************************************************************************/
@@ -623,7 +680,7 @@ GDALDatasetPool::RefDataset(const char *pszFileName, GDALAccess eAccess,
 
 void GDALDatasetPool::UnrefDataset(GDALProxyPoolCacheEntry *cacheEntry)
 {
-    CPLMutexHolderD(GDALGetphDLMutex());
+    std::lock_guard oLock(singleton->m_oMutex);
     cacheEntry->refCount--;
 }
 
@@ -636,11 +693,65 @@ void GDALDatasetPool::CloseDatasetIfZeroRefCount(const char *pszFileName,
                                                  GDALAccess eAccess,
                                                  const char *pszOwner)
 {
-    CPLMutexHolderD(GDALGetphDLMutex());
     singleton->_CloseDatasetIfZeroRefCount(pszFileName, papszOpenOptions,
                                            eAccess, pszOwner);
 }
 
+/************************************************************************/
+/*                           GetStatistics()                            */
+/************************************************************************/
+
+CPLStringList GDALDatasetPool::GetStatistics()
+{
+    CPLMutexHolderD(GDALGetphDLMutex());
+    CPLStringList aosStats;
+    if (!singleton)
+        return aosStats;
+
+    std::lock_guard oLock(singleton->m_oMutex);
+    int nOpenedDatasets = 0;
+    for (const GDALProxyPoolCacheEntry *cur = singleton->firstEntry; cur;
+         cur = cur->next)
+    {
+        if (cur->poDS)
+            ++nOpenedDatasets;
+    }
+    aosStats.SetNameValue("MAX_SIZE", CPLSPrintf("%d", singleton->maxSize));
+    aosStats.SetNameValue("CURRENT_SIZE",
+                          CPLSPrintf("%d", singleton->currentSize));
+    aosStats.SetNameValue("OPENED_DATASETS",
+                          CPLSPrintf("%d", nOpenedDatasets));
+    aosStats.SetNameValue(
+        "MAX_RAM_USAGE",
+        CPLSPrintf(CPL_FRMT_GIB,
+                   static_cast<GIntBig>(singleton->nMaxRAMUsage)));
+    aosStats.SetNameValue(
+        "RAM_USAGE",
+        CPLSPrintf(CPL_FRMT_GIB, static_cast<GIntBig>(singleton->nRAMUsage)));
+    aosStats.SetNameValue("HITS", CPLSPrintf(CPL_FRMT_GIB, singleton->m_nHits));
+    aosStats.SetNameValue("MISSES",
+                          CPLSPrintf(CPL_FRMT_GIB, singleton->m_nMisses));
+    aosStats.SetNameValue("EVICTIONS",
+                          CPLSPrintf(CPL_FRMT_GIB, singleton->m_nEvictions));
+    return aosStats;
+}
+
+/************************************************************************/
+/*                    GDALGetDatasetPoolStatistics()                    */
+/************************************************************************/
+
+/** Return statistics on the dataset pool, as a list of KEY=VALUE strings
+ * (MAX_SIZE, CURRENT_SIZE, OPENED_DATASETS, MAX_RAM_USAGE, RAM_USAGE, HITS,
+ * MISSES and EVICTIONS), or an empty list if the pool is not active.
+ *
+ * Used to tune GDAL_MAX_DATASET_POOL_SIZE and
+ * GDAL_MAX_DATASET_POOL_RAM_USAGE.
+ */
+CPLStringList GDALGetDatasetPoolStatistics()
+{
+    return GDALDatasetPool::GetStatistics();
+}
+
 struct GetMetadataElt
 {
     char *pszDomain;
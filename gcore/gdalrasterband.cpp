@@ -23,21 +23,28 @@
 #include <cstdlib>
 #include <cstring>
 #include <algorithm>
+#include <atomic>
+#include <functional>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <new>
 #include <type_traits>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_virtualmem.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_rat.h"
 #include "gdal_priv_templates.hpp"
 #include "gdal_interpolateatpoint.h"
+#include "gdal_thread_pool.h"
 
 /************************************************************************/
 /*                           GDALRasterBand()                           */
@@ -79,6 +86,11 @@ GDALRasterBand::~GDALRasterBand()
 
     delete poBandBlockCache;
 
+    // Blocks evicted while the band block cache was being destroyed may
+    // have been stored in the compressed cache. This must be done before the
+    // address of this band can be reused.
+    GDALRasterBlock::ForgetCompressed(this);
+
     if (static_cast<GIntBig>(nBlockReads) >
             static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn &&
         nBand == 1 && poDS != nullptr)
@@ -435,6 +447,10 @@ CPLErr GDALRasterBand::RasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
             IRasterIO(eRWFlag, nXOff, nYOff, nXSize, nYSize, pData, nBufXSize,
                       nBufYSize, eBufType, nPixelSpace, nLineSpace, psExtraArg);
 
+    // Drivers may write directly, without going through the block cache
+    if (eRWFlag == GF_Write)
+        GDALRasterBlock::DropCompressed(this, nXOff, nYOff, nXSize, nYSize);
+
     if (bCallLeaveReadWrite)
         LeaveReadWrite();
 
@@ -1261,6 +1277,8 @@ CPLErr GDALRasterBand::WriteBlock(int nXBlockOff, int nYBlockOff, void *pImage)
     /*      Invoke underlying implementation method.                        */
     /* -------------------------------------------------------------------- */
 
+    GDALRasterBlock::DropCompressed(this, nXBlockOff, nYBlockOff);
+
     const bool bCallLeaveReadWrite = CPL_TO_BOOL(EnterReadWrite(GF_Write));
     CPLErr eErr = IWriteBlock(nXBlockOff, nYBlockOff, pImage);
     if (bCallLeaveReadWrite)
@@ -1640,6 +1658,8 @@ CPLErr GDALRasterBand::FlushCache(bool bAtClosing)
         eFlushBlockErr = CE_None;
     }
 
+    GDALRasterBlock::DropCompressed(this);
+
     if (poBandBlockCache == nullptr || !poBandBlockCache->IsInitOK())
         return eGlobalErr;
 
@@ -1698,6 +1718,8 @@ CPLErr GDALRasterBand::DropCache()
         eFlushBlockErr = CE_None;
     }
 
+    GDALRasterBlock::DropCompressed(this);
+
     if (poBandBlockCache == nullptr || !poBandBlockCache->IsInitOK())
         result = eGlobalErr;
     else
@@ -1999,7 +2021,18 @@ GDALRasterBlock *GDALRasterBand::GetLockedBlockRef(int nXBlockOff,
             return nullptr;
         }
 
-        if (!bJustInitialize)
+        bool bFromCompressedCache = false;
+        if (bJustInitialize)
+        {
+            GDALRasterBlock::DropCompressed(this, nXBlockOff, nYBlockOff);
+        }
+        else if (GDALRasterBlock::FetchCompressed(
+                     this, nXBlockOff, nYBlockOff, poBlock->GetDataRef(),
+                     static_cast<size_t>(poBlock->GetBlockSize())))
+        {
+            bFromCompressedCache = true;
+        }
+        else
         {
             const GUInt32 nErrorCounter = CPLGetErrorCounter();
             int bCallLeaveReadWrite = EnterReadWrite(GF_Read);
@@ -2029,6 +2062,17 @@ GDALRasterBlock *GDALRasterBand::GetLockedBlockRef(int nXBlockOff,
                          poDS->GetDescription());
             }
         }
+
+        GDALRasterBlock::RecordMiss(
+            this,
+            bJustInitialize || bFromCompressedCache
+                ? 0
+                : static_cast<GIntBig>(poBlock->GetBlockSize()),
+            bFromCompressedCache);
+    }
+    else
+    {
+        GDALRasterBlock::RecordHit(this);
     }
 
     return poBlock;
@@ -3883,6 +3927,444 @@ static inline void ComputeFloatNoDataValue(GDALDataType eDataType,
     }
 }
 
+/************************************************************************/
+/*                       GDALSampledBlockIterator                       */
+/************************************************************************/
+
+namespace
+{
+
+// Iterates over the blocks of a band selected by a sample rate, and runs a
+// function on each of them. When GDAL_NUM_THREADS is set to a value greater
+// than 1, the per-block function runs in worker threads. If the dataset of
+// the band is opened in read-only mode and can be cloned, workers also read
+// and decode the blocks, through a thread-safe dataset (see
+// GDALGetThreadSafeDataset()), in a dedicated thread pool. Otherwise, since
+// drivers are not required to support concurrent reads, blocks are fetched by
+// the calling thread, and processed in workers of the global thread pool. The
+// matching part of the mask band is always read by the calling thread. Each
+// job owns an accumulator slot (iSlot) until it completes, so that callers
+// can update per-slot partial results without locking, and merge them once
+// Run() has returned.
+class GDALSampledBlockIterator
+{
+  public:
+    // Returns false to stop the iteration (this is not an error).
+    using ProcessFunc =
+        std::function<bool(int iSlot, const void *pData, const GByte *pabyMask,
+                           int nXCheck, int nYCheck)>;
+
+    GDALSampledBlockIterator(GDALRasterBand *poBand,
+                             GDALRasterBand *poMaskBand, int nSampleRate);
+    ~GDALSampledBlockIterator();
+
+    int GetSlotCount() const
+    {
+        return m_nSlots;
+    }
+
+    bool Run(const ProcessFunc &pfnProcess, const char *pszMessage,
+             GDALProgressFunc pfnProgress, void *pProgressData);
+
+  private:
+    CPL_DISALLOW_COPY_ASSIGN(GDALSampledBlockIterator)
+
+    struct Block
+    {
+        // Only set when blocks are fetched by the calling thread
+        GDALRasterBlock *poBlock = nullptr;
+        int iXBlock = 0;
+        int iYBlock = 0;
+        int nXCheck = 0;
+        int nYCheck = 0;
+        std::unique_ptr<GByte, VSIFreeReleaser> pabyMask{};
+    };
+
+    struct Job
+    {
+        int iSlot = 0;
+        std::vector<Block> aoBlocks{};
+    };
+
+    GDALRasterBand *m_poBand = nullptr;
+    GDALRasterBand *m_poMaskBand = nullptr;
+    int m_nSampleRate = 1;
+    int m_nBlockXSize = 0;
+    int m_nBlockYSize = 0;
+    int m_nBlocksPerRow = 0;
+    GIntBig m_nTotalBlocks = 0;
+    int m_nSlots = 1;
+    size_t m_nMaxBlocksPerJob = 1;
+    CPLWorkerThreadPool *m_poThreadPool = nullptr;
+
+    // Set when blocks are read by the workers
+    std::unique_ptr<CPLWorkerThreadPool> m_poOwnedThreadPool{};
+    GDALDataset *m_poThreadSafeDS = nullptr;
+    GDALRasterBand *m_poThreadSafeBand = nullptr;
+    std::vector<std::vector<GByte>> m_aabySlotBuffers{};
+
+    std::mutex m_oMutex{};
+    std::vector<int> m_anFreeSlots{};
+    std::vector<CPLErrorHandlerAccumulatorStruct> m_aoWorkerErrors{};
+    bool m_bWorkerReadFailed = false;
+
+    bool FetchBlock(int iXBlock, int iYBlock, Block &oBlock);
+    const void *ReadBlockInWorker(int iSlot, const Block &oBlock);
+    void SetupWorkerReads(int nThreads);
+};
+
+/************************************************************************/
+/*                      GDALSampledBlockIterator()                      */
+/************************************************************************/
+
+GDALSampledBlockIterator::GDALSampledBlockIterator(GDALRasterBand *poBand,
+                                                   GDALRasterBand *poMaskBand,
+                                                   int nSampleRate)
+    : m_poBand(poBand), m_poMaskBand(poMaskBand),
+      m_nSampleRate(std::max(1, nSampleRate))
+{
+    poBand->GetBlockSize(&m_nBlockXSize, &m_nBlockYSize);
+    m_nBlocksPerRow = DIV_ROUND_UP(poBand->GetXSize(), m_nBlockXSize);
+    const int nBlocksPerColumn =
+        DIV_ROUND_UP(poBand->GetYSize(), m_nBlockYSize);
+    m_nTotalBlocks = static_cast<GIntBig>(m_nBlocksPerRow) * nBlocksPerColumn;
+    const GIntBig nSampledBlocks = DIV_ROUND_UP(m_nTotalBlocks, m_nSampleRate);
+
+    const char *pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    const int nThreads = static_cast<int>(std::min<GIntBig>(
+        nSampledBlocks,
+        std::max(1, std::min(128, EQUAL(pszThreads, "ALL_CPUS")
+                                      ? CPLGetNumCPUs()
+                                      : atoi(pszThreads)))));
+    if (nThreads > 1)
+    {
+        SetupWorkerReads(nThreads);
+        if (!m_poThreadSafeBand)
+            m_poThreadPool = GDALGetGlobalThreadPool(nThreads);
+    }
+    if (m_poThreadPool)
+    {
+        // Twice as many slots as threads, so that the calling thread can
+        // fetch the next blocks while all workers are busy.
+        m_nSlots = 2 * nThreads;
+        for (int i = m_nSlots - 1; i >= 0; --i)
+            m_anFreeSlots.push_back(i);
+        if (m_poThreadSafeBand)
+            m_aabySlotBuffers.resize(m_nSlots);
+
+        // Limit the number of blocks locked by in-flight jobs to about a
+        // quarter of the block cache.
+        const GIntBig nBlockBytes =
+            std::max<GIntBig>(1, static_cast<GIntBig>(m_nBlockXSize) *
+                                     m_nBlockYSize *
+                                     GDALGetDataTypeSizeBytes(
+                                         poBand->GetRasterDataType()));
+        m_nMaxBlocksPerJob = static_cast<size_t>(std::max<GIntBig>(
+            1, std::min<GIntBig>(m_nBlocksPerRow,
+                                 GDALGetCacheMax64() / 4 / m_nSlots /
+                                     nBlockBytes)));
+    }
+}
+
+/************************************************************************/
+/*                     ~GDALSampledBlockIterator()                      */
+/************************************************************************/
+
+GDALSampledBlockIterator::~GDALSampledBlockIterator()
+{
+    // Join the workers before their thread-local datasets are closed
+    m_poOwnedThreadPool.reset();
+    if (m_poThreadSafeDS)
+        m_poThreadSafeDS->ReleaseRef();
+}
+
+/************************************************************************/
+/*                          SetupWorkerReads()                          */
+/************************************************************************/
+
+void GDALSampledBlockIterator::SetupWorkerReads(int nThreads)
+{
+    // Clones of the dataset would not see pending modifications
+    GDALDataset *poDS = m_poBand->GetDataset();
+    const int nBand = m_poBand->GetBand();
+    if (poDS == nullptr || poDS->GetAccess() != GA_ReadOnly || nBand <= 0 ||
+        nBand > poDS->GetRasterCount() ||
+        poDS->GetRasterBand(nBand) != m_poBand)
+    {
+        return;
+    }
+
+    // A dedicated pool, since drivers may use the global thread pool while
+    // decoding blocks.
+    auto poPool = std::make_unique<CPLWorkerThreadPool>();
+    if (!poPool->Setup(nThreads, nullptr, nullptr))
+        return;
+
+    {
+        // Fails if the dataset cannot be cloned, which is not an error here
+        CPLErrorStateBackuper oBackuper(CPLQuietErrorHandler);
+        m_poThreadSafeDS = GDALGetThreadSafeDataset(poDS, GDAL_OF_RASTER);
+    }
+    if (m_poThreadSafeDS == nullptr)
+        return;
+    m_poThreadSafeBand = m_poThreadSafeDS->GetRasterBand(nBand);
+    m_poOwnedThreadPool = std::move(poPool);
+    m_poThreadPool = m_poOwnedThreadPool.get();
+}
+
+/************************************************************************/
+/*                             FetchBlock()                             */
+/************************************************************************/
+
+bool GDALSampledBlockIterator::FetchBlock(int iXBlock, int iYBlock,
+                                          Block &oBlock)
+{
+    if (!m_poThreadSafeBand)
+    {
+        oBlock.poBlock = m_poBand->GetLockedBlockRef(iXBlock, iYBlock);
+        if (oBlock.poBlock == nullptr)
+            return false;
+    }
+    oBlock.iXBlock = iXBlock;
+    oBlock.iYBlock = iYBlock;
+
+    m_poBand->GetActualBlockSize(iXBlock, iYBlock, &oBlock.nXCheck,
+                                 &oBlock.nYCheck);
+
+    if (m_poMaskBand)
+    {
+        if (!oBlock.pabyMask)
+        {
+            oBlock.pabyMask.reset(static_cast<GByte *>(
+                VSI_MALLOC2_VERBOSE(m_nBlockXSize, m_nBlockYSize)));
+        }
+        if (!oBlock.pabyMask ||
+            m_poMaskBand->RasterIO(
+                GF_Read, iXBlock * m_nBlockXSize, iYBlock * m_nBlockYSize,
+                oBlock.nXCheck, oBlock.nYCheck, oBlock.pabyMask.get(),
+                oBlock.nXCheck, oBlock.nYCheck, GDT_Byte, 0, m_nBlockXSize,
+                nullptr) != CE_None)
+        {
+            if (oBlock.poBlock)
+                oBlock.poBlock->DropLock();
+            oBlock.poBlock = nullptr;
+            return false;
+        }
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                         ReadBlockInWorker()                          */
+/************************************************************************/
+
+// Read a block through the thread-safe dataset, in the buffer of the slot of
+// the job, with the same layout as the data of a GDALRasterBlock.
+const void *GDALSampledBlockIterator::ReadBlockInWorker(int iSlot,
+                                                        const Block &oBlock)
+{
+    const GDALDataType eDT = m_poBand->GetRasterDataType();
+    const int nDTSize = GDALGetDataTypeSizeBytes(eDT);
+    auto &abyBuffer = m_aabySlotBuffers[iSlot];
+    try
+    {
+        abyBuffer.resize(static_cast<size_t>(m_nBlockXSize) * m_nBlockYSize *
+                         nDTSize);
+    }
+    catch (const std::bad_alloc &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate block buffer");
+        return nullptr;
+    }
+    if (m_poThreadSafeBand->RasterIO(
+            GF_Read, oBlock.iXBlock * m_nBlockXSize,
+            oBlock.iYBlock * m_nBlockYSize, oBlock.nXCheck, oBlock.nYCheck,
+            abyBuffer.data(), oBlock.nXCheck, oBlock.nYCheck, eDT, nDTSize,
+            static_cast<GSpacing>(m_nBlockXSize) * nDTSize,
+            nullptr) != CE_None)
+    {
+        return nullptr;
+    }
+    return abyBuffer.data();
+}
+
+/************************************************************************/
+/*                                Run()                                 */
+/************************************************************************/
+
+bool GDALSampledBlockIterator::Run(const ProcessFunc &pfnProcess,
+                                   const char *pszMessage,
+                                   GDALProgressFunc pfnProgress,
+                                   void *pProgressData)
+{
+    if (pfnProgress == nullptr)
+        pfnProgress = GDALDummyProgress;
+
+    const auto ReportProgress = [this, pszMessage, pfnProgress,
+                                 pProgressData](GIntBig iSampleBlock)
+    {
+        if (!pfnProgress(static_cast<double>(iSampleBlock) /
+                             static_cast<double>(m_nTotalBlocks),
+                         pszMessage, pProgressData))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            return false;
+        }
+        return true;
+    };
+
+    if (!m_poThreadPool)
+    {
+        Block oBlock;
+        for (GIntBig iSampleBlock = 0; iSampleBlock < m_nTotalBlocks;
+             iSampleBlock += m_nSampleRate)
+        {
+            if (!ReportProgress(iSampleBlock))
+                return false;
+
+            const int iYBlock =
+                static_cast<int>(iSampleBlock / m_nBlocksPerRow);
+            const int iXBlock =
+                static_cast<int>(iSampleBlock % m_nBlocksPerRow);
+            if (!FetchBlock(iXBlock, iYBlock, oBlock))
+                return false;
+
+            const bool bContinue =
+                pfnProcess(0, oBlock.poBlock->GetDataRef(),
+                           oBlock.pabyMask.get(), oBlock.nXCheck,
+                           oBlock.nYCheck);
+            oBlock.poBlock->DropLock();
+            if (!bContinue)
+                break;
+        }
+        return true;
+    }
+
+    auto poJobQueue = m_poThreadPool->CreateJobQueue();
+    std::atomic<bool> bStop{false};
+    std::shared_ptr<Job> poJob;
+
+    const auto SubmitJob = [this, &poJobQueue, &poJob, &pfnProcess, &bStop]()
+    {
+        // Jobs give their slot back before being declared finished, so once
+        // less than m_nSlots jobs are pending, a slot is available.
+        poJobQueue->WaitCompletion(m_nSlots - 1);
+        {
+            std::lock_guard<std::mutex> oLock(m_oMutex);
+            poJob->iSlot = m_anFreeSlots.back();
+            m_anFreeSlots.pop_back();
+        }
+        auto poSubmittedJob = std::move(poJob);
+        poJob.reset();
+        poJobQueue->SubmitJob(
+            [this, poSubmittedJob, &pfnProcess, &bStop]()
+            {
+                // Errors are emitted again by the calling thread
+                std::vector<CPLErrorHandlerAccumulatorStruct> aoErrors;
+                CPLInstallErrorHandlerAccumulator(aoErrors);
+                bool bReadFailed = false;
+                const int iSlot = poSubmittedJob->iSlot;
+                for (auto &oBlock : poSubmittedJob->aoBlocks)
+                {
+                    if (!bStop)
+                    {
+                        const void *pData =
+                            oBlock.poBlock ? oBlock.poBlock->GetDataRef()
+                                           : ReadBlockInWorker(iSlot, oBlock);
+                        if (pData == nullptr)
+                        {
+                            bReadFailed = true;
+                            bStop = true;
+                        }
+                        else if (!pfnProcess(iSlot, pData,
+                                             oBlock.pabyMask.get(),
+                                             oBlock.nXCheck, oBlock.nYCheck))
+                        {
+                            bStop = true;
+                        }
+                    }
+                    if (oBlock.poBlock)
+                        oBlock.poBlock->DropLock();
+                }
+                CPLUninstallErrorHandlerAccumulator();
+
+                std::lock_guard<std::mutex> oLock(m_oMutex);
+                m_aoWorkerErrors.insert(m_aoWorkerErrors.end(),
+                                        aoErrors.begin(), aoErrors.end());
+                if (bReadFailed)
+                    m_bWorkerReadFailed = true;
+                m_anFreeSlots.push_back(iSlot);
+            });
+    };
+
+    bool bRet = true;
+    int iJobYBlock = -1;
+    for (GIntBig iSampleBlock = 0; iSampleBlock < m_nTotalBlocks && !bStop;
+         iSampleBlock += m_nSampleRate)
+    {
+        const int iYBlock = static_cast<int>(iSampleBlock / m_nBlocksPerRow);
+        const int iXBlock = static_cast<int>(iSampleBlock % m_nBlocksPerRow);
+
+        // A job covers the sampled blocks of a single block row
+        if (poJob && (iYBlock != iJobYBlock ||
+                      poJob->aoBlocks.size() >= m_nMaxBlocksPerJob))
+        {
+            SubmitJob();
+        }
+
+        if (!ReportProgress(iSampleBlock))
+        {
+            bRet = false;
+            break;
+        }
+
+        if (!poJob)
+        {
+            poJob = std::make_shared<Job>();
+            iJobYBlock = iYBlock;
+        }
+        poJob->aoBlocks.emplace_back();
+        if (!FetchBlock(iXBlock, iYBlock, poJob->aoBlocks.back()))
+        {
+            poJob->aoBlocks.pop_back();
+            bRet = false;
+            break;
+        }
+    }
+
+    if (poJob)
+    {
+        if (bRet)
+        {
+            SubmitJob();
+        }
+        else
+        {
+            for (auto &oBlock : poJob->aoBlocks)
+            {
+                if (oBlock.poBlock)
+                    oBlock.poBlock->DropLock();
+            }
+        }
+    }
+    bStop = bStop || !bRet;
+    poJobQueue->WaitCompletion();
+
+    for (const auto &oError : m_aoWorkerErrors)
+        CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+    m_aoWorkerErrors.clear();
+    if (m_bWorkerReadFailed)
+    {
+        m_bWorkerReadFailed = false;
+        bRet = false;
+    }
+
+    return bRet;
+}
+
+}  // namespace
+
 /************************************************************************/
 /*                            GetHistogram()                            */
 /************************************************************************/
@@ -3909,6 +4391,12 @@ static inline void ComputeFloatNoDataValue(GDALDataType eDataType,
  * in generating histogram based luts for instance.  Generally bApproxOK is
  * much faster than an exactly computed histogram.
  *
+ * Starting with GDAL 3.11, the GDAL_NUM_THREADS configuration option can be
+ * set to "ALL_CPUS" or a integer value to specify the number of threads to use
+ * for the computation of the histogram. Blocks are also read and decoded by
+ * the worker threads when the dataset is opened in read-only mode and can be
+ * cloned (see GDALGetThreadSafeDataset()).
+ *
  * This method is the same as the C functions GDALGetRasterHistogram() and
  * GDALGetRasterHistogramEx().
  *
@@ -4239,61 +4727,39 @@ CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
                 nSampleRate += 1;
         }
 
-        GByte *pabyMaskData = nullptr;
-        if (poMaskBand)
-        {
-            pabyMaskData = static_cast<GByte *>(
-                VSI_MALLOC2_VERBOSE(nBlockXSize, nBlockYSize));
-            if (!pabyMaskData)
-            {
-                return CE_Failure;
-            }
-        }
-
         /* --------------------------------------------------------------------
          */
         /*      Read the blocks, and add to histogram. */
         /* --------------------------------------------------------------------
          */
-        for (GIntBig iSampleBlock = 0;
-             iSampleBlock <
-             static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
-             iSampleBlock += nSampleRate)
-        {
-            if (!pfnProgress(
-                    static_cast<double>(iSampleBlock) /
-                        (static_cast<double>(nBlocksPerRow) * nBlocksPerColumn),
-                    "Compute Histogram", pProgressData))
-            {
-                CPLFree(pabyMaskData);
-                return CE_Failure;
-            }
-
-            const int iYBlock = static_cast<int>(iSampleBlock / nBlocksPerRow);
-            const int iXBlock = static_cast<int>(iSampleBlock % nBlocksPerRow);
+        GDALSampledBlockIterator oIter(this, poMaskBand, nSampleRate);
 
-            GDALRasterBlock *poBlock = GetLockedBlockRef(iXBlock, iYBlock);
-            if (poBlock == nullptr)
-            {
-                CPLFree(pabyMaskData);
-                return CE_Failure;
-            }
-
-            void *pData = poBlock->GetDataRef();
-
-            int nXCheck = 0, nYCheck = 0;
-            GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
+        // One partial histogram per accumulator slot of the iterator, merged
+        // at the end. Slot 0 accumulates directly into panHistogram.
+        std::vector<std::vector<GUIntBig>> aanSlotHistograms;
+        try
+        {
+            aanSlotHistograms.resize(oIter.GetSlotCount() - 1,
+                                     std::vector<GUIntBig>(nBuckets));
+        }
+        catch (const std::bad_alloc &)
+        {
+            ReportError(CE_Failure, CPLE_OutOfMemory,
+                        "Out of memory in GetHistogram()");
+            return CE_Failure;
+        }
 
-            if (poMaskBand &&
-                poMaskBand->RasterIO(GF_Read, iXBlock * nBlockXSize,
-                                     iYBlock * nBlockYSize, nXCheck, nYCheck,
-                                     pabyMaskData, nXCheck, nYCheck, GDT_Byte,
-                                     0, nBlockXSize, nullptr) != CE_None)
-            {
-                CPLFree(pabyMaskData);
-                poBlock->DropLock();
-                return CE_Failure;
-            }
+        const auto ProcessBlock =
+            [this, bSignedByte, dfScale, dfMin, nBuckets, panHistogram,
+             bIncludeOutOfRange, bGotNoDataValue, dfNoDataValue,
+             bGotFloatNoDataValue, fNoDataValue,
+             &aanSlotHistograms](int iSlot, const void *pData,
+                                 const GByte *pabyMaskData, int nXCheck,
+                                 int nYCheck)
+        {
+            GUIntBig *const panSlotHistogram =
+                iSlot == 0 ? panHistogram
+                           : aanSlotHistograms[iSlot - 1].data();
 
             // this is a special case for a common situation.
             if (eDataType == GDT_Byte && !bSignedByte && dfScale == 1.0 &&
@@ -4302,7 +4768,7 @@ CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
             {
                 const GPtrDiff_t nPixels =
                     static_cast<GPtrDiff_t>(nXCheck) * nYCheck;
-                GByte *pabyData = static_cast<GByte *>(pData);
+                const GByte *pabyData = static_cast<const GByte *>(pData);
 
                 for (GPtrDiff_t i = 0; i < nPixels; i++)
                 {
@@ -4311,12 +4777,11 @@ CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
                     if (!(bGotNoDataValue &&
                           (pabyData[i] == static_cast<GByte>(dfNoDataValue))))
                     {
-                        panHistogram[pabyData[i]]++;
+                        panSlotHistogram[pabyData[i]]++;
                     }
                 }
 
-                poBlock->DropLock();
-                continue;  // To next sample block.
+                return true;
             }
 
             // This isn't the fastest way to do this, but is easier for now.
@@ -4337,39 +4802,45 @@ CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
                         case GDT_Byte:
                         {
                             if (bSignedByte)
-                                dfValue =
-                                    static_cast<signed char *>(pData)[iOffset];
+                                dfValue = static_cast<const signed char *>(
+                                    pData)[iOffset];
                             else
-                                dfValue = static_cast<GByte *>(pData)[iOffset];
+                                dfValue =
+                                    static_cast<const GByte *>(pData)[iOffset];
                             break;
                         }
                         case GDT_Int8:
-                            dfValue = static_cast<GInt8 *>(pData)[iOffset];
+                            dfValue =
+                                static_cast<const GInt8 *>(pData)[iOffset];
                             break;
                         case GDT_UInt16:
-                            dfValue = static_cast<GUInt16 *>(pData)[iOffset];
+                            dfValue =
+                                static_cast<const GUInt16 *>(pData)[iOffset];
                             break;
                         case GDT_Int16:
-                            dfValue = static_cast<GInt16 *>(pData)[iOffset];
+                            dfValue =
+                                static_cast<const GInt16 *>(pData)[iOffset];
                             break;
                         case GDT_UInt32:
-                            dfValue = static_cast<GUInt32 *>(pData)[iOffset];
+                            dfValue =
+                                static_cast<const GUInt32 *>(pData)[iOffset];
                             break;
                         case GDT_Int32:
-                            dfValue = static_cast<GInt32 *>(pData)[iOffset];
+                            dfValue =
+                                static_cast<const GInt32 *>(pData)[iOffset];
                             break;
                         case GDT_UInt64:
                             dfValue = static_cast<double>(
-                                static_cast<GUInt64 *>(pData)[iOffset]);
+                                static_cast<const GUInt64 *>(pData)[iOffset]);
                             break;
                         case GDT_Int64:
                             dfValue = static_cast<double>(
-                                static_cast<GInt64 *>(pData)[iOffset]);
+                                static_cast<const GInt64 *>(pData)[iOffset]);
                             break;
                         case GDT_Float32:
                         {
                             const float fValue =
-                                static_cast<float *>(pData)[iOffset];
+                                static_cast<const float *>(pData)[iOffset];
                             if (std::isnan(fValue) ||
                                 (bGotFloatNoDataValue &&
                                  ARE_REAL_EQUAL(fValue, fNoDataValue)))
@@ -4378,34 +4849,35 @@ CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
                             break;
                         }
                         case GDT_Float64:
-                            dfValue = static_cast<double *>(pData)[iOffset];
+                            dfValue =
+                                static_cast<const double *>(pData)[iOffset];
                             if (std::isnan(dfValue))
                                 continue;
                             break;
                         case GDT_CInt16:
                         {
                             double dfReal =
-                                static_cast<GInt16 *>(pData)[iOffset * 2];
-                            double dfImag =
-                                static_cast<GInt16 *>(pData)[iOffset * 2 + 1];
+                                static_cast<const GInt16 *>(pData)[iOffset * 2];
+                            double dfImag = static_cast<const GInt16 *>(
+                                pData)[iOffset * 2 + 1];
                             dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
                         }
                         break;
                         case GDT_CInt32:
                         {
                             double dfReal =
-                                static_cast<GInt32 *>(pData)[iOffset * 2];
-                            double dfImag =
-                                static_cast<GInt32 *>(pData)[iOffset * 2 + 1];
+                                static_cast<const GInt32 *>(pData)[iOffset * 2];
+                            double dfImag = static_cast<const GInt32 *>(
+                                pData)[iOffset * 2 + 1];
                             dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
                         }
                         break;
                         case GDT_CFloat32:
                         {
                             double dfReal =
-                                static_cast<float *>(pData)[iOffset * 2];
-                            double dfImag =
-                                static_cast<float *>(pData)[iOffset * 2 + 1];
+                                static_cast<const float *>(pData)[iOffset * 2];
+                            double dfImag = static_cast<const float *>(
+                                pData)[iOffset * 2 + 1];
                             if (std::isnan(dfReal) || std::isnan(dfImag))
                                 continue;
                             dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
@@ -4414,9 +4886,9 @@ CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
                         case GDT_CFloat64:
                         {
                             double dfReal =
-                                static_cast<double *>(pData)[iOffset * 2];
-                            double dfImag =
-                                static_cast<double *>(pData)[iOffset * 2 + 1];
+                                static_cast<const double *>(pData)[iOffset * 2];
+                            double dfImag = static_cast<const double *>(
+                                pData)[iOffset * 2 + 1];
                             if (std::isnan(dfReal) || std::isnan(dfImag))
                                 continue;
                             dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
@@ -4425,8 +4897,7 @@ CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
                         case GDT_Unknown:
                         case GDT_TypeCount:
                             CPLAssert(false);
-                            CPLFree(pabyMaskData);
-                            return CE_Failure;
+                            return false;
                     }
 
                     if (eDataType != GDT_Float32 && bGotNoDataValue &&
@@ -4441,24 +4912,34 @@ CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
                     if (dfIndex < 0)
                     {
                         if (bIncludeOutOfRange)
-                            panHistogram[0]++;
+                            panSlotHistogram[0]++;
                     }
                     else if (dfIndex >= nBuckets)
                     {
                         if (bIncludeOutOfRange)
-                            ++panHistogram[nBuckets - 1];
+                            ++panSlotHistogram[nBuckets - 1];
                     }
                     else
                     {
-                        ++panHistogram[static_cast<int>(dfIndex)];
+                        ++panSlotHistogram[static_cast<int>(dfIndex)];
                     }
                 }
             }
 
-            poBlock->DropLock();
+            return true;
+        };
+
+        if (!oIter.Run(ProcessBlock, "Compute Histogram", pfnProgress,
+                       pProgressData))
+        {
+            return CE_Failure;
         }
 
-        CPLFree(pabyMaskData);
+        for (const auto &anSlotHistogram : aanSlotHistograms)
+        {
+            for (int i = 0; i < nBuckets; i++)
+                panHistogram[i] += anSlotHistogram[i];
+        }
     }
 
     pfnProgress(1.0, "Compute Histogram", pProgressData);
@@ -6182,6 +6663,12 @@ void GDALRasterBand::SetValidPercent(GUIntBig nSampleCount,
  *
  * Cached statistics can be cleared with GDALDataset::ClearStatistics().
  *
+ * Starting with GDAL 3.11, the GDAL_NUM_THREADS configuration option can be
+ * set to "ALL_CPUS" or a integer value to specify the number of threads to use
+ * for the computation of the statistics. Blocks are also read and decoded by
+ * the worker threads when the dataset is opened in read-only mode and can be
+ * cloned (see GDALGetThreadSafeDataset()).
+ *
  * This method is the same as the C function GDALComputeRasterStatistics().
  *
  * @param bApproxOK If TRUE statistics may be computed based on overviews
@@ -6455,34 +6942,38 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
                     ? static_cast<GUInt32>(dfNoDataValue + 1e-10)
                     : nMaxValueType + 1;
 
-            for (GIntBig iSampleBlock = 0;
-                 iSampleBlock <
-                 static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
-                 iSampleBlock += nSampleRate)
-            {
-                const int iYBlock =
-                    static_cast<int>(iSampleBlock / nBlocksPerRow);
-                const int iXBlock =
-                    static_cast<int>(iSampleBlock % nBlocksPerRow);
-
-                GDALRasterBlock *const poBlock =
-                    GetLockedBlockRef(iXBlock, iYBlock);
-                if (poBlock == nullptr)
-                    return CE_Failure;
-
-                void *const pData = poBlock->GetDataRef();
-
-                int nXCheck = 0, nYCheck = 0;
-                GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
+            GDALSampledBlockIterator oIter(this, nullptr, nSampleRate);
 
+            struct Accumulator
+            {
+                GUInt32 nMin;
+                GUInt32 nMax;
+                GUIntBig nSum;
+                GUIntBig nSumSquare;
+                GUIntBig nSampleCount;
+                GUIntBig nValidCount;
+            };
+
+            std::vector<Accumulator> asAccumulators(
+                oIter.GetSlotCount(),
+                Accumulator{nMaxValueType, 0, 0, 0, 0, 0});
+
+            const auto ProcessBlock =
+                [this, nMaxValueType, nNoDataValue,
+                 &asAccumulators](int iSlot, const void *pData,
+                                  const GByte * /* pabyMask */, int nXCheck,
+                                  int nYCheck)
+            {
+                Accumulator &sAcc = asAccumulators[iSlot];
                 if (eDataType == GDT_Byte)
                 {
                     ComputeStatisticsInternal<
                         GByte, /* COMPUTE_OTHER_STATS = */ true>::
                         f(nXCheck, nBlockXSize, nYCheck,
                           static_cast<const GByte *>(pData),
-                          nNoDataValue <= nMaxValueType, nNoDataValue, nMin,
-                          nMax, nSum, nSumSquare, nSampleCount, nValidCount);
+                          nNoDataValue <= nMaxValueType, nNoDataValue,
+                          sAcc.nMin, sAcc.nMax, sAcc.nSum, sAcc.nSumSquare,
+                          sAcc.nSampleCount, sAcc.nValidCount);
                 }
                 else
                 {
@@ -6490,21 +6981,27 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
                         GUInt16, /* COMPUTE_OTHER_STATS = */ true>::
                         f(nXCheck, nBlockXSize, nYCheck,
                           static_cast<const GUInt16 *>(pData),
-                          nNoDataValue <= nMaxValueType, nNoDataValue, nMin,
-                          nMax, nSum, nSumSquare, nSampleCount, nValidCount);
+                          nNoDataValue <= nMaxValueType, nNoDataValue,
+                          sAcc.nMin, sAcc.nMax, sAcc.nSum, sAcc.nSumSquare,
+                          sAcc.nSampleCount, sAcc.nValidCount);
                 }
+                return true;
+            };
 
-                poBlock->DropLock();
+            if (!oIter.Run(ProcessBlock, "Compute Statistics", pfnProgress,
+                           pProgressData))
+            {
+                return CE_Failure;
+            }
 
-                if (!pfnProgress(static_cast<double>(iSampleBlock) /
-                                     (static_cast<double>(nBlocksPerRow) *
-                                      nBlocksPerColumn),
-                                 "Compute Statistics", pProgressData))
-                {
-                    ReportError(CE_Failure, CPLE_UserInterrupt,
-                                "User terminated");
-                    return CE_Failure;
-                }
+            for (const auto &sAcc : asAccumulators)
+            {
+                nMin = std::min(nMin, sAcc.nMin);
+                nMax = std::max(nMax, sAcc.nMax);
+                nSum += sAcc.nSum;
+                nSumSquare += sAcc.nSumSquare;
+                nSampleCount += sAcc.nSampleCount;
+                nValidCount += sAcc.nValidCount;
             }
 
             if (!pfnProgress(1.0, "Compute Statistics", pProgressData))
@@ -6573,48 +7070,31 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
         }
 #endif
 
-        GByte *pabyMaskData = nullptr;
-        if (poMaskBand)
-        {
-            pabyMaskData = static_cast<GByte *>(
-                VSI_MALLOC2_VERBOSE(nBlockXSize, nBlockYSize));
-            if (!pabyMaskData)
-            {
-                return CE_Failure;
-            }
-        }
+        GDALSampledBlockIterator oIter(this, poMaskBand, nSampleRate);
 
-        for (GIntBig iSampleBlock = 0;
-             iSampleBlock <
-             static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
-             iSampleBlock += nSampleRate)
+        // Partial results of each accumulator slot of the iterator, merged
+        // at the end with the parallel variant of the Welford algorithm.
+        struct Accumulator
         {
-            const int iYBlock = static_cast<int>(iSampleBlock / nBlocksPerRow);
-            const int iXBlock = static_cast<int>(iSampleBlock % nBlocksPerRow);
-
-            GDALRasterBlock *const poBlock =
-                GetLockedBlockRef(iXBlock, iYBlock);
-            if (poBlock == nullptr)
-            {
-                CPLFree(pabyMaskData);
-                return CE_Failure;
-            }
-
-            void *const pData = poBlock->GetDataRef();
-
-            int nXCheck = 0, nYCheck = 0;
-            GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
-
-            if (poMaskBand &&
-                poMaskBand->RasterIO(GF_Read, iXBlock * nBlockXSize,
-                                     iYBlock * nBlockYSize, nXCheck, nYCheck,
-                                     pabyMaskData, nXCheck, nYCheck, GDT_Byte,
-                                     0, nBlockXSize, nullptr) != CE_None)
-            {
-                CPLFree(pabyMaskData);
-                poBlock->DropLock();
-                return CE_Failure;
-            }
+            double dfMin;
+            double dfMax;
+            double dfMean;
+            double dfM2;
+            GUIntBig nSampleCount;
+            GUIntBig nValidCount;
+        };
+
+        std::vector<Accumulator> asAccumulators(
+            oIter.GetSlotCount(), Accumulator{dfMin, dfMax, 0.0, 0.0, 0, 0});
+
+        const auto ProcessBlock =
+            [this, bSignedByte, bGotNoDataValue, dfNoDataValue,
+             bGotFloatNoDataValue, fNoDataValue,
+             &asAccumulators](int iSlot, const void *pData,
+                              const GByte *pabyMaskData, int nXCheck,
+                              int nYCheck)
+        {
+            Accumulator &sAcc = asAccumulators[iSlot];
 
             // This isn't the fastest way to do this, but is easier for now.
             for (int iY = 0; iY < nYCheck; iY++)
@@ -6635,32 +7115,53 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
                     if (!bValid)
                         continue;
 
-                    dfMin = std::min(dfMin, dfValue);
-                    dfMax = std::max(dfMax, dfValue);
+                    sAcc.dfMin = std::min(sAcc.dfMin, dfValue);
+                    sAcc.dfMax = std::max(sAcc.dfMax, dfValue);
 
-                    nValidCount++;
-                    const double dfDelta = dfValue - dfMean;
-                    dfMean += dfDelta / nValidCount;
-                    dfM2 += dfDelta * (dfValue - dfMean);
+                    sAcc.nValidCount++;
+                    const double dfDelta = dfValue - sAcc.dfMean;
+                    sAcc.dfMean += dfDelta / sAcc.nValidCount;
+                    sAcc.dfM2 += dfDelta * (dfValue - sAcc.dfMean);
                 }
             }
 
-            nSampleCount += static_cast<GUIntBig>(nXCheck) * nYCheck;
+            sAcc.nSampleCount += static_cast<GUIntBig>(nXCheck) * nYCheck;
+            return true;
+        };
 
-            poBlock->DropLock();
+        if (!oIter.Run(ProcessBlock, "Compute Statistics", pfnProgress,
+                       pProgressData))
+        {
+            return CE_Failure;
+        }
+
+        for (const auto &sAcc : asAccumulators)
+        {
+            nSampleCount += sAcc.nSampleCount;
+            if (sAcc.nValidCount == 0)
+                continue;
 
-            if (!pfnProgress(
-                    static_cast<double>(iSampleBlock) /
-                        (static_cast<double>(nBlocksPerRow) * nBlocksPerColumn),
-                    "Compute Statistics", pProgressData))
+            dfMin = std::min(dfMin, sAcc.dfMin);
+            dfMax = std::max(dfMax, sAcc.dfMax);
+            if (nValidCount == 0)
             {
-                ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-                CPLFree(pabyMaskData);
-                return CE_Failure;
+                dfMean = sAcc.dfMean;
+                dfM2 = sAcc.dfM2;
+                nValidCount = sAcc.nValidCount;
+            }
+            else
+            {
+                const GUIntBig nNewValidCount = nValidCount + sAcc.nValidCount;
+                const double dfDelta = sAcc.dfMean - dfMean;
+                const double dfWeight =
+                    static_cast<double>(sAcc.nValidCount) / nNewValidCount;
+                dfMean += dfDelta * dfWeight;
+                dfM2 += sAcc.dfM2 + dfDelta * dfDelta *
+                                        static_cast<double>(nValidCount) *
+                                        dfWeight;
+                nValidCount = nNewValidCount;
             }
         }
-
-        CPLFree(pabyMaskData);
     }
 
     if (!pfnProgress(1.0, "Compute Statistics", pProgressData))
@@ -6988,64 +7489,41 @@ static void ComputeMinMaxGeneric(const void *pData, GDALDataType eDataType,
 
 static bool ComputeMinMaxGenericIterBlocks(
     GDALRasterBand *poBand, GDALDataType eDataType, bool bSignedByte,
-    GIntBig nTotalBlocks, int nSampleRate, int nBlocksPerRow,
-    bool bGotNoDataValue, double dfNoDataValue, bool bGotFloatNoDataValue,
-    float fNoDataValue, GDALRasterBand *poMaskBand, double &dfMin,
-    double &dfMax)
+    int nSampleRate, bool bGotNoDataValue, double dfNoDataValue,
+    bool bGotFloatNoDataValue, float fNoDataValue, GDALRasterBand *poMaskBand,
+    double &dfMin, double &dfMax)
 
 {
-    GByte *pabyMaskData = nullptr;
     int nBlockXSize, nBlockYSize;
     poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
 
-    if (poMaskBand)
-    {
-        pabyMaskData =
-            static_cast<GByte *>(VSI_MALLOC2_VERBOSE(nBlockXSize, nBlockYSize));
-        if (!pabyMaskData)
-        {
-            return false;
-        }
-    }
+    GDALSampledBlockIterator oIter(poBand, poMaskBand, nSampleRate);
 
-    for (GIntBig iSampleBlock = 0; iSampleBlock < nTotalBlocks;
-         iSampleBlock += nSampleRate)
-    {
-        const int iYBlock = static_cast<int>(iSampleBlock / nBlocksPerRow);
-        const int iXBlock = static_cast<int>(iSampleBlock % nBlocksPerRow);
-
-        GDALRasterBlock *poBlock = poBand->GetLockedBlockRef(iXBlock, iYBlock);
-        if (poBlock == nullptr)
-        {
-            CPLFree(pabyMaskData);
-            return false;
-        }
-
-        void *const pData = poBlock->GetDataRef();
-
-        int nXCheck = 0, nYCheck = 0;
-        poBand->GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
-
-        if (poMaskBand &&
-            poMaskBand->RasterIO(GF_Read, iXBlock * nBlockXSize,
-                                 iYBlock * nBlockYSize, nXCheck, nYCheck,
-                                 pabyMaskData, nXCheck, nYCheck, GDT_Byte, 0,
-                                 nBlockXSize, nullptr) != CE_None)
-        {
-            poBlock->DropLock();
-            CPLFree(pabyMaskData);
-            return false;
-        }
+    // Per-slot min/max, merged at the end
+    std::vector<std::pair<double, double>> aoMinMax(oIter.GetSlotCount(),
+                                                    {dfMin, dfMax});
 
+    const auto ProcessBlock =
+        [eDataType, bSignedByte, nBlockXSize, bGotNoDataValue, dfNoDataValue,
+         bGotFloatNoDataValue, fNoDataValue,
+         &aoMinMax](int iSlot, const void *pData, const GByte *pabyMaskData,
+                    int nXCheck, int nYCheck)
+    {
         ComputeMinMaxGeneric(pData, eDataType, bSignedByte, nXCheck, nYCheck,
-                             nBlockXSize, CPL_TO_BOOL(bGotNoDataValue),
-                             dfNoDataValue, bGotFloatNoDataValue, fNoDataValue,
-                             pabyMaskData, dfMin, dfMax);
+                             nBlockXSize, bGotNoDataValue, dfNoDataValue,
+                             bGotFloatNoDataValue, fNoDataValue, pabyMaskData,
+                             aoMinMax[iSlot].first, aoMinMax[iSlot].second);
+        return true;
+    };
 
-        poBlock->DropLock();
-    }
+    if (!oIter.Run(ProcessBlock, nullptr, nullptr, nullptr))
+        return false;
 
-    CPLFree(pabyMaskData);
+    for (const auto &oMinMax : aoMinMax)
+    {
+        dfMin = std::min(dfMin, oMinMax.first);
+        dfMax = std::max(dfMax, oMinMax.second);
+    }
     return true;
 }
 
@@ -7060,6 +7538,12 @@ static bool ComputeMinMaxGenericIterBlocks(
  * If bApprox is FALSE, then all pixels will be read and used to compute
  * an exact range.
  *
+ * Starting with GDAL 3.11, the GDAL_NUM_THREADS configuration option can be
+ * set to "ALL_CPUS" or a integer value to specify the number of threads to use
+ * for the computation of the minimum and maximum. Blocks are also read and
+ * decoded by the worker threads when the dataset is opened in read-only mode
+ * and can be cloned (see GDALGetThreadSafeDataset()).
+ *
  * This method is the same as the C function GDALComputeRasterMinMax().
  *
  * @param bApproxOK TRUE if an approximate (faster) answer is OK, otherwise
@@ -7157,9 +7641,10 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                         eDataType == GDT_Int16 || eDataType == GDT_UInt16);
 
     const auto ComputeMinMaxForBlock =
-        [this, bSignedByte, bGotNoDataValue, dfNoDataValue, &nMin, &nMax,
-         &nMinInt16, &nMaxInt16](const void *pData, int nXCheck,
-                                 int nBufferWidth, int nYCheck)
+        [this, bSignedByte, bGotNoDataValue,
+         dfNoDataValue](const void *pData, int nXCheck, int nBufferWidth,
+                        int nYCheck, GUInt32 &nLocalMin, GUInt32 &nLocalMax,
+                        GInt16 &nLocalMinInt16, GInt16 &nLocalMaxInt16)
     {
         if (eDataType == GDT_Byte && !bSignedByte)
         {
@@ -7173,7 +7658,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                                       /* COMPUTE_OTHER_STATS = */ false>::
                 f(nXCheck, nBufferWidth, nYCheck,
                   static_cast<const GByte *>(pData), bHasNoData, nNoDataValue,
-                  nMin, nMax, nSum, nSumSquare, nSampleCount, nValidCount);
+                  nLocalMin, nLocalMax, nSum, nSumSquare, nSampleCount,
+                  nValidCount);
         }
         else if (eDataType == GDT_UInt16)
         {
@@ -7187,7 +7673,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                                       /* COMPUTE_OTHER_STATS = */ false>::
                 f(nXCheck, nBufferWidth, nYCheck,
                   static_cast<const GUInt16 *>(pData), bHasNoData, nNoDataValue,
-                  nMin, nMax, nSum, nSumSquare, nSampleCount, nValidCount);
+                  nLocalMin, nLocalMax, nSum, nSumSquare, nSampleCount,
+                  nValidCount);
         }
         else if (eDataType == GDT_Int16)
         {
@@ -7203,7 +7690,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                     ComputeMinMax<int16_t, true>(
                         static_cast<const int16_t *>(pData) +
                             static_cast<size_t>(iY) * nBufferWidth,
-                        nXCheck, nNoDataValue, &nMinInt16, &nMaxInt16);
+                        nXCheck, nNoDataValue, &nLocalMinInt16,
+                        &nLocalMaxInt16);
                 }
             }
             else
@@ -7213,7 +7701,7 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                     ComputeMinMax<int16_t, false>(
                         static_cast<const int16_t *>(pData) +
                             static_cast<size_t>(iY) * nBufferWidth,
-                        nXCheck, 0, &nMinInt16, &nMaxInt16);
+                        nXCheck, 0, &nLocalMinInt16, &nLocalMaxInt16);
                 }
             }
         }
@@ -7279,7 +7767,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
 
         if (bUseOptimizedPath)
         {
-            ComputeMinMaxForBlock(pData, nXReduced, nXReduced, nYReduced);
+            ComputeMinMaxForBlock(pData, nXReduced, nXReduced, nYReduced, nMin,
+                                  nMax, nMinInt16, nMaxInt16);
         }
         else
         {
@@ -7320,41 +7809,52 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
 
         if (bUseOptimizedPath)
         {
-            for (GIntBig iSampleBlock = 0;
-                 iSampleBlock <
-                 static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
-                 iSampleBlock += nSampleRate)
-            {
-                const int iYBlock =
-                    static_cast<int>(iSampleBlock / nBlocksPerRow);
-                const int iXBlock =
-                    static_cast<int>(iSampleBlock % nBlocksPerRow);
+            GDALSampledBlockIterator oIter(this, nullptr, nSampleRate);
 
-                GDALRasterBlock *poBlock = GetLockedBlockRef(iXBlock, iYBlock);
-                if (poBlock == nullptr)
-                    return CE_Failure;
-
-                void *const pData = poBlock->GetDataRef();
-
-                int nXCheck = 0, nYCheck = 0;
-                GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
+            struct Accumulator
+            {
+                GUInt32 nMin;
+                GUInt32 nMax;
+                GInt16 nMinInt16;
+                GInt16 nMaxInt16;
+            };
+
+            std::vector<Accumulator> asAccumulators(
+                oIter.GetSlotCount(),
+                Accumulator{nMin, nMax, nMinInt16, nMaxInt16});
+
+            const auto ProcessBlock =
+                [this, bSignedByte, &ComputeMinMaxForBlock,
+                 &asAccumulators](int iSlot, const void *pData,
+                                  const GByte * /* pabyMask */, int nXCheck,
+                                  int nYCheck)
+            {
+                Accumulator &sAcc = asAccumulators[iSlot];
+                ComputeMinMaxForBlock(pData, nXCheck, nBlockXSize, nYCheck,
+                                      sAcc.nMin, sAcc.nMax, sAcc.nMinInt16,
+                                      sAcc.nMaxInt16);
 
-                ComputeMinMaxForBlock(pData, nXCheck, nBlockXSize, nYCheck);
+                // Stop as soon as the full range of Byte has been found
+                return !(eDataType == GDT_Byte && !bSignedByte &&
+                         sAcc.nMin == 0 && sAcc.nMax == 255);
+            };
 
-                poBlock->DropLock();
+            if (!oIter.Run(ProcessBlock, nullptr, nullptr, nullptr))
+                return CE_Failure;
 
-                if (eDataType == GDT_Byte && !bSignedByte && nMin == 0 &&
-                    nMax == 255)
-                    break;
+            for (const auto &sAcc : asAccumulators)
+            {
+                nMin = std::min(nMin, sAcc.nMin);
+                nMax = std::max(nMax, sAcc.nMax);
+                nMinInt16 = std::min(nMinInt16, sAcc.nMinInt16);
+                nMaxInt16 = std::max(nMaxInt16, sAcc.nMaxInt16);
             }
         }
         else
         {
-            const GIntBig nTotalBlocks =
-                static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
             if (!ComputeMinMaxGenericIterBlocks(
-                    this, eDataType, bSignedByte, nTotalBlocks, nSampleRate,
-                    nBlocksPerRow, CPL_TO_BOOL(bGotNoDataValue), dfNoDataValue,
+                    this, eDataType, bSignedByte, nSampleRate,
+                    CPL_TO_BOOL(bGotNoDataValue), dfNoDataValue,
                     bGotFloatNoDataValue, fNoDataValue, poMaskBand, dfMin,
                     dfMax))
             {
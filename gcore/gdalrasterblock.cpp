@@ -17,7 +17,9 @@
 #include "gdal_priv.h"
 
 #include <algorithm>
+#include <chrono>
 #include <climits>
+#include <cstdio>
 #include <cstring>
 #include <mutex>
 
@@ -37,6 +39,18 @@ static GDALRasterBlock *poNewest = nullptr;  // Head.
 
 static int nDisableDirtyBlockFlushCounter = 0;
 
+// GDAL_BLOCK_CACHE_POLICY=CLOCK: Touch() only flags the block as recently
+// used, and eviction scans move flagged blocks to the newest end instead of
+// evicting them. Cache hits then no longer need hRBLock.
+static bool bClockPolicy = false;
+
+// GDAL_CACHE_STATISTICS=YES or DUMP: collect the counters returned by
+// GDALGetCacheStatistics(). With DUMP, they are also emitted as a debug
+// message when the driver manager is destroyed.
+static bool bCollectStatistics = false;
+static bool bDumpStatistics = false;
+static GDALBlockCacheCounters gsCounters;
+
 #if 0
 static CPLMutex *hRBLock = nullptr;
 #define INITIALIZE_LOCK CPLMutexHolderD(&hRBLock)
@@ -75,16 +89,64 @@ static CPLLockType GetLockType()
     return static_cast<CPLLockType>(nLockType);
 }
 
+namespace
+{
+// Measures the time spent waiting for hRBLock, when statistics are collected
+class GDALRBLockWaitTimer
+{
+    const bool m_bActive = bCollectStatistics;
+    std::chrono::steady_clock::time_point m_oStart{};
+
+  public:
+    GDALRBLockWaitTimer()
+    {
+        if (m_bActive)
+            m_oStart = std::chrono::steady_clock::now();
+    }
+
+    void Stop()
+    {
+        if (m_bActive)
+        {
+            gsCounters.nLockWaitNanoSec.fetch_add(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - m_oStart)
+                    .count(),
+                std::memory_order_relaxed);
+        }
+    }
+};
+}  // namespace
+
 #define INITIALIZE_LOCK                                                        \
+    GDALRBLockWaitTimer oLockWaitTimer;                                        \
     CPLLockHolderD(&hRBLock, GetLockType());                                   \
+    oLockWaitTimer.Stop();                                                     \
     CPLLockSetDebugPerf(hRBLock, bDebugContention)
-#define TAKE_LOCK CPLLockHolderOptionalLockD(hRBLock)
+#define TAKE_LOCK                                                              \
+    GDALRBLockWaitTimer oLockWaitTimer;                                        \
+    CPLLockHolderOptionalLockD(hRBLock);                                       \
+    oLockWaitTimer.Stop()
 #define DESTROY_LOCK CPLDestroyLock(hRBLock)
 
 #endif
 
 // #define ENABLE_DEBUG
 
+/************************************************************************/
+/*                           RecordEviction()                           */
+/************************************************************************/
+
+static void RecordEviction(GDALAbstractBandBlockCache *poBandBlockCache)
+{
+    if (!bCollectStatistics)
+        return;
+    gsCounters.nEvictions.fetch_add(1, std::memory_order_relaxed);
+    if (poBandBlockCache)
+        poBandBlockCache->m_oCounters.nEvictions.fetch_add(
+            1, std::memory_order_relaxed);
+}
+
 /************************************************************************/
 /*                          GDALSetCacheMax()                           */
 /************************************************************************/
@@ -232,6 +294,26 @@ GIntBig CPL_STDCALL GDALGetCacheMax64()
             bSleepsForBockCacheDebug =
                 CPLTestBool(CPLGetConfigOption("GDAL_DEBUG_BLOCK_CACHE", "NO"));
 
+            const char *pszStatistics =
+                CPLGetConfigOption("GDAL_CACHE_STATISTICS", "NO");
+            bDumpStatistics = EQUAL(pszStatistics, "DUMP");
+            bCollectStatistics =
+                bDumpStatistics || CPLTestBool(pszStatistics);
+
+            const char *pszPolicy =
+                CPLGetConfigOption("GDAL_BLOCK_CACHE_POLICY", "LRU");
+            if (EQUAL(pszPolicy, "CLOCK"))
+                bClockPolicy = true;
+            else if (!EQUAL(pszPolicy, "LRU"))
+            {
+                CPLError(CE_Warning, CPLE_NotSupported,
+                         "GDAL_BLOCK_CACHE_POLICY=%s not supported. "
+                         "Falling back to LRU",
+                         pszPolicy);
+            }
+
+            GDALRasterBlock::InitCompressedCache();
+
             const char *pszCacheMax = CPLGetConfigOption("GDAL_CACHEMAX", "5%");
             GIntBig nNewCacheMax;
             bool bUnitSpecified = false;
@@ -332,6 +414,98 @@ int CPL_STDCALL GDALFlushCacheBlock()
     return GDALRasterBlock::FlushCacheBlock();
 }
 
+/************************************************************************/
+/*                       GDALGetCacheStatistics()                       */
+/************************************************************************/
+
+/**
+ * \brief Get statistics of the raster block cache.
+ *
+ * Statistics are only collected when the GDAL_CACHE_STATISTICS configuration
+ * option is set to YES or DUMP before the cache is first used. Otherwise all
+ * values are zero.
+ *
+ * @param psStats Structure to fill. Must not be NULL.
+ *
+ * @since GDAL 3.11
+ */
+
+void GDALGetCacheStatistics(GDALCacheStatistics *psStats)
+{
+    VALIDATE_POINTER0(psStats, "GDALGetCacheStatistics");
+    memset(psStats, 0, sizeof(*psStats));
+    gsCounters.AddTo(psStats);
+}
+
+/************************************************************************/
+/*                      GDALResetCacheStatistics()                      */
+/************************************************************************/
+
+/**
+ * \brief Reset the statistics returned by GDALGetCacheStatistics().
+ *
+ * Statistics of individual bands are not reset.
+ *
+ * @since GDAL 3.11
+ */
+
+void GDALResetCacheStatistics()
+{
+    gsCounters.Reset();
+}
+
+/************************************************************************/
+/*                  GDALGetRasterBandCacheStatistics()                  */
+/************************************************************************/
+
+/**
+ * \brief Get statistics of the raster block cache for a band.
+ *
+ * Statistics are only collected when the GDAL_CACHE_STATISTICS configuration
+ * option is set to YES or DUMP. The lock wait time is not available per band.
+ *
+ * @param hBand Band.
+ * @param psStats Structure to fill. Must not be NULL.
+ *
+ * @since GDAL 3.11
+ */
+
+void GDALGetRasterBandCacheStatistics(GDALRasterBandH hBand,
+                                      GDALCacheStatistics *psStats)
+{
+    VALIDATE_POINTER0(hBand, "GDALGetRasterBandCacheStatistics");
+    VALIDATE_POINTER0(psStats, "GDALGetRasterBandCacheStatistics");
+    memset(psStats, 0, sizeof(*psStats));
+    GDALRasterBlock::AddBandStatistics(GDALRasterBand::FromHandle(hBand),
+                                       psStats);
+}
+
+/************************************************************************/
+/*                   GDALDatasetGetCacheStatistics()                    */
+/************************************************************************/
+
+/**
+ * \brief Get statistics of the raster block cache for a dataset.
+ *
+ * This is the sum of the statistics of its bands, as returned by
+ * GDALGetRasterBandCacheStatistics(). Masks and overviews are not included.
+ *
+ * @param hDS Dataset.
+ * @param psStats Structure to fill. Must not be NULL.
+ *
+ * @since GDAL 3.11
+ */
+
+void GDALDatasetGetCacheStatistics(GDALDatasetH hDS,
+                                   GDALCacheStatistics *psStats)
+{
+    VALIDATE_POINTER0(hDS, "GDALDatasetGetCacheStatistics");
+    VALIDATE_POINTER0(psStats, "GDALDatasetGetCacheStatistics");
+    memset(psStats, 0, sizeof(*psStats));
+    for (auto *poBand : GDALDataset::FromHandle(hDS)->GetBands())
+        GDALRasterBlock::AddBandStatistics(poBand, psStats);
+}
+
 /************************************************************************/
 /* ==================================================================== */
 /*                           GDALRasterBlock                            */
@@ -389,20 +563,38 @@ int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
 
 {
     GDALRasterBlock *poTarget;
+    // Retrieved before the block is detached, so that the compressed cache
+    // can tell if its band has been written in the meantime.
+    GUInt64 nCompressedCacheGeneration = 0;
+    RefreshCompressedCache();
 
     {
         INITIALIZE_LOCK;
         poTarget = poOldest;
 
+        // Stop giving second chances once we are back to the first block
+        // that got one.
+        GDALRasterBlock *poFirstSecondChance = nullptr;
+        bool bSecondChances = !bDirtyBlocksOnly;
         while (poTarget != nullptr)
         {
+            GDALRasterBlock *poPrevious = poTarget->poPrevious;
+            if (poTarget == poFirstSecondChance)
+                bSecondChances = false;
+            if (bSecondChances && poTarget->GiveSecondChance_unlocked())
+            {
+                if (poFirstSecondChance == nullptr)
+                    poFirstSecondChance = poTarget;
+                poTarget = poPrevious;
+                continue;
+            }
             if (!bDirtyBlocksOnly ||
                 (poTarget->GetDirty() && nDisableDirtyBlockFlushCounter == 0))
             {
                 if (CPLAtomicCompareAndExchange(&(poTarget->nLockCount), 0, -1))
                     break;
             }
-            poTarget = poTarget->poPrevious;
+            poTarget = poPrevious;
         }
 
         if (poTarget == nullptr)
@@ -416,8 +608,11 @@ int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
                 CPLSleep(dfDelay);
         }
 
+        if (!poTarget->GetDirty())
+            nCompressedCacheGeneration = GetCompressedCacheGeneration();
         poTarget->Detach_unlocked();
         poTarget->GetBand()->UnreferenceBlock(poTarget);
+        RecordEviction(poTarget->GetBand()->poBandBlockCache);
     }
 
     if (bSleepsForBockCacheDebug)
@@ -438,6 +633,10 @@ int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
             poTarget->GetBand()->SetFlushBlockErr(eErr);
         }
     }
+    else
+    {
+        StoreCompressed(poTarget, nCompressedCacheGeneration);
+    }
 
     VSIFreeAligned(poTarget->pData);
     poTarget->pData = nullptr;
@@ -539,7 +738,8 @@ GDALRasterBlock::GDALRasterBlock(GDALRasterBand *poBandIn, int nXOffIn,
                                  int nYOffIn)
     : eType(poBandIn->GetRasterDataType()), bDirty(false), nLockCount(0),
       nXOff(nXOffIn), nYOff(nYOffIn), nXSize(0), nYSize(0), pData(nullptr),
-      poBand(poBandIn), poNext(nullptr), poPrevious(nullptr), bMustDetach(true)
+      poBand(poBandIn), poNext(nullptr), poPrevious(nullptr), bMustDetach(true),
+      nRecentlyUsed(0)
 {
     CPLAssert(poBandIn != nullptr);
     poBand->GetBlockSize(&nXSize, &nYSize);
@@ -566,7 +766,8 @@ GDALRasterBlock::GDALRasterBlock(GDALRasterBand *poBandIn, int nXOffIn,
 GDALRasterBlock::GDALRasterBlock(int nXOffIn, int nYOffIn)
     : eType(GDT_Unknown), bDirty(false), nLockCount(0), nXOff(nXOffIn),
       nYOff(nYOffIn), nXSize(0), nYSize(0), pData(nullptr), poBand(nullptr),
-      poNext(nullptr), poPrevious(nullptr), bMustDetach(false)
+      poNext(nullptr), poPrevious(nullptr), bMustDetach(false),
+      nRecentlyUsed(0)
 {
 }
 
@@ -593,6 +794,7 @@ void GDALRasterBlock::RecycleFor(int nXOffIn, int nYOffIn)
     nXOff = nXOffIn;
     nYOff = nYOffIn;
     bMustDetach = true;
+    nRecentlyUsed = 0;
 }
 
 /************************************************************************/
@@ -781,6 +983,18 @@ CPLErr GDALRasterBlock::Write()
 
     MarkClean();
 
+    // A stale copy may have been stored by a concurrent eviction of the
+    // block before it was modified.
+    DropCompressed(poBand, nXOff, nYOff);
+
+    if (bCollectStatistics)
+    {
+        gsCounters.nDirtyFlushes.fetch_add(1, std::memory_order_relaxed);
+        if (poBand->poBandBlockCache)
+            poBand->poBandBlockCache->m_oCounters.nDirtyFlushes.fetch_add(
+                1, std::memory_order_relaxed);
+    }
+
     if (poBand->eFlushBlockErr == CE_None)
     {
         int bCallLeaveReadWrite = poBand->EnterReadWrite(GF_Write);
@@ -807,6 +1021,16 @@ CPLErr GDALRasterBlock::Write()
 void GDALRasterBlock::Touch()
 
 {
+    // With the CLOCK policy, the block is only moved at the next eviction
+    // scan. Avoid writing the flag when already set, to keep the cache line
+    // shared between threads.
+    if (bClockPolicy)
+    {
+        if (!nRecentlyUsed)
+            nRecentlyUsed = 1;
+        return;
+    }
+
     // Can be safely tested outside the lock
     if (poNewest == this)
         return;
@@ -860,6 +1084,27 @@ void GDALRasterBlock::Touch_unlocked()
 #endif
 }
 
+/************************************************************************/
+/*                     GiveSecondChance_unlocked()                      */
+/************************************************************************/
+
+/**
+ * With the CLOCK policy, spare a block found by an eviction scan if it has
+ * been used since the previous scan: clear its flag and move it to the
+ * newest end of the list.
+ *
+ * @return true if the block must not be evicted.
+ */
+
+bool GDALRasterBlock::GiveSecondChance_unlocked()
+{
+    if (!bClockPolicy || !nRecentlyUsed)
+        return false;
+    nRecentlyUsed = 0;
+    Touch_unlocked();
+    return true;
+}
+
 /************************************************************************/
 /*                            Internalize()                             */
 /************************************************************************/
@@ -895,17 +1140,24 @@ CPLErr GDALRasterBlock::Internalize()
     bool bFirstIter = true;
     bool bLoopAgain = false;
     GDALDataset *poThisDS = poBand->GetDataset();
+    RefreshCompressedCache();
     do
     {
         bLoopAgain = false;
         GDALRasterBlock *apoBlocksToFree[64] = {nullptr};
         int nBlocksToFree = 0;
+        // Retrieved before the first clean block is detached, so that the
+        // compressed cache can tell if its band has been written since.
+        bool bGotCompressedCacheGeneration = false;
+        GUInt64 nCompressedCacheGeneration = 0;
         {
             TAKE_LOCK;
 
             if (bFirstIter)
                 nCacheUsed += GetEffectiveBlockSize(nSizeInBytes);
             GDALRasterBlock *poTarget = poOldest;
+            GDALRasterBlock *poFirstSecondChance = nullptr;
+            bool bSecondChances = true;
             while (nCacheUsed > nCurCacheMax)
             {
                 GDALRasterBlock *poDirtyBlockOtherDataset = nullptr;
@@ -920,6 +1172,20 @@ CPLErr GDALRasterBlock::Internalize()
                 //    so gets the old value.
                 while (poTarget != nullptr)
                 {
+                    if (poTarget == poFirstSecondChance)
+                        bSecondChances = false;
+                    if (bSecondChances)
+                    {
+                        GDALRasterBlock *poPreviousBlock =
+                            poTarget->poPrevious;
+                        if (poTarget->GiveSecondChance_unlocked())
+                        {
+                            if (poFirstSecondChance == nullptr)
+                                poFirstSecondChance = poTarget;
+                            poTarget = poPreviousBlock;
+                            continue;
+                        }
+                    }
                     if (!poTarget->GetDirty())
                     {
                         if (CPLAtomicCompareAndExchange(&(poTarget->nLockCount),
@@ -981,8 +1247,16 @@ CPLErr GDALRasterBlock::Internalize()
 
                     GDALRasterBlock *_poPrevious = poTarget->poPrevious;
 
+                    if (!bGotCompressedCacheGeneration &&
+                        !poTarget->GetDirty())
+                    {
+                        nCompressedCacheGeneration =
+                            GetCompressedCacheGeneration();
+                        bGotCompressedCacheGeneration = true;
+                    }
                     poTarget->Detach_unlocked();
                     poTarget->GetBand()->UnreferenceBlock(poTarget);
+                    RecordEviction(poTarget->GetBand()->poBandBlockCache);
 
                     apoBlocksToFree[nBlocksToFree++] = poTarget;
                     if (poTarget->GetDirty())
@@ -1042,6 +1316,10 @@ CPLErr GDALRasterBlock::Internalize()
                     poBlock->GetBand()->SetFlushBlockErr(eErr);
                 }
             }
+            else
+            {
+                StoreCompressed(poBlock, nCompressedCacheGeneration);
+            }
 
             // Try to recycle the data of an existing block.
             void *pDataBlock = poBlock->pData;
@@ -1091,7 +1369,10 @@ void GDALRasterBlock::MarkDirty()
     {
         poBand->InitRWLock();
         if (!bDirty)
+        {
             poBand->IncDirtyBlocks(1);
+            DropCompressed(poBand, nXOff, nYOff);
+        }
     }
     bDirty = true;
 }
@@ -1114,6 +1395,30 @@ void GDALRasterBlock::MarkClean()
     bDirty = false;
 }
 
+/************************************************************************/
+/*                           DumpStatistics()                           */
+/************************************************************************/
+
+static void DumpStatistics()
+{
+    GDALCacheStatistics sStats;
+    GDALGetCacheStatistics(&sStats);
+    const GIntBig nRequests = sStats.nHits + sStats.nMisses;
+    CPLDebug("GDAL",
+             "Block cache statistics: GDAL_CACHEMAX=" CPL_FRMT_GIB
+             " bytes, hits=" CPL_FRMT_GIB " (%.1f%%), misses=" CPL_FRMT_GIB
+             ", bytes read=" CPL_FRMT_GIB ", evictions=" CPL_FRMT_GIB
+             ", dirty flushes=" CPL_FRMT_GIB ", lock wait time=%.3f s"
+             ", compressed cache hits=" CPL_FRMT_GIB,
+             nCacheMax, sStats.nHits,
+             nRequests ? 100.0 * static_cast<double>(sStats.nHits) /
+                             static_cast<double>(nRequests)
+                       : 0.0,
+             sStats.nMisses, sStats.nBytesRead, sStats.nEvictions,
+             sStats.nDirtyFlushes, sStats.dfLockWaitTime,
+             sStats.nCompressedHits);
+}
+
 /************************************************************************/
 /*                          DestroyRBMutex()                           */
 /************************************************************************/
@@ -1121,11 +1426,96 @@ void GDALRasterBlock::MarkClean()
 /*! @cond Doxygen_Suppress */
 void GDALRasterBlock::DestroyRBMutex()
 {
+    if (bDumpStatistics)
+        DumpStatistics();
+
+    DestroyCompressedCache();
+
     if (hRBLock != nullptr)
         DESTROY_LOCK;
     hRBLock = nullptr;
 }
 
+/************************************************************************/
+/*                             RecordHit()                              */
+/************************************************************************/
+
+void GDALRasterBlock::RecordHit(GDALRasterBand *poBand)
+{
+    if (!bCollectStatistics)
+        return;
+    gsCounters.nHits.fetch_add(1, std::memory_order_relaxed);
+    if (poBand->poBandBlockCache)
+        poBand->poBandBlockCache->m_oCounters.nHits.fetch_add(
+            1, std::memory_order_relaxed);
+}
+
+/************************************************************************/
+/*                             RecordMiss()                             */
+/************************************************************************/
+
+void GDALRasterBlock::RecordMiss(GDALRasterBand *poBand, GIntBig nBytesRead,
+                                 bool bFromCompressedCache)
+{
+    if (!bCollectStatistics)
+        return;
+    gsCounters.nMisses.fetch_add(1, std::memory_order_relaxed);
+    gsCounters.nBytesRead.fetch_add(nBytesRead, std::memory_order_relaxed);
+    if (bFromCompressedCache)
+        gsCounters.nCompressedHits.fetch_add(1, std::memory_order_relaxed);
+    if (poBand->poBandBlockCache)
+    {
+        auto &oCounters = poBand->poBandBlockCache->m_oCounters;
+        oCounters.nMisses.fetch_add(1, std::memory_order_relaxed);
+        oCounters.nBytesRead.fetch_add(nBytesRead, std::memory_order_relaxed);
+        if (bFromCompressedCache)
+            oCounters.nCompressedHits.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+/************************************************************************/
+/*                         AddBandStatistics()                          */
+/************************************************************************/
+
+void GDALRasterBlock::AddBandStatistics(GDALRasterBand *poBand,
+                                        GDALCacheStatistics *psStats)
+{
+    if (poBand->poBandBlockCache)
+        poBand->poBandBlockCache->m_oCounters.AddTo(psStats);
+}
+
+/************************************************************************/
+/*                    GDALBlockCacheCounters::Reset()                   */
+/************************************************************************/
+
+void GDALBlockCacheCounters::Reset()
+{
+    nHits = 0;
+    nMisses = 0;
+    nBytesRead = 0;
+    nEvictions = 0;
+    nDirtyFlushes = 0;
+    nLockWaitNanoSec = 0;
+    nCompressedHits = 0;
+}
+
+/************************************************************************/
+/*                    GDALBlockCacheCounters::AddTo()                   */
+/************************************************************************/
+
+void GDALBlockCacheCounters::AddTo(GDALCacheStatistics *psStats) const
+{
+    psStats->nHits += nHits.load(std::memory_order_relaxed);
+    psStats->nMisses += nMisses.load(std::memory_order_relaxed);
+    psStats->nBytesRead += nBytesRead.load(std::memory_order_relaxed);
+    psStats->nEvictions += nEvictions.load(std::memory_order_relaxed);
+    psStats->nDirtyFlushes += nDirtyFlushes.load(std::memory_order_relaxed);
+    psStats->dfLockWaitTime +=
+        static_cast<double>(nLockWaitNanoSec.load(std::memory_order_relaxed)) *
+        1e-9;
+    psStats->nCompressedHits += nCompressedHits.load(std::memory_order_relaxed);
+}
+
 /*! @endcond */
 
 /************************************************************************/
@@ -17,10 +17,15 @@
 #include "gdal_rat.h"
 #include "gdal_priv.h"
 
+#include <algorithm>
+#include <condition_variable>
+#include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <thread>
+#include <utility>
 #include <vector>
 
 /** Design notes of this file.
@@ -54,7 +59,8 @@ class GDALThreadLocalDatasetCache
     /** Least-recently-used based cache that maps a GDALThreadSafeDataset*
      * instance to the corresponding per-thread dataset.
      * It should be noted as this a LRU cache, entries might get evicted when
-     * its capacity is reached (64 datasets), which might be undesirable.
+     * its capacity is reached (GDAL_THREAD_SAFE_DATASET_CACHE_SIZE datasets,
+     * 64 by default), which might be undesirable.
      * Hence it is doubled with m_oMapReferencedDS for datasets that are in
      * active used by a thread.
      *
@@ -73,6 +79,8 @@ class GDALThreadLocalDatasetCache
     GDALThreadLocalDatasetCache &
     operator=(const GDALThreadLocalDatasetCache &) = delete;
 
+    static size_t GetMaxSize();
+
   public:
     GDALThreadLocalDatasetCache();
     ~GDALThreadLocalDatasetCache();
@@ -227,6 +235,13 @@ class GDALThreadSafeDataset final : public GDALProxyDataset
     }
 
   protected:
+    CPLErr IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff, int nXSize,
+                     int nYSize, void *pData, int nBufXSize, int nBufYSize,
+                     GDALDataType eBufType, int nBandCount,
+                     BANDMAP_TYPE panBandMap, GSpacing nPixelSpace,
+                     GSpacing nLineSpace, GSpacing nBandSpace,
+                     GDALRasterIOExtraArg *psExtraArg) override;
+
     GDALDataset *RefUnderlyingDataset() const override;
 
     void
@@ -263,6 +278,12 @@ class GDALThreadSafeDataset final : public GDALProxyDataset
     /** Cached value returned by GetGCPSpatialRef() */
     mutable OGRSpatialReference m_oGCPSRS{};
 
+    /** Whether blocks decoded by a thread-local dataset are shared with the
+     * other threads, through the block cache of GDALThreadSafeRasterBand
+     * (GDAL_THREAD_SAFE_DATASET_SHARE_BLOCKS configuration option).
+     */
+    const bool m_bShareBlocks;
+
     /** Structure that references all GDALThreadLocalDatasetCache* instances.
      */
     struct GlobalCache
@@ -373,15 +394,44 @@ class GDALThreadSafeRasterBand final : public GDALProxyRasterBand
     }
 
   protected:
+    CPLErr IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff, int nXSize,
+                     int nYSize, void *pData, int nBufXSize, int nBufYSize,
+                     GDALDataType eBufType, GSpacing nPixelSpace,
+                     GSpacing nLineSpace,
+                     GDALRasterIOExtraArg *psExtraArg) override;
+
     GDALRasterBand *RefUnderlyingRasterBand(bool bForceOpen) const override;
     void UnrefUnderlyingRasterBand(
         GDALRasterBand *poUnderlyingRasterBand) const override;
 
   private:
+    friend class GDALThreadSafeDataset;
+
     /** Pointer to the thread-safe dataset from which this band has been
      *created */
     GDALThreadSafeDataset *m_poTSDS = nullptr;
 
+    /** Mutex that protects the lookup and insertion of blocks in the block
+     * cache of this band, as well as m_oSetBlocksInProgress. Blocks are
+     * decoded without holding it.
+     */
+    std::mutex m_oSharedBlocksMutex{};
+
+    /** Signaled each time a block of m_oSetBlocksInProgress has been
+     * decoded (or failed to be). */
+    std::condition_variable m_oSharedBlocksCV{};
+
+    /** (nXBlockOff, nYBlockOff) of the blocks being decoded by a thread-local
+     * band, so that other threads wait for them rather than decoding them a
+     * second time.
+     */
+    std::set<std::pair<int, int>> m_oSetBlocksInProgress{};
+
+    bool CanUseSharedBlocks(GDALRWFlag eRWFlag, int nXSize, int nYSize,
+                            int nBufXSize, int nBufYSize) const;
+
+    GDALRasterBlock *GetSharedBlock(int nXBlockOff, int nYBlockOff);
+
     /** Pointer to the "prototype" raster band that corresponds to us.
      * All calls to m_poPrototypeBand should be protected by
      * GDALThreadSafeDataset:m_oPrototypeDSMutex.
@@ -418,6 +468,23 @@ class GDALThreadSafeRasterBand final : public GDALProxyRasterBand
 thread_local std::unique_ptr<GDALThreadLocalDatasetCache>
     GDALThreadSafeDataset::tl_poCache;
 
+/************************************************************************/
+/*                             GetMaxSize()                             */
+/************************************************************************/
+
+/** Returns the maximum number of thread-local datasets kept in the LRU cache
+ * of each thread, from the GDAL_THREAD_SAFE_DATASET_CACHE_SIZE configuration
+ * option. 0 means unlimited.
+ */
+/* static */ size_t GDALThreadLocalDatasetCache::GetMaxSize()
+{
+    const char *pszSize =
+        CPLGetConfigOption("GDAL_THREAD_SAFE_DATASET_CACHE_SIZE", "64");
+    if (EQUAL(pszSize, "UNLIMITED"))
+        return 0;
+    return static_cast<size_t>(std::max(1, atoi(pszSize)));
+}
+
 /************************************************************************/
 /*                    GDALThreadLocalDatasetCache()                     */
 /************************************************************************/
@@ -428,7 +495,8 @@ thread_local std::unique_ptr<GDALThreadLocalDatasetCache>
  */
 GDALThreadLocalDatasetCache::GDALThreadLocalDatasetCache()
     : m_poCache(std::make_unique<lru11::Cache<const GDALThreadSafeDataset *,
-                                              std::shared_ptr<GDALDataset>>>()),
+                                              std::shared_ptr<GDALDataset>>>(
+          GetMaxSize())),
       m_nThreadID(CPLGetPID()), m_oCache(*m_poCache.get())
 {
     CPLDebug("GDAL",
@@ -505,7 +573,9 @@ GDALThreadSafeDataset::GDALThreadSafeDataset(
     std::unique_ptr<GDALDataset> poPrototypeDSUniquePtr,
     GDALDataset *poPrototypeDS)
     : m_poPrototypeDS(poPrototypeDS),
-      m_aosThreadLocalConfigOptions(CPLGetThreadLocalConfigOptions())
+      m_aosThreadLocalConfigOptions(CPLGetThreadLocalConfigOptions()),
+      m_bShareBlocks(CPLTestBool(
+          CPLGetConfigOption("GDAL_THREAD_SAFE_DATASET_SHARE_BLOCKS", "NO")))
 {
     CPLAssert(poPrototypeDS != nullptr);
     if (poPrototypeDSUniquePtr)
@@ -821,6 +891,37 @@ void GDALThreadSafeDataset::UnrefUnderlyingDataset(
     poCache->m_oMapReferencedDS.erase(oIter);
 }
 
+/************************************************************************/
+/*                             IRasterIO()                              */
+/************************************************************************/
+
+/** Implements GDALDataset::IRasterIO.
+ *
+ * When blocks are shared between threads, non-resampled reads are dispatched
+ * to the GDALThreadSafeRasterBand instances, so that they go through their
+ * shared block cache. Other requests are forwarded to the thread-local
+ * dataset.
+ */
+CPLErr GDALThreadSafeDataset::IRasterIO(
+    GDALRWFlag eRWFlag, int nXOff, int nYOff, int nXSize, int nYSize,
+    void *pData, int nBufXSize, int nBufYSize, GDALDataType eBufType,
+    int nBandCount, BANDMAP_TYPE panBandMap, GSpacing nPixelSpace,
+    GSpacing nLineSpace, GSpacing nBandSpace, GDALRasterIOExtraArg *psExtraArg)
+{
+    if (m_bShareBlocks && eRWFlag == GF_Read && nXSize == nBufXSize &&
+        nYSize == nBufYSize)
+    {
+        return BandBasedRasterIO(eRWFlag, nXOff, nYOff, nXSize, nYSize, pData,
+                                 nBufXSize, nBufYSize, eBufType, nBandCount,
+                                 panBandMap, nPixelSpace, nLineSpace,
+                                 nBandSpace, psExtraArg);
+    }
+    return GDALProxyDataset::IRasterIO(eRWFlag, nXOff, nYOff, nXSize, nYSize,
+                                       pData, nBufXSize, nBufYSize, eBufType,
+                                       nBandCount, panBandMap, nPixelSpace,
+                                       nLineSpace, nBandSpace, psExtraArg);
+}
+
 /************************************************************************/
 /*                      GDALThreadSafeRasterBand()                      */
 /************************************************************************/
@@ -1003,6 +1104,161 @@ void GDALThreadSafeRasterBand::UnrefUnderlyingRasterBand(
     }
 }
 
+/************************************************************************/
+/*                         CanUseSharedBlocks()                         */
+/************************************************************************/
+
+/** Returns whether a RasterIO() request can be served from the blocks
+ * shared between threads, that is a non-resampled read.
+ */
+bool GDALThreadSafeRasterBand::CanUseSharedBlocks(GDALRWFlag eRWFlag,
+                                                  int nXSize, int nYSize,
+                                                  int nBufXSize,
+                                                  int nBufYSize) const
+{
+    return m_poTSDS->m_bShareBlocks && eRWFlag == GF_Read &&
+           nXSize == nBufXSize && nYSize == nBufYSize && nBlockXSize > 0 &&
+           nBlockYSize > 0;
+}
+
+/************************************************************************/
+/*                           GetSharedBlock()                           */
+/************************************************************************/
+
+/** Returns a locked block of the block cache of this band, which is shared
+ * by all threads, decoding it through the thread-local band if needed.
+ *
+ * If another thread is already decoding the same block, wait for it rather
+ * than decoding it a second time.
+ */
+GDALRasterBlock *GDALThreadSafeRasterBand::GetSharedBlock(int nXBlockOff,
+                                                          int nYBlockOff)
+{
+    const std::pair<int, int> oKey(nXBlockOff, nYBlockOff);
+    {
+        std::unique_lock oLock(m_oSharedBlocksMutex);
+        while (true)
+        {
+            // Call the base implementations, and do not forward to proxy
+            GDALRasterBlock *poBlock =
+                GDALRasterBand::TryGetLockedBlockRef(nXBlockOff, nYBlockOff);
+            if (poBlock)
+                return poBlock;
+            if (!cpl::contains(m_oSetBlocksInProgress, oKey))
+                break;
+            m_oSharedBlocksCV.wait(oLock);
+        }
+        m_oSetBlocksInProgress.insert(oKey);
+    }
+
+    // Decode the block without holding the lock
+    const size_t nBlockBytes = static_cast<size_t>(nBlockXSize) * nBlockYSize *
+                               GDALGetDataTypeSizeBytes(eDataType);
+    void *pBuffer = VSI_MALLOC_VERBOSE(nBlockBytes);
+    bool bOK = pBuffer != nullptr;
+    if (bOK)
+    {
+        GDALRasterBand *poTLBand = RefUnderlyingRasterBand(false);
+        bOK = poTLBand != nullptr &&
+              poTLBand->ReadBlock(nXBlockOff, nYBlockOff, pBuffer) == CE_None;
+        if (poTLBand)
+            UnrefUnderlyingRasterBand(poTLBand);
+    }
+
+    GDALRasterBlock *poBlock = nullptr;
+    {
+        std::lock_guard oLock(m_oSharedBlocksMutex);
+        m_oSetBlocksInProgress.erase(oKey);
+        if (bOK)
+        {
+            poBlock = GDALRasterBand::GetLockedBlockRef(
+                nXBlockOff, nYBlockOff, /* bJustInitialize = */ TRUE);
+            if (poBlock)
+                memcpy(poBlock->GetDataRef(), pBuffer, nBlockBytes);
+        }
+    }
+    m_oSharedBlocksCV.notify_all();
+    VSIFree(pBuffer);
+
+    return poBlock;
+}
+
+/************************************************************************/
+/*                             IRasterIO()                              */
+/************************************************************************/
+
+/** Implements GDALRasterBand::IRasterIO.
+ *
+ * Non-resampled reads are served from the block cache of this band, which is
+ * shared by all threads, so that a block read by several threads is only
+ * decoded once. Other requests are forwarded to the thread-local band.
+ */
+CPLErr GDALThreadSafeRasterBand::IRasterIO(
+    GDALRWFlag eRWFlag, int nXOff, int nYOff, int nXSize, int nYSize,
+    void *pData, int nBufXSize, int nBufYSize, GDALDataType eBufType,
+    GSpacing nPixelSpace, GSpacing nLineSpace, GDALRasterIOExtraArg *psExtraArg)
+{
+    // GDALCopyWords64() takes an int pixel spacing
+    if (!CanUseSharedBlocks(eRWFlag, nXSize, nYSize, nBufXSize, nBufYSize) ||
+        nPixelSpace > std::numeric_limits<int>::max() ||
+        nPixelSpace < std::numeric_limits<int>::min())
+    {
+        return GDALProxyRasterBand::IRasterIO(
+            eRWFlag, nXOff, nYOff, nXSize, nYSize, pData, nBufXSize, nBufYSize,
+            eBufType, nPixelSpace, nLineSpace, psExtraArg);
+    }
+
+    const int nDTSize = GDALGetDataTypeSizeBytes(eDataType);
+    GByte *pabyData = static_cast<GByte *>(pData);
+    const int nFirstYBlock = nYOff / nBlockYSize;
+    const int nLastYBlock = (nYOff + nYSize - 1) / nBlockYSize;
+    const int nFirstXBlock = nXOff / nBlockXSize;
+    const int nLastXBlock = (nXOff + nXSize - 1) / nBlockXSize;
+
+    for (int iYBlock = nFirstYBlock; iYBlock <= nLastYBlock; ++iYBlock)
+    {
+        const int nYStart = std::max(nYOff, iYBlock * nBlockYSize);
+        const int nYEnd = std::min(nYOff + nYSize, (iYBlock + 1) * nBlockYSize);
+        for (int iXBlock = nFirstXBlock; iXBlock <= nLastXBlock; ++iXBlock)
+        {
+            GDALRasterBlock *poBlock = GetSharedBlock(iXBlock, iYBlock);
+            if (!poBlock)
+                return CE_Failure;
+
+            const int nXStart = std::max(nXOff, iXBlock * nBlockXSize);
+            const int nXEnd =
+                std::min(nXOff + nXSize, (iXBlock + 1) * nBlockXSize);
+            const GByte *pabyBlock =
+                static_cast<const GByte *>(poBlock->GetDataRef());
+            for (int iY = nYStart; iY < nYEnd; ++iY)
+            {
+                const size_t nSrcOffset =
+                    (static_cast<size_t>(iY - iYBlock * nBlockYSize) *
+                         nBlockXSize +
+                     (nXStart - iXBlock * nBlockXSize)) *
+                    nDTSize;
+                GDALCopyWords64(pabyBlock + nSrcOffset, eDataType, nDTSize,
+                                pabyData + (iY - nYOff) * nLineSpace +
+                                    (nXStart - nXOff) * nPixelSpace,
+                                eBufType, static_cast<int>(nPixelSpace),
+                                nXEnd - nXStart);
+            }
+            poBlock->DropLock();
+        }
+
+        if (psExtraArg->pfnProgress != nullptr &&
+            !psExtraArg->pfnProgress(static_cast<double>(nYEnd - nYOff) /
+                                         nYSize,
+                                     "", psExtraArg->pProgressData))
+        {
+            ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            return CE_Failure;
+        }
+    }
+
+    return CE_None;
+}
+
 /************************************************************************/
 /*                           GetMaskBand()                              */
 /************************************************************************/
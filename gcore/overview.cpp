@@ -22,10 +22,12 @@
 #include <algorithm>
 #include <complex>
 #include <condition_variable>
+#include <functional>
 #include <limits>
 #include <list>
 #include <memory>
 #include <mutex>
+#include <type_traits>
 #include <vector>
 
 #include "cpl_conv.h"
@@ -5035,6 +5037,475 @@ CPLErr GDALRegenerateOverviewsEx(GDALRasterBandH hSrcBand, int nOverviewCount,
     return eErr;
 }
 
+/************************************************************************/
+/*                    GDALCascadeComputeNoDataMask()                    */
+/************************************************************************/
+
+// Same logic as GDALNoDataMaskBand, applied to values of the overview data
+// type.
+template <class T>
+static void GDALCascadeComputeNoDataMask(const void *pValues, size_t nCount,
+                                         double dfNoDataValue, GByte *pabyMask)
+{
+    const T *paValues = static_cast<const T *>(pValues);
+    if constexpr (std::is_floating_point<T>::value)
+    {
+        if (std::isnan(dfNoDataValue))
+        {
+            for (size_t i = 0; i < nCount; ++i)
+                pabyMask[i] = std::isnan(paValues[i]) ? 0 : 255;
+            return;
+        }
+        if (!std::isinf(dfNoDataValue) &&
+            !GDALIsValueInRange<T>(dfNoDataValue))
+        {
+            memset(pabyMask, 255, nCount);
+            return;
+        }
+        const T noData = static_cast<T>(dfNoDataValue);
+        for (size_t i = 0; i < nCount; ++i)
+            pabyMask[i] = ARE_REAL_EQUAL(paValues[i], noData) ? 0 : 255;
+    }
+    else
+    {
+        if (!GDALIsValueInRange<T>(dfNoDataValue))
+        {
+            memset(pabyMask, 255, nCount);
+            return;
+        }
+        const T noData = static_cast<T>(dfNoDataValue);
+        for (size_t i = 0; i < nCount; ++i)
+            pabyMask[i] = paValues[i] == noData ? 0 : 255;
+    }
+}
+
+namespace
+{
+// State of one level of a cascaded overview computation. Level 0 is the
+// source.
+struct GDALCascadeLevel
+{
+    int nWidth = 0;
+    int nHeight = 0;
+
+    // Rows [nBufYOff, nBufYOff + nBufYCount) of this level, in the working
+    // data type, that are still needed to compute the next level.
+    int nBufYOff = 0;
+    int nBufYCount = 0;
+    std::vector<std::vector<GByte>> aabyValues{};
+    std::vector<std::vector<GByte>> aabyMask{};
+
+    // Mask flags and nodata value of the bands of this level, used to
+    // recompute the mask of the buffered rows (overview levels only).
+    std::vector<int> anMaskFlags{};
+    std::vector<double> adfMaskNoData{};
+
+    // Resampling parameters from the previous level (overview levels only).
+    int nNextRow = 0;
+    int nBatchRows = 0;
+    double dfXRatioDstToSrc = 0;
+    double dfYRatioDstToSrc = 0;
+    int nOvrFactor = 1;
+};
+}  // namespace
+
+/************************************************************************/
+/*                GDALRegenerateOverviewsMultiBandCascaded()            */
+/************************************************************************/
+
+// Computes all overview levels in a single pass over the source bands.
+// Each level is computed from the rows of the previous level kept in
+// memory, instead of being read back from the overview bands just written,
+// as done by the default mode of GDALRegenerateOverviewsMultiBand().
+// bEligible is set to false, and nothing is done, if the configuration is
+// not eligible to the cascaded mode.
+
+static CPLErr GDALRegenerateOverviewsMultiBandCascaded(
+    int nBands, GDALRasterBand *const *papoSrcBands, int nOverviews,
+    GDALRasterBand *const *const *papapoOverviewBands,
+    const char *pszResampling, GDALResampleFunction pfnResampleFn,
+    int nKernelRadius, GDALDataType eWrkDataType, bool bUseNoDataMask,
+    const bool *pabHasNoData, const double *padfNoDataValue,
+    bool bPropagateNoData, CPLJobQueue *poJobQueue, double dfTotalPixelCount,
+    GDALProgressFunc pfnProgress, void *pProgressData, bool &bEligible)
+{
+    bEligible = false;
+    const char *pszCascade = CPLGetConfigOption("GDAL_OVR_CASCADE", "AUTO");
+    if (EQUAL(pszCascade, "NO") || nOverviews < 2 ||
+        papoSrcBands[0]->IsMaskBand())
+    {
+        return CE_None;
+    }
+
+    const GDALDataType eDataType = papoSrcBands[0]->GetRasterDataType();
+    const int nWrkDataTypeSize = GDALGetDataTypeSizeBytes(eWrkDataType);
+
+    std::vector<GDALCascadeLevel> aoLevels(nOverviews + 1);
+    aoLevels[0].nWidth = papoSrcBands[0]->GetXSize();
+    aoLevels[0].nHeight = papoSrcBands[0]->GetYSize();
+    double dfMemRequirement = 0;
+    for (int iLevel = 1; iLevel <= nOverviews; ++iLevel)
+    {
+        auto &oLevel = aoLevels[iLevel];
+        const auto &oPrevLevel = aoLevels[iLevel - 1];
+        GDALRasterBand *poOvrBand = papapoOverviewBands[0][iLevel - 1];
+        oLevel.nWidth = poOvrBand->GetXSize();
+        oLevel.nHeight = poOvrBand->GetYSize();
+        // Each level must be computed from the previous one, as in the
+        // default mode.
+        if (oLevel.nWidth >= oPrevLevel.nWidth)
+            return CE_None;
+
+        oLevel.dfXRatioDstToSrc =
+            static_cast<double>(oPrevLevel.nWidth) / oLevel.nWidth;
+        oLevel.dfYRatioDstToSrc =
+            static_cast<double>(oPrevLevel.nHeight) / oLevel.nHeight;
+        oLevel.nOvrFactor = std::max(
+            {1, static_cast<int>(0.5 + oLevel.dfXRatioDstToSrc),
+             static_cast<int>(0.5 + oLevel.dfYRatioDstToSrc)});
+
+        // Compute rows by batches of whole blocks, so that the overview
+        // blocks are written completely.
+        int nBlockXSize = 0;
+        int nBlockYSize = 0;
+        poOvrBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+        nBlockYSize = std::max(1, nBlockYSize);
+        oLevel.nBatchRows = nBlockYSize < 32
+                                ? DIV_ROUND_UP(32, nBlockYSize) * nBlockYSize
+                                : std::min(nBlockYSize, 1024);
+        oLevel.nBatchRows = std::min(oLevel.nBatchRows, oLevel.nHeight);
+
+        // The mask of overview levels used as the input of another level is
+        // recomputed from the values, which is only possible if it is
+        // derived from the nodata value.
+        if (bUseNoDataMask && iLevel < nOverviews)
+        {
+            for (int iBand = 0; iBand < nBands; ++iBand)
+            {
+                GDALRasterBand *poBand = papapoOverviewBands[iBand][iLevel - 1];
+                const int nMaskFlags = poBand->GetMaskFlags();
+                if (nMaskFlags != GMF_ALL_VALID && nMaskFlags != GMF_NODATA)
+                    return CE_None;
+                const GDALDataType eOvrDataType = poBand->GetRasterDataType();
+                if (nMaskFlags == GMF_NODATA && eOvrDataType != GDT_Byte &&
+                    eOvrDataType != GDT_UInt16 && eOvrDataType != GDT_Int16 &&
+                    eOvrDataType != GDT_Float32 && eOvrDataType != GDT_Float64)
+                {
+                    return CE_None;
+                }
+                oLevel.anMaskFlags.push_back(nMaskFlags);
+                oLevel.adfMaskNoData.push_back(poBand->GetNoDataValue());
+            }
+        }
+
+        // Rows of the previous level needed for one batch, plus the batch
+        // of rows of the previous level being appended.
+        const double dfBufferedRows =
+            std::ceil((oLevel.nBatchRows + 1) * oLevel.dfYRatioDstToSrc) +
+            2.0 * nKernelRadius * oLevel.nOvrFactor + oPrevLevel.nBatchRows;
+        dfMemRequirement += dfBufferedRows * oPrevLevel.nWidth * nBands *
+                            (nWrkDataTypeSize + (bUseNoDataMask ? 1 : 0));
+    }
+
+    if (EQUAL(pszCascade, "AUTO") &&
+        dfMemRequirement > static_cast<double>(GDALGetCacheMax64()) / 4)
+    {
+        CPLDebug("GDAL",
+                 "Not using cascaded overview computation: it would require "
+                 "%.0f MB of RAM",
+                 dfMemRequirement / (1024 * 1024));
+        return CE_None;
+    }
+    CPLDebug("GDAL", "Using cascaded overview computation");
+    bEligible = true;
+
+    for (auto &oLevel : aoLevels)
+    {
+        oLevel.aabyValues.resize(nBands);
+        if (bUseNoDataMask)
+            oLevel.aabyMask.resize(nBands);
+    }
+
+    // Drop the buffered rows of a level before row nYOff
+    const auto DropRows = [nBands, bUseNoDataMask, nWrkDataTypeSize](
+                              GDALCascadeLevel &oLevel, int nYOff)
+    {
+        const int nDropped =
+            std::min(oLevel.nBufYCount, std::max(0, nYOff - oLevel.nBufYOff));
+        if (nDropped == 0)
+            return;
+        const size_t nValueBytes =
+            static_cast<size_t>(nDropped) * oLevel.nWidth * nWrkDataTypeSize;
+        const size_t nMaskBytes = static_cast<size_t>(nDropped) * oLevel.nWidth;
+        for (int iBand = 0; iBand < nBands; ++iBand)
+        {
+            auto &abyValues = oLevel.aabyValues[iBand];
+            abyValues.erase(abyValues.begin(), abyValues.begin() + nValueBytes);
+            if (bUseNoDataMask)
+            {
+                auto &abyMask = oLevel.aabyMask[iBand];
+                abyMask.erase(abyMask.begin(), abyMask.begin() + nMaskBytes);
+            }
+        }
+        oLevel.nBufYOff += nDropped;
+        oLevel.nBufYCount -= nDropped;
+    };
+
+    // Read source rows up to nYOff2 (excluded) into the level 0 buffer
+    const auto ReadSourceRows = [&](int nYOff2)
+    {
+        auto &oLevel = aoLevels[0];
+        const int nYOff = oLevel.nBufYOff + oLevel.nBufYCount;
+        const int nYCount = nYOff2 - nYOff;
+        if (nYCount <= 0)
+            return CE_None;
+        const size_t nPixels = static_cast<size_t>(nYCount) * oLevel.nWidth;
+        CPLErr eErr = CE_None;
+        for (int iBand = 0; iBand < nBands && eErr == CE_None; ++iBand)
+        {
+            auto &abyValues = oLevel.aabyValues[iBand];
+            const size_t nOldSize = abyValues.size();
+            abyValues.resize(nOldSize + nPixels * nWrkDataTypeSize);
+            eErr = papoSrcBands[iBand]->RasterIO(
+                GF_Read, 0, nYOff, oLevel.nWidth, nYCount,
+                abyValues.data() + nOldSize, oLevel.nWidth, nYCount,
+                eWrkDataType, 0, 0, nullptr);
+            if (bUseNoDataMask && eErr == CE_None)
+            {
+                auto &abyMask = oLevel.aabyMask[iBand];
+                const size_t nOldMaskSize = abyMask.size();
+                abyMask.resize(nOldMaskSize + nPixels);
+                eErr = papoSrcBands[iBand]->GetMaskBand()->RasterIO(
+                    GF_Read, 0, nYOff, oLevel.nWidth, nYCount,
+                    abyMask.data() + nOldMaskSize, oLevel.nWidth, nYCount,
+                    GDT_Byte, 0, 0, nullptr);
+            }
+        }
+        oLevel.nBufYCount += nYCount;
+        return eErr;
+    };
+
+    struct BandJob
+    {
+        GDALOverviewResampleArgs args{};
+        const void *pChunk = nullptr;
+        void *pDstBuffer = nullptr;
+        GDALDataType eDstBufferDataType = GDT_Unknown;
+        CPLErr eErr = CE_None;
+    };
+
+    std::vector<BandJob> asJobs(nBands);
+    std::vector<GByte> abyOvrRow;
+    double dfCurPixelCount = 0;
+
+    // Compute the next batch of rows of level iLevel, recursively computing
+    // the rows of the previous levels it needs.
+    std::function<CPLErr(int)> ComputeBatch;
+    const auto EnsureRows = [&](int iLevel, int nYOff2)
+    {
+        if (iLevel == 0)
+            return ReadSourceRows(nYOff2);
+        auto &oLevel = aoLevels[iLevel];
+        CPLErr eErr = CE_None;
+        while (eErr == CE_None && oLevel.nNextRow < nYOff2)
+            eErr = ComputeBatch(iLevel);
+        return eErr;
+    };
+
+    ComputeBatch = [&](int iLevel)
+    {
+        auto &oLevel = aoLevels[iLevel];
+        auto &oPrevLevel = aoLevels[iLevel - 1];
+        const int nDstYOff = oLevel.nNextRow;
+        const int nDstYOff2 =
+            std::min(oLevel.nHeight, nDstYOff + oLevel.nBatchRows);
+        const int nRadius = nKernelRadius * oLevel.nOvrFactor;
+
+        // Same computation of the source window as in the default mode
+        const int nChunkYOff =
+            static_cast<int>(nDstYOff * oLevel.dfYRatioDstToSrc);
+        int nChunkYOff2 =
+            static_cast<int>(ceil(nDstYOff2 * oLevel.dfYRatioDstToSrc));
+        if (nChunkYOff2 > oPrevLevel.nHeight || nDstYOff2 == oLevel.nHeight)
+            nChunkYOff2 = oPrevLevel.nHeight;
+        const int nChunkYOffQueried = std::max(0, nChunkYOff - nRadius);
+        const int nChunkYOff2Queried =
+            std::min(oPrevLevel.nHeight, nChunkYOff2 + nRadius);
+
+        CPLErr eErr = EnsureRows(iLevel - 1, nChunkYOff2Queried);
+        if (eErr != CE_None)
+            return eErr;
+        CPLAssert(oPrevLevel.nBufYOff <= nChunkYOffQueried);
+        CPLAssert(oPrevLevel.nBufYOff + oPrevLevel.nBufYCount >=
+                  nChunkYOff2Queried);
+
+        const size_t nSkippedPixels =
+            static_cast<size_t>(nChunkYOffQueried - oPrevLevel.nBufYOff) *
+            oPrevLevel.nWidth;
+        for (int iBand = 0; iBand < nBands; ++iBand)
+        {
+            auto &sJob = asJobs[iBand];
+            GDALRasterBand *poDstBand =
+                papapoOverviewBands[iBand][iLevel - 1];
+            sJob = BandJob();
+            sJob.args.eOvrDataType = poDstBand->GetRasterDataType();
+            sJob.args.nOvrXSize = oLevel.nWidth;
+            sJob.args.nOvrYSize = oLevel.nHeight;
+            const char *pszNBITS =
+                poDstBand->GetMetadataItem("NBITS", "IMAGE_STRUCTURE");
+            sJob.args.nOvrNBITS = pszNBITS ? atoi(pszNBITS) : 0;
+            sJob.args.dfXRatioDstToSrc = oLevel.dfXRatioDstToSrc;
+            sJob.args.dfYRatioDstToSrc = oLevel.dfYRatioDstToSrc;
+            sJob.args.eWrkDataType = eWrkDataType;
+            sJob.pChunk = oPrevLevel.aabyValues[iBand].data() +
+                          nSkippedPixels * nWrkDataTypeSize;
+            sJob.args.pabyChunkNodataMask =
+                bUseNoDataMask
+                    ? oPrevLevel.aabyMask[iBand].data() + nSkippedPixels
+                    : nullptr;
+            sJob.args.nChunkXOff = 0;
+            sJob.args.nChunkXSize = oPrevLevel.nWidth;
+            sJob.args.nChunkYOff = nChunkYOffQueried;
+            sJob.args.nChunkYSize = nChunkYOff2Queried - nChunkYOffQueried;
+            sJob.args.nDstXOff = 0;
+            sJob.args.nDstXOff2 = oLevel.nWidth;
+            sJob.args.nDstYOff = nDstYOff;
+            sJob.args.nDstYOff2 = nDstYOff2;
+            sJob.args.pszResampling = pszResampling;
+            sJob.args.bHasNoData = pabHasNoData[iBand];
+            sJob.args.dfNoDataValue = padfNoDataValue[iBand];
+            sJob.args.eSrcDataType = eDataType;
+            sJob.args.bPropagateNoData = bPropagateNoData;
+        }
+
+        const auto RunJob = [pfnResampleFn](BandJob *psJob)
+        {
+            psJob->eErr =
+                pfnResampleFn(psJob->args, psJob->pChunk, &psJob->pDstBuffer,
+                              &psJob->eDstBufferDataType);
+        };
+        if (poJobQueue && nBands > 1)
+        {
+            for (auto &sJob : asJobs)
+                poJobQueue->SubmitJob([&RunJob, &sJob]() { RunJob(&sJob); });
+            poJobQueue->WaitCompletion();
+        }
+        else
+        {
+            for (auto &sJob : asJobs)
+                RunJob(&sJob);
+        }
+
+        const int nDstYCount = nDstYOff2 - nDstYOff;
+        const size_t nDstPixels =
+            static_cast<size_t>(nDstYCount) * oLevel.nWidth;
+        for (int iBand = 0; iBand < nBands; ++iBand)
+        {
+            auto &sJob = asJobs[iBand];
+            if (eErr == CE_None)
+                eErr = sJob.eErr;
+            if (eErr == CE_None)
+            {
+                eErr = papapoOverviewBands[iBand][iLevel - 1]->RasterIO(
+                    GF_Write, 0, nDstYOff, oLevel.nWidth, nDstYCount,
+                    sJob.pDstBuffer, oLevel.nWidth, nDstYCount,
+                    sJob.eDstBufferDataType, 0, 0, nullptr);
+            }
+
+            // Keep the rows as the input of the next level, after a round
+            // trip through the overview data type, as if they had been read
+            // back from the overview band.
+            if (eErr == CE_None && iLevel < nOverviews)
+            {
+                const GDALDataType eOvrDataType =
+                    papapoOverviewBands[iBand][iLevel - 1]
+                        ->GetRasterDataType();
+                const int nOvrDataTypeSize =
+                    GDALGetDataTypeSizeBytes(eOvrDataType);
+                abyOvrRow.resize(nDstPixels * nOvrDataTypeSize);
+                GDALCopyWords64(sJob.pDstBuffer, sJob.eDstBufferDataType,
+                                GDALGetDataTypeSizeBytes(
+                                    sJob.eDstBufferDataType),
+                                abyOvrRow.data(), eOvrDataType,
+                                nOvrDataTypeSize, nDstPixels);
+
+                auto &abyValues = oLevel.aabyValues[iBand];
+                const size_t nOldSize = abyValues.size();
+                abyValues.resize(nOldSize + nDstPixels * nWrkDataTypeSize);
+                GDALCopyWords64(abyOvrRow.data(), eOvrDataType,
+                                nOvrDataTypeSize, abyValues.data() + nOldSize,
+                                eWrkDataType, nWrkDataTypeSize, nDstPixels);
+
+                if (bUseNoDataMask)
+                {
+                    auto &abyMask = oLevel.aabyMask[iBand];
+                    const size_t nOldMaskSize = abyMask.size();
+                    abyMask.resize(nOldMaskSize + nDstPixels);
+                    GByte *pabyMask = abyMask.data() + nOldMaskSize;
+                    const double dfNoData = oLevel.adfMaskNoData[iBand];
+                    if (oLevel.anMaskFlags[iBand] == GMF_ALL_VALID)
+                        memset(pabyMask, 255, nDstPixels);
+                    else if (eOvrDataType == GDT_Byte)
+                        GDALCascadeComputeNoDataMask<GByte>(
+                            abyOvrRow.data(), nDstPixels, dfNoData, pabyMask);
+                    else if (eOvrDataType == GDT_UInt16)
+                        GDALCascadeComputeNoDataMask<GUInt16>(
+                            abyOvrRow.data(), nDstPixels, dfNoData, pabyMask);
+                    else if (eOvrDataType == GDT_Int16)
+                        GDALCascadeComputeNoDataMask<GInt16>(
+                            abyOvrRow.data(), nDstPixels, dfNoData, pabyMask);
+                    else if (eOvrDataType == GDT_Float32)
+                        GDALCascadeComputeNoDataMask<float>(
+                            abyOvrRow.data(), nDstPixels, dfNoData, pabyMask);
+                    else
+                        GDALCascadeComputeNoDataMask<double>(
+                            abyOvrRow.data(), nDstPixels, dfNoData, pabyMask);
+                }
+            }
+            CPLFree(sJob.pDstBuffer);
+            sJob.pDstBuffer = nullptr;
+        }
+        if (eErr != CE_None)
+            return eErr;
+        if (iLevel < nOverviews)
+            oLevel.nBufYCount += nDstYCount;
+        oLevel.nNextRow = nDstYOff2;
+
+        // Rows of the previous level before the source window of the next
+        // batch are no longer needed.
+        DropRows(oPrevLevel,
+                 static_cast<int>(nDstYOff2 * oLevel.dfYRatioDstToSrc) -
+                     nRadius);
+
+        dfCurPixelCount += static_cast<double>(nDstPixels);
+        if (!pfnProgress(dfCurPixelCount / dfTotalPixelCount, nullptr,
+                         pProgressData))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            return CE_Failure;
+        }
+        return CE_None;
+    };
+
+    // Pulling the rows of the last level drives the computation of all
+    // the other ones.
+    CPLErr eErr = EnsureRows(nOverviews, aoLevels[nOverviews].nHeight);
+
+    for (int iOverview = 0; iOverview < nOverviews; ++iOverview)
+    {
+        for (int iBand = 0; iBand < nBands; ++iBand)
+        {
+            if (papapoOverviewBands[iBand][iOverview]->FlushCache(false) !=
+                    CE_None &&
+                eErr == CE_None)
+            {
+                eErr = CE_Failure;
+            }
+        }
+    }
+    return eErr;
+}
+
 /************************************************************************/
 /*            GDALRegenerateOverviewsMultiBand()                        */
 /************************************************************************/
@@ -5073,6 +5544,12 @@ CPLErr GDALRegenerateOverviewsEx(GDALRasterBandH hSrcBand, int nOverviewCount,
  * to "ALL_CPUS" or a integer value to specify the number of threads to use for
  * overview computation.
  *
+ * Starting with GDAL 3.11, when several overview levels are regenerated on
+ * the whole extent of the source, they are computed in a single pass over the
+ * source: each level is computed from the rows of the previous level kept in
+ * memory, rather than read back from the overview bands. This is controlled
+ * with the GDAL_OVR_CASCADE configuration option.
+ *
  * @param nBands the number of bands, size of papoSrcBands and size of
  *               first dimension of papapoOverviewBands
  * @param papoSrcBands the list of source bands to downsample
@@ -5241,6 +5718,30 @@ CPLErr GDALRegenerateOverviewsMultiBand(
     auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue()
                                    : std::unique_ptr<CPLJobQueue>(nullptr);
 
+    // When regenerating the whole extent, try to compute all the overview
+    // levels in a single pass over the source.
+    if (nSrcXOff == 0 && nSrcYOff == 0 && nSrcXSize == nToplevelSrcWidth &&
+        nSrcYSize == nToplevelSrcHeight)
+    {
+        bool bCascaded = false;
+        const CPLErr eErr = GDALRegenerateOverviewsMultiBandCascaded(
+            nBands, papoSrcBands, nOverviews, papapoOverviewBands,
+            pszResampling, pfnResampleFn, nKernelRadius, eWrkDataType,
+            bUseNoDataMask, pabHasNoData, padfNoDataValue, bPropagateNoData,
+            poJobQueue.get(), dfTotalPixelCount, pfnProgress, pProgressData,
+            bCascaded);
+        if (bCascaded)
+        {
+            CPLFree(pabHasNoData);
+            CPLFree(padfNoDataValue);
+
+            if (eErr == CE_None)
+                pfnProgress(1.0, nullptr, pProgressData);
+
+            return eErr;
+        }
+    }
+
     // Only configurable for debug / testing
     const int nChunkMaxSize = std::max(
         100, atoi(CPLGetConfigOption("GDAL_OVR_CHUNK_MAX_SIZE", "10485760")));
@@ -25,16 +25,23 @@
 #include <cstring>
 
 #include <algorithm>
+#include <condition_variable>
+#include <deque>
 #include <limits>
+#include <mutex>
 #include <stdexcept>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_cpu_features.h"
 #include "cpl_error.h"
+#include "cpl_error_internal.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal_priv_templates.hpp"
 #include "gdal_vrt.h"
 #include "gdalwarper.h"
@@ -2112,6 +2119,12 @@ void CPL_STDCALL GDALSwapWordsEx(void *pData, int nWordSize, size_t nWordCount,
     }
 }
 
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) &&                                      \
+    (defined(__x86_64) || defined(_M_X64))
+#include "rasterio_avx2.h"
+#define GDAL_COPY_WORDS_AVX2
+#endif
+
 // Place the new GDALCopyWords helpers in an anonymous namespace
 namespace
 {
@@ -2234,6 +2247,12 @@ void GDALCopyWordsByteTo16Bit(const GByte *const CPL_RESTRICT pSrcData,
         nDstPixelStride == static_cast<int>(sizeof(*pDstData)))
     {
         decltype(nWordCount) n = 0;
+#ifdef GDAL_COPY_WORDS_AVX2
+        if (CPLHaveRuntimeAVX2())
+            n = static_cast<decltype(n)>(GDALCopyByteTo16Bit_AVX2(
+                pSrcData, reinterpret_cast<GUInt16 *>(pDstData),
+                static_cast<size_t>(nWordCount)));
+#endif
         const __m128i xmm_zero = _mm_setzero_si128();
         GByte *CPL_RESTRICT pabyDstDataPtr =
             reinterpret_cast<GByte *>(pDstData);
@@ -2352,6 +2371,11 @@ void GDALCopyWordsT(const GByte *const CPL_RESTRICT pSrcData,
         nDstPixelStride == static_cast<int>(sizeof(*pDstData)))
     {
         decltype(nWordCount) n = 0;
+#ifdef GDAL_COPY_WORDS_AVX2
+        if (CPLHaveRuntimeAVX2())
+            n = static_cast<decltype(n)>(GDALCopyByteToFloat_AVX2(
+                pSrcData, pDstData, static_cast<size_t>(nWordCount)));
+#endif
         const __m128i xmm_zero = _mm_setzero_si128();
         GByte *CPL_RESTRICT pabyDstDataPtr =
             reinterpret_cast<GByte *>(pDstData);
@@ -2471,6 +2495,11 @@ void GDALCopyWordsT(const GUInt16 *const CPL_RESTRICT pSrcData,
         nDstPixelStride == static_cast<int>(sizeof(*pDstData)))
     {
         decltype(nWordCount) n = 0;
+#ifdef GDAL_COPY_WORDS_AVX2
+        if (CPLHaveRuntimeAVX2())
+            n = static_cast<decltype(n)>(GDALCopyUInt16ToByte_AVX2(
+                pSrcData, pDstData, static_cast<size_t>(nWordCount)));
+#endif
         // In SSE2, min_epu16 does not exist, so shift from
         // UInt16 to SInt16 to be able to use min_epi16
         const __m128i xmm_UINT16_to_INT16 = _mm_set1_epi16(-32768);
@@ -2543,6 +2572,11 @@ void GDALCopyWordsT(const GUInt16 *const CPL_RESTRICT pSrcData,
         nDstPixelStride == static_cast<int>(sizeof(*pDstData)))
     {
         decltype(nWordCount) n = 0;
+#ifdef GDAL_COPY_WORDS_AVX2
+        if (CPLHaveRuntimeAVX2())
+            n = static_cast<decltype(n)>(GDALCopyUInt16ToFloat_AVX2(
+                pSrcData, pDstData, static_cast<size_t>(nWordCount)));
+#endif
         const __m128i xmm_zero = _mm_setzero_si128();
         GByte *CPL_RESTRICT pabyDstDataPtr =
             reinterpret_cast<GByte *>(pDstData);
@@ -2621,6 +2655,43 @@ void GDALCopyWordsT(const GUInt16 *const CPL_RESTRICT pSrcData,
     }
 }
 
+template <>
+void GDALCopyWordsT(const GInt16 *const CPL_RESTRICT pSrcData,
+                    int nSrcPixelStride, float *const CPL_RESTRICT pDstData,
+                    int nDstPixelStride, GPtrDiff_t nWordCount)
+{
+    if (nSrcPixelStride == static_cast<int>(sizeof(*pSrcData)) &&
+        nDstPixelStride == static_cast<int>(sizeof(*pDstData)))
+    {
+        decltype(nWordCount) n = 0;
+#ifdef GDAL_COPY_WORDS_AVX2
+        if (CPLHaveRuntimeAVX2())
+            n = static_cast<decltype(n)>(GDALCopyInt16ToFloat_AVX2(
+                pSrcData, pDstData, static_cast<size_t>(nWordCount)));
+#endif
+        for (; n < nWordCount - 7; n += 8)
+        {
+            __m128i xmm = _mm_loadu_si128(
+                reinterpret_cast<const __m128i *>(pSrcData + n));
+            // Sign extension of int16 to int32: put each value in the
+            // upper half of a int32, and do an arithmetic shift right.
+            __m128i xmm0 = _mm_srai_epi32(_mm_unpacklo_epi16(xmm, xmm), 16);
+            __m128i xmm1 = _mm_srai_epi32(_mm_unpackhi_epi16(xmm, xmm), 16);
+            _mm_storeu_ps(pDstData + n, _mm_cvtepi32_ps(xmm0));
+            _mm_storeu_ps(pDstData + n + 4, _mm_cvtepi32_ps(xmm1));
+        }
+        for (; n < nWordCount; n++)
+        {
+            pDstData[n] = pSrcData[n];
+        }
+    }
+    else
+    {
+        GDALCopyWordsGenericT(pSrcData, nSrcPixelStride, pDstData,
+                              nDstPixelStride, nWordCount);
+    }
+}
+
 template <>
 void GDALCopyWordsT(const double *const CPL_RESTRICT pSrcData,
                     int nSrcPixelStride, GUInt16 *const CPL_RESTRICT pDstData,
@@ -2637,8 +2708,18 @@ void GDALCopyWordsT(const float *const CPL_RESTRICT pSrcData,
                     int nSrcPixelStride, GByte *const CPL_RESTRICT pDstData,
                     int nDstPixelStride, GPtrDiff_t nWordCount)
 {
-    GDALCopyWordsT_8atatime(pSrcData, nSrcPixelStride, pDstData,
-                            nDstPixelStride, nWordCount);
+    GPtrDiff_t n = 0;
+#ifdef GDAL_COPY_WORDS_AVX2
+    if (nSrcPixelStride == static_cast<int>(sizeof(*pSrcData)) &&
+        nDstPixelStride == static_cast<int>(sizeof(*pDstData)) &&
+        CPLHaveRuntimeAVX2())
+    {
+        n = static_cast<GPtrDiff_t>(GDALCopyFloatToByte_AVX2(
+            pSrcData, pDstData, static_cast<size_t>(nWordCount)));
+    }
+#endif
+    GDALCopyWordsT_8atatime(pSrcData + n, nSrcPixelStride, pDstData + n,
+                            nDstPixelStride, nWordCount - n);
 }
 
 template <>
@@ -2646,8 +2727,18 @@ void GDALCopyWordsT(const float *const CPL_RESTRICT pSrcData,
                     int nSrcPixelStride, GInt16 *const CPL_RESTRICT pDstData,
                     int nDstPixelStride, GPtrDiff_t nWordCount)
 {
-    GDALCopyWordsT_8atatime(pSrcData, nSrcPixelStride, pDstData,
-                            nDstPixelStride, nWordCount);
+    GPtrDiff_t n = 0;
+#ifdef GDAL_COPY_WORDS_AVX2
+    if (nSrcPixelStride == static_cast<int>(sizeof(*pSrcData)) &&
+        nDstPixelStride == static_cast<int>(sizeof(*pDstData)) &&
+        CPLHaveRuntimeAVX2())
+    {
+        n = static_cast<GPtrDiff_t>(GDALCopyFloatToInt16_AVX2(
+            pSrcData, pDstData, static_cast<size_t>(nWordCount)));
+    }
+#endif
+    GDALCopyWordsT_8atatime(pSrcData + n, nSrcPixelStride, pDstData + n,
+                            nDstPixelStride, nWordCount - n);
 }
 
 template <>
@@ -2655,8 +2746,18 @@ void GDALCopyWordsT(const float *const CPL_RESTRICT pSrcData,
                     int nSrcPixelStride, GUInt16 *const CPL_RESTRICT pDstData,
                     int nDstPixelStride, GPtrDiff_t nWordCount)
 {
-    GDALCopyWordsT_8atatime(pSrcData, nSrcPixelStride, pDstData,
-                            nDstPixelStride, nWordCount);
+    GPtrDiff_t n = 0;
+#ifdef GDAL_COPY_WORDS_AVX2
+    if (nSrcPixelStride == static_cast<int>(sizeof(*pSrcData)) &&
+        nDstPixelStride == static_cast<int>(sizeof(*pDstData)) &&
+        CPLHaveRuntimeAVX2())
+    {
+        n = static_cast<GPtrDiff_t>(GDALCopyFloatToUInt16_AVX2(
+            pSrcData, pDstData, static_cast<size_t>(nWordCount)));
+    }
+#endif
+    GDALCopyWordsT_8atatime(pSrcData + n, nSrcPixelStride, pDstData + n,
+                            nDstPixelStride, nWordCount - n);
 }
 
 /************************************************************************/
@@ -4603,6 +4704,10 @@ static void GDALCopyWholeRasterGetSwathSize(GDALRasterBand *poSrcPrototypeBand,
  * sizes to achieve best compression.</li> <li>"SKIP_HOLES=YES" to skip chunks
  * for which GDALGetDataCoverageStatus() returns GDAL_DATA_COVERAGE_STATUS_EMPTY
  * (GDAL &gt;= 2.2)</li>
+ * <li>"PIPELINE=YES/NO" to read the next swath in the calling thread while
+ * the previous one is written by a separate thread (GDAL &gt;= 3.11).
+ * Defaults to the value of the GDAL_COPY_WHOLE_RASTER_PIPELINE configuration
+ * option, or NO.</li>
  * </ul>
  * More options may be supported in the future.
  *
@@ -4708,6 +4813,16 @@ CPLErr CPL_STDCALL GDALDatasetCopyWholeRaster(GDALDatasetH hSrcDS,
     if (pszDstCompressed != nullptr && CPLTestBool(pszDstCompressed))
         bDstIsCompressed = true;
 
+    /* -------------------------------------------------------------------- */
+    /*      Do we want to pipeline reads and writes?                        */
+    /* -------------------------------------------------------------------- */
+    bool bPipeline = CPLFetchBool(
+        papszOptions, "PIPELINE",
+        CPLTestBool(
+            CPLGetConfigOption("GDAL_COPY_WHOLE_RASTER_PIPELINE", "NO")));
+    if (poSrcDS == poDstDS)
+        bPipeline = false;
+
     /* -------------------------------------------------------------------- */
     /*      What will our swath size be?                                    */
     /* -------------------------------------------------------------------- */
@@ -4718,19 +4833,35 @@ CPLErr CPL_STDCALL GDALDatasetCopyWholeRaster(GDALDatasetH hSrcDS,
                                     nBandCount, bDstIsCompressed, bInterleave,
                                     &nSwathCols, &nSwathLines);
 
+    if (bPipeline)
+    {
+        // Two swath buffers are used when pipelining, so halve the swath
+        // height when it spans several rows of blocks. This keeps the memory
+        // usage unchanged and the swaths aligned on blocks, and gives the
+        // reading and the writing stage more swaths to overlap.
+        int nSrcBlockXSize = 0;
+        int nSrcBlockYSize = 0;
+        int nDstBlockXSize = 0;
+        int nDstBlockYSize = 0;
+        poSrcPrototypeBand->GetBlockSize(&nSrcBlockXSize, &nSrcBlockYSize);
+        poDstPrototypeBand->GetBlockSize(&nDstBlockXSize, &nDstBlockYSize);
+        const int nMaxBlockYSize = std::max(nSrcBlockYSize, nDstBlockYSize);
+        if (nSwathLines >= 2 * nMaxBlockYSize &&
+            (nSwathLines % nMaxBlockYSize) == 0)
+        {
+            nSwathLines = (nSwathLines / nMaxBlockYSize / 2) * nMaxBlockYSize;
+        }
+    }
+
     int nPixelSize = GDALGetDataTypeSizeBytes(eDT);
     if (bInterleave)
         nPixelSize *= nBandCount;
 
-    void *pSwathBuf = VSI_MALLOC3_VERBOSE(nSwathCols, nSwathLines, nPixelSize);
-    if (pSwathBuf == nullptr)
-    {
-        return CE_Failure;
-    }
-
     CPLDebug("GDAL",
-             "GDALDatasetCopyWholeRaster(): %d*%d swaths, bInterleave=%d",
-             nSwathCols, nSwathLines, static_cast<int>(bInterleave));
+             "GDALDatasetCopyWholeRaster(): %d*%d swaths, bInterleave=%d, "
+             "bPipeline=%d",
+             nSwathCols, nSwathLines, static_cast<int>(bInterleave),
+             static_cast<int>(bPipeline));
 
     // Advise the source raster that we are going to read it completely
     // Note: this might already have been done by GDALCreateCopy() in the
@@ -4738,175 +4869,267 @@ CPLErr CPL_STDCALL GDALDatasetCopyWholeRaster(GDALDatasetH hSrcDS,
     poSrcDS->AdviseRead(0, 0, nXSize, nYSize, nXSize, nYSize, eDT, nBandCount,
                         nullptr, nullptr);
 
-    /* ==================================================================== */
-    /*      Band oriented (uninterleaved) case.                             */
-    /* ==================================================================== */
-    CPLErr eErr = CE_None;
+    /* -------------------------------------------------------------------- */
+    /*      Collect the swaths, band per band in the uninterleaved case,    */
+    /*      or with all bands at once in the pixel interleaved case.        */
+    /* -------------------------------------------------------------------- */
+    struct Swath
+    {
+        int nBand;  // 0 for all bands
+        int nXOff;
+        int nYOff;
+        int nXSize;
+        int nYSize;
+    };
+
+    std::vector<Swath> aoSwaths;
+    for (int iBand = 0; iBand < (bInterleave ? 1 : nBandCount); iBand++)
+    {
+        for (int iY = 0; iY < nYSize; iY += nSwathLines)
+        {
+            const int nThisLines = std::min(nSwathLines, nYSize - iY);
+            for (int iX = 0; iX < nXSize; iX += nSwathCols)
+            {
+                const int nThisCols = std::min(nSwathCols, nXSize - iX);
+                aoSwaths.push_back(Swath{bInterleave ? 0 : iBand + 1, iX, iY,
+                                         nThisCols, nThisLines});
+            }
+        }
+    }
+    const double dfTotalSwaths = static_cast<double>(aoSwaths.size());
+
     const bool bCheckHoles =
         CPLTestBool(CSLFetchNameValueDef(papszOptions, "SKIP_HOLES", "NO"));
 
-    if (!bInterleave)
+    const auto HasData = [poSrcDS, nBandCount, bCheckHoles](const Swath &oSwath)
     {
+        if (!bCheckHoles)
+            return true;
+        for (int iBand = 0; iBand < nBandCount; iBand++)
+        {
+            if (oSwath.nBand != 0 && oSwath.nBand != iBand + 1)
+                continue;
+            if (poSrcDS->GetRasterBand(iBand + 1)->GetDataCoverageStatus(
+                    oSwath.nXOff, oSwath.nYOff, oSwath.nXSize, oSwath.nYSize,
+                    GDAL_DATA_COVERAGE_STATUS_DATA) &
+                GDAL_DATA_COVERAGE_STATUS_DATA)
+            {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    const auto CopySwath = [eDT, nBandCount](GDALDataset *poDS,
+                                             GDALRWFlag eRWFlag,
+                                             const Swath &oSwath, void *pBuf,
+                                             GDALRasterIOExtraArg *psExtraArg)
+    {
+        return poDS->RasterIO(eRWFlag, oSwath.nXOff, oSwath.nYOff,
+                              oSwath.nXSize, oSwath.nYSize, pBuf,
+                              oSwath.nXSize, oSwath.nYSize, eDT,
+                              oSwath.nBand ? 1 : nBandCount,
+                              oSwath.nBand ? &oSwath.nBand : nullptr, 0, 0, 0,
+                              psExtraArg);
+    };
+
+    CPLErr eErr = CE_None;
+
+    /* ==================================================================== */
+    /*      Sequential case: read a swath, then write it.                   */
+    /* ==================================================================== */
+    if (!bPipeline)
+    {
+        void *pSwathBuf =
+            VSI_MALLOC3_VERBOSE(nSwathCols, nSwathLines, nPixelSize);
+        if (pSwathBuf == nullptr)
+        {
+            return CE_Failure;
+        }
+
         GDALRasterIOExtraArg sExtraArg;
         INIT_RASTERIO_EXTRA_ARG(sExtraArg);
         CPL_IGNORE_RET_VAL(sExtraArg.pfnProgress);  // to make cppcheck happy
 
-        const GIntBig nTotalBlocks = static_cast<GIntBig>(nBandCount) *
-                                     DIV_ROUND_UP(nYSize, nSwathLines) *
-                                     DIV_ROUND_UP(nXSize, nSwathCols);
-        GIntBig nBlocksDone = 0;
-
-        for (int iBand = 0; iBand < nBandCount && eErr == CE_None; iBand++)
+        for (size_t iSwath = 0; iSwath < aoSwaths.size() && eErr == CE_None;
+             iSwath++)
         {
-            int nBand = iBand + 1;
-
-            for (int iY = 0; iY < nYSize && eErr == CE_None; iY += nSwathLines)
+            const Swath &oSwath = aoSwaths[iSwath];
+            if (HasData(oSwath))
             {
-                int nThisLines = nSwathLines;
+                sExtraArg.pfnProgress = GDALScaledProgress;
+                sExtraArg.pProgressData = GDALCreateScaledProgress(
+                    iSwath / dfTotalSwaths, (iSwath + 0.5) / dfTotalSwaths,
+                    pfnProgress, pProgressData);
+                if (sExtraArg.pProgressData == nullptr)
+                    sExtraArg.pfnProgress = nullptr;
 
-                if (iY + nThisLines > nYSize)
-                    nThisLines = nYSize - iY;
+                eErr = CopySwath(poSrcDS, GF_Read, oSwath, pSwathBuf,
+                                 &sExtraArg);
 
-                for (int iX = 0; iX < nXSize && eErr == CE_None;
-                     iX += nSwathCols)
-                {
-                    int nThisCols = nSwathCols;
-
-                    if (iX + nThisCols > nXSize)
-                        nThisCols = nXSize - iX;
-
-                    int nStatus = GDAL_DATA_COVERAGE_STATUS_DATA;
-                    if (bCheckHoles)
-                    {
-                        nStatus = poSrcDS->GetRasterBand(nBand)
-                                      ->GetDataCoverageStatus(
-                                          iX, iY, nThisCols, nThisLines,
-                                          GDAL_DATA_COVERAGE_STATUS_DATA);
-                    }
-                    if (nStatus & GDAL_DATA_COVERAGE_STATUS_DATA)
-                    {
-                        sExtraArg.pfnProgress = GDALScaledProgress;
-                        sExtraArg.pProgressData = GDALCreateScaledProgress(
-                            nBlocksDone / static_cast<double>(nTotalBlocks),
-                            (nBlocksDone + 0.5) /
-                                static_cast<double>(nTotalBlocks),
-                            pfnProgress, pProgressData);
-                        if (sExtraArg.pProgressData == nullptr)
-                            sExtraArg.pfnProgress = nullptr;
-
-                        eErr = poSrcDS->RasterIO(GF_Read, iX, iY, nThisCols,
-                                                 nThisLines, pSwathBuf,
-                                                 nThisCols, nThisLines, eDT, 1,
-                                                 &nBand, 0, 0, 0, &sExtraArg);
-
-                        GDALDestroyScaledProgress(sExtraArg.pProgressData);
+                GDALDestroyScaledProgress(sExtraArg.pProgressData);
 
-                        if (eErr == CE_None)
-                            eErr = poDstDS->RasterIO(
-                                GF_Write, iX, iY, nThisCols, nThisLines,
-                                pSwathBuf, nThisCols, nThisLines, eDT, 1,
-                                &nBand, 0, 0, 0, nullptr);
-                    }
+                if (eErr == CE_None)
+                    eErr = CopySwath(poDstDS, GF_Write, oSwath, pSwathBuf,
+                                     nullptr);
+            }
 
-                    nBlocksDone++;
-                    if (eErr == CE_None &&
-                        !pfnProgress(nBlocksDone /
-                                         static_cast<double>(nTotalBlocks),
-                                     nullptr, pProgressData))
-                    {
-                        eErr = CE_Failure;
-                        CPLError(CE_Failure, CPLE_UserInterrupt,
-                                 "User terminated CreateCopy()");
-                    }
-                }
+            if (eErr == CE_None &&
+                !pfnProgress((iSwath + 1) / dfTotalSwaths, nullptr,
+                             pProgressData))
+            {
+                eErr = CE_Failure;
+                CPLError(CE_Failure, CPLE_UserInterrupt,
+                         "User terminated CreateCopy()");
             }
         }
+
+        CPLFree(pSwathBuf);
+        return eErr;
     }
 
     /* ==================================================================== */
-    /*      Pixel interleaved case.                                         */
+    /*      Pipelined case: swaths are read by the calling thread, and      */
+    /*      handed over to a writer thread through a bounded queue.         */
     /* ==================================================================== */
-    else /* if( bInterleave ) */
+    constexpr int NUM_SWATH_BUFFERS = 2;
+    std::vector<void *> apSwathBufs;
+    for (int i = 0; i < NUM_SWATH_BUFFERS; i++)
     {
-        GDALRasterIOExtraArg sExtraArg;
-        INIT_RASTERIO_EXTRA_ARG(sExtraArg);
-        CPL_IGNORE_RET_VAL(sExtraArg.pfnProgress);  // to make cppcheck happy
-
-        const GIntBig nTotalBlocks =
-            static_cast<GIntBig>(DIV_ROUND_UP(nYSize, nSwathLines)) *
-            DIV_ROUND_UP(nXSize, nSwathCols);
-        GIntBig nBlocksDone = 0;
-
-        for (int iY = 0; iY < nYSize && eErr == CE_None; iY += nSwathLines)
+        void *pSwathBuf =
+            VSI_MALLOC3_VERBOSE(nSwathCols, nSwathLines, nPixelSize);
+        if (pSwathBuf == nullptr)
         {
-            int nThisLines = nSwathLines;
-
-            if (iY + nThisLines > nYSize)
-                nThisLines = nYSize - iY;
+            for (void *pBuf : apSwathBufs)
+                CPLFree(pBuf);
+            return CE_Failure;
+        }
+        apSwathBufs.push_back(pSwathBuf);
+    }
+
+    std::mutex oMutex;
+    std::condition_variable oCV;
+    // Swaths read and waiting to be written, in order. A null buffer marks
+    // a hole that has been skipped.
+    std::deque<std::pair<size_t, void *>> aoPendingWrites;
+    std::vector<void *> apFreeSwathBufs(apSwathBufs);
+    bool bReadDone = false;
+    CPLErr eWriteErr = CE_None;
+    size_t nSwathsWritten = 0;
+    std::vector<CPLErrorHandlerAccumulatorStruct> aoWriteErrors;
+
+    // The writer thread must see the same thread-local configuration
+    // options as the calling thread.
+    const CPLStringList aosThreadLocalConfigOptions(
+        CPLGetThreadLocalConfigOptions());
+
+    // A dedicated thread, rather than the global thread pool, so that
+    // drivers using the global pool while writing cannot be starved.
+    CPLWorkerThreadPool oWriterPool(1);
+    auto poJobQueue = oWriterPool.CreateJobQueue();
+    poJobQueue->SubmitJob(
+        [&]()
+        {
+            const CPLStringList aosTLConfigOptionsBackup(
+                CPLGetThreadLocalConfigOptions());
+            CPLSetThreadLocalConfigOptions(aosThreadLocalConfigOptions.List());
+            CPLInstallErrorHandlerAccumulator(aoWriteErrors);
+            std::unique_lock<std::mutex> oLock(oMutex);
+            while (true)
+            {
+                oCV.wait(oLock, [&aoPendingWrites, &bReadDone]
+                         { return !aoPendingWrites.empty() || bReadDone; });
+                if (aoPendingWrites.empty())
+                    break;
+                const auto oItem = aoPendingWrites.front();
+                aoPendingWrites.pop_front();
+                const bool bFailed = eWriteErr != CE_None;
+                oLock.unlock();
+
+                CPLErr eLocalErr = CE_None;
+                if (oItem.second && !bFailed)
+                    eLocalErr = CopySwath(poDstDS, GF_Write,
+                                          aoSwaths[oItem.first], oItem.second,
+                                          nullptr);
+
+                oLock.lock();
+                if (eLocalErr != CE_None)
+                    eWriteErr = eLocalErr;
+                if (oItem.second)
+                    apFreeSwathBufs.push_back(oItem.second);
+                nSwathsWritten++;
+                oCV.notify_all();
+            }
+            oLock.unlock();
+            CPLUninstallErrorHandlerAccumulator();
+            CPLSetThreadLocalConfigOptions(aosTLConfigOptionsBackup.List());
+        });
 
-            for (int iX = 0; iX < nXSize && eErr == CE_None; iX += nSwathCols)
+    for (size_t iSwath = 0; iSwath < aoSwaths.size() && eErr == CE_None;
+         iSwath++)
+    {
+        const Swath &oSwath = aoSwaths[iSwath];
+        void *pSwathBuf = nullptr;
+        if (HasData(oSwath))
+        {
             {
-                int nThisCols = nSwathCols;
+                std::unique_lock<std::mutex> oLock(oMutex);
+                oCV.wait(oLock, [&apFreeSwathBufs, &eWriteErr]
+                         {
+                             return !apFreeSwathBufs.empty() ||
+                                    eWriteErr != CE_None;
+                         });
+                if (eWriteErr != CE_None)
+                    break;
+                pSwathBuf = apFreeSwathBufs.back();
+                apFreeSwathBufs.pop_back();
+            }
 
-                if (iX + nThisCols > nXSize)
-                    nThisCols = nXSize - iX;
+            eErr = CopySwath(poSrcDS, GF_Read, oSwath, pSwathBuf, nullptr);
+            if (eErr != CE_None)
+                break;
+        }
 
-                int nStatus = GDAL_DATA_COVERAGE_STATUS_DATA;
-                if (bCheckHoles)
-                {
-                    nStatus = 0;
-                    for (int iBand = 0; iBand < nBandCount; iBand++)
-                    {
-                        nStatus |= poSrcDS->GetRasterBand(iBand + 1)
-                                       ->GetDataCoverageStatus(
-                                           iX, iY, nThisCols, nThisLines,
-                                           GDAL_DATA_COVERAGE_STATUS_DATA);
-                        if (nStatus & GDAL_DATA_COVERAGE_STATUS_DATA)
-                            break;
-                    }
-                }
-                if (nStatus & GDAL_DATA_COVERAGE_STATUS_DATA)
-                {
-                    sExtraArg.pfnProgress = GDALScaledProgress;
-                    sExtraArg.pProgressData = GDALCreateScaledProgress(
-                        nBlocksDone / static_cast<double>(nTotalBlocks),
-                        (nBlocksDone + 0.5) / static_cast<double>(nTotalBlocks),
-                        pfnProgress, pProgressData);
-                    if (sExtraArg.pProgressData == nullptr)
-                        sExtraArg.pfnProgress = nullptr;
+        size_t nWritten = 0;
+        {
+            std::lock_guard<std::mutex> oLock(oMutex);
+            aoPendingWrites.emplace_back(iSwath, pSwathBuf);
+            nWritten = nSwathsWritten;
+        }
+        oCV.notify_all();
 
-                    eErr = poSrcDS->RasterIO(GF_Read, iX, iY, nThisCols,
-                                             nThisLines, pSwathBuf, nThisCols,
-                                             nThisLines, eDT, nBandCount,
-                                             nullptr, 0, 0, 0, &sExtraArg);
+        if (!pfnProgress(nWritten / dfTotalSwaths, nullptr, pProgressData))
+        {
+            eErr = CE_Failure;
+            CPLError(CE_Failure, CPLE_UserInterrupt,
+                     "User terminated CreateCopy()");
+        }
+    }
 
-                    GDALDestroyScaledProgress(sExtraArg.pProgressData);
+    {
+        std::lock_guard<std::mutex> oLock(oMutex);
+        bReadDone = true;
+    }
+    oCV.notify_all();
+    poJobQueue->WaitCompletion();
 
-                    if (eErr == CE_None)
-                        eErr = poDstDS->RasterIO(
-                            GF_Write, iX, iY, nThisCols, nThisLines, pSwathBuf,
-                            nThisCols, nThisLines, eDT, nBandCount, nullptr, 0,
-                            0, 0, nullptr);
-                }
+    for (const auto &oError : aoWriteErrors)
+        CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+    if (eErr == CE_None)
+        eErr = eWriteErr;
 
-                nBlocksDone++;
-                if (eErr == CE_None &&
-                    !pfnProgress(nBlocksDone /
-                                     static_cast<double>(nTotalBlocks),
-                                 nullptr, pProgressData))
-                {
-                    eErr = CE_Failure;
-                    CPLError(CE_Failure, CPLE_UserInterrupt,
-                             "User terminated CreateCopy()");
-                }
-            }
-        }
+    if (eErr == CE_None && !pfnProgress(1.0, nullptr, pProgressData))
+    {
+        eErr = CE_Failure;
+        CPLError(CE_Failure, CPLE_UserInterrupt,
+                 "User terminated CreateCopy()");
     }
 
     /* -------------------------------------------------------------------- */
     /*      Cleanup                                                         */
     /* -------------------------------------------------------------------- */
-    CPLFree(pSwathBuf);
+    for (void *pBuf : apSwathBufs)
+        CPLFree(pBuf);
 
     return eErr;
 }
@@ -0,0 +1,230 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  AVX2 specializations of GDALCopyWords()
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#include "cpl_port.h"
+
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) &&                                      \
+    (defined(__x86_64) || defined(_M_X64))
+
+#include "rasterio_avx2.h"
+
+#include <immintrin.h>
+
+// Do not include gdal_priv_templates.hpp here: its inline functions would be
+// compiled with AVX2 enabled and could be picked by the linker for callers
+// running on CPUs without AVX2.
+
+/************************************************************************/
+/*                     GDALCopyByteTo16Bit_AVX2()                       */
+/************************************************************************/
+
+size_t GDALCopyByteTo16Bit_AVX2(const GByte *CPL_RESTRICT pSrc,
+                                GUInt16 *CPL_RESTRICT pDst, size_t nIters)
+{
+    size_t i = 0;
+    for (; i + 32 <= nIters; i += 32)
+    {
+        const __m128i xmm0 =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(pSrc + i));
+        const __m128i xmm1 =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(pSrc + i + 16));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(pDst + i),
+                            _mm256_cvtepu8_epi16(xmm0));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(pDst + i + 16),
+                            _mm256_cvtepu8_epi16(xmm1));
+    }
+    return i;
+}
+
+/************************************************************************/
+/*                     GDALCopyByteToFloat_AVX2()                       */
+/************************************************************************/
+
+size_t GDALCopyByteToFloat_AVX2(const GByte *CPL_RESTRICT pSrc,
+                                float *CPL_RESTRICT pDst, size_t nIters)
+{
+    size_t i = 0;
+    for (; i + 16 <= nIters; i += 16)
+    {
+        const __m128i xmm =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(pSrc + i));
+        const __m256i ymm0 = _mm256_cvtepu8_epi32(xmm);
+        const __m256i ymm1 = _mm256_cvtepu8_epi32(_mm_srli_si128(xmm, 8));
+        _mm256_storeu_ps(pDst + i, _mm256_cvtepi32_ps(ymm0));
+        _mm256_storeu_ps(pDst + i + 8, _mm256_cvtepi32_ps(ymm1));
+    }
+    return i;
+}
+
+/************************************************************************/
+/*                     GDALCopyUInt16ToByte_AVX2()                      */
+/************************************************************************/
+
+size_t GDALCopyUInt16ToByte_AVX2(const GUInt16 *CPL_RESTRICT pSrc,
+                                 GByte *CPL_RESTRICT pDst, size_t nIters)
+{
+    const __m256i ymm_255 = _mm256_set1_epi16(255);
+    size_t i = 0;
+    for (; i + 32 <= nIters; i += 32)
+    {
+        __m256i ymm0 =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pSrc + i));
+        __m256i ymm1 = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(pSrc + i + 16));
+        ymm0 = _mm256_min_epu16(ymm0, ymm_255);
+        ymm1 = _mm256_min_epu16(ymm1, ymm_255);
+        // Packing works within each 128-bit lane, hence the permutation
+        __m256i ymm = _mm256_packus_epi16(ymm0, ymm1);
+        ymm = _mm256_permute4x64_epi64(ymm, 0 | (2 << 2) | (1 << 4) | (3 << 6));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(pDst + i), ymm);
+    }
+    return i;
+}
+
+/************************************************************************/
+/*                    GDALCopyUInt16ToFloat_AVX2()                      */
+/************************************************************************/
+
+size_t GDALCopyUInt16ToFloat_AVX2(const GUInt16 *CPL_RESTRICT pSrc,
+                                  float *CPL_RESTRICT pDst, size_t nIters)
+{
+    size_t i = 0;
+    for (; i + 16 <= nIters; i += 16)
+    {
+        const __m128i xmm0 =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(pSrc + i));
+        const __m128i xmm1 =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(pSrc + i + 8));
+        _mm256_storeu_ps(pDst + i,
+                         _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(xmm0)));
+        _mm256_storeu_ps(pDst + i + 8,
+                         _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(xmm1)));
+    }
+    return i;
+}
+
+/************************************************************************/
+/*                     GDALCopyInt16ToFloat_AVX2()                      */
+/************************************************************************/
+
+size_t GDALCopyInt16ToFloat_AVX2(const GInt16 *CPL_RESTRICT pSrc,
+                                 float *CPL_RESTRICT pDst, size_t nIters)
+{
+    size_t i = 0;
+    for (; i + 16 <= nIters; i += 16)
+    {
+        const __m128i xmm0 =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(pSrc + i));
+        const __m128i xmm1 =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(pSrc + i + 8));
+        _mm256_storeu_ps(pDst + i,
+                         _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(xmm0)));
+        _mm256_storeu_ps(pDst + i + 8,
+                         _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(xmm1)));
+    }
+    return i;
+}
+
+/************************************************************************/
+/*                    GDALRoundFloatToUInt_AVX2()                       */
+/************************************************************************/
+
+// Same rounding and clamping as GDALCopy4Words(const float*, GByte/GUInt16*)
+// so that results do not depend on which code path is taken. NaN are mapped
+// to 0 since _mm256_max_ps() returns its second operand in that case.
+static inline __m256i GDALRoundFloatToUInt_AVX2(const float *pSrc,
+                                                const __m256 ymm_max)
+{
+    const __m256 p0d5 = _mm256_set1_ps(0.5f);
+    __m256 ymm = _mm256_loadu_ps(pSrc);
+    ymm = _mm256_add_ps(ymm, p0d5);
+    ymm = _mm256_min_ps(_mm256_max_ps(ymm, p0d5), ymm_max);
+    return _mm256_cvttps_epi32(ymm);
+}
+
+/************************************************************************/
+/*                     GDALCopyFloatToByte_AVX2()                       */
+/************************************************************************/
+
+size_t GDALCopyFloatToByte_AVX2(const float *CPL_RESTRICT pSrc,
+                                GByte *CPL_RESTRICT pDst, size_t nIters)
+{
+    const __m256 ymm_max = _mm256_set1_ps(255);
+    size_t i = 0;
+    for (; i + 16 <= nIters; i += 16)
+    {
+        const __m256i ymm0 = GDALRoundFloatToUInt_AVX2(pSrc + i, ymm_max);
+        const __m256i ymm1 = GDALRoundFloatToUInt_AVX2(pSrc + i + 8, ymm_max);
+        __m256i ymm = _mm256_packus_epi32(ymm0, ymm1);
+        ymm = _mm256_permute4x64_epi64(ymm, 0 | (2 << 2) | (1 << 4) | (3 << 6));
+        const __m128i xmm = _mm_packus_epi16(_mm256_castsi256_si128(ymm),
+                                             _mm256_extracti128_si256(ymm, 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(pDst + i), xmm);
+    }
+    return i;
+}
+
+/************************************************************************/
+/*                    GDALCopyFloatToUInt16_AVX2()                      */
+/************************************************************************/
+
+size_t GDALCopyFloatToUInt16_AVX2(const float *CPL_RESTRICT pSrc,
+                                  GUInt16 *CPL_RESTRICT pDst, size_t nIters)
+{
+    const __m256 ymm_max = _mm256_set1_ps(65535);
+    size_t i = 0;
+    for (; i + 16 <= nIters; i += 16)
+    {
+        const __m256i ymm0 = GDALRoundFloatToUInt_AVX2(pSrc + i, ymm_max);
+        const __m256i ymm1 = GDALRoundFloatToUInt_AVX2(pSrc + i + 8, ymm_max);
+        __m256i ymm = _mm256_packus_epi32(ymm0, ymm1);
+        ymm = _mm256_permute4x64_epi64(ymm, 0 | (2 << 2) | (1 << 4) | (3 << 6));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(pDst + i), ymm);
+    }
+    return i;
+}
+
+/************************************************************************/
+/*                    GDALCopyFloatToInt16_AVX2()                       */
+/************************************************************************/
+
+static inline __m256i GDALRoundFloatToInt16_AVX2(const float *pSrc)
+{
+    const __m256 ymm_min = _mm256_set1_ps(-32768);
+    const __m256 ymm_max = _mm256_set1_ps(32767);
+    const __m256 p0d5 = _mm256_set1_ps(0.5f);
+    const __m256 m0d5 = _mm256_set1_ps(-0.5f);
+    __m256 ymm = _mm256_loadu_ps(pSrc);
+    // Map NaN to 0, as GDALCopyWord() does
+    ymm = _mm256_and_ps(ymm, _mm256_cmp_ps(ymm, ymm, _CMP_ORD_Q));
+    // f >= 0.0f ? f + 0.5f : f - 0.5f, then clamp
+    const __m256 mask = _mm256_cmp_ps(ymm, _mm256_setzero_ps(), _CMP_GE_OQ);
+    ymm = _mm256_add_ps(ymm, _mm256_blendv_ps(m0d5, p0d5, mask));
+    ymm = _mm256_min_ps(_mm256_max_ps(ymm, ymm_min), ymm_max);
+    return _mm256_cvttps_epi32(ymm);
+}
+
+size_t GDALCopyFloatToInt16_AVX2(const float *CPL_RESTRICT pSrc,
+                                 GInt16 *CPL_RESTRICT pDst, size_t nIters)
+{
+    size_t i = 0;
+    for (; i + 16 <= nIters; i += 16)
+    {
+        const __m256i ymm0 = GDALRoundFloatToInt16_AVX2(pSrc + i);
+        const __m256i ymm1 = GDALRoundFloatToInt16_AVX2(pSrc + i + 8);
+        __m256i ymm = _mm256_packs_epi32(ymm0, ymm1);
+        ymm = _mm256_permute4x64_epi64(ymm, 0 | (2 << 2) | (1 << 4) | (3 << 6));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(pDst + i), ymm);
+    }
+    return i;
+}
+
+#endif
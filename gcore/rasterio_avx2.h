@@ -0,0 +1,50 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  AVX2 specializations of GDALCopyWords()
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#ifndef RASTERIO_AVX2_H_INCLUDED
+#define RASTERIO_AVX2_H_INCLUDED
+
+#include "cpl_port.h"
+
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) &&                                      \
+    (defined(__x86_64) || defined(_M_X64))
+
+// All functions below work on packed buffers, only process whole vectors
+// and return the number of words processed. The caller is responsible for
+// the remaining ones, with the same rounding and clamping rules.
+
+size_t GDALCopyByteTo16Bit_AVX2(const GByte *CPL_RESTRICT pSrc,
+                                GUInt16 *CPL_RESTRICT pDst, size_t nIters);
+
+size_t GDALCopyByteToFloat_AVX2(const GByte *CPL_RESTRICT pSrc,
+                                float *CPL_RESTRICT pDst, size_t nIters);
+
+size_t GDALCopyUInt16ToByte_AVX2(const GUInt16 *CPL_RESTRICT pSrc,
+                                 GByte *CPL_RESTRICT pDst, size_t nIters);
+
+size_t GDALCopyUInt16ToFloat_AVX2(const GUInt16 *CPL_RESTRICT pSrc,
+                                  float *CPL_RESTRICT pDst, size_t nIters);
+
+size_t GDALCopyInt16ToFloat_AVX2(const GInt16 *CPL_RESTRICT pSrc,
+                                 float *CPL_RESTRICT pDst, size_t nIters);
+
+size_t GDALCopyFloatToByte_AVX2(const float *CPL_RESTRICT pSrc,
+                                GByte *CPL_RESTRICT pDst, size_t nIters);
+
+size_t GDALCopyFloatToInt16_AVX2(const float *CPL_RESTRICT pSrc,
+                                 GInt16 *CPL_RESTRICT pDst, size_t nIters);
+
+size_t GDALCopyFloatToUInt16_AVX2(const float *CPL_RESTRICT pSrc,
+                                  GUInt16 *CPL_RESTRICT pDst, size_t nIters);
+
+#endif
+
+#endif /* RASTERIO_AVX2_H_INCLUDED */
@@ -3,10 +3,16 @@
 
 #include "ogrsf_frmts.h"
 #include "cpl_string.h"
+#include "cpl_error_internal.h"
+#include "cpl_worker_thread_pool.h"
 #include "DPI.h"
 #include "DPIext.h"
 #include "DPItypes.h"
 
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #define UNDETERMINED_SRID -2
 #define NDCT_IDCLS_PACKAGE 14
 #define NDCT_PKGID_DMGEO2 (NDCT_IDCLS_PACKAGE << 24 | 112)
@@ -29,11 +35,16 @@
 #define NDCT_CLSID_GEO2_ST_GEOGRAPHY (NDCT_IDCLS_PACKAGE << 24 | 129)
 
 #define fetchnum 100000
+#define DM_FETCH_INITIAL_ARRAY_SIZE 1000
+#define DM_FETCH_LOB_ROW_SIZE 4096
+#define DM_FETCH_MEMORY_LIMIT_DEFAULT "67108864"
 #define FORCED_COMMIT_NUM 10
 #define FORCED_INSERT_NUM 300
+#define DM_BULK_LOAD_MAX_ARRAY_SIZE 10000
+#define DM_BULK_LOAD_INITIAL_WIDTH 256
 
-extern int ogr_DM_insertnum;
 class OGRDMDataSource;
+class swq_expr_node;
 class OGRDMLayer;
 
 typedef enum
@@ -73,11 +84,18 @@ class CPL_DLL OGRDMConn
     char *pszPassword;
     char *pszDatabase;
 
+    /* TRUE while a user transaction is active: no intermediate commit */
+    int bInTransaction = FALSE;
+
   public:
     OGRDMConn();
     virtual ~OGRDMConn();
     int EstablishConn(const char *pszUserid, const char *pszPassword,
                       const char *pszDatabase);
+    int Commit();
+    int StartTransaction();
+    int CommitTransaction();
+    int RollbackTransaction();
 };
 
 typedef struct
@@ -93,6 +111,20 @@ typedef struct
     slength display_size;
 } DmColDesc;
 
+/* One parameter of a bulk load INSERT, bound column-wise */
+typedef struct
+{
+    int iField;     /* attribute field, or -1 */
+    int iGeomField; /* geometry field, or -1 */
+    sdint2 c_type;
+    DmColDesc desc;
+    slength width; /* bytes per row in data */
+    udbyte *data;
+    slength *ind;
+    dhobj *objs;
+    GSERIALIZED **geoms;
+} DmBulkColumn;
+
 class OGRDMGeomFieldDefn final : public OGRGeomFieldDefn
 {
     OGRDMGeomFieldDefn(const OGRDMGeomFieldDefn &) = delete;
@@ -165,10 +197,30 @@ class CPL_DLL OGRDMStatement
     CPLErr Prepare(const char *pszStatement);
     CPLErr ExecuteInsert(const char *pszSQLStatement, int nMode);
     CPLErr Execute(const char *pszStatement, int nMode = -1);
-    CPLErr Excute_for_fetchmany(const char *pszStatement);
+    CPLErr Excute_for_fetchmany(const char *pszStatement, int nArraySize = 0);
+    CPLErr Reexecute();
+    CPLErr BindParam(int iParam, GIntBig *pnValue);
     void Clean();
     char **SimpleFetchRow();
     char ***Fetchmany(ulength *rows);
+    size_t GetValueLength(int iCol, int iRow) const;
+    /* Whether the last Fetchmany() reached the end of the result set */
+    int IsLastBatch() const
+    {
+        return bLastBatch;
+    }
+    /* Column names of the result set, cached by Excute_for_fetchmany() */
+    const char *GetColName(int iCol) const
+    {
+        return iCol < static_cast<int>(aosFetchColNames.size())
+                   ? aosFetchColNames[iCol].c_str()
+                   : nullptr;
+    }
+    void EnablePrefetch();
+    OGRDMConn *GetConn()
+    {
+        return poConn;
+    }
     int GetColCount() const
     {
         return nRawColumnCount;
@@ -178,6 +230,17 @@ class CPL_DLL OGRDMStatement
     CPLErr Execute_for_insert(OGRDMFeatureDefn *params,
                               OGRFeature *poFeature,
                               std::map<std::string, int> mymap);
+    CPLErr FlushInserts();
+    void DiscardInserts();
+    void SetInsertArraySize(int nSize)
+    {
+        nInsertArraySize = nSize;
+    }
+    CPLErr PrepareBulkLoad(const char *pszStatement,
+                           OGRDMFeatureDefn *poDefn,
+                           const std::vector<int> &anGeomFields,
+                           const std::vector<int> &anFields);
+    CPLErr BulkLoadFeature(OGRFeature *poFeature);
 
   private:
     OGRDMConn *poConn;
@@ -197,16 +260,56 @@ class CPL_DLL OGRDMStatement
     dhloblctr **lobs;
     dhobjdesc **objdescs;
     char ***papszCurImages;
+    int *panFetchBufWidths = nullptr;
+    int nFetchArraySize = 0;
+    int nFetchArrayMax = 0;
+    int nFetchAllocated = 0;
+    bool bLastFetchFull = false;
+    bool bLastBatch = true;
+    bool bFetchFailed = false; /* set by FetchmanyInternal() on error */
+    std::vector<CPLString> aosFetchColNames{};
+    CPLErr BindFetchBuffers(int nNewSize);
+    void FreeFetchBuffers();
+    char ***FetchmanyInternal(ulength *rows);
+    //used for prefetching: second slot of fetch buffers
+    bool bPrefetchEnabled = false;
+    char ***results_other = nullptr;
+    dhobj **objs_other = nullptr;
+    dhloblctr **lobs_other = nullptr;
+    int **blob_lens_other = nullptr;
+    int **panFetchedLens = nullptr; /* blob_lens of the returned batch */
+    char ***papszCurImages_other = nullptr;
+    int nFetchAllocated_other = 0;
+    std::unique_ptr<CPLWorkerThreadPool> poPrefetchPool{};
+    std::unique_ptr<CPLJobQueue> poPrefetchQueue{};
+    bool bPrefetchPending = false;
+    bool bPrefetchFailed = false;
+    std::vector<CPLErrorHandlerAccumulatorStruct> aoPrefetchErrors{};
+    char ***papszPrefetched = nullptr;
+    ulength nPrefetchedRows = 0;
+    int nPrefetchCount = 0;
+    double dfPrefetchWait = 0;
+    void SwapFetchBuffers();
+    void WaitPrefetch();
     int param_nums = 0;
     DmColDesc *paramdescs = nullptr;
     dhobj **insert_objs;
     dhobjdesc insert_objdesc;
-    GSERIALIZED ***insert_geovalues;
+    GSERIALIZED ***insert_geovalues = nullptr;
     char ***insert_values;
-    int geonum;
+    int geonum = 0;
     int valuesnum;
     size_t gser_length = 0;
     int insert_num = 0;
+    int nInsertArraySize = FORCED_INSERT_NUM;
+    //used for bulk load
+    bool bBulkLoad = false;
+    bool bBulkUncommitted = false;
+    OGRDMFeatureDefn *poBulkDefn = nullptr;
+    std::vector<DmBulkColumn> asBulkColumns{};
+    CPLErr BindBulkColumn(DmBulkColumn &oCol, int iParam);
+    CPLErr ExecuteBulkBatch();
+    void FreeBulkColumns();
 };
 
 class OGRDMLayer CPL_NON_FINAL : public OGRLayer
@@ -232,6 +335,9 @@ class OGRDMLayer CPL_NON_FINAL : public OGRLayer
     char *pszQueryStatement = nullptr;
 
     OGRDMStatement *poStatement;
+    /* Session taken from the datasource pool for this layer's reads */
+    OGRDMConn *poPoolConn = nullptr;
+    OGRDMConn *GetLayerConn();
     int nResultOffset = 0;
 
     char *pszFIDColumn = nullptr;
@@ -254,9 +360,12 @@ class OGRDMLayer CPL_NON_FINAL : public OGRLayer
     OGRFeature *RecordToFeature(OGRDMStatement *hResult,
                                 const int *panMapFieldNameToIndex,
                                 const int *panMapFieldNameToGeomIndex,
-                                int iRecord);
+                                int iRecord, char ***papszRows = nullptr);
 
+    int FetchNextRecord();
     OGRFeature *GetNextRawFeature();
+    virtual int GetNextArrowArray(struct ArrowArrayStream *,
+                                  struct ArrowArray *out_array) override;
     OGRDMStatement **stmt = nullptr;
     int col_count;
     ulength rows = 0;
@@ -264,6 +373,9 @@ class OGRDMLayer CPL_NON_FINAL : public OGRLayer
     char ***result;
     int isfetchall = 0;
 
+    /* Whether m_poAttrQuery has to be evaluated on the fetched rows */
+    bool m_bFilterMustBeClientSideEvaluated = true;
+
   public:
     OGRDMLayer();
     virtual ~OGRDMLayer();
@@ -306,9 +418,31 @@ class OGRDMTableLayer final : public OGRDMLayer
     int bUpdate = false;
 
     void BuildWhere();
+    CPLString BuildFilter(const swq_expr_node *poNode);
+    CPLString BuildFilterValue(const OGRFieldDefn *poFieldDefn,
+                               const swq_expr_node *poNode);
     CPLString BuildFields();
     void BuildFullQueryStatement();
 
+    /* Prepared SELECT of the feature with the FID nFID */
+    struct FIDQuery
+    {
+        OGRDMStatement *poStmt = nullptr;
+        CPLString osSQL{};
+        GIntBig nFID = 0;
+        int *panMapFieldNameToIndex = nullptr;
+        int *panMapFieldNameToGeomIndex = nullptr;
+    };
+    /* Exact results of GetFeatureCount() and GetExtent() without */
+    /* filters, kept until this connection writes to the table */
+    GIntBig m_nCachedFeatureCount = -1;
+    std::map<int, OGREnvelope> m_oMapCachedExtent{};
+    GIntBig GetCatalogFeatureCount();
+
+    FIDQuery m_oGetFeatureQuery{};
+    OGRDMStatement *RunFIDQuery(FIDQuery &oQuery, GIntBig nFID);
+    static void ResetFIDQuery(FIDQuery &oQuery);
+
     char *pszTableName = nullptr;
     char *pszSchemaName = nullptr;
     char *m_pszTableDescription = nullptr;
@@ -335,6 +469,9 @@ class OGRDMTableLayer final : public OGRDMLayer
     int bFirstInsertion = true;
 
     OGRErr CreateFeatureViaInsert(OGRFeature *poFeature);
+    OGRErr CreateFeatureViaBulkLoad(OGRFeature *poFeature);
+    int bUseBulkLoad = false;
+    int nBulkLoadFieldCount = -1;
 
     int bHasWarnedIncompatibleGeom = false;
     void CheckGeomTypeCompatibility(int iGeomField,
@@ -372,6 +509,10 @@ class OGRDMTableLayer final : public OGRDMLayer
 
     CPLErr CheckINI(int *checkini);
 
+  protected:
+    virtual int GetNextArrowArray(struct ArrowArrayStream *,
+                                  struct ArrowArray *out_array) override;
+
   public:
     OGRDMTableLayer(OGRDMDataSource *,
                     CPLString &osCurrentSchema,
@@ -386,6 +527,11 @@ class OGRDMTableLayer final : public OGRDMLayer
                                 int nGeomFieldCount);
 
     virtual OGRFeature *GetFeature(GIntBig nFeatureId) override;
+    void InvalidateStatistics()
+    {
+        m_nCachedFeatureCount = -1;
+        m_oMapCachedExtent.clear();
+    }
     virtual void ResetReading() override;
     virtual OGRFeature *GetNextFeature() override;
     virtual GIntBig GetFeatureCount(int) override;
@@ -402,6 +548,8 @@ class OGRDMTableLayer final : public OGRDMLayer
     virtual OGRErr ISetFeature(OGRFeature *poFeature) override;
     virtual OGRErr DeleteFeature(GIntBig nFID) override;
     virtual OGRErr ICreateFeature(OGRFeature *poFeature) override;
+    OGRErr FlushPendingInserts();
+    void DiscardPendingInserts();
 
     virtual OGRErr CreateField(const OGRFieldDefn *poField,
                                int bApproxOK = TRUE) override;
@@ -453,6 +601,10 @@ class OGRDMTableLayer final : public OGRDMLayer
     {
         bPreservePrecision = bFlag;
     }
+    void SetBulkLoad(int bFlag)
+    {
+        bUseBulkLoad = bFlag;
+    }
 
     void SetOverrideColumnTypes(const char *pszOverrideColumnTypes);
 
@@ -562,6 +714,11 @@ class OGRDMDataSource final : public OGRDataSource
 
     OGRDMConn *poSession = nullptr;
 
+    /* Extra sessions for concurrent readers, see AcquireConn() */
+    std::mutex oPoolMutex{};
+    std::vector<OGRDMConn *> apoIdleConns{};
+    int nPoolConnCount = 0;
+
     OGRErr DeleteLayer(int iLayer) override;
 
     // We maintain a list of known SRID to reduce the number of trips to
@@ -587,6 +744,14 @@ class OGRDMDataSource final : public OGRDataSource
   public:
     int bUseBinaryCursor = false;
     int bBinaryTimeFormatIsInt8 = false;
+    /* Rows fetched per round trip, 0 for adaptive sizing */
+    int nFetchArraySize = 0;
+    /* Rows sent per INSERT round trip */
+    int nInsertArraySize = FORCED_INSERT_NUM;
+    /* Fetch the next batch in the background while decoding one */
+    int bPrefetch = false;
+    /* Maximum number of sessions, including poSession */
+    int nPoolSize = 1;
     int bUseEscapeStringSyntax = false;
 
     bool m_bHasGeometryColumns = true;
@@ -609,6 +774,8 @@ class OGRDMDataSource final : public OGRDataSource
     {
         return poSession;
     }
+    OGRDMConn *AcquireConn();
+    void ReleaseConn(OGRDMConn *poConn);
 
     int FetchSRSId(const OGRSpatialReference *poSRS);
     OGRSpatialReference *FetchSRS(int nSRSId);
@@ -644,6 +811,11 @@ class OGRDMDataSource final : public OGRDataSource
                                  const char *pszDialect) override;
     virtual void ReleaseResultSet(OGRLayer *poLayer) override;
 
+    virtual OGRErr StartTransaction(int bForce = FALSE) override;
+    virtual OGRErr CommitTransaction() override;
+    virtual OGRErr RollbackTransaction() override;
+    OGRErr FlushPendingInserts();
+
     virtual const char *GetMetadataItem(const char *pszKey,
                                         const char *pszDomain) override;
 };
@@ -1267,9 +1439,17 @@ byte *lwgeom_to_wkb_buffer(const LWGEOM *geom,
 LWGEOM *lwgeom_from_gserialized(GSERIALIZED *geom);
 
 byte *dm_gser_to_wkb(GSERIALIZED *geom,
+                     size_t length,
                      ulint64 *size,
                      ulint *type);
 
+OGRGeometry *dm_gser_to_geometry(const GSERIALIZED *geom,
+                                 size_t length);
+
+size_t dm_gser_to_iso_wkb(const GSERIALIZED *geom,
+                          size_t length,
+                          byte *wkb);
+
 GSERIALIZED *gserialized_from_ewkb(const char *hexwkb,
                                    size_t *size);
 
@@ -128,3 +128,85 @@ int OGRDMConn::EstablishConn(const char* pszUseridIn,
 
     return TRUE;
 }
+
+/************************************************************************/
+/*                               Commit()                               */
+/*                                                                      */
+/*      Commit the work done since the last commit, unless a user       */
+/*      transaction is active, in which case CommitTransaction() will   */
+/*      do it.                                                          */
+/************************************************************************/
+
+int OGRDMConn::Commit()
+{
+    if (bInTransaction)
+        return TRUE;
+
+    DPIRETURN rt = dpi_commit(hCon);
+    if (!DSQL_SUCCEEDED(rt))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "failed to commit!");
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/************************************************************************/
+/*                            StartTransaction()                        */
+/************************************************************************/
+
+int OGRDMConn::StartTransaction()
+{
+    if (bInTransaction)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Transaction already established");
+        return FALSE;
+    }
+
+    /* Autocommit is off: make sure the transaction does not include */
+    /* work done before it. */
+    if (!Commit())
+        return FALSE;
+
+    bInTransaction = TRUE;
+    return TRUE;
+}
+
+/************************************************************************/
+/*                          CommitTransaction()                         */
+/************************************************************************/
+
+int OGRDMConn::CommitTransaction()
+{
+    if (!bInTransaction)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Transaction not established");
+        return FALSE;
+    }
+
+    bInTransaction = FALSE;
+    return Commit();
+}
+
+/************************************************************************/
+/*                         RollbackTransaction()                        */
+/************************************************************************/
+
+int OGRDMConn::RollbackTransaction()
+{
+    if (!bInTransaction)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Transaction not established");
+        return FALSE;
+    }
+
+    bInTransaction = FALSE;
+    DPIRETURN rt = dpi_rollback(hCon);
+    if (!DSQL_SUCCEEDED(rt))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "failed to rollback!");
+        return FALSE;
+    }
+    return TRUE;
+}
@@ -4,12 +4,13 @@
 #include "cpl_string.h"
 #include "cpl_hash_set.h"
 #include <cctype>
+#include <algorithm>
+#include <climits>
 #include <set>
 
 CPL_CVSID("$Id$")
 
 
-int ogr_DM_insertnum = FORCED_INSERT_NUM;
 /*
 OGRDMDataSource()
 */
@@ -19,6 +20,10 @@ OGRDMDataSource::OGRDMDataSource() = default;
 OGRDMDataSource::~OGRDMDataSource()
 
 {
+    /* A transaction that was not committed is discarded */
+    if (poSession != nullptr && poSession->bInTransaction)
+        RollbackTransaction();
+
     OGRDMDataSource::FlushCache(true);
 
     CPLFree(pszName);
@@ -37,6 +42,11 @@ OGRDMDataSource::~OGRDMDataSource()
     }
     CPLFree(panSRID);
     CPLFree(papoSRS);
+    for (OGRDMConn *poConn : apoIdleConns)
+        delete poConn;
+    if (static_cast<int>(apoIdleConns.size()) != nPoolConnCount)
+        CPLDebug("DM", "%d pooled sessions were not released",
+                 nPoolConnCount - static_cast<int>(apoIdleConns.size()));
     delete poSession;
 }
 
@@ -163,7 +173,7 @@ int OGRDMDataSource::Open(const char *pszNewName,
         {
             if (pszUserid[i] == ';')
             {
-                ogr_DM_insertnum = atoi(pszUserid + i + 1);
+                nInsertArraySize = std::max(1, atoi(pszUserid + i + 1));
                 pszUserid[i] = '\0';
                 break;
             }
@@ -191,6 +201,33 @@ int OGRDMDataSource::Open(const char *pszNewName,
         }
     }
 
+    bPrefetch = CPLTestBool(
+        CSLFetchNameValueDef(papszOpenOptionsIn, "PREFETCH",
+                             CPLGetConfigOption("DM_PREFETCH", "NO")));
+
+    /* Prefetching needs a session per layer being read */
+    const char *pszPoolSize = CSLFetchNameValueDef(
+        papszOpenOptionsIn, "POOL_SIZE",
+        CPLGetConfigOption("DM_POOL_SIZE", bPrefetch ? "UNLIMITED" : "1"));
+    if (EQUAL(pszPoolSize, "UNLIMITED"))
+        nPoolSize = INT_MAX;
+    else
+        nPoolSize = std::max(1, atoi(pszPoolSize));
+
+    const char *pszInsertArraySize =
+        CSLFetchNameValueDef(papszOpenOptionsIn, "INSERTNUM",
+                             CPLGetConfigOption("DM_INSERT_ARRAY_SIZE", nullptr));
+    if (pszInsertArraySize != nullptr)
+        nInsertArraySize = std::max(1, atoi(pszInsertArraySize));
+
+    const char *pszFetchArraySize = CSLFetchNameValueDef(
+        papszOpenOptionsIn, "FETCH_ARRAY_SIZE",
+        CPLGetConfigOption("DM_FETCH_ARRAY_SIZE", "AUTO"));
+    if (EQUAL(pszFetchArraySize, "AUTO"))
+        nFetchArraySize = 0;
+    else
+        nFetchArraySize = std::max(1, atoi(pszFetchArraySize));
+
     /* -------------------------------------------------------------------- */
     /*      Try to establish connection.                                    */
     /* -------------------------------------------------------------------- */
@@ -809,6 +846,9 @@ OGRLayer *OGRDMDataSource::ICreateLayer(const char *pszLayerName,
                                 pszGeomType, nSRSId, GeometryTypeFlags);
     poLayer->SetLaunderFlag(CPLFetchBool(papszOptions, "LAUNDER", true));
     poLayer->SetPrecisionFlag(CPLFetchBool(papszOptions, "PRECISION", true));
+    poLayer->SetBulkLoad(CPLFetchBool(
+        papszOptions, "BULK_LOAD",
+        CPLTestBool(CPLGetConfigOption("DM_BULK_LOAD", "YES"))));
     //poLayer->SetForcedSRSId(nForcedSRSId);
     poLayer->SetForcedGeometryTypeFlags(ForcedGeometryTypeFlags);
     poLayer->SetCreateSpatialIndex(bCreateSpatialIndex, pszSpatialIndexType);
@@ -854,10 +894,152 @@ int OGRDMDataSource::TestCapability(const char *pszCap)
         return TRUE;
     else if (EQUAL(pszCap, ODsCRandomLayerWrite))
         return TRUE;
+    else if (EQUAL(pszCap, ODsCTransactions))
+        return TRUE;
     else
         return FALSE;
 }
 
+/************************************************************************/
+/*                         FlushPendingInserts()                        */
+/************************************************************************/
+
+OGRErr OGRDMDataSource::FlushPendingInserts()
+
+{
+    OGRErr eErr = OGRERR_NONE;
+    for (int i = 0; i < nLayers; i++)
+    {
+        if (papoLayers[i]->FlushPendingInserts() != OGRERR_NONE)
+            eErr = OGRERR_FAILURE;
+    }
+    return eErr;
+}
+
+/************************************************************************/
+/*                            AcquireConn()                             */
+/*                                                                      */
+/*      Hand out a session of its own to a reader, so that layers       */
+/*      read from several threads do not serialize on poSession.        */
+/*      Idle sessions are reused, and new ones opened until the pool    */
+/*      holds POOL_SIZE - 1 of them.  Returns nullptr when the pool is  */
+/*      exhausted, in which case the caller uses poSession.             */
+/************************************************************************/
+
+OGRDMConn *OGRDMDataSource::AcquireConn()
+
+{
+    if (poSession == nullptr || nPoolSize <= 1)
+        return nullptr;
+
+    std::lock_guard<std::mutex> oLock(oPoolMutex);
+    if (!apoIdleConns.empty())
+    {
+        OGRDMConn *poConn = apoIdleConns.back();
+        apoIdleConns.pop_back();
+        return poConn;
+    }
+    if (nPoolConnCount >= nPoolSize - 1)
+        return nullptr;
+
+    OGRDMConn *poConn = OGRGetDMConnection(
+        poSession->pszUserid, poSession->pszPassword, poSession->pszDatabase);
+    if (poConn != nullptr)
+    {
+        nPoolConnCount++;
+        CPLDebug("DM", "Opened pooled session %d of %d", nPoolConnCount + 1,
+                 nPoolSize);
+    }
+    return poConn;
+}
+
+/************************************************************************/
+/*                            ReleaseConn()                             */
+/*                                                                      */
+/*      Give back a session obtained from AcquireConn().  All the       */
+/*      statements allocated on it must have been freed.                */
+/************************************************************************/
+
+void OGRDMDataSource::ReleaseConn(OGRDMConn *poConn)
+
+{
+    if (poConn == nullptr)
+        return;
+
+    std::lock_guard<std::mutex> oLock(oPoolMutex);
+    apoIdleConns.push_back(poConn);
+}
+
+/************************************************************************/
+/*                          StartTransaction()                          */
+/*                                                                      */
+/*      The connection runs with autocommit off, so this only stops     */
+/*      the driver from committing until CommitTransaction().           */
+/************************************************************************/
+
+OGRErr OGRDMDataSource::StartTransaction(CPL_UNUSED int bForce)
+
+{
+    if (poSession == nullptr)
+        return OGRERR_FAILURE;
+
+    if (poSession->bInTransaction)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Transaction already established");
+        return OGRERR_FAILURE;
+    }
+
+    if (FlushPendingInserts() != OGRERR_NONE)
+        return OGRERR_FAILURE;
+
+    return poSession->StartTransaction() ? OGRERR_NONE : OGRERR_FAILURE;
+}
+
+/************************************************************************/
+/*                         CommitTransaction()                          */
+/************************************************************************/
+
+OGRErr OGRDMDataSource::CommitTransaction()
+
+{
+    if (poSession == nullptr || !poSession->bInTransaction)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Transaction not established");
+        return OGRERR_FAILURE;
+    }
+
+    if (FlushPendingInserts() != OGRERR_NONE)
+    {
+        RollbackTransaction();
+        return OGRERR_FAILURE;
+    }
+
+    return poSession->CommitTransaction() ? OGRERR_NONE : OGRERR_FAILURE;
+}
+
+/************************************************************************/
+/*                        RollbackTransaction()                         */
+/************************************************************************/
+
+OGRErr OGRDMDataSource::RollbackTransaction()
+
+{
+    if (poSession == nullptr || !poSession->bInTransaction)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Transaction not established");
+        return OGRERR_FAILURE;
+    }
+
+    for (int i = 0; i < nLayers; i++)
+    {
+        papoLayers[i]->DiscardPendingInserts();
+        papoLayers[i]->InvalidateStatistics();
+    }
+
+    return poSession->RollbackTransaction() ? OGRERR_NONE : OGRERR_FAILURE;
+}
+
 /************************************************************************/
 /*                              GetLayer()                              */
 /************************************************************************/
@@ -1277,6 +1459,10 @@ OGRLayer *OGRDMDataSource::ExecuteSQL(const char *pszSQLCommand,
         return nullptr;
     }
 
+    /* Results may be read on a pooled session, which only sees what has */
+    /* been committed. */
+    FlushPendingInserts();
+
     /* -------------------------------------------------------------------- */
     /*      Execute the statement.                                          */
     /* -------------------------------------------------------------------- */
@@ -1288,6 +1474,8 @@ OGRLayer *OGRDMDataSource::ExecuteSQL(const char *pszSQLCommand,
     {
         /* For something that is not a select or a select without table, do not */
         /* run under transaction (CREATE DATABASE, VACUUM don't like transactions) */
+        for (int i = 0; i < nLayers; i++)
+            papoLayers[i]->InvalidateStatistics();
         CPLErr rt = oCommand.Execute(pszSQLCommand);
         if (rt == CE_None)
         {
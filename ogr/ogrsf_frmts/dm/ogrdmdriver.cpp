@@ -93,8 +93,18 @@ void RegisterOGRDM()
         "  <Option name='PASSWORD' type='string' description='Password'/>"
         "  <Option name='TABLES' type='string' description='Restricted set of "
         "tables to list (comma separated)'/>"
-        "  <Option name='INSERTNUM' type='boolean' description='Whether all "
-        "tables, including non-spatial ones, should be listed' default='NO'/>"
+        "  <Option name='INSERTNUM' type='int' description='Number of rows "
+        "sent per INSERT round trip' default='300'/>"
+        "  <Option name='FETCH_ARRAY_SIZE' type='string' description='Number "
+        "of rows fetched per round trip, or AUTO to size it from the columns "
+        "within DM_FETCH_MEMORY_LIMIT bytes' default='AUTO'/>"
+        "  <Option name='PREFETCH' type='boolean' description='Whether to "
+        "fetch the next batch of rows on a worker thread, using a dedicated "
+        "connection, while the current one is processed' default='NO'/>"
+        "  <Option name='POOL_SIZE' type='string' description='Maximum number "
+        "of sessions opened to the server, so that layers can be read "
+        "concurrently, or UNLIMITED. Defaults to UNLIMITED when PREFETCH=YES' "
+        "default='1'/>"
         "</OpenOptionList>");
 
     poDriver->SetMetadataItem(GDAL_DMD_CREATIONOPTIONLIST,
@@ -129,6 +139,11 @@ void RegisterOGRDM()
         "default='NO'/>"
         "  <Option name='DESCRIPTION' type='string' description='Description "
         "string to put in the all_tab_comments system table'/>"
+        "  <Option name='BULK_LOAD' type='boolean' description='Whether to "
+        "insert features with large array-bound batches committed once at "
+        "the end of the load, like COPY. Rows rejected by the server are "
+        "then reported when their batch is sent, not by the CreateFeature() "
+        "call that passed them' default='YES'/>"
         "</LayerCreationOptionList>");
 
     poDriver->SetMetadataItem(GDAL_DMD_CREATIONFIELDDATATYPES,
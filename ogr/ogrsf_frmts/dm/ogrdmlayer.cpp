@@ -1,6 +1,7 @@
 #include "ogr_dm.h"
 #include "cpl_conv.h"
 #include "ogr_p.h"
+#include "ograrrowarrayhelper.h"
 
 CPL_CVSID("$Id$")
 
@@ -38,6 +39,8 @@ OGRDMLayer::~OGRDMLayer()
 
     if (poStatement != nullptr)
         delete poStatement;
+    if (poPoolConn != nullptr)
+        poDS->ReleaseConn(poPoolConn);
 
     if (poFeatureDefn != nullptr)
         poFeatureDefn->Release();
@@ -63,15 +66,16 @@ void OGRDMLayer::ResetReading()
 /************************************************************************/
 /*                          RecordToFeature()                           */
 /*                                                                      */
-/*      Convert the indicated record of the current result set into     */
-/*      a feature.                                                      */
+/*      Convert the indicated record of the current result set, or      */
+/*      of papszRows when given, into a feature.                        */
 /************************************************************************/
 
 OGRFeature *OGRDMLayer::RecordToFeature(OGRDMStatement *hStmt,
                                         const int *panMapFieldNameToIndex,
                                         const int *panMapFieldNameToGeomIndex,
-                                        int iRecord)
+                                        int iRecord, char ***papszRows)
 {
+    char ***papszResult = papszRows ? papszRows : result;
     OGRFeature *poFeature = new OGRFeature(poFeatureDefn);
     sdint2 rs_deci = 0;
     ulength rs_size = 0;
@@ -89,19 +93,26 @@ OGRFeature *OGRDMLayer::RecordToFeature(OGRDMStatement *hStmt,
 
     for (int iField = 0; iField < hStmt->GetColCount(); iField++)
     {
-        sdbyte pszFieldName[200];
-        rt = dpi_desc_column(*hStmt->GetStatement(), (sdint2)iField + 1,
-                             pszFieldName, name_max, &rs_name_len, &rs_type,
-                             &rs_size, &rs_deci, &rs_null);
-        if (!DSQL_SUCCEEDED(rt))
+        /* Prefer the cached names: the statement handle may be busy */
+        /* prefetching the next batch. */
+        sdbyte szFieldName[200];
+        const char *pszFieldName = hStmt->GetColName(iField);
+        if (pszFieldName == nullptr)
         {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "Error!");
-            return NULL;
+            rt = dpi_desc_column(*hStmt->GetStatement(), (sdint2)iField + 1,
+                                 szFieldName, name_max, &rs_name_len, &rs_type,
+                                 &rs_size, &rs_deci, &rs_null);
+            if (!DSQL_SUCCEEDED(rt))
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Error!");
+                return NULL;
+            }
+            pszFieldName = (const char *)szFieldName;
         }
-        char *pabyData = result[iField][iRecord];
+        char *pabyData = papszResult[iField][iRecord];
         if (pszFIDColumn != nullptr &&
-            EQUAL((const char *)pszFieldName, pszFIDColumn))
+            EQUAL(pszFieldName, pszFIDColumn))
         {
             if (pabyData)
                 poFeature->SetFID(CPLAtoGIntBig(pabyData));
@@ -124,23 +135,20 @@ OGRFeature *OGRDMLayer::RecordToFeature(OGRDMStatement *hStmt,
             (poGeomFieldDefn->eDMGeoType == GEOM_TYPE_GEOMETRY ||
              poGeomFieldDefn->eDMGeoType == GEOM_TYPE_GEOGRAPHY))
         {
-            if (STARTS_WITH_CI((const char *)pszFieldName,
-                               "DMGEO2.ST_AsBinary"))
+            if (STARTS_WITH_CI(pszFieldName, "DMGEO2.ST_AsBinary"))
             {
                 CPLError(CE_Failure, CPLE_AppDefined,
                          "We cannot handle binary type!");
                 return NULL;
             }
             else if (!poDS->bUseBinaryCursor &&
-                     STARTS_WITH_CI((const char *)pszFieldName,
-                                    "DMGEO2.ST_AsEWKB"))
+                     STARTS_WITH_CI(pszFieldName, "DMGEO2.ST_AsEWKB"))
             {
                 CPLError(CE_Failure, CPLE_AppDefined,
                          "We cannot handle binary type!");
                 return NULL;
             }
-            else if (STARTS_WITH_CI((const char *)pszFieldName,
-                                    "DMGEO2.ST_ASTEXT"))
+            else if (STARTS_WITH_CI(pszFieldName, "DMGEO2.ST_ASTEXT"))
             {
                 /* Handle WKT */
                 const char *pszWKT = pabyData;
@@ -169,16 +177,25 @@ OGRFeature *OGRDMLayer::RecordToFeature(OGRDMStatement *hStmt,
                     poGeomFieldDefn->eDMGeoType == GEOM_TYPE_GEOGRAPHY)
                 {
                     OGRGeometry *poGeometry = nullptr;
-                    pabyData = result[iField][iRecord];
+                    pabyData = papszResult[iField][iRecord];
                     if (pabyData)
                     {
-                        ulint64 length;
-                        byte *pabyVal = dm_gser_to_wkb((GSERIALIZED *)pabyData,
-                                                       &length, nullptr);
-                        OGRGeometryFactory::createFromWkb(pabyVal, nullptr,
-                                                          &poGeometry, length,
-                                                          wkbVariantOldOgc);
-                        CPLFree(pabyVal);
+                        const size_t nDataLength =
+                            hStmt->GetValueLength(iField, iRecord);
+                        poGeometry = dm_gser_to_geometry(
+                            (const GSERIALIZED *)pabyData, nDataLength);
+                        if (poGeometry == nullptr)
+                        {
+                            ulint64 length = 0;
+                            byte *pabyVal =
+                                dm_gser_to_wkb((GSERIALIZED *)pabyData,
+                                               nDataLength, &length, nullptr);
+                            if (pabyVal != nullptr)
+                                OGRGeometryFactory::createFromWkb(
+                                    pabyVal, nullptr, &poGeometry, length,
+                                    wkbVariantOldOgc);
+                            CPLFree(pabyVal);
+                        }
                         if (poGeometry != nullptr)
                         {
                             poGeometry->assignSpatialReference(
@@ -204,7 +221,7 @@ OGRFeature *OGRDMLayer::RecordToFeature(OGRDMStatement *hStmt,
 
         if (iOGRField < 0)
             continue;
-        pabyData = result[iField][iRecord];
+        pabyData = papszResult[iField][iRecord];
         if (!pabyData)
         {
             poFeature->SetFieldNull(iOGRField);
@@ -306,19 +323,44 @@ void OGRDMLayer::CreateMapFromFieldNameToIndex(OGRDMStatement *hStmt,
 
 void OGRDMLayer::SetInitialQuery()
 {
-    OGRDMConn *hDMConn = poDS->GetDMConn();
+    CPLAssert(pszQueryStatement != nullptr);
+
+    /* -------------------------------------------------------------------- */
+    /*      The query runs on the layer's pooled session when there is      */
+    /*      one: other layers can be read at the same time, and the         */
+    /*      worker thread of prefetch mode never shares a handle with       */
+    /*      the rest of the driver.                                         */
+    /* -------------------------------------------------------------------- */
+    OGRDMConn *hDMConn = GetLayerConn();
+
+    /* Same query as the previous pass: run it again with the fetch */
+    /* buffers already allocated and bound. */
+    if (poStatement != nullptr && poStatement->GetConn() == hDMConn &&
+        poStatement->pszCommandText != nullptr &&
+        strcmp(poStatement->pszCommandText, pszQueryStatement) == 0 &&
+        poStatement->Reexecute() == CE_None)
+    {
+        nResultOffset = 0;
+        return;
+    }
+
+    delete poStatement;
     poStatement = new OGRDMStatement(hDMConn);
     CPLString osCommand;
 
-    CPLAssert(pszQueryStatement != nullptr);
     osCommand.Printf("%s", pszQueryStatement);
-    CPLErr rt = poStatement->Excute_for_fetchmany(osCommand.c_str());
+    CPLErr rt = poStatement->Excute_for_fetchmany(osCommand.c_str(),
+                                                  poDS->nFetchArraySize);
 
-    if (!DSQL_SUCCEEDED(rt))
+    if (rt != CE_None)
     {
         CPLError(CE_Failure, CPLE_AppDefined,
                  "DM:Execute command failure!");
     }
+    else if (poDS->bPrefetch && hDMConn == poPoolConn)
+    {
+        poStatement->EnablePrefetch();
+    }
 
     CreateMapFromFieldNameToIndex(poStatement, poFeatureDefn,
                                   m_panMapFieldNameToIndex,
@@ -328,51 +370,445 @@ void OGRDMLayer::SetInitialQuery()
 }
 
 /************************************************************************/
-/*                         GetNextRawFeature()                          */
+/*                            GetLayerConn()                            */
+/*                                                                      */
+/*      Session to run this layer's read queries on.  A pooled          */
+/*      session does not see the uncommitted changes of a user          */
+/*      transaction, so the main one is used while a transaction is     */
+/*      active.                                                         */
 /************************************************************************/
 
-OGRFeature *OGRDMLayer::GetNextRawFeature()
+OGRDMConn *OGRDMLayer::GetLayerConn()
+{
+    OGRDMConn *hDMConn = poDS->GetDMConn();
+    if (hDMConn->bInTransaction)
+        return hDMConn;
+
+    if (poPoolConn == nullptr)
+        poPoolConn = poDS->AcquireConn();
+    return poPoolConn != nullptr ? poPoolConn : hDMConn;
+}
+
+/************************************************************************/
+/*                          FetchNextRecord()                           */
+/*                                                                      */
+/*      Make sure the current fetch batch holds an unread record,       */
+/*      fetching the next batch if needed, and return its index in      */
+/*      the batch, or -1 at the end of the result set.  The record is   */
+/*      only consumed by the caller decrementing rows.                  */
+/************************************************************************/
+
+int OGRDMLayer::FetchNextRecord()
 
 {
-    OGRFeature *poFeature = nullptr;
     if (iNextShapeId == 0)
     {
         SetInitialQuery();
+        rows = 0;
         result = poStatement->Fetchmany(&rows);
         total_rows = rows;
-        if (rows < fetchnum)
+        isfetchall = poStatement->IsLastBatch();
+    }
+    else if (rows == 0 && isfetchall == 0)
+    {
+        rows = 0;
+        result = poStatement->Fetchmany(&rows);
+        total_rows = rows;
+        if (poStatement->IsLastBatch())
             isfetchall = 1;
     }
-    if (rows > 0)
+
+    if (rows == 0 || result == nullptr)
+        return -1;
+
+    return (int)(total_rows - rows);
+}
+
+/************************************************************************/
+/*                         GetNextRawFeature()                          */
+/************************************************************************/
+
+OGRFeature *OGRDMLayer::GetNextRawFeature()
+
+{
+    OGRFeature *poFeature = nullptr;
+    const int iRecord = FetchNextRecord();
+    if (iRecord >= 0)
     {
         poFeature = RecordToFeature(poStatement, m_panMapFieldNameToIndex,
-                                    m_panMapFieldNameToGeomIndex,
-                                    (int)(total_rows - rows));
+                                    m_panMapFieldNameToGeomIndex, iRecord);
         rows--;
     }
-    else if (isfetchall == 0)
+    nResultOffset++;
+    iNextShapeId++;
+    return poFeature;
+}
+
+/************************************************************************/
+/*                         GetNextArrowArray()                          */
+/*                                                                      */
+/*      Fill the Arrow arrays straight from the fetch buffers of the    */
+/*      statement, without instantiating OGRFeature objects.            */
+/*      Geometries are converted from GSERIALIZED to ISO WKB directly.  */
+/************************************************************************/
+
+int OGRDMLayer::GetNextArrowArray(struct ArrowArrayStream *stream,
+                                  struct ArrowArray *out_array)
+{
+    if (!m_poSharedArrowArrayStreamPrivateData->m_anQueriedFIDs.empty() ||
+        CPLTestBool(CPLGetConfigOption("OGR_DM_STREAM_BASE_IMPL", "NO")))
+    {
+        return OGRLayer::GetNextArrowArray(stream, out_array);
+    }
+
+    /* The spatial filter is evaluated by the server on GEOMETRY and */
+    /* GEOGRAPHY columns only, others need OGRFeature objects. */
+    if (m_poFilterGeom != nullptr && poFeatureDefn->GetGeomFieldCount() > 0)
     {
-        result = poStatement->Fetchmany(&rows);
-        total_rows = rows;
-        if (rows < fetchnum)
-            isfetchall = 1;
-        if (rows == 0)
-            poFeature = nullptr;
-        else
+        const OGRDMGeomFieldDefn *poGeomFieldDefn =
+            poFeatureDefn->GetGeomFieldDefn(m_iGeomFieldFilter);
+        if (poGeomFieldDefn->eDMGeoType != GEOM_TYPE_GEOMETRY &&
+            poGeomFieldDefn->eDMGeoType != GEOM_TYPE_GEOGRAPHY)
         {
-            poFeature = RecordToFeature(poStatement, m_panMapFieldNameToIndex,
-                                        m_panMapFieldNameToGeomIndex,
-                                        (int)(total_rows - rows));
-            rows--;
+            return OGRLayer::GetNextArrowArray(stream, out_array);
         }
     }
-    else
+
+    auto poPrivate = static_cast<ArrowArrayStreamPrivateDataSharedDataWrapper *>(
+        stream->private_data);
+
+begin:
+    memset(out_array, 0, sizeof(*out_array));
+    if (poPrivate->poShared->m_bEOF)
+        return 0;
+
+    int iRecord = FetchNextRecord();
+    if (iRecord < 0)
     {
-        poFeature = nullptr;
+        poPrivate->poShared->m_bEOF = true;
+        iNextShapeId++;
+        return 0;
     }
-    nResultOffset++;
-    iNextShapeId++;
-    return poFeature;
+
+    /* -------------------------------------------------------------------- */
+    /*      Work out once per batch what each column of the result set      */
+    /*      maps to, instead of describing it again for every record.       */
+    /* -------------------------------------------------------------------- */
+    enum
+    {
+        COL_IGNORED,
+        COL_FIELD,
+        COL_GSERIALIZED,
+        COL_WKT
+    };
+    const int nColumns = poStatement->GetColCount();
+    std::vector<int> anColKind(nColumns, COL_IGNORED);
+    std::vector<int> anColIndex(nColumns, -1);
+    int iFIDCol = -1;
+
+    OGRArrowArrayHelper sHelper(poDS, poFeatureDefn,
+                                m_aosArrowArrayStreamOptions, out_array);
+    if (out_array->release == nullptr)
+        return ENOMEM;
+
+    for (int iCol = 0; iCol < nColumns; iCol++)
+    {
+        const char *pszColName = poStatement->GetColName(iCol);
+        if (pszColName == nullptr)
+        {
+            CPLError(CE_Failure, CPLE_AppDefined, "failed to get col_desc");
+            sHelper.ClearArray();
+            return EIO;
+        }
+
+        if (pszFIDColumn != nullptr && EQUAL(pszColName, pszFIDColumn))
+            iFIDCol = iCol;
+
+        const int iOGRGeomField = m_panMapFieldNameToGeomIndex
+                                      ? m_panMapFieldNameToGeomIndex[iCol]
+                                      : -1;
+        if (iOGRGeomField >= 0)
+        {
+            const OGRDMGeomFieldDefn *poGeomFieldDefn =
+                poFeatureDefn->GetGeomFieldDefn(iOGRGeomField);
+            if (sHelper.m_mapOGRGeomFieldToArrowField[iOGRGeomField] < 0 ||
+                (poGeomFieldDefn->eDMGeoType != GEOM_TYPE_GEOMETRY &&
+                 poGeomFieldDefn->eDMGeoType != GEOM_TYPE_GEOGRAPHY))
+                continue;
+
+            if (STARTS_WITH_CI(pszColName, "DMGEO2.ST_AsBinary") ||
+                (!poDS->bUseBinaryCursor &&
+                 STARTS_WITH_CI(pszColName, "DMGEO2.ST_AsEWKB")))
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "We cannot handle binary type!");
+                sHelper.ClearArray();
+                return EIO;
+            }
+            anColKind[iCol] =
+                STARTS_WITH_CI(pszColName, "DMGEO2.ST_ASTEXT") ? COL_WKT
+                                                               : COL_GSERIALIZED;
+            anColIndex[iCol] = iOGRGeomField;
+        }
+        else if (m_panMapFieldNameToIndex &&
+                 m_panMapFieldNameToIndex[iCol] >= 0 &&
+                 sHelper.m_mapOGRFieldToArrowField
+                         [m_panMapFieldNameToIndex[iCol]] >= 0)
+        {
+            anColKind[iCol] = COL_FIELD;
+            anColIndex[iCol] = m_panMapFieldNameToIndex[iCol];
+        }
+    }
+
+    std::vector<bool> abSetFields(sHelper.m_nFieldCount);
+    std::vector<bool> abSetGeomFields(sHelper.m_nGeomFieldCount);
+    struct tm brokenDown;
+    memset(&brokenDown, 0, sizeof(brokenDown));
+
+    const uint32_t nMemLimit = OGRArrowArrayHelper::GetMemLimit();
+    int iFeat = 0;
+    while (iFeat < sHelper.m_nMaxBatchSize)
+    {
+        if (iFeat > 0)
+        {
+            iRecord = FetchNextRecord();
+            if (iRecord < 0)
+            {
+                poPrivate->poShared->m_bEOF = true;
+                iNextShapeId++;
+                break;
+            }
+        }
+
+        abSetFields.assign(abSetFields.size(), false);
+        abSetGeomFields.assign(abSetGeomFields.size(), false);
+        GIntBig nFID = iNextShapeId;
+
+        for (int iCol = 0; iCol < nColumns; iCol++)
+        {
+            const char *pszValue = result[iCol][iRecord];
+
+            if (iCol == iFIDCol && pszValue != nullptr)
+                nFID = CPLAtoGIntBig(pszValue);
+
+            if (anColKind[iCol] == COL_IGNORED || pszValue == nullptr)
+                continue;
+
+            /* ---------------------------------------------------------------- */
+            /*      Geometry columns.                                           */
+            /* ---------------------------------------------------------------- */
+            if (anColKind[iCol] != COL_FIELD)
+            {
+                const int iArrowField =
+                    sHelper.m_mapOGRGeomFieldToArrowField[anColIndex[iCol]];
+                OGRGeometry *poGeometry = nullptr;
+                size_t nWKBSize = 0;
+                size_t nValueLength = 0;
+
+                if (anColKind[iCol] == COL_GSERIALIZED)
+                {
+                    nValueLength =
+                        poStatement->GetValueLength(iCol, iRecord);
+                    nWKBSize = dm_gser_to_iso_wkb(
+                        (const GSERIALIZED *)pszValue, nValueLength, nullptr);
+                    if (nWKBSize == 0)
+                        poGeometry = dm_gser_to_geometry(
+                            (const GSERIALIZED *)pszValue, nValueLength);
+                }
+                else
+                {
+                    OGRGeometryFactory::createFromWkt(pszValue, nullptr,
+                                                      &poGeometry);
+                }
+                if (poGeometry != nullptr)
+                    nWKBSize = poGeometry->WkbSize();
+                else if (nWKBSize == 0)
+                    continue;
+
+                if (iFeat > 0)
+                {
+                    auto psArray = out_array->children[iArrowField];
+                    auto panOffsets = static_cast<int32_t *>(
+                        const_cast<void *>(psArray->buffers[1]));
+                    const uint32_t nCurLength =
+                        static_cast<uint32_t>(panOffsets[iFeat]);
+                    if (nWKBSize <= nMemLimit &&
+                        nWKBSize > nMemLimit - nCurLength)
+                    {
+                        delete poGeometry;
+                        goto after_loop;
+                    }
+                }
+
+                GByte *pabyOut = sHelper.GetPtrForStringOrBinary(
+                    iArrowField, iFeat, nWKBSize);
+                if (pabyOut == nullptr)
+                {
+                    delete poGeometry;
+                    sHelper.ClearArray();
+                    return ENOMEM;
+                }
+                if (poGeometry != nullptr)
+                {
+                    poGeometry->exportToWkb(wkbNDR, pabyOut, wkbVariantIso);
+                    delete poGeometry;
+                }
+                else
+                {
+                    dm_gser_to_iso_wkb((const GSERIALIZED *)pszValue,
+                                       nValueLength, pabyOut);
+                }
+                abSetGeomFields[anColIndex[iCol]] = true;
+                continue;
+            }
+
+            /* ---------------------------------------------------------------- */
+            /*      Regular fields, transferred as text by the statement.       */
+            /* ---------------------------------------------------------------- */
+            const int iOGRField = anColIndex[iCol];
+            const int iArrowField = sHelper.m_mapOGRFieldToArrowField[iOGRField];
+            auto psArray = out_array->children[iArrowField];
+            const OGRFieldDefn *poFieldDefn =
+                poFeatureDefn->GetFieldDefnUnsafe(iOGRField);
+
+            switch (poFieldDefn->GetType())
+            {
+                case OFTInteger:
+                    if (poFieldDefn->GetSubType() == OFSTBoolean)
+                    {
+                        if ((pszValue[0] == '1' && pszValue[1] == '\0') ||
+                            EQUAL(pszValue, "true"))
+                            sHelper.SetBoolOn(psArray, iFeat);
+                    }
+                    else if (poFieldDefn->GetSubType() == OFSTInt16)
+                        sHelper.SetInt16(psArray, iFeat,
+                                         static_cast<int16_t>(atoi(pszValue)));
+                    else
+                        sHelper.SetInt32(psArray, iFeat, atoi(pszValue));
+                    break;
+
+                case OFTInteger64:
+                    sHelper.SetInt64(psArray, iFeat, CPLAtoGIntBig(pszValue));
+                    break;
+
+                case OFTReal:
+                    if (poFieldDefn->GetSubType() == OFSTFloat32)
+                        sHelper.SetFloat(psArray, iFeat,
+                                         static_cast<float>(CPLAtof(pszValue)));
+                    else
+                        sHelper.SetDouble(psArray, iFeat, CPLAtof(pszValue));
+                    break;
+
+                case OFTString:
+                {
+                    const size_t nLen = strlen(pszValue);
+                    if (iFeat > 0)
+                    {
+                        auto panOffsets = static_cast<int32_t *>(
+                            const_cast<void *>(psArray->buffers[1]));
+                        const uint32_t nCurLength =
+                            static_cast<uint32_t>(panOffsets[iFeat]);
+                        if (nLen <= nMemLimit && nLen > nMemLimit - nCurLength)
+                        {
+                            goto after_loop;
+                        }
+                    }
+                    GByte *pabyOut =
+                        sHelper.GetPtrForStringOrBinary(iArrowField, iFeat, nLen);
+                    if (pabyOut == nullptr)
+                    {
+                        sHelper.ClearArray();
+                        return ENOMEM;
+                    }
+                    memcpy(pabyOut, pszValue, nLen);
+                    break;
+                }
+
+                case OFTDate:
+                case OFTTime:
+                case OFTDateTime:
+                {
+                    OGRField sField;
+                    if (!OGRParseDate(pszValue, &sField, 0))
+                        continue;
+                    if (poFieldDefn->GetType() == OFTDate)
+                        sHelper.SetDate(psArray, iFeat, brokenDown, sField);
+                    else if (poFieldDefn->GetType() == OFTDateTime)
+                        sHelper.SetDateTime(psArray, iFeat, brokenDown,
+                                            sHelper.m_anTZFlags[iOGRField],
+                                            sField);
+                    else
+                        sHelper.SetInt32(
+                            psArray, iFeat,
+                            sField.Date.Hour * 3600000 +
+                                sField.Date.Minute * 60000 +
+                                static_cast<int>(sField.Date.Second * 1000 +
+                                                 0.5));
+                    break;
+                }
+
+                default:
+                    /* Same as OGRFeature::SetField(int, const char*) */
+                    continue;
+            }
+            abSetFields[iOGRField] = true;
+        }
+
+        /* -------------------------------------------------------------------- */
+        /*      Mark fields without a value as null.                            */
+        /* -------------------------------------------------------------------- */
+        for (int i = 0; i < sHelper.m_nFieldCount; i++)
+        {
+            const int iArrowField = sHelper.m_mapOGRFieldToArrowField[i];
+            if (abSetFields[i] || iArrowField < 0)
+                continue;
+            if (sHelper.m_abNullableFields[i])
+                sHelper.SetNull(iArrowField, iFeat);
+            else if (out_array->children[iArrowField]->n_buffers == 3)
+                sHelper.SetEmptyStringOrBinary(
+                    out_array->children[iArrowField], iFeat);
+        }
+        for (int i = 0; i < sHelper.m_nGeomFieldCount; i++)
+        {
+            const int iArrowField = sHelper.m_mapOGRGeomFieldToArrowField[i];
+            if (!abSetGeomFields[i] && iArrowField >= 0)
+                sHelper.SetNull(iArrowField, iFeat);
+        }
+
+        if (sHelper.m_panFIDValues)
+            sHelper.m_panFIDValues[iFeat] = nFID;
+
+        rows--;
+        iFeat++;
+        nResultOffset++;
+        iNextShapeId++;
+        m_nFeaturesRead++;
+    }
+after_loop:
+    sHelper.Shrink(iFeat);
+
+    if (out_array->length != 0 && m_poAttrQuery != nullptr &&
+        m_bFilterMustBeClientSideEvaluated)
+    {
+        struct ArrowSchema schema;
+        stream->get_schema(stream, &schema);
+        CPLAssert(schema.release != nullptr);
+        CPLAssert(schema.n_children == out_array->n_children);
+        PostFilterArrowArray(&schema, out_array, nullptr);
+        schema.release(&schema);
+    }
+
+    if (out_array->length == 0)
+    {
+        if (out_array->release)
+            out_array->release(out_array);
+        memset(out_array, 0, sizeof(*out_array));
+
+        if (m_poAttrQuery != nullptr && m_bFilterMustBeClientSideEvaluated)
+            goto begin;
+    }
+
+    return 0;
 }
 
 /************************************************************************/
@@ -573,16 +1009,21 @@ OGRErr OGRDMLayer::RunGetExtentRequest(OGREnvelope *psExtent,
     if (psExtent == nullptr)
         return OGRERR_FAILURE;
 
-    OGRDMConn *hDMConn = poDS->GetDMConn();
-    OGRDMStatement *hStmt = new OGRDMStatement(hDMConn);
-    CPLErr eErr = hStmt->Execute(osCommand);
-    if (!hStmt || eErr)
+    OGRDMConn *hDMConn = GetLayerConn();
+    OGRDMStatement oStmt(hDMConn);
+    CPLErr eErr = oStmt.Execute(osCommand);
+    char **papszRow = eErr == CE_None ? oStmt.SimpleFetchRow() : nullptr;
+    if (papszRow == nullptr || papszRow[0] == nullptr)
     {
-        CPLDebug("DM", "Unable to get extent by DMGEO2");
+        if (bErrorAsDebug)
+            CPLDebug("DM", "Unable to get extent by DMGEO2");
+        else
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "Unable to get extent by DMGEO2");
         return OGRERR_FAILURE;
     }
 
-    char *pszBox = hStmt->SimpleFetchRow()[0];
+    char *pszBox = papszRow[0];
     char *ptr, *ptrEndParenthesis;
     char szVals[64 * 6 + 6];
 
@@ -601,6 +1042,13 @@ OGRErr OGRDMLayer::RunGetExtentRequest(OGREnvelope *psExtent,
     szVals[ptrEndParenthesis - ptr] = '\0';
 
     char **papszTokens = CSLTokenizeString2(szVals, " ,", CSLT_HONOURSTRINGS);
+    if (CSLCount(papszTokens) < 4)
+    {
+        CPLError(CE_Failure, CPLE_IllegalArg, "Bad extent representation: '%s'",
+                 pszBox);
+        CSLDestroy(papszTokens);
+        return OGRERR_FAILURE;
+    }
 
     psExtent->MinX = CPLAtof(papszTokens[0]);
     psExtent->MinY = CPLAtof(papszTokens[1]);
@@ -608,7 +1056,6 @@ OGRErr OGRDMLayer::RunGetExtentRequest(OGREnvelope *psExtent,
     psExtent->MaxY = CPLAtof(papszTokens[3]);
 
     CSLDestroy(papszTokens);
-    hStmt->Clean();
 
     return OGRERR_NONE;
 }
@@ -142,7 +142,7 @@ GIntBig OGRDMResultLayer::GetFeatureCount(int bForce)
     if (TestCapability(OLCFastFeatureCount) == FALSE)
         return OGRDMLayer::GetFeatureCount(bForce);
 
-    OGRDMConn *hDMConn = poDS->GetDMConn();
+    OGRDMConn *hDMConn = GetLayerConn();
     char **hResult = nullptr;
     OGRDMStatement oCommand(hDMConn);
     CPLString osCommand;
@@ -206,6 +206,9 @@ int OGRDMResultLayer::TestCapability(const char *pszCap)
     else if (EQUAL(pszCap, OLCStringsAsUTF8))
         return TRUE;
 
+    else if (EQUAL(pszCap, OLCFastGetArrowStream))
+        return TRUE;
+
     else
         return FALSE;
 }
@@ -310,7 +313,7 @@ void OGRDMResultLayer::ResolveSRID(const OGRDMGeomFieldDefn *poGFldDefn)
     /* We have to get the SRID of the geometry column, so to be able */
     /* to do spatial filtering */
     int nSRSId = UNDETERMINED_SRID;
-    OGRDMConn *hDMConn = poDS->GetDMConn();
+    OGRDMConn *hDMConn = GetLayerConn();
     OGRDMStatement oCommand(hDMConn);
 
     if (nSRSId == UNDETERMINED_SRID &&
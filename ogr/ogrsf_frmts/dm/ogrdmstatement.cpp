@@ -1,6 +1,9 @@
 #include "ogr_dm.h"
 #include "cpl_conv.h"
 #include <ogr_p.h>
+#include <algorithm>
+#include <chrono>
+#include <functional>
 
 CPL_CVSID("$Id$")
 
@@ -37,27 +40,11 @@ void OGRDMStatement::Clean()
 
 {
     DPIRETURN rt;
-    if (insert_num > 0)
-    {
-        rt = dpi_set_stmt_attr(hStatement, DSQL_ATTR_PARAMSET_SIZE,
-                               (void *)insert_num, 0);
-        rt = dpi_exec(hStatement);
-        if (!DSQL_SUCCEEDED(rt))
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "failed to exectue");
-            return;
-        }
-        insert_num = 0;
-        for (int iparam = 0; iparam < geonum; iparam++)
-        {
-            for (int num = 0; num < insert_num; num++)
-            {
-                CPLFree(insert_geovalues[iparam][num]);
-            }
-        }
-    }
-    rt = dpi_commit((poConn->hCon));
+    WaitPrefetch();
+    if (insert_num > 0 || bBulkUncommitted)
+        FlushInserts();
+    FreeBulkColumns();
+    poConn->Commit();
     if (pszCommandText)
         CPLFree(pszCommandText);
     pszCommandText = nullptr;
@@ -106,63 +93,32 @@ void OGRDMStatement::Clean()
     {
         if (results)
         {
-            for (int col = 0; results[col] != nullptr; col++)
+            FreeFetchBuffers();
+            if (bPrefetchEnabled)
             {
-
-                if (object_index[col])
-                {
-                    for (int row = 0; row < fetchnum; row++)
-                    {
-                        if (results[col][row])
-                            CPLFree(results[col][row]);
-                        rt = dpi_free_obj(objs[col][row]);
-                        if (!DSQL_SUCCEEDED(rt))
-                        {
-                            CPLError(CE_Failure, CPLE_AppDefined,
-                                     "failed to free obj");
-                        }
-                        dpi_free_obj_desc(objdescs[col][row]);
-                        if (!DSQL_SUCCEEDED(rt))
-                        {
-                            CPLError(CE_Failure, CPLE_AppDefined,
-                                     "failed to free objdesc");
-                        }
-                    }
-                }
-                else if (lob_index[col])
+                SwapFetchBuffers();
+                FreeFetchBuffers();
+            }
+            for (int col = 0; col < nRawColumnCount; col++)
+            {
+                if (object_index[col] && objdescs[col] && objdescs[col][0])
                 {
-                    for (int row = 0; row < fetchnum; row++)
+                    rt = dpi_free_obj_desc(objdescs[col][0]);
+                    if (!DSQL_SUCCEEDED(rt))
                     {
-                        if (results[col][row])
-                            CPLFree(results[col][row]);
-                        rt = dpi_free_lob_locator(lobs[col][row]);
-                        if (!DSQL_SUCCEEDED(rt))
-                        {
-                            CPLError(CE_Failure, CPLE_AppDefined,
-                                     "failed to free lob");
-                        }
+                        CPLError(CE_Failure, CPLE_AppDefined,
+                                 "failed to free objdesc");
                     }
                 }
-                else
-                {
-                    if (results[col][0])
-                        CPLFree(results[col][0]);
-                }
-                CPLFree(results[col]);
-                CPLFree(objs[col]);
                 CPLFree(objdescs[col]);
-                CPLFree(lobs[col]);
-                CPLFree(blob_lens[col]);
-                if (papszCurImages && papszCurImages[col])
-                    CPLFree(papszCurImages[col]);
             }
-            CPLFree(results);
-            CPLFree(objs);
             CPLFree(objdescs);
-            CPLFree(lobs);
-            CPLFree(blob_lens);
-            if (papszCurImages)
-                CPLFree(papszCurImages);
+        }
+        CPLFree(panFetchBufWidths);
+        if (bPrefetchEnabled)
+        {
+            CPLDebug("DM", "Prefetch: waited %.3f s for %d batches",
+                     dfPrefetchWait, nPrefetchCount);
         }
     }
     if (object_index)
@@ -181,8 +137,21 @@ void OGRDMStatement::Clean()
     objs = nullptr;
     objdescs = nullptr;
     blob_lens = nullptr;
+    panFetchedLens = nullptr;
     papszCurImages = nullptr;
     papszCurImage = nullptr;
+    panFetchBufWidths = nullptr;
+    nFetchArraySize = 0;
+    nFetchArrayMax = 0;
+    nFetchAllocated = 0;
+    bLastFetchFull = false;
+    bLastBatch = true;
+    aosFetchColNames.clear();
+    bPrefetchEnabled = false;
+    bPrefetchFailed = false;
+    aoPrefetchErrors.clear();
+    nPrefetchCount = 0;
+    dfPrefetchWait = 0;
 
     if (hStatement)
     {
@@ -196,6 +165,141 @@ void OGRDMStatement::Clean()
     }
 }
 
+/************************************************************************/
+/*                          FreeFetchBuffers()                          */
+/*                                                                      */
+/*      Free the fetch buffers of the current slot.                     */
+/************************************************************************/
+
+void OGRDMStatement::FreeFetchBuffers()
+{
+    DPIRETURN rt;
+
+    if (results == nullptr)
+        return;
+
+    for (int col = 0; col < nRawColumnCount; col++)
+    {
+        if (object_index[col])
+        {
+            for (int row = 0; row < nFetchAllocated; row++)
+            {
+                if (results[col][row])
+                    CPLFree(results[col][row]);
+                rt = dpi_free_obj(objs[col][row]);
+                if (!DSQL_SUCCEEDED(rt))
+                {
+                    CPLError(CE_Failure, CPLE_AppDefined,
+                             "failed to free obj");
+                }
+            }
+        }
+        else if (lob_index[col])
+        {
+            for (int row = 0; row < nFetchAllocated; row++)
+            {
+                if (results[col][row])
+                    CPLFree(results[col][row]);
+                rt = dpi_free_lob_locator(lobs[col][row]);
+                if (!DSQL_SUCCEEDED(rt))
+                {
+                    CPLError(CE_Failure, CPLE_AppDefined,
+                             "failed to free lob");
+                }
+            }
+        }
+        else
+        {
+            if (results[col] && results[col][0])
+                CPLFree(results[col][0]);
+        }
+        CPLFree(results[col]);
+        CPLFree(objs[col]);
+        CPLFree(lobs[col]);
+        CPLFree(blob_lens[col]);
+        if (papszCurImages && papszCurImages[col])
+            CPLFree(papszCurImages[col]);
+    }
+    CPLFree(results);
+    CPLFree(objs);
+    CPLFree(lobs);
+    CPLFree(blob_lens);
+    if (papszCurImages)
+        CPLFree(papszCurImages);
+    results = nullptr;
+    objs = nullptr;
+    lobs = nullptr;
+    blob_lens = nullptr;
+    panFetchedLens = nullptr;
+    papszCurImages = nullptr;
+    nFetchAllocated = 0;
+}
+
+/************************************************************************/
+/*                          SwapFetchBuffers()                          */
+/*                                                                      */
+/*      Switch between the two slots of fetch buffers used when         */
+/*      prefetching.  The buffers still have to be bound again.         */
+/************************************************************************/
+
+void OGRDMStatement::SwapFetchBuffers()
+{
+    std::swap(results, results_other);
+    std::swap(objs, objs_other);
+    std::swap(lobs, lobs_other);
+    std::swap(blob_lens, blob_lens_other);
+    std::swap(papszCurImages, papszCurImages_other);
+    std::swap(nFetchAllocated, nFetchAllocated_other);
+}
+
+/************************************************************************/
+/*                           EnablePrefetch()                           */
+/*                                                                      */
+/*      Let Fetchmany() fetch the next batch on a worker thread while   */
+/*      the caller decodes the current one.  The statement handle, and  */
+/*      the connection, must then not be used by anything else.         */
+/************************************************************************/
+
+void OGRDMStatement::EnablePrefetch()
+{
+    if (!is_fectmany || bPrefetchEnabled)
+        return;
+
+    /* A single worker of our own, reused for all batches, rather than */
+    /* the global thread pool, as it mostly waits for the server. */
+    if (!poPrefetchPool)
+    {
+        auto poPool = std::make_unique<CPLWorkerThreadPool>();
+        if (!poPool->Setup(1, nullptr, nullptr))
+            return;
+        poPrefetchQueue = poPool->CreateJobQueue();
+        poPrefetchPool = std::move(poPool);
+    }
+
+    results_other = (char ***)CPLCalloc(sizeof(char **), nRawColumnCount + 1);
+    lobs_other = (dhloblctr **)CPLCalloc(sizeof(dhloblctr *), nRawColumnCount);
+    objs_other = (dhobj **)CPLCalloc(sizeof(dhobj *), nRawColumnCount);
+    blob_lens_other = (int **)CPLCalloc(sizeof(int *), nRawColumnCount);
+    papszCurImages_other = nullptr;
+    nFetchAllocated_other = 0;
+    bPrefetchEnabled = true;
+}
+
+/************************************************************************/
+/*                            WaitPrefetch()                            */
+/*                                                                      */
+/*      Wait for the batch being fetched in the background.  Its        */
+/*      errors are only kept for Fetchmany() to emit them.              */
+/************************************************************************/
+
+void OGRDMStatement::WaitPrefetch()
+{
+    if (!bPrefetchPending)
+        return;
+    poPrefetchQueue->WaitCompletion();
+    bPrefetchPending = false;
+}
+
 CPLErr OGRDMStatement::Prepare(const char *pszSQLstatement)
 
 {
@@ -243,7 +347,7 @@ CPLErr OGRDMStatement::Execute_for_insert(OGRDMFeatureDefn *params,
     {
         bind_flag = 1;
         rt = dpi_set_stmt_attr(hStatement, DSQL_ATTR_PARAMSET_SIZE,
-                               (void *)FORCED_INSERT_NUM, 0);
+                               (void *)(size_t)nInsertArraySize, 0);
         if (!DSQL_SUCCEEDED(rt))
         {
             CPLError(CE_Failure, CPLE_AppDefined,
@@ -280,7 +384,7 @@ CPLErr OGRDMStatement::Execute_for_insert(OGRDMFeatureDefn *params,
         for (int num = 0; num < i; num++)
         {
             insert_objs[num] =
-                (dhobj *)CPLCalloc(sizeof(dhobj), FORCED_INSERT_NUM);
+                (dhobj *)CPLCalloc(sizeof(dhobj), nInsertArraySize);
         }
         if (i > 0)
         {
@@ -300,7 +404,7 @@ CPLErr OGRDMStatement::Execute_for_insert(OGRDMFeatureDefn *params,
         }
         for (int iparam = 0; iparam < i; iparam++)
         {
-            for (int num = 0; num < FORCED_INSERT_NUM; num++)
+            for (int num = 0; num < nInsertArraySize; num++)
             {
                 rt = dpi_alloc_obj((poConn->hCon), &insert_objs[iparam][num]);
                 if (!DSQL_SUCCEEDED(rt))
@@ -324,7 +428,7 @@ CPLErr OGRDMStatement::Execute_for_insert(OGRDMFeatureDefn *params,
         for (int iparam = 0; iparam < i; iparam++)
         {
             insert_geovalues[iparam] = (GSERIALIZED **)CPLCalloc(
-                sizeof(GSERIALIZED *), FORCED_INSERT_NUM);
+                sizeof(GSERIALIZED *), nInsertArraySize);
         }
 
         valuesnum = param_nums - i;
@@ -332,9 +436,9 @@ CPLErr OGRDMStatement::Execute_for_insert(OGRDMFeatureDefn *params,
         for (int iparam = 0; iparam < valuesnum; iparam++)
         {
             insert_values[iparam] =
-                (char **)CPLCalloc(sizeof(char *), FORCED_INSERT_NUM);
-            char *date = (char *)CPLMalloc(8192 * FORCED_INSERT_NUM);
-            for (int num = 0; num < FORCED_INSERT_NUM; num++)
+                (char **)CPLCalloc(sizeof(char *), nInsertArraySize);
+            char *date = (char *)CPLMalloc(static_cast<size_t>(8192) * nInsertArraySize);
+            for (int num = 0; num < nInsertArraySize; num++)
             {
                 insert_values[iparam][num] = date + 8192 * num;
             }
@@ -488,7 +592,7 @@ CPLErr OGRDMStatement::Execute_for_insert(OGRDMFeatureDefn *params,
         }
     }
     insert_num++;
-    if (insert_num < FORCED_INSERT_NUM)
+    if (insert_num < nInsertArraySize)
         return CE_None;
     rt = dpi_exec(hStatement);
     if (!DSQL_SUCCEEDED(rt))
@@ -497,25 +601,529 @@ CPLErr OGRDMStatement::Execute_for_insert(OGRDMFeatureDefn *params,
                  "failed to exectue");
         return CE_Failure;
     }
-    rt = dpi_commit((poConn->hCon));
+    DiscardInserts();
+    if (!poConn->Commit())
+        return CE_Failure;
+
+    return CE_None;
+}
+
+/************************************************************************/
+/*                            FlushInserts()                            */
+/*                                                                      */
+/*      Send the rows buffered by Execute_for_insert() that do not      */
+/*      fill a whole batch yet.                                         */
+/************************************************************************/
+
+CPLErr OGRDMStatement::FlushInserts()
+{
+    if (bBulkLoad)
+    {
+        CPLErr eErr = ExecuteBulkBatch();
+        if (bBulkUncommitted)
+        {
+            bBulkUncommitted = false;
+            if (!poConn->Commit())
+                return CE_Failure;
+        }
+        return eErr;
+    }
+
+    if (insert_num == 0)
+        return CE_None;
+
+    DPIRETURN rt = dpi_set_stmt_attr(hStatement, DSQL_ATTR_PARAMSET_SIZE,
+                                     (void *)(size_t)insert_num, 0);
+    if (DSQL_SUCCEEDED(rt))
+        rt = dpi_exec(hStatement);
     if (!DSQL_SUCCEEDED(rt))
     {
         CPLError(CE_Failure, CPLE_AppDefined,
-                 "failed to commit");
+                 "failed to exectue");
+        DiscardInserts();
         return CE_Failure;
     }
-    insert_num = 0;
+    DiscardInserts();
+
+    rt = dpi_set_stmt_attr(hStatement, DSQL_ATTR_PARAMSET_SIZE,
+                           (void *)(size_t)nInsertArraySize, 0);
+    if (!DSQL_SUCCEEDED(rt))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "failed to set stmt paramset size");
+        return CE_Failure;
+    }
+    if (!poConn->Commit())
+        return CE_Failure;
+    return CE_None;
+}
+
+/************************************************************************/
+/*                           DiscardInserts()                           */
+/************************************************************************/
+
+void OGRDMStatement::DiscardInserts()
+{
     for (int iparam = 0; iparam < geonum; iparam++)
     {
-        for (int num = 0; num < FORCED_INSERT_NUM; num++)
+        for (int num = 0; num < insert_num; num++)
         {
             CPLFree(insert_geovalues[iparam][num]);
+            insert_geovalues[iparam][num] = nullptr;
+        }
+    }
+    for (auto &oCol : asBulkColumns)
+    {
+        if (oCol.geoms == nullptr)
+            continue;
+        for (int num = 0; num < insert_num; num++)
+        {
+            CPLFree(oCol.geoms[num]);
+            oCol.geoms[num] = nullptr;
+        }
+    }
+    insert_num = 0;
+}
+
+/************************************************************************/
+/*                          PrepareBulkLoad()                           */
+/*                                                                      */
+/*      Prepare an INSERT whose parameters are the geometry fields      */
+/*      followed by the attribute fields given, and bind them           */
+/*      column-wise with their native C types.  Rows are then added     */
+/*      by BulkLoadFeature() and only committed by FlushInserts(),      */
+/*      like a COPY.                                                    */
+/************************************************************************/
+
+CPLErr OGRDMStatement::PrepareBulkLoad(const char *pszStatement,
+                                       OGRDMFeatureDefn *poDefn,
+                                       const std::vector<int> &anGeomFields,
+                                       const std::vector<int> &anFields)
+{
+    if (Prepare(pszStatement) != CE_None)
+        return CE_Failure;
+
+    poBulkDefn = poDefn;
+    bBulkLoad = true;
+    insert_num = 0;
+
+    size_t nRowBytes = 0;
+    for (int iGeomField : anGeomFields)
+    {
+        DmBulkColumn oCol;
+        memset(&oCol, 0, sizeof(oCol));
+        oCol.iField = -1;
+        oCol.iGeomField = iGeomField;
+        /* Like Execute_for_insert(): serialized geometry objects for      */
+        /* GEOMETRY and GEOGRAPHY columns, and plain WKB for the others    */
+        if (poDefn->GetGeomFieldDefn(iGeomField)->eDMGeoType ==
+            GEOM_TYPE_WKB)
+        {
+            oCol.c_type = DSQL_C_BINARY;
+            oCol.width = DM_BULK_LOAD_INITIAL_WIDTH;
+            nRowBytes += oCol.width + sizeof(slength);
+        }
+        else
+        {
+            oCol.c_type = DSQL_C_CLASS;
+            oCol.width = sizeof(dhobj);
+            nRowBytes +=
+                sizeof(dhobj) + sizeof(slength) + DM_FETCH_LOB_ROW_SIZE;
+        }
+        asBulkColumns.push_back(oCol);
+    }
+    for (int iField : anFields)
+    {
+        const OGRFieldDefn *poFieldDefn = poDefn->GetFieldDefn(iField);
+        DmBulkColumn oCol;
+        memset(&oCol, 0, sizeof(oCol));
+        oCol.iField = iField;
+        oCol.iGeomField = -1;
+        switch (poFieldDefn->GetType())
+        {
+            case OFTInteger:
+                oCol.c_type = DSQL_C_SLONG;
+                oCol.width = sizeof(int);
+                break;
+            case OFTInteger64:
+                oCol.c_type = DSQL_C_SBIGINT;
+                oCol.width = sizeof(GIntBig);
+                break;
+            case OFTReal:
+                oCol.c_type = DSQL_C_DOUBLE;
+                oCol.width = sizeof(double);
+                break;
+            case OFTBinary:
+                oCol.c_type = DSQL_C_BINARY;
+                oCol.width = poFieldDefn->GetWidth() > 0
+                                 ? poFieldDefn->GetWidth()
+                                 : DM_BULK_LOAD_INITIAL_WIDTH;
+                break;
+            default:
+                /* Room for UTF-8 characters and the terminating nul */
+                oCol.c_type = DSQL_C_NCHAR;
+                oCol.width = poFieldDefn->GetWidth() > 0
+                                 ? poFieldDefn->GetWidth() * 4 + 1
+                                 : DM_BULK_LOAD_INITIAL_WIDTH;
+                break;
+        }
+        asBulkColumns.push_back(oCol);
+        nRowBytes += oCol.width + sizeof(slength);
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Use batches larger than the regular insert path, as long as     */
+    /*      they fit in the memory budget.                                  */
+    /* -------------------------------------------------------------------- */
+    const GIntBig nBudget = std::max(
+        static_cast<GIntBig>(1),
+        CPLAtoGIntBig(CPLGetConfigOption("DM_BULK_LOAD_MEMORY_LIMIT",
+                                         DM_FETCH_MEMORY_LIMIT_DEFAULT)));
+    nInsertArraySize = static_cast<int>(std::max(
+        static_cast<GIntBig>(nInsertArraySize),
+        std::min(static_cast<GIntBig>(DM_BULK_LOAD_MAX_ARRAY_SIZE),
+                 nBudget / static_cast<GIntBig>(
+                               std::max(nRowBytes, static_cast<size_t>(1))))));
+    CPLDebug("DM", "Bulk load: %d columns, batches of %d rows",
+             static_cast<int>(asBulkColumns.size()), nInsertArraySize);
+
+    DPIRETURN rt = dpi_set_stmt_attr(hStatement, DSQL_ATTR_PARAMSET_SIZE,
+                                     (void *)(size_t)nInsertArraySize, 0);
+    if (!DSQL_SUCCEEDED(rt))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "failed to set stmt paramset size");
+        return CE_Failure;
+    }
+
+    for (size_t iCol = 0; iCol < asBulkColumns.size(); iCol++)
+    {
+        DmBulkColumn &oCol = asBulkColumns[iCol];
+        const udint2 iParam = static_cast<udint2>(iCol + 1);
+        rt = dpi_desc_param(hStatement, iParam, &oCol.desc.sql_type,
+                            &oCol.desc.prec, &oCol.desc.scale,
+                            &oCol.desc.nullable);
+        if (!DSQL_SUCCEEDED(rt))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined, "failed to get param desc");
+            return CE_Failure;
+        }
+
+        oCol.ind = static_cast<slength *>(
+            CPLCalloc(sizeof(slength), nInsertArraySize));
+        if (oCol.c_type == DSQL_C_CLASS)
+        {
+            dhdesc hdesc_param;
+            dhobjdesc hobjdesc;
+            sdint4 val_len;
+            rt = dpi_get_stmt_attr(hStatement, DSQL_ATTR_IMP_PARAM_DESC,
+                                   (dpointer)&hdesc_param, 0, &val_len);
+            if (DSQL_SUCCEEDED(rt))
+                rt = dpi_get_desc_field(hdesc_param, (sdint2)iParam,
+                                        DSQL_DESC_OBJ_DESCRIPTOR, &hobjdesc,
+                                        sizeof(dhobjdesc), NULL);
+            if (!DSQL_SUCCEEDED(rt))
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "failed to get geometry desc");
+                return CE_Failure;
+            }
+            oCol.objs = static_cast<dhobj *>(
+                CPLCalloc(sizeof(dhobj), nInsertArraySize));
+            oCol.geoms = static_cast<GSERIALIZED **>(
+                CPLCalloc(sizeof(GSERIALIZED *), nInsertArraySize));
+            for (int num = 0; num < nInsertArraySize; num++)
+            {
+                rt = dpi_alloc_obj(poConn->hCon, &oCol.objs[num]);
+                if (DSQL_SUCCEEDED(rt))
+                    rt = dpi_bind_obj_desc(oCol.objs[num], hobjdesc);
+                if (!DSQL_SUCCEEDED(rt))
+                {
+                    CPLError(CE_Failure, CPLE_AppDefined,
+                             "failed to alloc obj");
+                    return CE_Failure;
+                }
+            }
+        }
+        else
+        {
+            oCol.data = static_cast<udbyte *>(
+                CPLMalloc(static_cast<size_t>(oCol.width) * nInsertArraySize));
+        }
+        if (BindBulkColumn(oCol, iParam) != CE_None)
+            return CE_Failure;
+    }
+
+    return CE_None;
+}
+
+/************************************************************************/
+/*                           BindBulkColumn()                           */
+/************************************************************************/
+
+CPLErr OGRDMStatement::BindBulkColumn(DmBulkColumn &oCol, int iParam)
+{
+    dpointer buf = oCol.c_type == DSQL_C_CLASS
+                       ? static_cast<dpointer>(oCol.objs)
+                       : static_cast<dpointer>(oCol.data);
+    DPIRETURN rt = dpi_bind_param(hStatement, (udint2)iParam,
+                                  DSQL_PARAM_INPUT, oCol.c_type,
+                                  oCol.desc.sql_type, oCol.desc.prec,
+                                  oCol.desc.scale, buf, oCol.width, oCol.ind);
+    if (!DSQL_SUCCEEDED(rt))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "failed to bind param");
+        return CE_Failure;
+    }
+    return CE_None;
+}
+
+/************************************************************************/
+/*                          BulkLoadFeature()                           */
+/************************************************************************/
+
+CPLErr OGRDMStatement::BulkLoadFeature(OGRFeature *poFeature)
+{
+    DPIRETURN rt;
+
+    /* -------------------------------------------------------------------- */
+    /*      Widen the variable length buffers this row does not fit in.     */
+    /*      The bound arrays cannot be resized while they hold rows, so     */
+    /*      send those first.                                               */
+    /* -------------------------------------------------------------------- */
+    for (size_t iCol = 0; iCol < asBulkColumns.size(); iCol++)
+    {
+        DmBulkColumn &oCol = asBulkColumns[iCol];
+        if (oCol.c_type != DSQL_C_NCHAR && oCol.c_type != DSQL_C_BINARY)
+            continue;
+
+        slength nNeeded;
+        if (oCol.iGeomField >= 0)
+        {
+            const OGRGeometry *poGeom =
+                poFeature->GetGeomFieldRef(oCol.iGeomField);
+            if (poGeom == nullptr)
+                continue;
+            nNeeded = static_cast<slength>(poGeom->WkbSize());
+        }
+        else if (!poFeature->IsFieldSetAndNotNull(oCol.iField))
+            continue;
+        else if (oCol.c_type == DSQL_C_BINARY)
+        {
+            int nBytes = 0;
+            poFeature->GetFieldAsBinary(oCol.iField, &nBytes);
+            nNeeded = nBytes;
+        }
+        else
+            nNeeded = strlen(poFeature->GetFieldAsString(oCol.iField)) + 1;
+        if (nNeeded <= oCol.width)
+            continue;
+
+        if (ExecuteBulkBatch() != CE_None)
+            return CE_Failure;
+        oCol.width = std::max(nNeeded, oCol.width * 2);
+        CPLFree(oCol.data);
+        oCol.data = static_cast<udbyte *>(
+            CPLMalloc(static_cast<size_t>(oCol.width) * nInsertArraySize));
+        if (BindBulkColumn(oCol, static_cast<int>(iCol + 1)) != CE_None)
+            return CE_Failure;
+    }
+
+    const int row = insert_num;
+    for (auto &oCol : asBulkColumns)
+    {
+        if (oCol.c_type == DSQL_C_CLASS)
+        {
+            OGRDMGeomFieldDefn *poGeomFieldDefn =
+                poBulkDefn->GetGeomFieldDefn(oCol.iGeomField);
+            OGRGeometry *poGeom = poFeature->GetGeomFieldRef(oCol.iGeomField);
+            if (poGeom == nullptr)
+            {
+                oCol.ind[row] = DSQL_NULL_DATA;
+                continue;
+            }
+            poGeom->closeRings();
+            poGeom->set3D(poGeomFieldDefn->GeometryTypeFlags &
+                          OGRGeometry::OGR_G_3D);
+            poGeom->setMeasured(poGeomFieldDefn->GeometryTypeFlags &
+                                OGRGeometry::OGR_G_MEASURED);
+
+            char *pszHexEWKB =
+                OGRGeometryToHexEWKB(poGeom, poGeomFieldDefn->nSRSId, 3, 3);
+            size_t nLength = 0;
+            oCol.geoms[row] = gserialized_from_ewkb(pszHexEWKB, &nLength);
+            CPLFree(pszHexEWKB);
+            rt = dpi_set_obj_val(oCol.objs[row], 1, DSQL_C_BINARY,
+                                 oCol.geoms[row], nLength);
+            if (!DSQL_SUCCEEDED(rt))
+            {
+                CPLError(CE_Failure, CPLE_AppDefined, "failed to set obj val");
+                return CE_Failure;
+            }
+            oCol.ind[row] = sizeof(dhobj);
+            continue;
+        }
+
+        udbyte *pabyDst = oCol.data + static_cast<size_t>(oCol.width) * row;
+        if (oCol.iGeomField >= 0)
+        {
+            const OGRGeometry *poGeom =
+                poFeature->GetGeomFieldRef(oCol.iGeomField);
+            if (poGeom == nullptr)
+            {
+                oCol.ind[row] = DSQL_NULL_DATA;
+                continue;
+            }
+            /* Same WKB flavor as GeometryToBlob() */
+            const OGRwkbVariant eVariant =
+                wkbFlatten(poGeom->getGeometryType()) == wkbPoint &&
+                        poGeom->IsEmpty()
+                    ? wkbVariantIso
+                    : wkbVariantOldOgc;
+            if (poGeom->exportToWkb(wkbNDR, pabyDst, eVariant) !=
+                OGRERR_NONE)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "failed to export geometry to WKB");
+                return CE_Failure;
+            }
+            oCol.ind[row] = static_cast<slength>(poGeom->WkbSize());
+            continue;
+        }
+
+        if (!poFeature->IsFieldSetAndNotNull(oCol.iField))
+        {
+            oCol.ind[row] = DSQL_NULL_DATA;
+            continue;
+        }
+        switch (oCol.c_type)
+        {
+            case DSQL_C_SLONG:
+            {
+                const int nVal = poFeature->GetFieldAsInteger(oCol.iField);
+                memcpy(pabyDst, &nVal, sizeof(nVal));
+                oCol.ind[row] = sizeof(nVal);
+                break;
+            }
+            case DSQL_C_SBIGINT:
+            {
+                const GIntBig nVal =
+                    poFeature->GetFieldAsInteger64(oCol.iField);
+                memcpy(pabyDst, &nVal, sizeof(nVal));
+                oCol.ind[row] = sizeof(nVal);
+                break;
+            }
+            case DSQL_C_DOUBLE:
+            {
+                const double dfVal = poFeature->GetFieldAsDouble(oCol.iField);
+                memcpy(pabyDst, &dfVal, sizeof(dfVal));
+                oCol.ind[row] = sizeof(dfVal);
+                break;
+            }
+            case DSQL_C_BINARY:
+            {
+                int nBytes = 0;
+                const GByte *pabyVal =
+                    poFeature->GetFieldAsBinary(oCol.iField, &nBytes);
+                memcpy(pabyDst, pabyVal, nBytes);
+                oCol.ind[row] = nBytes;
+                break;
+            }
+            default:
+            {
+                const char *pszVal = poFeature->GetFieldAsString(oCol.iField);
+                // Check if date is NULL: 0000-00-00
+                if (poBulkDefn->GetFieldDefn(oCol.iField)->GetType() ==
+                        OFTDate &&
+                    STARTS_WITH_CI(pszVal, "0000"))
+                {
+                    oCol.ind[row] = DSQL_NULL_DATA;
+                    break;
+                }
+                const size_t nLen = strlen(pszVal);
+                memcpy(pabyDst, pszVal, nLen + 1);
+                oCol.ind[row] = static_cast<slength>(nLen);
+                break;
+            }
         }
     }
 
+    insert_num++;
+    if (insert_num < nInsertArraySize)
+        return CE_None;
+    return ExecuteBulkBatch();
+}
+
+/************************************************************************/
+/*                          ExecuteBulkBatch()                          */
+/*                                                                      */
+/*      Send the rows buffered by BulkLoadFeature(), without            */
+/*      committing them.                                                */
+/************************************************************************/
+
+CPLErr OGRDMStatement::ExecuteBulkBatch()
+{
+    if (insert_num == 0)
+        return CE_None;
+
+    DPIRETURN rt = DSQL_SUCCESS;
+    const bool bPartial = insert_num < nInsertArraySize;
+    if (bPartial)
+        rt = dpi_set_stmt_attr(hStatement, DSQL_ATTR_PARAMSET_SIZE,
+                               (void *)(size_t)insert_num, 0);
+    if (DSQL_SUCCEEDED(rt))
+        rt = dpi_exec(hStatement);
+    const int nRows = insert_num;
+    DiscardInserts();
+    if (!DSQL_SUCCEEDED(rt))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "failed to execute bulk load of %d rows", nRows);
+        return CE_Failure;
+    }
+    bBulkUncommitted = true;
+
+    if (bPartial)
+    {
+        rt = dpi_set_stmt_attr(hStatement, DSQL_ATTR_PARAMSET_SIZE,
+                               (void *)(size_t)nInsertArraySize, 0);
+        if (!DSQL_SUCCEEDED(rt))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "failed to set stmt paramset size");
+            return CE_Failure;
+        }
+    }
     return CE_None;
 }
 
+/************************************************************************/
+/*                          FreeBulkColumns()                           */
+/************************************************************************/
+
+void OGRDMStatement::FreeBulkColumns()
+{
+    DiscardInserts();
+    for (auto &oCol : asBulkColumns)
+    {
+        if (oCol.objs)
+        {
+            for (int num = 0; num < nInsertArraySize; num++)
+            {
+                if (oCol.objs[num])
+                    dpi_free_obj(oCol.objs[num]);
+            }
+        }
+        CPLFree(oCol.objs);
+        CPLFree(oCol.geoms);
+        CPLFree(oCol.data);
+        CPLFree(oCol.ind);
+    }
+    asBulkColumns.clear();
+    bBulkLoad = false;
+    poBulkDefn = nullptr;
+}
+
 CPLErr OGRDMStatement::ExecuteInsert(const char *pszSQLStatement, int nMode)
 {
     DPIRETURN rt;
@@ -716,7 +1324,8 @@ CPLErr OGRDMStatement::Execute(const char *pszSQLStatement, int nMode)
     return CE_None;
 }
 
-CPLErr OGRDMStatement::Excute_for_fetchmany(const char *pszSQLStatement)
+CPLErr OGRDMStatement::Excute_for_fetchmany(const char *pszSQLStatement,
+                                            int nArraySize)
 {
     DPIRETURN rt;
 
@@ -734,8 +1343,6 @@ CPLErr OGRDMStatement::Excute_for_fetchmany(const char *pszSQLStatement)
         return CE_Failure;
     }
 
-    rt = dpi_set_stmt_attr(hStatement, DSQL_ATTR_ROW_ARRAY_SIZE,
-                           (void *)fetchnum, 0);
     sdint4 nStmtType;
     slength len;
     rt = dpi_get_diag_field(DSQL_HANDLE_STMT, hStatement, 0,
@@ -781,14 +1388,7 @@ CPLErr OGRDMStatement::Excute_for_fetchmany(const char *pszSQLStatement)
     objs = (dhobj **)CPLCalloc(sizeof(dhobj *), column_count);
     blob_lens = (int **)CPLCalloc(sizeof(int *), column_count);
     objdescs = (dhobjdesc **)CPLCalloc(sizeof(dhobjdesc *), column_count);
-    for (int i = 0; i < column_count; i++)
-    {
-        results[i] = (char **)CPLCalloc(sizeof(char *), fetchnum);
-        blob_lens[i] = (int *)CPLCalloc(sizeof(int), fetchnum);
-        lobs[i] = (dhloblctr *)CPLCalloc(sizeof(dhloblctr), fetchnum);
-        objs[i] = (dhobj *)CPLCalloc(sizeof(dhobj), fetchnum);
-        objdescs[i] = (dhobjdesc *)CPLCalloc(sizeof(dhobjdesc), fetchnum);
-    }
+    panFetchBufWidths = (int *)CPLCalloc(sizeof(int), column_count);
 
     dhdesc hdesc_col;
     sdint4 val_len;
@@ -801,6 +1401,11 @@ CPLErr OGRDMStatement::Excute_for_fetchmany(const char *pszSQLStatement)
         return CE_Failure;
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Describe the columns and estimate the memory needed by one      */
+    /*      row of the fetch buffers.                                       */
+    /* -------------------------------------------------------------------- */
+    size_t nRowBytes = 0;
     for (int iParam = 0; iParam < nRawColumnCount; iParam++)
     {
         DmColDesc coldesc;
@@ -815,8 +1420,15 @@ CPLErr OGRDMStatement::Excute_for_fetchmany(const char *pszSQLStatement)
             return CE_Failure;
         }
 
+        aosFetchColNames.emplace_back(
+            reinterpret_cast<const char *>(coldesc.name),
+            static_cast<size_t>(std::max<int>(
+                0, std::min<int>(coldesc.nameLen, sizeof(coldesc.name) - 1))));
+        nRowBytes += 2 * sizeof(char *) + sizeof(int);
+
         if (coldesc.sql_type == DSQL_CLASS)
         {
+            objdescs[iParam] = (dhobjdesc *)CPLCalloc(sizeof(dhobjdesc), 1);
             rt = dpi_get_desc_field(
                 hdesc_col, (sdint2)iParam + 1, DSQL_DESC_OBJ_DESCRIPTOR,
                 &(objdescs[iParam][0]), sizeof(dhobjdesc), NULL);
@@ -826,51 +1438,18 @@ CPLErr OGRDMStatement::Excute_for_fetchmany(const char *pszSQLStatement)
                          "failed to get object descriptor");
                 return CE_Failure;
             }
-            for (int i = 0; i < fetchnum; i++)
-            {
-                rt = dpi_alloc_obj((poConn->hCon), &(objs[iParam][i]));
-
-                if (!DSQL_SUCCEEDED(rt))
-                {
-                    CPLError(CE_Failure, CPLE_AppDefined,
-                             "failed to alloc obj");
-                    return CE_Failure;
-                }
-                rt = dpi_bind_obj_desc(objs[iParam][i], objdescs[iParam][0]);
-
-                if (!DSQL_SUCCEEDED(rt))
-                {
-                    CPLError(CE_Failure, CPLE_AppDefined,
-                             "failed to bind obj");
-                    return CE_Failure;
-                }
-            }
-
-            rt = dpi_bind_col(hStatement, (udint2)iParam + 1, DSQL_C_CLASS,
-                              &objs[iParam][0], sizeof(objs[iParam][0]), NULL);
-
             object_index[iParam] = 1;
             lob_index[iParam] = 0;
+            nRowBytes += sizeof(dhobj) + DM_FETCH_LOB_ROW_SIZE;
         }
         else if (coldesc.sql_type == DSQL_BLOB || coldesc.sql_type == DSQL_CLOB)
         {
-            for (int i = 0; i < fetchnum; i++)
-            {
-                rt = dpi_alloc_lob_locator(hStatement, &(lobs[iParam][i]));
-                if (!DSQL_SUCCEEDED(rt))
-                {
-                    CPLError(CE_Failure, CPLE_AppDefined,
-                             "failed to alloc lob");
-                    return CE_Failure;
-                }
-            }
-            rt = dpi_bind_col(hStatement, (udint2)iParam + 1, DSQL_C_LOB_HANDLE,
-                              &lobs[iParam][0], sizeof(lobs[iParam][0]), NULL);
             if (coldesc.sql_type == DSQL_BLOB)
                 lob_index[iParam] = 2;
             else
                 lob_index[iParam] = 1;
             object_index[iParam] = 0;
+            nRowBytes += sizeof(dhloblctr) + DM_FETCH_LOB_ROW_SIZE;
         }
         else
         {
@@ -888,25 +1467,211 @@ CPLErr OGRDMStatement::Excute_for_fetchmany(const char *pszSQLStatement)
 
             if (coldesc.prec > 0)
                 nbufwidth = (int)coldesc.display_size + 3;
-            char *date = (char *)CPLMalloc((nbufwidth + 2) * fetchnum);
-            for (int i = 0; i < fetchnum; i++)
+            panFetchBufWidths[iParam] = nbufwidth + 2;
+            object_index[iParam] = 0;
+            lob_index[iParam] = 0;
+            nRowBytes += panFetchBufWidths[iParam];
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Work out the row array size.  In adaptive mode, start with a    */
+    /*      small batch and let Fetchmany() grow it up to what fits in      */
+    /*      the memory budget.                                              */
+    /* -------------------------------------------------------------------- */
+    if (nArraySize > 0)
+    {
+        nFetchArrayMax = std::min(nArraySize, fetchnum);
+    }
+    else
+    {
+        const GIntBig nBudget = std::max(
+            static_cast<GIntBig>(1),
+            CPLAtoGIntBig(CPLGetConfigOption("DM_FETCH_MEMORY_LIMIT",
+                                             DM_FETCH_MEMORY_LIMIT_DEFAULT)));
+        nFetchArrayMax = static_cast<int>(std::max(
+            static_cast<GIntBig>(1),
+            std::min(static_cast<GIntBig>(fetchnum),
+                     nBudget / static_cast<GIntBig>(
+                                   std::max(nRowBytes, static_cast<size_t>(1))))));
+    }
+    CPLDebug("DM", "Fetch array size: %s, up to %d rows of about %d bytes",
+             nArraySize > 0 ? "fixed" : "adaptive", nFetchArrayMax,
+             static_cast<int>(nRowBytes));
+
+    return BindFetchBuffers(nArraySize > 0
+                                ? nFetchArrayMax
+                                : std::min(nFetchArrayMax,
+                                           DM_FETCH_INITIAL_ARRAY_SIZE));
+}
+
+/************************************************************************/
+/*                          BindFetchBuffers()                          */
+/*                                                                      */
+/*      Make the per column fetch buffers hold nNewSize rows, keeping   */
+/*      the ones already allocated, and bind them to the statement.     */
+/************************************************************************/
+
+CPLErr OGRDMStatement::BindFetchBuffers(int nNewSize)
+{
+    DPIRETURN rt;
+    const int nOldSize = nFetchAllocated;
+
+    if (nNewSize > nOldSize)
+    {
+        for (int iParam = 0; iParam < nRawColumnCount; iParam++)
+        {
+            results[iParam] = (char **)CPLRealloc(results[iParam],
+                                                  sizeof(char *) * nNewSize);
+            memset(results[iParam] + nOldSize, 0,
+                   sizeof(char *) * (nNewSize - nOldSize));
+            blob_lens[iParam] =
+                (int *)CPLRealloc(blob_lens[iParam], sizeof(int) * nNewSize);
+            memset(blob_lens[iParam] + nOldSize, 0,
+                   sizeof(int) * (nNewSize - nOldSize));
+            if (papszCurImages)
             {
-                //results[i][iParam] = (char*)CPLMalloc(nbufwidth + 2);
-                results[iParam][i] = date + i * (nbufwidth + 2);
+                papszCurImages[iParam] = (char **)CPLRealloc(
+                    papszCurImages[iParam], sizeof(char *) * nNewSize);
+                memset(papszCurImages[iParam] + nOldSize, 0,
+                       sizeof(char *) * (nNewSize - nOldSize));
             }
-            rt = dpi_bind_col(
-                hStatement, (udint2)iParam + 1, DSQL_C_NCHAR,
-                (dpointer)results[iParam][0] /*results[0][iParam]*/,
-                nbufwidth + 2, NULL);
-            if (!DSQL_SUCCEEDED(rt))
+
+            if (object_index[iParam])
             {
-                CPLError(CE_Failure, CPLE_AppDefined,
-                         "failed to bind col");
-                return CE_Failure;
+                objs[iParam] =
+                    (dhobj *)CPLRealloc(objs[iParam], sizeof(dhobj) * nNewSize);
+                for (int i = nOldSize; i < nNewSize; i++)
+                {
+                    objs[iParam][i] = nullptr;
+                    rt = dpi_alloc_obj((poConn->hCon), &(objs[iParam][i]));
+
+                    if (!DSQL_SUCCEEDED(rt))
+                    {
+                        CPLError(CE_Failure, CPLE_AppDefined,
+                                 "failed to alloc obj");
+                        nFetchAllocated = i;
+                        return CE_Failure;
+                    }
+                    rt = dpi_bind_obj_desc(objs[iParam][i],
+                                           objdescs[iParam][0]);
+
+                    if (!DSQL_SUCCEEDED(rt))
+                    {
+                        CPLError(CE_Failure, CPLE_AppDefined,
+                                 "failed to bind obj");
+                        nFetchAllocated = i + 1;
+                        return CE_Failure;
+                    }
+                }
+            }
+            else if (lob_index[iParam])
+            {
+                lobs[iParam] = (dhloblctr *)CPLRealloc(
+                    lobs[iParam], sizeof(dhloblctr) * nNewSize);
+                for (int i = nOldSize; i < nNewSize; i++)
+                {
+                    lobs[iParam][i] = nullptr;
+                    rt = dpi_alloc_lob_locator(hStatement, &(lobs[iParam][i]));
+                    if (!DSQL_SUCCEEDED(rt))
+                    {
+                        CPLError(CE_Failure, CPLE_AppDefined,
+                                 "failed to alloc lob");
+                        nFetchAllocated = i;
+                        return CE_Failure;
+                    }
+                }
+            }
+            else
+            {
+                const int nWidth = panFetchBufWidths[iParam];
+                char *date = (char *)CPLRealloc(
+                    nOldSize > 0 ? results[iParam][0] : nullptr,
+                    static_cast<size_t>(nWidth) * nNewSize);
+                for (int i = 0; i < nNewSize; i++)
+                {
+                    results[iParam][i] = date + static_cast<size_t>(i) * nWidth;
+                }
             }
-            object_index[iParam] = 0;
-            lob_index[iParam] = 0;
         }
+        nFetchAllocated = nNewSize;
+    }
+
+    for (int iParam = 0; iParam < nRawColumnCount; iParam++)
+    {
+        if (object_index[iParam])
+            rt = dpi_bind_col(hStatement, (udint2)iParam + 1, DSQL_C_CLASS,
+                              &objs[iParam][0], sizeof(objs[iParam][0]), NULL);
+        else if (lob_index[iParam])
+            rt = dpi_bind_col(hStatement, (udint2)iParam + 1, DSQL_C_LOB_HANDLE,
+                              &lobs[iParam][0], sizeof(lobs[iParam][0]), NULL);
+        else
+            rt = dpi_bind_col(hStatement, (udint2)iParam + 1, DSQL_C_NCHAR,
+                              (dpointer)results[iParam][0],
+                              panFetchBufWidths[iParam], NULL);
+        if (!DSQL_SUCCEEDED(rt))
+        {
+            CPLError(CE_Failure, CPLE_AppDefined,
+                     "failed to bind col");
+            return CE_Failure;
+        }
+    }
+
+    rt = dpi_set_stmt_attr(hStatement, DSQL_ATTR_ROW_ARRAY_SIZE,
+                           (void *)(size_t)nNewSize, 0);
+    if (!DSQL_SUCCEEDED(rt))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "failed to set row array size");
+        return CE_Failure;
+    }
+    nFetchArraySize = nNewSize;
+    return CE_None;
+}
+
+/************************************************************************/
+/*                             Reexecute()                              */
+/*                                                                      */
+/*      Run again the query of a previous Excute_for_fetchmany(),       */
+/*      keeping the fetch buffers and their bindings.                   */
+/************************************************************************/
+
+CPLErr OGRDMStatement::Reexecute()
+{
+    if (hStatement == nullptr || !is_fectmany)
+        return CE_Failure;
+
+    WaitPrefetch();
+    dpi_close_cursor(hStatement);
+    DPIRETURN rt = dpi_exec(hStatement);
+    if (!DSQL_SUCCEEDED(rt))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "failed to exectue");
+        return CE_Failure;
+    }
+    bLastFetchFull = false;
+    bLastBatch = false;
+    return CE_None;
+}
+
+/************************************************************************/
+/*                             BindParam()                              */
+/*                                                                      */
+/*      Bind a BIGINT input parameter of the prepared statement.  The   */
+/*      value is read from pnValue at each execution.                   */
+/************************************************************************/
+
+CPLErr OGRDMStatement::BindParam(int iParam, GIntBig *pnValue)
+{
+    DPIRETURN rt = dpi_bind_param(hStatement, (udint2)iParam,
+                                  DSQL_PARAM_INPUT, DSQL_C_SBIGINT,
+                                  DSQL_BIGINT, 0, 0, pnValue,
+                                  sizeof(GIntBig), NULL);
+    if (!DSQL_SUCCEEDED(rt))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "failed to bind param");
+        return CE_Failure;
     }
     return CE_None;
 }
@@ -933,16 +1698,142 @@ char **OGRDMStatement::SimpleFetchRow()
     return papszCurImage;
 }
 
+/************************************************************************/
+/*                             Fetchmany()                              */
+/*                                                                      */
+/*      Return the next batch of rows.  When prefetching is enabled,    */
+/*      this is the batch fetched in the background during the          */
+/*      previous call, and the one after it is requested right away     */
+/*      into the other slot of buffers.                                 */
+/************************************************************************/
+
 char ***OGRDMStatement::Fetchmany(ulength *rows)
+{
+    if (!bPrefetchEnabled)
+    {
+        char ***papszRet = FetchmanyInternal(rows);
+        bLastBatch = papszRet == nullptr || !bLastFetchFull;
+        panFetchedLens = blob_lens;
+        return papszRet;
+    }
+
+    char ***papszRet = nullptr;
+    if (bPrefetchPending)
+    {
+        const auto nStart = std::chrono::steady_clock::now();
+        WaitPrefetch();
+        dfPrefetchWait += std::chrono::duration<double>(
+                              std::chrono::steady_clock::now() - nStart)
+                              .count();
+        nPrefetchCount++;
+
+        /* Emit the errors of the worker in the calling thread */
+        bool bFailureEmitted = false;
+        for (const auto &oError : aoPrefetchErrors)
+        {
+            CPLError(oError.type, oError.no, "%s", oError.msg.c_str());
+            if (oError.type == CE_Failure)
+                bFailureEmitted = true;
+        }
+        aoPrefetchErrors.clear();
+        if (bPrefetchFailed)
+        {
+            if (!bFailureEmitted)
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "failed to fetch the next rows");
+            bLastBatch = true;
+            panFetchedLens = nullptr;
+            return nullptr;
+        }
+        papszRet = papszPrefetched;
+        *rows = nPrefetchedRows;
+    }
+    else
+    {
+        papszRet = FetchmanyInternal(rows);
+    }
+    bLastBatch = papszRet == nullptr || !bLastFetchFull;
+    panFetchedLens = blob_lens;
+
+    /* The caller is done with the buffers of the other slot */
+    if (!bLastBatch)
+    {
+        SwapFetchBuffers();
+        papszPrefetched = nullptr;
+        nPrefetchedRows = 0;
+        bPrefetchFailed = false;
+        aoPrefetchErrors.clear();
+        const std::function<void()> oJob = [this]()
+        {
+            CPLInstallErrorHandlerAccumulator(aoPrefetchErrors);
+            if (BindFetchBuffers(nFetchArraySize) == CE_None)
+            {
+                papszPrefetched = FetchmanyInternal(&nPrefetchedRows);
+                bPrefetchFailed = bFetchFailed;
+            }
+            else
+            {
+                bPrefetchFailed = true;
+            }
+            CPLUninstallErrorHandlerAccumulator();
+        };
+        /* Should not happen, but fetch synchronously if it does */
+        if (!poPrefetchQueue->SubmitJob(oJob))
+            oJob();
+        bPrefetchPending = true;
+    }
+
+    return papszRet;
+}
+
+/************************************************************************/
+/*                           GetValueLength()                           */
+/*                                                                      */
+/*      Number of bytes fetched for a binary value (object or BLOB      */
+/*      column) of the batch last returned by Fetchmany(), or 0 when    */
+/*      it is not known.                                                */
+/************************************************************************/
+
+size_t OGRDMStatement::GetValueLength(int iCol, int iRow) const
+{
+    if (panFetchedLens == nullptr || iCol < 0 || iCol >= nRawColumnCount ||
+        iRow < 0 || (object_index[iCol] == 0 && lob_index[iCol] != 2))
+        return 0;
+    return static_cast<size_t>(std::max(0, panFetchedLens[iCol][iRow]));
+}
+
+char ***OGRDMStatement::FetchmanyInternal(ulength *rows)
 {
     DPIRETURN rt = 0;
     ulength row = 0;
 
+    /* Distinguishes errors from the end of the result set */
+    bFetchFailed = true;
+
+    /* The previous batch was full: let the next ones be larger, now */
+    /* that the caller is done with the buffers. */
+    if (bLastFetchFull && nFetchArraySize < nFetchArrayMax)
+    {
+        if (BindFetchBuffers(std::min(nFetchArrayMax, nFetchArraySize * 8)) !=
+            CE_None)
+            return nullptr;
+    }
+
+    bLastFetchFull = false;
     rt = dpi_fetch(hStatement, &row);
+    if (rt == DSQL_NO_DATA)
+    {
+        bFetchFailed = false;
+        return nullptr;
+    }
     if (!DSQL_SUCCEEDED(rt))
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "failed to fetch");
         return nullptr;
+    }
 
     *rows = row;
+    bLastFetchFull = (row == (ulength)nFetchArraySize);
 
     if (papszCurImages == nullptr)
     {
@@ -950,7 +1841,8 @@ char ***OGRDMStatement::Fetchmany(ulength *rows)
             (char ***)CPLCalloc(sizeof(char **), nRawColumnCount + 1);
         for (int i = 0; i < nRawColumnCount; i++)
         {
-            papszCurImages[i] = (char **)CPLCalloc(sizeof(char *), fetchnum);
+            papszCurImages[i] =
+                (char **)CPLCalloc(sizeof(char *), nFetchAllocated);
         }
     }
 
@@ -979,6 +1871,7 @@ char ***OGRDMStatement::Fetchmany(ulength *rows)
                         CPLFree(results[i][num]);
                     }
                     results[i][num] = nullptr;
+                    blob_lens[i][num] = 0;
                     papszCurImages[i][num] = nullptr;
                     continue;
                 }
@@ -1004,6 +1897,7 @@ char ***OGRDMStatement::Fetchmany(ulength *rows)
                              "failed to get object value");
                     return nullptr;
                 }
+                blob_lens[i][num] = (int)val_len;
                 papszCurImages[i][num] = results[i][num];
             }
         }
@@ -1022,6 +1916,7 @@ char ***OGRDMStatement::Fetchmany(ulength *rows)
                         CPLFree(results[i][num]);
                     }
                     results[i][num] = nullptr;
+                    blob_lens[i][num] = 0;
                     papszCurImages[i][num] = nullptr;
                     continue;
                 }
@@ -1053,5 +1948,6 @@ char ***OGRDMStatement::Fetchmany(ulength *rows)
         }
     }
 
+    bFetchFailed = false;
     return papszCurImages;
 }
@@ -28,7 +28,10 @@
 
 #include "ogr_dm.h"
 #include <ogr_p.h>
+#include "ogr_swq.h"
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <condition_variable>
 #include <mutex>
 #include <thread>
@@ -162,6 +165,11 @@ OGRDMTableLayer::OGRDMTableLayer(OGRDMDataSource *poDSIn,
     SetDescription(poFeatureDefn->GetName());
     poFeatureDefn->Reference();
 
+    /* Appending to an existing table keeps the row by row semantics */
+    /* unless asked otherwise; CreateLayer() enables bulk load for the */
+    /* tables it creates. */
+    bUseBulkLoad = CPLTestBool(CPLGetConfigOption("DM_BULK_LOAD", "NO"));
+
     if (pszDescriptionIn != nullptr && !EQUAL(pszDescriptionIn, ""))
     {
         OGRLayer::SetMetadataItem("DESCRIPTION", pszDescriptionIn);
@@ -183,6 +191,7 @@ OGRDMTableLayer::~OGRDMTableLayer()
     CPLFree(pszGeomColForced);
     if (InsertStatement)
         delete InsertStatement;
+    ResetFIDQuery(m_oGetFeatureQuery);
     CSLDestroy(papszOverrideColumnTypes);
 }
 
@@ -739,9 +748,10 @@ void OGRDMTableLayer::SetSpatialFilter(int iGeomField,
 void OGRDMTableLayer::BuildWhere()
 
 {
-    osWHERE = "";                                 
+    osWHERE = "";
+    CPLString osSpatialWHERE;
     OGRDMGeomFieldDefn *poGeomFieldDefn = nullptr;
-    if (poFeatureDefn->GetGeomFieldCount() != 0)  
+    if (poFeatureDefn->GetGeomFieldCount() != 0)
         poGeomFieldDefn =
             poFeatureDefn->GetGeomFieldDefn(m_iGeomFieldFilter);
 
@@ -763,16 +773,341 @@ void OGRDMTableLayer::BuildWhere()
                     sEnvelope.MaxY);
         CPLsnprintf(szBox3D_4, sizeof(szBox3D_2), "%.18g %.18g", sEnvelope.MaxX,
                     sEnvelope.MinY);
-        osWHERE.Printf(
-            "WHERE DMGEO2.ST_BOXCONTAINS(dmgeo2.st_geogfromtext('POLYGON(( %s, "
-            "%s, %s, %s, %s))'), %s);",
+        osSpatialWHERE.Printf(
+            "DMGEO2.ST_BOXCONTAINS(dmgeo2.st_geogfromtext('POLYGON(( %s, "
+            "%s, %s, %s, %s))'), %s)",
             szBox3D_1, szBox3D_2, szBox3D_3, szBox3D_4, szBox3D_1,
             poGeomFieldDefn->GetNameRef());
     }
-    else
+
+    if (!osSpatialWHERE.empty() && !osQuery.empty())
+    {
+        osWHERE.Printf("WHERE %s AND (%s)", osSpatialWHERE.c_str(),
+                       osQuery.c_str());
+    }
+    else if (!osSpatialWHERE.empty())
+    {
+        osWHERE.Printf("WHERE %s", osSpatialWHERE.c_str());
+    }
+    else if (!osQuery.empty())
+    {
+        osWHERE.Printf("WHERE %s", osQuery.c_str());
+    }
+}
+
+/************************************************************************/
+/*                          BuildFilterValue()                          */
+/*                                                                      */
+/*      Translate a constant of the OGR SQL expression into a DM SQL    */
+/*      literal compatible with the type of the compared field.         */
+/*      Returns an empty string if it cannot be done faithfully.        */
+/************************************************************************/
+
+CPLString OGRDMTableLayer::BuildFilterValue(const OGRFieldDefn *poFieldDefn,
+                                            const swq_expr_node *poNode)
+
+{
+    if (poNode->eNodeType != SNT_CONSTANT || poNode->is_null)
+        return CPLString();
+
+    const OGRFieldType eType =
+        poFieldDefn ? poFieldDefn->GetType() : OFTInteger64;
+
+    switch (eType)
+    {
+        case OFTInteger:
+        case OFTInteger64:
+        case OFTReal:
+        {
+            if (poNode->field_type == SWQ_INTEGER ||
+                poNode->field_type == SWQ_INTEGER64 ||
+                poNode->field_type == SWQ_BOOLEAN)
+            {
+                return CPLString().Printf(CPL_FRMT_GIB, poNode->int_value);
+            }
+            if (poNode->field_type == SWQ_FLOAT &&
+                std::isfinite(poNode->float_value))
+            {
+                return CPLString().Printf("%.18g", poNode->float_value);
+            }
+            break;
+        }
+
+        case OFTString:
+        {
+            if (poNode->field_type == SWQ_STRING)
+            {
+                return "'" +
+                       CPLString(poNode->string_value).replaceAll('\'', "''") +
+                       "'";
+            }
+            break;
+        }
+
+        case OFTDate:
+        case OFTTime:
+        case OFTDateTime:
+        {
+            if (poNode->field_type != SWQ_STRING &&
+                poNode->field_type != SWQ_TIMESTAMP &&
+                poNode->field_type != SWQ_DATE &&
+                poNode->field_type != SWQ_TIME)
+                break;
+
+            OGRField sField;
+            if (!OGRParseDate(poNode->string_value, &sField, 0))
+                break;
+
+            /* Time zones cannot be compared the way OGR does on the */
+            /* server side, as the DM columns have none. */
+            if (sField.Date.TZFlag > 1)
+                break;
+
+            CPLString osTime;
+            if (sField.Date.Second == static_cast<int>(sField.Date.Second))
+                osTime.Printf("%02d:%02d:%02d", sField.Date.Hour,
+                              sField.Date.Minute,
+                              static_cast<int>(sField.Date.Second));
+            else
+                osTime.Printf("%02d:%02d:%06.3f", sField.Date.Hour,
+                              sField.Date.Minute, sField.Date.Second);
+
+            if (eType == OFTTime)
+                return "TIME '" + osTime + "'";
+
+            CPLString osDate;
+            osDate.Printf("%04d-%02d-%02d", sField.Date.Year,
+                          sField.Date.Month, sField.Date.Day);
+            if (eType == OFTDate)
+                return "DATE '" + osDate + "'";
+            return "TIMESTAMP '" + osDate + " " + osTime + "'";
+        }
+
+        default:
+            break;
+    }
+
+    return CPLString();
+}
+
+/************************************************************************/
+/*                            BuildFilter()                             */
+/*                                                                      */
+/*      Translate the OGR SQL attribute filter into a DM SQL            */
+/*      expression.  Parts that cannot be translated are left to the    */
+/*      client side evaluation of m_poAttrQuery.                        */
+/************************************************************************/
+
+CPLString OGRDMTableLayer::BuildFilter(const swq_expr_node *poNode)
+
+{
+    const int nFieldCount = poFeatureDefn->GetFieldCount();
+
+    /* Name of the column referenced by a SNT_COLUMN node, and its */
+    /* definition (nullptr for the FID column). */
+    const auto GetColumn =
+        [this, nFieldCount](const swq_expr_node *poColumn,
+                            const OGRFieldDefn *&poFieldDefnOut) -> CPLString
+    {
+        poFieldDefnOut = nullptr;
+        if (poColumn->eNodeType != SNT_COLUMN || poColumn->table_index != 0)
+            return CPLString();
+        if (poColumn->field_index >= 0 && poColumn->field_index < nFieldCount)
+        {
+            poFieldDefnOut = poFeatureDefn->GetFieldDefn(poColumn->field_index);
+            const OGRFieldType eType = poFieldDefnOut->GetType();
+            if (eType != OFTInteger && eType != OFTInteger64 &&
+                eType != OFTReal && eType != OFTString && eType != OFTDate &&
+                eType != OFTTime && eType != OFTDateTime)
+                return CPLString();
+            return poFieldDefnOut->GetNameRef();
+        }
+        if (poColumn->field_index == nFieldCount + SPF_FID &&
+            pszFIDColumn != nullptr)
+            return pszFIDColumn;
+        return CPLString();
+    };
+
+    if (poNode->eNodeType == SNT_OPERATION && poNode->nOperation == SWQ_AND &&
+        poNode->nSubExprCount == 2)
+    {
+        /* For AND, a failure in one of the branches is fine since the */
+        /* client side evaluation will do the extra filtering. */
+        CPLString osFilter1 = BuildFilter(poNode->papoSubExpr[0]);
+        CPLString osFilter2 = BuildFilter(poNode->papoSubExpr[1]);
+        if (!osFilter1.empty() && !osFilter2.empty())
+            return '(' + osFilter1 + ") AND (" + osFilter2 + ')';
+        else if (!osFilter1.empty())
+            return osFilter1;
+        else
+            return osFilter2;
+    }
+    else if (poNode->eNodeType == SNT_OPERATION &&
+             poNode->nOperation == SWQ_OR && poNode->nSubExprCount == 2)
+    {
+        /* Evaluate both branches before testing, so that a partial */
+        /* translation is flagged as needing client side evaluation. */
+        CPLString osFilter1 = BuildFilter(poNode->papoSubExpr[0]);
+        CPLString osFilter2 = BuildFilter(poNode->papoSubExpr[1]);
+        if (!osFilter1.empty() && !osFilter2.empty())
+            return '(' + osFilter1 + ") OR (" + osFilter2 + ')';
+    }
+    else if (poNode->eNodeType == SNT_OPERATION &&
+             poNode->nOperation == SWQ_NOT && poNode->nSubExprCount == 1)
+    {
+        const bool bMustBeClientSideEvaluatedBefore =
+            m_bFilterMustBeClientSideEvaluated;
+        m_bFilterMustBeClientSideEvaluated = false;
+        CPLString osFilterChild = BuildFilter(poNode->papoSubExpr[0]);
+        /* NOT of a partial translation would select too few rows */
+        const bool bPartial = m_bFilterMustBeClientSideEvaluated;
+        m_bFilterMustBeClientSideEvaluated = bMustBeClientSideEvaluatedBefore;
+        if (!osFilterChild.empty() && !bPartial)
+            return "NOT (" + osFilterChild + ')';
+    }
+    else if (poNode->eNodeType == SNT_OPERATION &&
+             poNode->nOperation == SWQ_ISNULL && poNode->nSubExprCount == 1)
+    {
+        const OGRFieldDefn *poFieldDefn = nullptr;
+        CPLString osColumn = GetColumn(poNode->papoSubExpr[0], poFieldDefn);
+        if (!osColumn.empty())
+            return osColumn + " IS NULL";
+    }
+    else if (poNode->eNodeType == SNT_OPERATION &&
+             poNode->nOperation == SWQ_IN && poNode->nSubExprCount >= 2)
+    {
+        const OGRFieldDefn *poFieldDefn = nullptr;
+        CPLString osColumn = GetColumn(poNode->papoSubExpr[0], poFieldDefn);
+        if (!osColumn.empty())
+        {
+            CPLString osRet = osColumn + " IN (";
+            int i = 1;
+            for (; i < poNode->nSubExprCount; i++)
+            {
+                CPLString osValue =
+                    BuildFilterValue(poFieldDefn, poNode->papoSubExpr[i]);
+                if (osValue.empty())
+                    break;
+                if (i > 1)
+                    osRet += ", ";
+                osRet += osValue;
+            }
+            if (i == poNode->nSubExprCount)
+                return osRet + ')';
+        }
+    }
+    else if (poNode->eNodeType == SNT_OPERATION &&
+             (poNode->nOperation == SWQ_LIKE ||
+              poNode->nOperation == SWQ_ILIKE) &&
+             (poNode->nSubExprCount == 2 || poNode->nSubExprCount == 3))
+    {
+        const OGRFieldDefn *poFieldDefn = nullptr;
+        CPLString osColumn = GetColumn(poNode->papoSubExpr[0], poFieldDefn);
+        const swq_expr_node *poPattern = poNode->papoSubExpr[1];
+        const swq_expr_node *poEscape =
+            poNode->nSubExprCount == 3 ? poNode->papoSubExpr[2] : nullptr;
+        if (!osColumn.empty() && poFieldDefn != nullptr &&
+            poFieldDefn->GetType() == OFTString &&
+            poPattern->eNodeType == SNT_CONSTANT &&
+            poPattern->field_type == SWQ_STRING && !poPattern->is_null &&
+            (poEscape == nullptr ||
+             (poEscape->eNodeType == SNT_CONSTANT &&
+              poEscape->field_type == SWQ_STRING && !poEscape->is_null &&
+              strlen(poEscape->string_value) == 1)))
+        {
+            CPLString osPattern = BuildFilterValue(poFieldDefn, poPattern);
+            CPLString osRet;
+            if (poNode->nOperation == SWQ_ILIKE ||
+                CPLTestBool(
+                    CPLGetConfigOption("OGR_SQL_LIKE_AS_ILIKE", "FALSE")))
+            {
+                osRet = "UPPER(" + osColumn + ") LIKE UPPER(" + osPattern + ')';
+            }
+            else
+            {
+                osRet = osColumn + " LIKE " + osPattern;
+            }
+            if (poEscape != nullptr)
+                osRet += " ESCAPE " + BuildFilterValue(poFieldDefn, poEscape);
+            return osRet;
+        }
+    }
+    else if (poNode->eNodeType == SNT_OPERATION &&
+             (poNode->nOperation == SWQ_EQ || poNode->nOperation == SWQ_NE ||
+              poNode->nOperation == SWQ_GT || poNode->nOperation == SWQ_GE ||
+              poNode->nOperation == SWQ_LT || poNode->nOperation == SWQ_LE) &&
+             poNode->nSubExprCount == 2)
     {
-        osWHERE = "";
+        const swq_expr_node *poLeft = poNode->papoSubExpr[0];
+        const swq_expr_node *poRight = poNode->papoSubExpr[1];
+        swq_op eOp = poNode->nOperation;
+
+        /* Put the column on the left hand side */
+        if (poLeft->eNodeType == SNT_CONSTANT &&
+            poRight->eNodeType == SNT_COLUMN)
+        {
+            std::swap(poLeft, poRight);
+            if (eOp == SWQ_GT)
+                eOp = SWQ_LT;
+            else if (eOp == SWQ_GE)
+                eOp = SWQ_LE;
+            else if (eOp == SWQ_LT)
+                eOp = SWQ_GT;
+            else if (eOp == SWQ_LE)
+                eOp = SWQ_GE;
+        }
+
+        const OGRFieldDefn *poFieldDefn = nullptr;
+        CPLString osColumn = GetColumn(poLeft, poFieldDefn);
+        CPLString osValue;
+        if (!osColumn.empty() && poRight->eNodeType == SNT_COLUMN)
+        {
+            const OGRFieldDefn *poOtherFieldDefn = nullptr;
+            osValue = GetColumn(poRight, poOtherFieldDefn);
+            const OGRFieldType eType =
+                poFieldDefn ? poFieldDefn->GetType() : OFTInteger64;
+            const OGRFieldType eOtherType =
+                poOtherFieldDefn ? poOtherFieldDefn->GetType() : OFTInteger64;
+            const auto IsNumeric = [](OGRFieldType e)
+            { return e == OFTInteger || e == OFTInteger64 || e == OFTReal; };
+            if (eType != eOtherType &&
+                !(IsNumeric(eType) && IsNumeric(eOtherType)))
+                osValue.clear();
+        }
+        else if (!osColumn.empty())
+        {
+            osValue = BuildFilterValue(poFieldDefn, poRight);
+        }
+
+        if (!osValue.empty())
+        {
+            const char *pszOp = "=";
+            switch (eOp)
+            {
+                case SWQ_NE:
+                    pszOp = "<>";
+                    break;
+                case SWQ_GT:
+                    pszOp = ">";
+                    break;
+                case SWQ_GE:
+                    pszOp = ">=";
+                    break;
+                case SWQ_LT:
+                    pszOp = "<";
+                    break;
+                case SWQ_LE:
+                    pszOp = "<=";
+                    break;
+                default:
+                    break;
+            }
+            return osColumn + ' ' + pszOp + ' ' + osValue;
+        }
     }
+
+    m_bFilterMustBeClientSideEvaluated = true;
+    return CPLString();
 }
 
 /************************************************************************/
@@ -807,6 +1142,9 @@ void OGRDMTableLayer::ResetReading()
         return;
     bInResetReading = TRUE;
 
+    /* Make the features created so far visible to the new query */
+    FlushPendingInserts();
+
     BuildFullQueryStatement();
 
     OGRDMLayer::ResetReading();
@@ -839,11 +1177,14 @@ OGRFeature *OGRDMTableLayer::GetNextFeature()
         /* We just have to look if there is a geometry filter */
         /* If there's a geometry column, the spatial filter */
         /* is already taken into account in the select request */
-        /* The attribute filter is always taken into account by the select request */
-        if (m_poFilterGeom == nullptr || poGeomFieldDefn == nullptr ||
-            poGeomFieldDefn->eDMGeoType == GEOM_TYPE_GEOMETRY ||
-            poGeomFieldDefn->eDMGeoType == GEOM_TYPE_GEOGRAPHY ||
-            FilterGeometry(poFeature->GetGeomFieldRef(m_iGeomFieldFilter)))
+        /* The attribute filter is taken into account by the select */
+        /* request, unless part of it could not be translated to SQL */
+        if ((m_poFilterGeom == nullptr || poGeomFieldDefn == nullptr ||
+             poGeomFieldDefn->eDMGeoType == GEOM_TYPE_GEOMETRY ||
+             poGeomFieldDefn->eDMGeoType == GEOM_TYPE_GEOGRAPHY ||
+             FilterGeometry(poFeature->GetGeomFieldRef(m_iGeomFieldFilter))) &&
+            (m_poAttrQuery == nullptr || !m_bFilterMustBeClientSideEvaluated ||
+             m_poAttrQuery->Evaluate(poFeature)))
         {
             if (iFIDAsRegularColumnIndex >= 0)
             {
@@ -857,6 +1198,23 @@ OGRFeature *OGRDMTableLayer::GetNextFeature()
     }
 }
 
+/************************************************************************/
+/*                         GetNextArrowArray()                          */
+/************************************************************************/
+
+int OGRDMTableLayer::GetNextArrowArray(struct ArrowArrayStream *stream,
+                                       struct ArrowArray *out_array)
+{
+    if (pszQueryStatement == nullptr)
+        ResetReading();
+
+    /* The FID has to be copied into a regular field by GetNextFeature() */
+    if (iFIDAsRegularColumnIndex >= 0)
+        return OGRLayer::GetNextArrowArray(stream, out_array);
+
+    return OGRDMLayer::GetNextArrowArray(stream, out_array);
+}
+
 /************************************************************************/
 /*                            BuildFields()                             */
 /*                                                                      */
@@ -947,13 +1305,31 @@ CPLString OGRDMTableLayer::BuildFields()
 OGRErr OGRDMTableLayer::SetAttributeFilter(const char *pszQuery)
 
 {
-    CPLFree(m_pszAttrQueryString);
-    m_pszAttrQueryString = (pszQuery) ? CPLStrdup(pszQuery) : nullptr;
+    OGRErr eErr = OGRLayer::SetAttributeFilter(pszQuery);
+    if (eErr != OGRERR_NONE)
+        return eErr;
 
-    if (pszQuery == nullptr)
-        osQuery = "";
-    else
-        osQuery = pszQuery;
+    osQuery = "";
+    m_bFilterMustBeClientSideEvaluated = false;
+    if (m_poAttrQuery != nullptr)
+    {
+        swq_expr_node *poNode =
+            static_cast<swq_expr_node *>(m_poAttrQuery->GetSWQExpr());
+        poNode->ReplaceBetweenByGEAndLERecurse();
+
+        osQuery = BuildFilter(poNode);
+        if (osQuery.empty())
+        {
+            m_bFilterMustBeClientSideEvaluated = true;
+            CPLDebug("DM", "Full filter will be evaluated on client side.");
+        }
+        else if (m_bFilterMustBeClientSideEvaluated)
+        {
+            CPLDebug("DM", "Only part of the filter (%s) will be evaluated "
+                           "on server side.",
+                     osQuery.c_str());
+        }
+    }
 
     BuildWhere();
 
@@ -969,6 +1345,7 @@ OGRErr OGRDMTableLayer::SetAttributeFilter(const char *pszQuery)
 OGRErr OGRDMTableLayer::DeleteFeature(GIntBig nFID)
 
 {
+    InvalidateStatistics();
     OGRDMConn *hDMConn = poDS->GetDMConn();
     OGRDMStatement oCommand(hDMConn);
     CPLString osCommand;
@@ -1047,6 +1424,7 @@ CPLErr OGRDMTableLayer::CheckINI(int *checkini)
 
 OGRErr OGRDMTableLayer::ISetFeature(OGRFeature *poFeature)
 {
+    InvalidateStatistics();
     OGRDMConn *hDMConn = poDS->GetDMConn();
     OGRDMStatement oCommand(hDMConn);
     CPLString osCommand;
@@ -1244,6 +1622,7 @@ OGRErr OGRDMTableLayer::ISetFeature(OGRFeature *poFeature)
 
 OGRErr OGRDMTableLayer::ICreateFeature(OGRFeature *poFeature)
 {
+    InvalidateStatistics();
     GetLayerDefn()->GetFieldCount();
 
     if (nullptr == poFeature)
@@ -1295,7 +1674,10 @@ OGRErr OGRDMTableLayer::ICreateFeature(OGRFeature *poFeature)
     }
 
     OGRErr eErr;
-    eErr = CreateFeatureViaInsert(poFeature);
+    if (bUseBulkLoad)
+        eErr = CreateFeatureViaBulkLoad(poFeature);
+    else
+        eErr = CreateFeatureViaInsert(poFeature);
 
     if (eErr == OGRERR_NONE && iFIDAsRegularColumnIndex >= 0)
     {
@@ -1336,9 +1718,8 @@ OGRErr OGRDMTableLayer::CreateFeatureViaInsert(OGRFeature *poFeature)
         char **hResult = oCommand.SimpleFetchRow();
         hResult = oCommand.SimpleFetchRow();  //skip ogc_fid
         InsertStatement = new OGRDMStatement(hDMConn);
-        InsertSQL += " INSERT INTO \"";
-        InsertSQL += pszSqlTableName;
-        InsertSQL += "\" (";
+        InsertSQL += CPLString().Printf(" INSERT INTO \"%s\".\"%s\" (",
+                                        pszSchemaName, pszTableName);
         sql = ") VALUES(";
         while (hResult)
         {
@@ -1349,13 +1730,14 @@ OGRErr OGRDMTableLayer::CreateFeatureViaInsert(OGRFeature *poFeature)
                 InsertSQL += ", ";
                 sql += ",";
             }
-            InsertSQL += hResult[0];
+            InsertSQL += CPLString().Printf("\"%s\"", hResult[0]);
             mymap.insert(std::make_pair(hResult[0], num++));
             sql += "?";
             hResult = oCommand.SimpleFetchRow();
         }
         InsertSQL = InsertSQL + sql + ");";
         InsertStatement->Prepare(InsertSQL);
+        InsertStatement->SetInsertArraySize(poDS->nInsertArraySize);
     }
     CPLErr eErr =
         InsertStatement->Execute_for_insert(poFeatureDefn, poFeature, mymap);
@@ -1363,6 +1745,138 @@ OGRErr OGRDMTableLayer::CreateFeatureViaInsert(OGRFeature *poFeature)
     return eErr;
 }
 
+/************************************************************************/
+/*                      CreateFeatureViaBulkLoad()                      */
+/*                                                                      */
+/*      COPY-like path: all geometry and attribute fields are sent      */
+/*      through one array-bound INSERT with native types, and the       */
+/*      rows are committed when the load ends, in                       */
+/*      FlushPendingInserts().  Rows rejected by the server are only    */
+/*      reported when their batch is sent, so the error may come from   */
+/*      a later CreateFeature() call, or from the flush, rather than    */
+/*      from the call that passed the faulty feature.                   */
+/************************************************************************/
+
+OGRErr OGRDMTableLayer::CreateFeatureViaBulkLoad(OGRFeature *poFeature)
+
+{
+    /* Fields were added or removed since the INSERT was prepared */
+    if (InsertStatement != nullptr &&
+        nBulkLoadFieldCount != poFeatureDefn->GetFieldCount())
+    {
+        OGRErr eErr = FlushPendingInserts();
+        delete InsertStatement;
+        InsertStatement = nullptr;
+        if (eErr != OGRERR_NONE)
+            return eErr;
+    }
+
+    if (InsertStatement == nullptr)
+    {
+        /* Geometries sent as text, or to columns of unknown type, are   */
+        /* only handled by the regular INSERT.                            */
+        bool bCanBulkLoad =
+            !CPLTestBool(CPLGetConfigOption("DM_USE_TEXT", "NO"));
+        for (int i = 0; bCanBulkLoad && i < poFeatureDefn->GetGeomFieldCount();
+             i++)
+        {
+            if (poFeatureDefn->GetGeomFieldDefn(i)->eDMGeoType ==
+                GEOM_TYPE_UNKNOWN)
+                bCanBulkLoad = false;
+        }
+        if (!bCanBulkLoad)
+        {
+            bUseBulkLoad = false;
+            return CreateFeatureViaInsert(poFeature);
+        }
+
+        std::vector<int> anGeomFields;
+        std::vector<int> anFields;
+        CPLString osColumns;
+        CPLString osValues;
+
+        for (int i = 0; i < poFeatureDefn->GetGeomFieldCount(); i++)
+        {
+            if (!osColumns.empty())
+            {
+                osColumns += ", ";
+                osValues += ", ";
+            }
+            osColumns += CPLString().Printf(
+                "\"%s\"", poFeatureDefn->GetGeomFieldDefn(i)->GetNameRef());
+            osValues += "?";
+            anGeomFields.push_back(i);
+        }
+        for (int i = 0; i < poFeatureDefn->GetFieldCount(); i++)
+        {
+            if (iFIDAsRegularColumnIndex == i || m_abGeneratedColumns[i])
+                continue;
+            if (!osColumns.empty())
+            {
+                osColumns += ", ";
+                osValues += ", ";
+            }
+            osColumns += CPLString().Printf(
+                "\"%s\"", poFeatureDefn->GetFieldDefn(i)->GetNameRef());
+            osValues += "?";
+            anFields.push_back(i);
+        }
+        if (osColumns.empty())
+        {
+            bUseBulkLoad = false;
+            return CreateFeatureViaInsert(poFeature);
+        }
+
+        CPLString osCommand;
+        osCommand.Printf("INSERT INTO \"%s\".\"%s\" (%s) VALUES(%s)",
+                         pszSchemaName, pszTableName, osColumns.c_str(),
+                         osValues.c_str());
+
+        InsertStatement = new OGRDMStatement(poDS->GetDMConn());
+        InsertStatement->SetInsertArraySize(poDS->nInsertArraySize);
+        if (InsertStatement->PrepareBulkLoad(osCommand, poFeatureDefn,
+                                             anGeomFields,
+                                             anFields) != CE_None)
+        {
+            delete InsertStatement;
+            InsertStatement = nullptr;
+            return OGRERR_FAILURE;
+        }
+        nBulkLoadFieldCount = poFeatureDefn->GetFieldCount();
+    }
+
+    return InsertStatement->BulkLoadFeature(poFeature) == CE_None
+               ? OGRERR_NONE
+               : OGRERR_FAILURE;
+}
+
+/************************************************************************/
+/*                        FlushPendingInserts()                         */
+/*                                                                      */
+/*      Send the features buffered by CreateFeatureViaInsert() that     */
+/*      do not fill a whole batch yet.                                  */
+/************************************************************************/
+
+OGRErr OGRDMTableLayer::FlushPendingInserts()
+
+{
+    if (InsertStatement == nullptr)
+        return OGRERR_NONE;
+    return InsertStatement->FlushInserts() == CE_None ? OGRERR_NONE
+                                                      : OGRERR_FAILURE;
+}
+
+/************************************************************************/
+/*                       DiscardPendingInserts()                        */
+/************************************************************************/
+
+void OGRDMTableLayer::DiscardPendingInserts()
+
+{
+    if (InsertStatement != nullptr)
+        InsertStatement->DiscardInserts();
+}
+
 /************************************************************************/
 /*                           TestCapability()                           */
 /************************************************************************/
@@ -1404,6 +1918,9 @@ int OGRDMTableLayer::TestCapability(const char *pszCap)
     else if (EQUAL(pszCap, OLCTransactions))
         return TRUE;
 
+    else if (EQUAL(pszCap, OLCFastGetArrowStream))
+        return iFIDAsRegularColumnIndex < 0;
+
     else if (EQUAL(pszCap, OLCFastGetExtent))
     {
         OGRDMGeomFieldDefn *poGeomFieldDefn = nullptr;
@@ -1847,6 +2364,68 @@ OGRErr OGRDMTableLayer::AlterFieldDefn(int iField,
     return OGRERR_NONE;
 }
 
+/************************************************************************/
+/*                            RunFIDQuery()                             */
+/*                                                                      */
+/*      Select the feature with the FID nFID.  The statement is         */
+/*      prepared once and kept, with its column maps, in oQuery: later  */
+/*      calls only re-execute it, as long as the field list and the     */
+/*      session are unchanged.                                          */
+/************************************************************************/
+
+OGRDMStatement *OGRDMTableLayer::RunFIDQuery(FIDQuery &oQuery, GIntBig nFID)
+
+{
+    OGRDMConn *hDMConn = GetLayerConn();
+    CPLString osCommand;
+    osCommand.Printf("SELECT %s FROM \"%s\" WHERE %s = ?",
+                     BuildFields().c_str(), pszSqlTableName, pszFIDColumn);
+
+    if (oQuery.poStmt != nullptr && oQuery.poStmt->GetConn() == hDMConn &&
+        oQuery.osSQL == osCommand)
+    {
+        oQuery.nFID = nFID;
+        if (oQuery.poStmt->Reexecute() != CE_None)
+            return nullptr;
+        return oQuery.poStmt;
+    }
+
+    ResetFIDQuery(oQuery);
+    oQuery.poStmt = new OGRDMStatement(hDMConn);
+    oQuery.nFID = nFID;
+    CPLErr eErr = oQuery.poStmt->Prepare(osCommand);
+    if (eErr == CE_None)
+        eErr = oQuery.poStmt->BindParam(1, &oQuery.nFID);
+    if (eErr == CE_None)
+        eErr = oQuery.poStmt->Excute_for_fetchmany(nullptr, 1);
+    if (eErr != CE_None)
+    {
+        ResetFIDQuery(oQuery);
+        return nullptr;
+    }
+    CreateMapFromFieldNameToIndex(oQuery.poStmt, poFeatureDefn,
+                                  oQuery.panMapFieldNameToIndex,
+                                  oQuery.panMapFieldNameToGeomIndex);
+    oQuery.osSQL = osCommand;
+    return oQuery.poStmt;
+}
+
+/************************************************************************/
+/*                           ResetFIDQuery()                            */
+/************************************************************************/
+
+void OGRDMTableLayer::ResetFIDQuery(FIDQuery &oQuery)
+
+{
+    delete oQuery.poStmt;
+    oQuery.poStmt = nullptr;
+    oQuery.osSQL.clear();
+    CPLFree(oQuery.panMapFieldNameToIndex);
+    oQuery.panMapFieldNameToIndex = nullptr;
+    CPLFree(oQuery.panMapFieldNameToGeomIndex);
+    oQuery.panMapFieldNameToGeomIndex = nullptr;
+}
+
 /************************************************************************/
 /*                             GetFeature()                             */
 /************************************************************************/
@@ -1862,69 +2441,31 @@ OGRFeature *OGRDMTableLayer::GetFeature(GIntBig nFeatureId)
     /* -------------------------------------------------------------------- */
     /*      Issue query for a single record.                                */
     /* -------------------------------------------------------------------- */
-    OGRFeature *poFeature = nullptr;
-    OGRDMConn *hDMConn = poDS->GetDMConn();
-    OGRDMStatement oCommand(hDMConn);
-    CPLErr eErr;
-    CPLString osFieldList = BuildFields();
-    CPLString osCommand;
-    DPIRETURN rt;
-
-    osCommand.Printf("DECLARE getfeaturecursor %s for "
-                     "SELECT %s FROM \"%s\" WHERE %s = " CPL_FRMT_GIB,
-                     (poDS->bUseBinaryCursor) ? "BINARY CURSOR" : "CURSOR",
-                     osFieldList.c_str(), pszSqlTableName, pszFIDColumn,
-                     nFeatureId);
-
-    eErr = oCommand.Execute(osCommand);
-
-    if (eErr == CE_None)
+    FlushPendingInserts();
+    OGRDMStatement *poStmt = RunFIDQuery(m_oGetFeatureQuery, nFeatureId);
+    if (poStmt == nullptr)
     {
-        eErr = oCommand.Execute("FETCH ALL in getfeaturecursor");
-
-        if (eErr == CE_None)
-        {
-            sdint2 nParams;
-            rt = dpi_number_params(oCommand.GetStatement(), &nParams);
-            if (nParams > 0)
-            {
-                int *panTempMapFieldNameToIndex = nullptr;
-                int *panTempMapFieldNameToGeomIndex = nullptr;
-                CreateMapFromFieldNameToIndex(&oCommand, poFeatureDefn,
-                                              panTempMapFieldNameToIndex,
-                                              panTempMapFieldNameToGeomIndex);
-                poFeature =
-                    RecordToFeature(&oCommand, panTempMapFieldNameToIndex,
-                                    panTempMapFieldNameToGeomIndex, 0);
-                CPLFree(panTempMapFieldNameToIndex);
-                CPLFree(panTempMapFieldNameToGeomIndex);
-                if (poFeature && iFIDAsRegularColumnIndex >= 0)
-                {
-                    poFeature->SetField(iFIDAsRegularColumnIndex,
-                                        poFeature->GetFID());
-                }
+        CPLError(CE_Failure, CPLE_AppDefined, "Get Feature Failed!");
+        return nullptr;
+    }
 
-                if (nParams > 1)
-                {
-                    CPLError(
-                        CE_Warning, CPLE_AppDefined,
-                        "%d rows in response to the WHERE %s = " CPL_FRMT_GIB
-                        " clause !",
-                        nParams, pszFIDColumn, nFeatureId);
-                }
-            }
-            else
-            {
-                CPLError(CE_Failure, CPLE_AppDefined,
-                         "Attempt to read feature with unknown feature id "
-                         "(" CPL_FRMT_GIB ").",
-                         nFeatureId);
-            }
-        }
+    ulength nRows = 0;
+    char ***papszRows = poStmt->Fetchmany(&nRows);
+    if (papszRows == nullptr || nRows == 0)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Attempt to read feature with unknown feature id "
+                 "(" CPL_FRMT_GIB ").",
+                 nFeatureId);
+        return nullptr;
     }
-    else if (eErr != CE_None)
+
+    OGRFeature *poFeature = RecordToFeature(
+        poStmt, m_oGetFeatureQuery.panMapFieldNameToIndex,
+        m_oGetFeatureQuery.panMapFieldNameToGeomIndex, 0, papszRows);
+    if (poFeature && iFIDAsRegularColumnIndex >= 0)
     {
-        CPLError(CE_Failure, CPLE_AppDefined, "Get Feature Failed!");
+        poFeature->SetField(iFIDAsRegularColumnIndex, poFeature->GetFID());
     }
 
     return poFeature;
@@ -1938,29 +2479,83 @@ GIntBig OGRDMTableLayer::GetFeatureCount(int bForce)
 
 {
     /* -------------------------------------------------------------------- */
-    /*      In theory it might be wise to cache this result, but it         */
-    /*      won't be trivial to work out the lifetime of the value.         */
-    /*      After all someone else could be adding records from another     */
-    /*      application when working against a database.                    */
+    /*      Filters that are not fully evaluated by the server need the     */
+    /*      features to be read.  Otherwise the unfiltered count is         */
+    /*      cached until this connection writes to the table, so records    */
+    /*      added by another application in the meantime are not seen.      */
+    /*      -1 is returned if the count cannot be computed.                 */
     /* -------------------------------------------------------------------- */
-    OGRDMConn *hDMConn = poDS->GetDMConn();
+    OGRDMGeomFieldDefn *poGeomFieldDefn = nullptr;
+    if (poFeatureDefn->GetGeomFieldCount() != 0)
+        poGeomFieldDefn =
+            poFeatureDefn->GetGeomFieldDefn(m_iGeomFieldFilter);
+    if ((m_poAttrQuery != nullptr && m_bFilterMustBeClientSideEvaluated) ||
+        (m_poFilterGeom != nullptr && poGeomFieldDefn != nullptr &&
+         poGeomFieldDefn->eDMGeoType != GEOM_TYPE_GEOMETRY &&
+         poGeomFieldDefn->eDMGeoType != GEOM_TYPE_GEOGRAPHY))
+    {
+        return OGRLayer::GetFeatureCount(bForce);
+    }
+
+    const bool bNoFilter = m_poAttrQuery == nullptr && m_poFilterGeom == nullptr;
+    if (bNoFilter && m_nCachedFeatureCount >= 0)
+        return m_nCachedFeatureCount;
+
+    FlushPendingInserts();
+
+    /* Without filter, an approximate count is good enough */
+    if (!bForce && bNoFilter)
+    {
+        const GIntBig nCatalogCount = GetCatalogFeatureCount();
+        if (nCatalogCount >= 0)
+            return nCatalogCount;
+    }
+
+    OGRDMConn *hDMConn = GetLayerConn();
     OGRDMStatement oCommand(hDMConn);
     CPLString osCommand;
-    GIntBig nCount = 0;
+    GIntBig nCount = -1;
 
     osCommand.Printf("SELECT count(*) FROM \"%s\" %s", pszSqlTableName,
                      osWHERE.c_str());
 
     CPLErr rt = oCommand.Execute(osCommand);
-    char **hResult = oCommand.SimpleFetchRow();
-    if (hResult != nullptr && !DSQL_SUCCEEDED(rt))
+    char **hResult = rt == CE_None ? oCommand.SimpleFetchRow() : nullptr;
+    if (hResult != nullptr && hResult[0] != nullptr)
+    {
         nCount = CPLAtoGIntBig(hResult[0]);
+        if (bNoFilter)
+            m_nCachedFeatureCount = nCount;
+    }
     else
         CPLDebug("DM", "%s; failed.", osCommand.c_str());
 
     return nCount;
 }
 
+/************************************************************************/
+/*                       GetCatalogFeatureCount()                       */
+/*                                                                      */
+/*      Row count recorded in the catalog by the last statistics        */
+/*      gathering, or -1 if there is none.                              */
+/************************************************************************/
+
+GIntBig OGRDMTableLayer::GetCatalogFeatureCount()
+
+{
+    OGRDMStatement oCommand(GetLayerConn());
+    CPLString osCommand;
+    osCommand.Printf("SELECT NUM_ROWS FROM DBA_TABLES WHERE OWNER = '%s' "
+                     "AND TABLE_NAME = '%s'",
+                     pszSchemaName, pszTableName);
+
+    CPLErr rt = oCommand.Execute(osCommand);
+    char **hResult = rt == CE_None ? oCommand.SimpleFetchRow() : nullptr;
+    if (hResult == nullptr || hResult[0] == nullptr || hResult[0][0] == '\0')
+        return -1;
+    return CPLAtoGIntBig(hResult[0]);
+}
+
 /************************************************************************/
 /*                             ResolveSRID()                            */
 /************************************************************************/
@@ -1968,7 +2563,7 @@ GIntBig OGRDMTableLayer::GetFeatureCount(int bForce)
 void OGRDMTableLayer::ResolveSRID(const OGRDMGeomFieldDefn *poGFldDefn)
 
 {
-    OGRDMConn *hDMConn = poDS->GetDMConn();
+    OGRDMConn *hDMConn = GetLayerConn();
     OGRDMStatement oCommand(hDMConn);
     CPLString osCommand;
     DPIRETURN rt;
@@ -2134,6 +2729,8 @@ OGRErr OGRDMTableLayer::GetExtent(int iGeomField,
         return OGRERR_FAILURE;
     }
 
+    FlushPendingInserts();
+
     OGRDMGeomFieldDefn *poGeomFieldDefn =
         poFeatureDefn->GetGeomFieldDefn(iGeomField);
 
@@ -2151,7 +2748,21 @@ OGRErr OGRDMTableLayer::GetExtent(int iGeomField,
             "Unable to get estimated extent by DMGEO2. Trying real extent.");
     }
 
-    return OGRDMLayer::GetExtent(psExtent, bForce);
+    const bool bNoFilter = m_poAttrQuery == nullptr && m_poFilterGeom == nullptr;
+    if (bNoFilter)
+    {
+        auto oIter = m_oMapCachedExtent.find(iGeomField);
+        if (oIter != m_oMapCachedExtent.end())
+        {
+            *psExtent = oIter->second;
+            return OGRERR_NONE;
+        }
+    }
+
+    OGRErr eErr = OGRDMLayer::GetExtent(iGeomField, psExtent, bForce);
+    if (eErr == OGRERR_NONE && bNoFilter)
+        m_oMapCachedExtent[iGeomField] = *psExtent;
+    return eErr;
 }
 
 /************************************************************************/
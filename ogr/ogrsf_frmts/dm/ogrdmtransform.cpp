@@ -2,6 +2,8 @@
 #include <math.h>
 #include <limits.h>
 #include <float.h>
+#include <limits>
+#include <vector>
 
 /** Max depth in a geometry. Matches the default YYINITDEPTH for WKT */
 #define LW_PARSER_MAX_DEPTH 200
@@ -2004,20 +2006,54 @@ LWGEOM *lwgeom_from_gserialized(GSERIALIZED *geom)
     return lwgeom_from_gserialized_buffer(data_ptr, lwflags, srid);
 }
 
+/***********************************************************************
+Name:
+gser_check_size
+Purpose:
+    check the size in the gserialized header against the number of
+    bytes fetched, and return the number of bytes that can be read.
+    A length of 0 means that the number of bytes fetched is not known,
+    in which case only the header is trusted. Values whose header
+    claims less than the 8 bytes of the header itself are rejected.
+***********************************************************************/
+static int gser_check_size(const GSERIALIZED *geom,
+                           size_t length,
+                           size_t *size)
+{
+    if (length != 0 && length < 8)
+        return LW_FALSE;
+    *size = LWSIZE_GET(geom->size);
+    if (*size < 8)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Invalid serialized geometry size: %u",
+                 static_cast<unsigned>(*size));
+        return LW_FALSE;
+    }
+    if (length != 0 && *size > length)
+        *size = length;
+    return LW_TRUE;
+}
+
 /***************************************************************
 Name:
 dm_gser_to_wkb
 Purpose:
-    gserialized to wkb.
+    gserialized to wkb. length is the number of bytes fetched for
+    the value, which must hold all of the serialized geometry, or 0
+    when it is not known.
 ***************************************************************/
 byte *dm_gser_to_wkb(GSERIALIZED *geom,
+                     size_t length,
                      ulint64 *size,
                      ulint *type)
 {
     LWGEOM *lwgeom;
     byte *wkb;
+    size_t gsize;
 
-    if (!geom)
+    if (!geom || !gser_check_size(geom, length, &gsize) ||
+        gsize < LWSIZE_GET(geom->size))
         return NULL;
 
     lwgeom = lwgeom_from_gserialized(geom);
@@ -2031,6 +2067,642 @@ byte *dm_gser_to_wkb(GSERIALIZED *geom,
     return wkb;
 }
 
+/*
+* Direct GSERIALIZED to OGRGeometry decoding.
+*
+* The functions below walk the serialized payload once and fill the
+* OGR coordinate arrays straight from it, instead of going through
+* lwgeom_from_gserialized(), lwgeom_to_wkb_buffer() and
+* OGRGeometryFactory::createFromWkb().
+*/
+typedef struct
+{
+    const byte *pos;         /* Current read position */
+    const byte *end;         /* End of the serialized buffer */
+    int has_z;               /* Z? */
+    int has_m;               /* M? */
+    int ndims;               /* Number of ordinates per point */
+    std::vector<OGRRawPoint> xy; /* Scratch buffers used to de-interleave */
+    std::vector<double> z;       /* XYZ, XYM and XYZM point arrays */
+    std::vector<double> m;
+} gser_read_state;
+
+/***********************************************************************
+Name:
+gser_read_uint
+Purpose:
+    read a 4 bytes unsigned integer from the gserialized payload.
+***********************************************************************/
+static int gser_read_uint(gser_read_state *s,
+                          ulint *value)
+{
+    if (s->end - s->pos < (ptrdiff_t)sizeof(ulint))
+        return LW_FALSE;
+    memcpy(value, s->pos, sizeof(ulint));
+    s->pos += sizeof(ulint);
+    return LW_TRUE;
+}
+
+/***********************************************************************
+Name:
+gser_check_points
+Purpose:
+    check that npoints points fit in what remains of the payload.
+***********************************************************************/
+static int gser_check_points(const gser_read_state *s,
+                             ulint npoints)
+{
+    const size_t ptsize = s->ndims * sizeof(double);
+
+    if (npoints > (ulint)INT_MAX)
+        return LW_FALSE;
+    if ((size_t)(s->end - s->pos) / ptsize < npoints)
+        return LW_FALSE;
+    return LW_TRUE;
+}
+
+/***********************************************************************
+Name:
+gser_read_curve_points
+Purpose:
+    copy npoints serialized points into a simple curve. 2D point arrays
+    have the OGRRawPoint layout and are copied in one go, others are
+    split into XY, Z and M arrays first.
+***********************************************************************/
+static int gser_read_curve_points(gser_read_state *s,
+                                  ulint npoints,
+                                  OGRSimpleCurve *curve)
+{
+    ulint i;
+
+    if (!gser_check_points(s, npoints))
+        return LW_FALSE;
+
+    if (s->ndims == 2)
+    {
+        if (!curve->setPoints((int)npoints, (const OGRRawPoint *)s->pos))
+            return LW_FALSE;
+    }
+    else
+    {
+        const double *ord = (const double *)s->pos;
+
+        s->xy.resize(npoints);
+        if (s->has_z)
+            s->z.resize(npoints);
+        if (s->has_m)
+            s->m.resize(npoints);
+        for (i = 0; i < npoints; i++)
+        {
+            double ptord[4];
+            int k = 0;
+
+            memcpy(ptord, ord + (size_t)i * s->ndims,
+                   s->ndims * sizeof(double));
+            s->xy[i].x = ptord[k++];
+            s->xy[i].y = ptord[k++];
+            if (s->has_z)
+                s->z[i] = ptord[k++];
+            if (s->has_m)
+                s->m[i] = ptord[k++];
+        }
+        if (!curve->setPoints((int)npoints, s->xy.data(),
+                              s->has_z ? s->z.data() : NULL,
+                              s->has_m ? s->m.data() : NULL))
+            return LW_FALSE;
+    }
+    s->pos += (size_t)npoints * s->ndims * sizeof(double);
+
+    return LW_TRUE;
+}
+
+/***********************************************************************
+Name:
+gser_read_point
+Purpose:
+    decode a serialized point.
+***********************************************************************/
+static OGRGeometry *gser_read_point(gser_read_state *s)
+{
+    ulint npoints = 0;
+    double ptord[4];
+
+    if (!gser_read_uint(s, &npoints))
+        return NULL;
+    if (npoints == 0) /* Empty point */
+        return new OGRPoint();
+    if (npoints != 1 || !gser_check_points(s, 1))
+        return NULL;
+
+    memcpy(ptord, s->pos, s->ndims * sizeof(double));
+    s->pos += s->ndims * sizeof(double);
+
+    if (s->has_z && s->has_m)
+        return new OGRPoint(ptord[0], ptord[1], ptord[2], ptord[3]);
+    if (s->has_z)
+        return new OGRPoint(ptord[0], ptord[1], ptord[2]);
+    if (s->has_m)
+        return OGRPoint::createXYM(ptord[0], ptord[1], ptord[2]);
+    return new OGRPoint(ptord[0], ptord[1]);
+}
+
+/***********************************************************************
+Name:
+gser_read_polygon
+Purpose:
+    decode a serialized polygon. The ring sizes are all stored before
+    the ordinates, padded to keep the ordinates double aligned.
+***********************************************************************/
+static OGRGeometry *gser_read_polygon(gser_read_state *s)
+{
+    ulint nrings = 0;
+    ulint i;
+
+    if (!gser_read_uint(s, &nrings))
+        return NULL;
+    if ((size_t)(s->end - s->pos) / sizeof(ulint) < nrings)
+        return NULL;
+
+    const byte *npoints_ptr = s->pos;
+    s->pos += (size_t)nrings * sizeof(ulint);
+    if (nrings % 2) /* If there is padding, move past that too. */
+        s->pos += sizeof(ulint);
+    if (s->pos > s->end)
+        return NULL;
+
+    OGRPolygon *poly = new OGRPolygon();
+    for (i = 0; i < nrings; i++)
+    {
+        ulint npoints = 0;
+
+        memcpy(&npoints, npoints_ptr + i * sizeof(ulint), sizeof(ulint));
+
+        OGRLinearRing *ring = new OGRLinearRing();
+        if (!gser_read_curve_points(s, npoints, ring))
+        {
+            delete ring;
+            delete poly;
+            return NULL;
+        }
+        poly->addRingDirectly(ring);
+    }
+
+    return poly;
+}
+
+static OGRGeometry *gser_read_geometry(gser_read_state *s,
+                                       int depth,
+                                       ulint *type);
+
+/***********************************************************************
+Name:
+gser_read_collection
+Purpose:
+    decode a serialized collection and its sub-geometries, which follow
+    each other without any header of their own.
+***********************************************************************/
+static OGRGeometry *gser_read_collection(gser_read_state *s,
+                                         ulint type,
+                                         int depth)
+{
+    OGRGeometry *geom = NULL;
+    ulint ngeoms = 0;
+    ulint i;
+
+    if (!gser_read_uint(s, &ngeoms))
+        return NULL;
+    /* Each sub-geometry takes at least its type and count */
+    if ((size_t)(s->end - s->pos) / 8 < ngeoms)
+        return NULL;
+
+    switch (type)
+    {
+        case MULTIPOINTTYPE:
+            geom = new OGRMultiPoint();
+            break;
+        case MULTILINETYPE:
+            geom = new OGRMultiLineString();
+            break;
+        case MULTIPOLYGONTYPE:
+            geom = new OGRMultiPolygon();
+            break;
+        case COMPOUNDTYPE:
+            geom = new OGRCompoundCurve();
+            break;
+        case CURVEPOLYTYPE:
+            geom = new OGRCurvePolygon();
+            break;
+        case MULTICURVETYPE:
+            geom = new OGRMultiCurve();
+            break;
+        case MULTISURFACETYPE:
+            geom = new OGRMultiSurface();
+            break;
+        case POLYHEDRALSURFACETYPE:
+            geom = new OGRPolyhedralSurface();
+            break;
+        case TINTYPE:
+            geom = new OGRTriangulatedSurface();
+            break;
+        default:
+            geom = new OGRGeometryCollection();
+            break;
+    }
+
+    for (i = 0; i < ngeoms; i++)
+    {
+        ulint subtype = 0;
+        OGRErr eErr = OGRERR_FAILURE;
+        OGRGeometry *sub = gser_read_geometry(s, depth + 1, &subtype);
+
+        if (sub == NULL || !lwcollection_allows_subtype(type, subtype))
+        {
+            delete sub;
+            delete geom;
+            return NULL;
+        }
+
+        switch (type)
+        {
+            case COMPOUNDTYPE:
+                eErr = geom->toCompoundCurve()->addCurveDirectly(
+                    sub->toCurve());
+                break;
+            case CURVEPOLYTYPE:
+                eErr = geom->toCurvePolygon()->addRingDirectly(sub->toCurve());
+                break;
+            case POLYHEDRALSURFACETYPE:
+            case TINTYPE:
+                eErr = geom->toPolyhedralSurface()->addGeometryDirectly(sub);
+                break;
+            default:
+                eErr = geom->toGeometryCollection()->addGeometryDirectly(sub);
+                break;
+        }
+        if (eErr != OGRERR_NONE)
+        {
+            delete sub;
+            delete geom;
+            return NULL;
+        }
+    }
+
+    return geom;
+}
+
+/***********************************************************************
+Name:
+gser_read_geometry
+Purpose:
+    decode the serialized geometry at the current position.
+***********************************************************************/
+static OGRGeometry *gser_read_geometry(gser_read_state *s,
+                                       int depth,
+                                       ulint *type)
+{
+    ulint npoints = 0;
+
+    if (depth > LW_PARSER_MAX_DEPTH || !gser_read_uint(s, type))
+        return NULL;
+
+    switch (*type)
+    {
+        case POINTTYPE:
+            return gser_read_point(s);
+        case LINETYPE:
+        case CIRCSTRINGTYPE:
+        {
+            OGRSimpleCurve *curve = NULL;
+
+            if (*type == LINETYPE)
+                curve = new OGRLineString();
+            else
+                curve = new OGRCircularString();
+            if (!gser_read_uint(s, &npoints) ||
+                !gser_read_curve_points(s, npoints, curve))
+            {
+                delete curve;
+                return NULL;
+            }
+            return curve;
+        }
+        case POLYGONTYPE:
+            return gser_read_polygon(s);
+        case TRIANGLETYPE:
+        {
+            OGRTriangle *triangle = new OGRTriangle();
+
+            if (!gser_read_uint(s, &npoints))
+            {
+                delete triangle;
+                return NULL;
+            }
+            if (npoints > 0)
+            {
+                OGRLinearRing *ring = new OGRLinearRing();
+                if (!gser_read_curve_points(s, npoints, ring) ||
+                    triangle->addRingDirectly(ring) != OGRERR_NONE)
+                {
+                    delete ring;
+                    delete triangle;
+                    return NULL;
+                }
+            }
+            return triangle;
+        }
+        case MULTIPOINTTYPE:
+        case MULTILINETYPE:
+        case MULTIPOLYGONTYPE:
+        case COMPOUNDTYPE:
+        case CURVEPOLYTYPE:
+        case MULTICURVETYPE:
+        case MULTISURFACETYPE:
+        case POLYHEDRALSURFACETYPE:
+        case TINTYPE:
+        case COLLECTIONTYPE:
+            return gser_read_collection(s, *type, depth);
+        default:
+            return NULL;
+    }
+}
+
+/***********************************************************************
+Name:
+gser_read_state_init
+Purpose:
+    parse the gserialized header and position the read state on the
+    first geometry, past the extended flags and the bounding box.
+    Reads are bounded by the smaller of the size in the header and
+    the length of the fetched buffer, when the latter is known.
+***********************************************************************/
+static int gser_read_state_init(gser_read_state *s,
+                                const GSERIALIZED *geom,
+                                size_t length)
+{
+    size_t size;
+
+    if (!gser_check_size(geom, length, &size))
+        return LW_FALSE;
+    s->pos = (const byte *)geom->data;
+    s->end = (const byte *)geom + size;
+    s->has_z = G2FLAGS_GET_Z(geom->gflags);
+    s->has_m = G2FLAGS_GET_M(geom->gflags);
+    s->ndims = 2 + s->has_z + s->has_m;
+
+    if (G2FLAGS_GET_EXTENDED(geom->gflags))
+        s->pos += sizeof(ulint64);
+    if (G2FLAGS_GET_BBOX(geom->gflags))
+    {
+        if (G2FLAGS_GET_GEODETIC(geom->gflags))
+            s->pos += 6 * sizeof(float);
+        else
+            s->pos += 2 * s->ndims * sizeof(float);
+    }
+    if (s->pos > s->end)
+        return LW_FALSE;
+
+    return LW_TRUE;
+}
+
+/***************************************************************
+Name:
+dm_gser_to_geometry
+Purpose:
+    gserialized to OGRGeometry, in a single pass over the buffer.
+    Returns NULL if the buffer cannot be decoded, in which case
+    callers may fall back to dm_gser_to_wkb(). length is the
+    number of bytes fetched for the value, or 0 when it is not
+    known.
+***************************************************************/
+OGRGeometry *dm_gser_to_geometry(const GSERIALIZED *geom,
+                                 size_t length)
+{
+    gser_read_state s;
+    ulint type = 0;
+
+    if (!geom || !gser_read_state_init(&s, geom, length))
+        return NULL;
+
+    OGRGeometry *poGeometry = gser_read_geometry(&s, 0, &type);
+    if (poGeometry == NULL)
+        return NULL;
+
+    /* Empty geometries carry no ordinates, so set the dimension here */
+    if (s.has_z)
+        poGeometry->set3D(TRUE);
+    if (s.has_m)
+        poGeometry->setMeasured(TRUE);
+
+    return poGeometry;
+}
+
+/***********************************************************************
+Name:
+gser_wkb_put
+Purpose:
+    append n bytes to the ISO WKB output. Only the size is accumulated
+    when no output buffer is given.
+***********************************************************************/
+static void gser_wkb_put(byte **out,
+                         size_t *size,
+                         const void *src,
+                         size_t n)
+{
+    if (*out)
+    {
+        memcpy(*out, src, n);
+        *out += n;
+    }
+    *size += n;
+}
+
+/***********************************************************************
+Name:
+gser_wkb_put_header
+Purpose:
+    write the byte order and the ISO geometry type code.
+***********************************************************************/
+static void gser_wkb_put_header(const gser_read_state *s,
+                                byte **out,
+                                size_t *size,
+                                ulint type)
+{
+    byte byte_order = IS_BIG_ENDIAN ? 0 : 1;
+    ulint wkbtype;
+
+    switch (type)
+    {
+        case POLYHEDRALSURFACETYPE:
+            wkbtype = WKB_POLYHEDRALSURFACE_TYPE;
+            break;
+        case TRIANGLETYPE:
+            wkbtype = WKB_TRIANGLE_TYPE;
+            break;
+        case TINTYPE:
+            wkbtype = WKB_TIN_TYPE;
+            break;
+        default:
+            wkbtype = type;
+            break;
+    }
+    if (s->has_z)
+        wkbtype += 1000;
+    if (s->has_m)
+        wkbtype += 2000;
+
+    gser_wkb_put(out, size, &byte_order, 1);
+    gser_wkb_put(out, size, &wkbtype, sizeof(ulint));
+}
+
+/***********************************************************************
+Name:
+gser_wkb_put_points
+Purpose:
+    copy npoints serialized points to the ISO WKB output. Both formats
+    store the ordinates interleaved in the same order.
+***********************************************************************/
+static int gser_wkb_put_points(gser_read_state *s,
+                               byte **out,
+                               size_t *size,
+                               ulint npoints)
+{
+    const size_t nbytes = (size_t)npoints * s->ndims * sizeof(double);
+
+    if (!gser_check_points(s, npoints))
+        return LW_FALSE;
+    gser_wkb_put(out, size, &npoints, sizeof(ulint));
+    gser_wkb_put(out, size, s->pos, nbytes);
+    s->pos += nbytes;
+
+    return LW_TRUE;
+}
+
+/***********************************************************************
+Name:
+gser_to_wkb_any
+Purpose:
+    convert the serialized geometry at the current position to ISO WKB.
+***********************************************************************/
+static int gser_to_wkb_any(gser_read_state *s,
+                           byte **out,
+                           size_t *size,
+                           int depth,
+                           ulint *type)
+{
+    ulint count = 0;
+    ulint i;
+
+    if (depth > LW_PARSER_MAX_DEPTH || !gser_read_uint(s, type) ||
+        !gser_read_uint(s, &count))
+        return LW_FALSE;
+
+    gser_wkb_put_header(s, out, size, *type);
+    switch (*type)
+    {
+        case POINTTYPE:
+            if (count == 0) /* Empty point is written as NaN ordinates */
+            {
+                const double nan = std::numeric_limits<double>::quiet_NaN();
+                for (i = 0; i < (ulint)s->ndims; i++)
+                    gser_wkb_put(out, size, &nan, sizeof(double));
+                return LW_TRUE;
+            }
+            if (count != 1 || !gser_check_points(s, 1))
+                return LW_FALSE;
+            gser_wkb_put(out, size, s->pos, s->ndims * sizeof(double));
+            s->pos += s->ndims * sizeof(double);
+            return LW_TRUE;
+        case LINETYPE:
+        case CIRCSTRINGTYPE:
+            return gser_wkb_put_points(s, out, size, count);
+        case TRIANGLETYPE:
+        {
+            /* A triangle is a polygon with a single ring in WKB */
+            ulint nrings = count > 0 ? 1 : 0;
+
+            gser_wkb_put(out, size, &nrings, sizeof(ulint));
+            if (count == 0)
+                return LW_TRUE;
+            return gser_wkb_put_points(s, out, size, count);
+        }
+        case POLYGONTYPE:
+        {
+            if ((size_t)(s->end - s->pos) / sizeof(ulint) < count)
+                return LW_FALSE;
+
+            const byte *npoints_ptr = s->pos;
+            s->pos += (size_t)count * sizeof(ulint);
+            if (count % 2) /* If there is padding, move past that too. */
+                s->pos += sizeof(ulint);
+            if (s->pos > s->end)
+                return LW_FALSE;
+
+            gser_wkb_put(out, size, &count, sizeof(ulint));
+            for (i = 0; i < count; i++)
+            {
+                ulint npoints = 0;
+
+                memcpy(&npoints, npoints_ptr + i * sizeof(ulint),
+                       sizeof(ulint));
+                if (!gser_wkb_put_points(s, out, size, npoints))
+                    return LW_FALSE;
+            }
+            return LW_TRUE;
+        }
+        case MULTIPOINTTYPE:
+        case MULTILINETYPE:
+        case MULTIPOLYGONTYPE:
+        case COMPOUNDTYPE:
+        case CURVEPOLYTYPE:
+        case MULTICURVETYPE:
+        case MULTISURFACETYPE:
+        case POLYHEDRALSURFACETYPE:
+        case TINTYPE:
+        case COLLECTIONTYPE:
+        {
+            if ((size_t)(s->end - s->pos) / 8 < count)
+                return LW_FALSE;
+
+            gser_wkb_put(out, size, &count, sizeof(ulint));
+            for (i = 0; i < count; i++)
+            {
+                ulint subtype = 0;
+
+                if (!gser_to_wkb_any(s, out, size, depth + 1, &subtype) ||
+                    !lwcollection_allows_subtype(*type, subtype))
+                    return LW_FALSE;
+            }
+            return LW_TRUE;
+        }
+        default:
+            return LW_FALSE;
+    }
+}
+
+/***************************************************************
+Name:
+dm_gser_to_iso_wkb
+Purpose:
+    gserialized to ISO WKB, copying the point arrays as they are.
+    When wkb is NULL only the size of the WKB is computed.
+    Returns the WKB size, or 0 if the buffer cannot be decoded.
+***************************************************************/
+size_t dm_gser_to_iso_wkb(const GSERIALIZED *geom,
+                          size_t length,
+                          byte *wkb)
+{
+    gser_read_state s;
+    ulint type = 0;
+    size_t size = 0;
+
+    if (!geom || !gser_read_state_init(&s, geom, length))
+        return 0;
+    if (!gser_to_wkb_any(&s, &wkb, &size, 0, &type))
+        return 0;
+
+    return size;
+}
+
 /**
 * Internal function declarations.
 */
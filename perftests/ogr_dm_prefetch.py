@@ -0,0 +1,65 @@
+# SPDX-License-Identifier: MIT
+# Copyright 2026, GDAL contributors
+
+# Compare the time to read a DM layer with and without the PREFETCH open
+# option, which fetches the next batch of rows while the current one is
+# turned into features. With CPL_DEBUG=DM set, the time spent waiting for
+# the background batches is also reported, which shows the overlap.
+
+import sys
+import time
+
+from osgeo import gdal
+
+gdal.UseExceptions()
+
+
+def Usage():
+    print("Usage: ogr_dm_prefetch.py [-repeat N] <DM connection string> <layer>")
+    sys.exit(1)
+
+
+def read_layer(connection_string, layer_name, prefetch):
+    with gdal.OpenEx(
+        connection_string,
+        gdal.OF_VECTOR,
+        open_options=["PREFETCH=" + prefetch],
+    ) as ds:
+        lyr = ds.GetLayerByName(layer_name)
+        start = time.perf_counter()
+        count = 0
+        for f in lyr:
+            f.GetGeometryRef()
+            count += 1
+        return count, time.perf_counter() - start
+
+
+def main():
+    repeat = 3
+    args = []
+    i = 1
+    while i < len(sys.argv):
+        if sys.argv[i] == "-repeat" and i + 1 < len(sys.argv):
+            repeat = int(sys.argv[i + 1])
+            i += 1
+        elif sys.argv[i][0] == "-":
+            Usage()
+        else:
+            args.append(sys.argv[i])
+        i += 1
+    if len(args) != 2:
+        Usage()
+
+    for prefetch in ("NO", "YES"):
+        timings = []
+        for _ in range(repeat):
+            count, elapsed = read_layer(args[0], args[1], prefetch)
+            timings.append(elapsed)
+        print(
+            f"PREFETCH={prefetch}: {count} features, best of {repeat}: "
+            f"{min(timings):.3f} s"
+        )
+
+
+if __name__ == "__main__":
+    main()
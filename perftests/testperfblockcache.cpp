@@ -0,0 +1,88 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  Test performance of concurrent accesses to the raster block cache.
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#include "gdal_priv.h"
+#include "cpl_conv.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Each thread reads again and again the blocks of its own in-memory dataset,
+// which all fit in the cache, so that almost every access is a cache hit.
+// Run with --config GDAL_BLOCK_CACHE_POLICY LRU or CLOCK to compare policies.
+
+static void ReadBlocks(int nIterations)
+{
+    constexpr int SIZE = 1024;
+    auto poDriver = GetGDALDriverManager()->GetDriverByName("MEM");
+    auto poDS = std::unique_ptr<GDALDataset>(
+        poDriver->Create("", SIZE, SIZE, 1, GDT_Byte, nullptr));
+    auto poBand = poDS->GetRasterBand(1);
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+    const int nBlocksX = DIV_ROUND_UP(SIZE, nBlockXSize);
+    const int nBlocksY = DIV_ROUND_UP(SIZE, nBlockYSize);
+
+    for (int iIter = 0; iIter < nIterations; iIter++)
+    {
+        for (int iY = 0; iY < nBlocksY; iY++)
+        {
+            for (int iX = 0; iX < nBlocksX; iX++)
+            {
+                GDALRasterBlock *poBlock = poBand->GetLockedBlockRef(iX, iY);
+                if (poBlock)
+                    poBlock->DropLock();
+            }
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    argc = GDALGeneralCmdLineProcessor(argc, &argv, 0);
+    if (argc < 1)
+        exit(-argc);
+
+    const int nThreads = argc >= 2 ? atoi(argv[1]) : 8;
+    const int nIterations = argc >= 3 ? atoi(argv[2]) : 1000;
+    if (nThreads <= 0 || nIterations <= 0)
+    {
+        fprintf(stderr, "Usage: testperfblockcache [num_threads] "
+                        "[num_iterations]\n");
+        CSLDestroy(argv);
+        return 1;
+    }
+
+    GDALAllRegister();
+    // Room for the blocks of all threads
+    GDALSetCacheMax64(static_cast<GIntBig>(nThreads) * 2 * 1024 * 1024);
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> aoThreads;
+    for (int i = 0; i < nThreads; i++)
+        aoThreads.emplace_back(ReadBlocks, nIterations);
+    for (auto &oThread : aoThreads)
+        oThread.join();
+    const auto end = std::chrono::steady_clock::now();
+
+    printf("%s policy, %d threads x %d iterations: %.2f s\n",
+           CPLGetConfigOption("GDAL_BLOCK_CACHE_POLICY", "LRU"), nThreads,
+           nIterations, std::chrono::duration<double>(end - start).count());
+
+    CSLDestroy(argv);
+    GDALDestroyDriverManager();
+    return 0;
+}
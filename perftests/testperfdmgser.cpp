@@ -0,0 +1,96 @@
+/******************************************************************************
+ *
+ * Project:  DM Translator
+ * Purpose:  Compare the decoding of serialized DM geometries into
+ *           OGRGeometry, directly or through LWGEOM and WKB.
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#include "ogr_dm.h"
+#include "ogr_p.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+// Polygon looking like a parcel, with a ring of nPoints points
+static std::unique_ptr<OGRPolygon> CreatePolygon(int nPoints)
+{
+    auto poRing = std::make_unique<OGRLinearRing>();
+    for (int i = 0; i < nPoints; i++)
+    {
+        const double dfAngle = 2 * M_PI * i / nPoints;
+        poRing->addPoint(500000 + 20 * cos(dfAngle),
+                         4500000 + 20 * sin(dfAngle));
+    }
+    poRing->closeRings();
+    auto poPolygon = std::make_unique<OGRPolygon>();
+    poPolygon->addRingDirectly(poRing.release());
+    return poPolygon;
+}
+
+int main(int argc, char *argv[])
+{
+    argc = GDALGeneralCmdLineProcessor(argc, &argv, 0);
+    if (argc < 1)
+        exit(-argc);
+
+    const int nIterations = argc >= 2 ? atoi(argv[1]) : 1000000;
+    const int nPoints = argc >= 3 ? atoi(argv[2]) : 16;
+    if (nIterations <= 0 || nPoints < 3)
+    {
+        fprintf(stderr, "Usage: testperfdmgser [num_iterations] "
+                        "[num_points_per_ring]\n");
+        CSLDestroy(argv);
+        return 1;
+    }
+
+    auto poPolygon = CreatePolygon(nPoints);
+    char *pszHexEWKB = OGRGeometryToHexEWKB(poPolygon.get(), 4326, 3, 3);
+    size_t nLength = 0;
+    GSERIALIZED *psGSer = gserialized_from_ewkb(pszHexEWKB, &nLength);
+    CPLFree(pszHexEWKB);
+    if (psGSer == nullptr)
+    {
+        fprintf(stderr, "gserialized_from_ewkb() failed\n");
+        CSLDestroy(argv);
+        return 1;
+    }
+
+    // Previous path: GSERIALIZED -> LWGEOM -> WKB -> OGRGeometry
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nIterations; i++)
+    {
+        ulint64 nWKBSize = 0;
+        byte *pabyWKB = dm_gser_to_wkb(psGSer, nLength, &nWKBSize, nullptr);
+        OGRGeometry *poGeom = nullptr;
+        OGRGeometryFactory::createFromWkb(pabyWKB, nullptr, &poGeom,
+                                          static_cast<size_t>(nWKBSize),
+                                          wkbVariantOldOgc);
+        CPLFree(pabyWKB);
+        delete poGeom;
+    }
+    auto end = std::chrono::steady_clock::now();
+    printf("dm_gser_to_wkb() + createFromWkb(): %.3f s\n",
+           std::chrono::duration<double>(end - start).count());
+
+    // Direct decoding
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nIterations; i++)
+    {
+        delete dm_gser_to_geometry(psGSer, nLength);
+    }
+    end = std::chrono::steady_clock::now();
+    printf("dm_gser_to_geometry(): %.3f s\n",
+           std::chrono::duration<double>(end - start).count());
+
+    CPLFree(psGSer);
+    CSLDestroy(argv);
+    return 0;
+}
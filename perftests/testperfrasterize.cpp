@@ -0,0 +1,137 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Algorithms
+ * Purpose:  Test performance of GDALRasterizeLayers() with several threads.
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#include "gdal_priv.h"
+#include "gdal_alg.h"
+#include "cpl_conv.h"
+#include "cpl_string.h"
+#include "ogrsf_frmts.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+
+// Burn a layer of small random quadrilaterals, evenly spread over the
+// raster, with the serial and the tile-parallel implementations of
+// GDALRasterizeLayers(). The reference benchmark is 10 million polygons into
+// a 100000 x 100000 raster, which should be written to a sparse tiled
+// GeoTIFF file:
+//   testperfrasterize 10000000 100000 ALL_CPUS /tmp/out.tif
+
+static double Rasterize(GDALDataset *poDS, OGRLayer *poLayer,
+                        const char *pszThreads)
+{
+    CPLStringList aosOptions;
+    aosOptions.SetNameValue("NUM_THREADS", pszThreads);
+    int nBand = 1;
+    double dfBurnValue = 1;
+    OGRLayerH hLayer = OGRLayer::ToHandle(poLayer);
+    const auto start = std::chrono::steady_clock::now();
+    GDALRasterizeLayers(GDALDataset::ToHandle(poDS), 1, &nBand, 1, &hLayer,
+                        nullptr, nullptr, &dfBurnValue, aosOptions.List(),
+                        nullptr, nullptr);
+    poDS->FlushCache();
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+int main(int argc, char *argv[])
+{
+    argc = GDALGeneralCmdLineProcessor(argc, &argv, 0);
+    if (argc < 1)
+        exit(-argc);
+
+    const int nPolygons = argc >= 2 ? atoi(argv[1]) : 100000;
+    const int nSize = argc >= 3 ? atoi(argv[2]) : 10000;
+    const char *pszThreads = argc >= 4 ? argv[3] : "ALL_CPUS";
+    const std::string osOutput = argc >= 5 ? argv[4] : "";
+    if (nPolygons <= 0 || nSize <= 0)
+    {
+        fprintf(stderr, "Usage: testperfrasterize [num_polygons] "
+                        "[raster_size] [num_threads] [output_filename]\n");
+        CSLDestroy(argv);
+        return 1;
+    }
+
+    GDALAllRegister();
+
+    auto poMemDriver = GetGDALDriverManager()->GetDriverByName("Memory");
+    std::unique_ptr<GDALDataset> poVectorDS(
+        poMemDriver->Create("", 0, 0, 0, GDT_Unknown, nullptr));
+    OGRLayer *poLayer =
+        poVectorDS->CreateLayer("polygons", nullptr, wkbPolygon, nullptr);
+
+    // Polygons of a few pixels on average, so that they cover a significant
+    // part of the raster.
+    std::mt19937 oGenerator(0);
+    std::uniform_real_distribution<double> oPos(0, nSize);
+    const double dfMaxPolySize =
+        std::max(2.0, 4.0 * nSize / std::sqrt(static_cast<double>(nPolygons)));
+    std::uniform_real_distribution<double> oPolySize(1, dfMaxPolySize);
+    for (int i = 0; i < nPolygons; i++)
+    {
+        const double dfX = oPos(oGenerator);
+        const double dfY = oPos(oGenerator);
+        const double dfW = oPolySize(oGenerator);
+        const double dfH = oPolySize(oGenerator);
+        auto poRing = std::make_unique<OGRLinearRing>();
+        poRing->addPoint(dfX, dfY);
+        poRing->addPoint(dfX + dfW, dfY + dfH / 4);
+        poRing->addPoint(dfX + dfW * 3 / 4, dfY + dfH);
+        poRing->addPoint(dfX - dfW / 4, dfY + dfH * 3 / 4);
+        poRing->addPoint(dfX, dfY);
+        auto poPolygon = std::make_unique<OGRPolygon>();
+        poPolygon->addRingDirectly(poRing.release());
+        OGRFeature oFeature(poLayer->GetLayerDefn());
+        oFeature.SetGeometryDirectly(poPolygon.release());
+        CPL_IGNORE_RET_VAL(poLayer->CreateFeature(&oFeature));
+    }
+
+    std::unique_ptr<GDALDataset> poDS;
+    if (osOutput.empty())
+    {
+        auto poDriver = GetGDALDriverManager()->GetDriverByName("MEM");
+        poDS.reset(poDriver->Create("", nSize, nSize, 1, GDT_Byte, nullptr));
+    }
+    else
+    {
+        auto poDriver = GetGDALDriverManager()->GetDriverByName("GTiff");
+        CPLStringList aosCreationOptions;
+        aosCreationOptions.SetNameValue("TILED", "YES");
+        aosCreationOptions.SetNameValue("SPARSE_OK", "YES");
+        aosCreationOptions.SetNameValue("BIGTIFF", "IF_SAFER");
+        poDS.reset(poDriver->Create(osOutput.c_str(), nSize, nSize, 1,
+                                    GDT_Byte, aosCreationOptions.List()));
+    }
+    if (!poDS)
+    {
+        CSLDestroy(argv);
+        return 1;
+    }
+    double adfGeoTransform[6] = {0, 1, 0, 0, 0, 1};
+    poDS->SetGeoTransform(adfGeoTransform);
+
+    printf("%d polygons into %dx%d raster\n", nPolygons, nSize, nSize);
+    printf("1 thread: %.3f s\n", Rasterize(poDS.get(), poLayer, "1"));
+    printf("%s threads: %.3f s\n", pszThreads,
+           Rasterize(poDS.get(), poLayer, pszThreads));
+
+    poDS.reset();
+    poVectorDS.reset();
+    CSLDestroy(argv);
+    GDALDestroyDriverManager();
+    return 0;
+}
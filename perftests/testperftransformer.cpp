@@ -0,0 +1,157 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Algorithms
+ * Purpose:  Test performance of the warping transformers.
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#include "gdal_priv.h"
+#include "gdal_alg.h"
+#include "gdalwarper.h"
+#include "cpl_conv.h"
+#include "ogr_spatialref.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// For a few common pairs of CRS, time the approximate GenImgProj transformer
+// on all the scanlines of the target raster, as the warp kernel does, and a
+// nearest neighbour warp between in-memory datasets.
+
+namespace
+{
+struct CRSPair
+{
+    const char *pszSrcCRS;
+    double adfSrcGeoTransform[6];
+    const char *pszDstCRS;
+};
+}  // namespace
+
+static GDALDataset *CreateDataset(int nXSize, int nYSize,
+                                  const OGRSpatialReference &oSRS,
+                                  const double *padfGeoTransform)
+{
+    auto poDriver = GetGDALDriverManager()->GetDriverByName("MEM");
+    auto poDS = poDriver->Create("", nXSize, nYSize, 1, GDT_Byte, nullptr);
+    poDS->SetSpatialRef(&oSRS);
+    poDS->SetGeoTransform(const_cast<double *>(padfGeoTransform));
+    return poDS;
+}
+
+static void Benchmark(const CRSPair &sPair, int nSize, int nIterations)
+{
+    OGRSpatialReference oSrcSRS;
+    oSrcSRS.SetFromUserInput(sPair.pszSrcCRS);
+    oSrcSRS.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+    OGRSpatialReference oDstSRS;
+    oDstSRS.SetFromUserInput(sPair.pszDstCRS);
+    oDstSRS.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+
+    std::unique_ptr<GDALDataset> poSrcDS(
+        CreateDataset(nSize, nSize, oSrcSRS, sPair.adfSrcGeoTransform));
+
+    CPLStringList aosOptions;
+    aosOptions.SetNameValue("DST_SRS", sPair.pszDstCRS);
+    void *hTransformArg = GDALCreateGenImgProjTransformer2(
+        poSrcDS.get(), nullptr, aosOptions.List());
+    double adfDstGeoTransform[6] = {};
+    int nDstXSize = 0;
+    int nDstYSize = 0;
+    GDALSuggestedWarpOutput(poSrcDS.get(), GDALGenImgProjTransform,
+                            hTransformArg, adfDstGeoTransform, &nDstXSize,
+                            &nDstYSize);
+    GDALDestroyGenImgProjTransformer(hTransformArg);
+
+    std::unique_ptr<GDALDataset> poDstDS(
+        CreateDataset(nDstXSize, nDstYSize, oDstSRS, adfDstGeoTransform));
+
+    hTransformArg = GDALCreateGenImgProjTransformer2(
+        poSrcDS.get(), poDstDS.get(), nullptr);
+    void *hApproxArg = GDALCreateApproxTransformer(
+        GDALGenImgProjTransform, hTransformArg, 0.125);
+    GDALApproxTransformerOwnsSubtransformer(hApproxArg, TRUE);
+
+    std::vector<double> adfX(nDstXSize);
+    std::vector<double> adfY(nDstXSize);
+    std::vector<double> adfZ(nDstXSize);
+    std::vector<int> anSuccess(nDstXSize);
+    auto start = std::chrono::steady_clock::now();
+    for (int iIter = 0; iIter < nIterations; iIter++)
+    {
+        for (int iLine = 0; iLine < nDstYSize; iLine++)
+        {
+            for (int iPixel = 0; iPixel < nDstXSize; iPixel++)
+            {
+                adfX[iPixel] = iPixel + 0.5;
+                adfY[iPixel] = iLine + 0.5;
+                adfZ[iPixel] = 0.0;
+            }
+            GDALApproxTransform(hApproxArg, TRUE, nDstXSize, adfX.data(),
+                                adfY.data(), adfZ.data(), anSuccess.data());
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    printf("%s -> %s, %dx%d: transformer %.3f s",
+           sPair.pszSrcCRS, sPair.pszDstCRS, nDstXSize, nDstYSize,
+           std::chrono::duration<double>(end - start).count());
+    GDALDestroyApproxTransformer(hApproxArg);
+
+    start = std::chrono::steady_clock::now();
+    for (int iIter = 0; iIter < nIterations; iIter++)
+    {
+        GDALReprojectImage(poSrcDS.get(), nullptr, poDstDS.get(), nullptr,
+                           GRA_NearestNeighbour, 0, 0.125, nullptr, nullptr,
+                           nullptr);
+    }
+    end = std::chrono::steady_clock::now();
+    printf(", nearest warp %.3f s\n",
+           std::chrono::duration<double>(end - start).count());
+}
+
+int main(int argc, char *argv[])
+{
+    argc = GDALGeneralCmdLineProcessor(argc, &argv, 0);
+    if (argc < 1)
+        exit(-argc);
+
+    const int nSize = argc >= 2 ? atoi(argv[1]) : 4096;
+    const int nIterations = argc >= 3 ? atoi(argv[2]) : 5;
+    if (nSize <= 0 || nIterations <= 0)
+    {
+        fprintf(stderr, "Usage: testperftransformer [raster_size] "
+                        "[num_iterations]\n");
+        CSLDestroy(argv);
+        return 1;
+    }
+
+    GDALAllRegister();
+
+    const double dfDegRes = 10.0 / nSize;
+    const double dfMetricRes = 100000.0 / nSize;
+    const CRSPair asPairs[] = {
+        {"EPSG:4326", {2, dfDegRes, 0, 49, 0, -dfDegRes}, "EPSG:3857"},
+        {"EPSG:4326", {0, dfDegRes, 0, 50, 0, -dfDegRes}, "EPSG:32631"},
+        {"EPSG:32631",
+         {400000, dfMetricRes, 0, 5500000, 0, -dfMetricRes},
+         "EPSG:4326"},
+        {"EPSG:32631",
+         {400000, dfMetricRes, 0, 5500000, 0, -dfMetricRes},
+         "EPSG:3857"},
+        {"EPSG:3857",
+         {200000, dfMetricRes, 0, 6300000, 0, -dfMetricRes},
+         "EPSG:3857"},
+    };
+    for (const auto &sPair : asPairs)
+        Benchmark(sPair, nSize, nIterations);
+
+    CSLDestroy(argv);
+    GDALDestroyDriverManager();
+    return 0;
+}
@@ -136,6 +136,10 @@ public:
   }
 
 #if defined(SWIGPYTHON)
+  void GetCacheStatistics(GDALCacheStatistics *psStatsOut) {
+      GDALGetRasterBandCacheStatistics(self, psStatsOut);
+  }
+
   void GetActualBlockSize(int nXBlockOff, int nYBlockOff, int* pnxvalid, int* pnyvalid, int* pisvalid)
   {
     *pisvalid = (GDALGetActualBlockSize(self, nXBlockOff, nYBlockOff, pnxvalid, pnyvalid) == CE_None);
@@ -475,6 +475,12 @@ public:
   }
 %clear char **;
 
+#if defined(SWIGPYTHON)
+  void GetCacheStatistics(GDALCacheStatistics *psStatsOut) {
+      GDALDatasetGetCacheStatistics(self, psStatsOut);
+  }
+#endif
+
 #if defined(SWIGPYTHON)
 %feature("kwargs") WriteRaster;
 %apply (GIntBig nLen, char *pBuf) { (GIntBig buf_len, char *buf_string) };
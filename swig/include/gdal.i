@@ -675,6 +675,18 @@ void wrapper_GDALSetCacheMax(GIntBig nBytes)
 }
 }
 
+%rename (GetCacheStatistics) wrapper_GDALGetCacheStatistics;
+%rename (ResetCacheStatistics) GDALResetCacheStatistics;
+
+%inline {
+void wrapper_GDALGetCacheStatistics(GDALCacheStatistics *psStatsOut)
+{
+    GDALGetCacheStatistics(psStatsOut);
+}
+}
+
+void GDALResetCacheStatistics();
+
 #else
 %inline {
 int wrapper_GDALGetCacheMax()
@@ -153,6 +153,19 @@ list
     list with the x and y dimensions of a block
 ";
 
+%feature("docstring")  GetCacheStatistics "
+
+Get the statistics of the block cache for this band. lock_wait_time is
+always 0 at the band level.
+See :cpp:func:`GDALGetRasterBandCacheStatistics`.
+
+Returns
+-------
+dict
+    with the hits, misses, bytes_read, evictions, dirty_flushes,
+    lock_wait_time and compressed_hits keys
+";
+
 %feature("docstring")  GetCategoryNames "
 
 Fetch the list of category names for this raster.
@@ -314,6 +314,19 @@ Returns
 list, or ``None`` if no field domains are stored in the dataset.
 ";
 
+%feature("docstring")  GetCacheStatistics "
+
+Get the statistics of the block cache for the bands of this dataset,
+masks and overviews excluded.
+See :cpp:func:`GDALDatasetGetCacheStatistics`.
+
+Returns
+-------
+dict
+    with the hits, misses, bytes_read, evictions, dirty_flushes,
+    lock_wait_time and compressed_hits keys
+";
+
 %feature("docstring")  GetFileList "
 
 Returns a list of files believed to be part of this dataset.
@@ -36,6 +36,27 @@ int
     cache size in bytes
 ";
 
+// gdal.GetCacheStatistics
+%feature("docstring") wrapper_GDALGetCacheStatistics "
+
+Get the statistics of the block cache. They are only collected when the
+GDAL_CACHE_STATISTICS configuration option is set at startup.
+See :cpp:func:`GDALGetCacheStatistics`.
+
+Returns
+-------
+dict
+    with the hits, misses, bytes_read, evictions, dirty_flushes,
+    lock_wait_time and compressed_hits keys
+";
+
+// gdal.ResetCacheStatistics
+%feature("docstring") GDALResetCacheStatistics "
+
+Reset the statistics returned by :py:func:`GetCacheStatistics`.
+See :cpp:func:`GDALResetCacheStatistics`.
+";
+
 // gdal.GetConfigOption
 %feature("docstring") wrapper_CPLGetConfigOption "
 
@@ -3715,3 +3715,42 @@ OBJECT_LIST_INPUT(GDALMDArrayHS);
 %#endif
   }
 }
+
+/*
+ * Typemap argout used in GetCacheStatistics()
+ */
+%typemap(in,numinputs=0) (GDALCacheStatistics *psStatsOut) (GDALCacheStatistics sStats)
+{
+  /* %typemap(in,numinputs=0) (GDALCacheStatistics *psStatsOut) */
+  memset(&sStats, 0, sizeof(sStats));
+  $1 = &sStats;
+}
+
+%typemap(argout) (GDALCacheStatistics *psStatsOut)
+{
+  /* %typemap(argout) (GDALCacheStatistics *psStatsOut) */
+  Py_DECREF($result);
+  PyObject *dict = PyDict_New();
+  PyObject *val = PyLong_FromLongLong($1->nHits);
+  PyDict_SetItemString(dict, "hits", val);
+  Py_DECREF(val);
+  val = PyLong_FromLongLong($1->nMisses);
+  PyDict_SetItemString(dict, "misses", val);
+  Py_DECREF(val);
+  val = PyLong_FromLongLong($1->nBytesRead);
+  PyDict_SetItemString(dict, "bytes_read", val);
+  Py_DECREF(val);
+  val = PyLong_FromLongLong($1->nEvictions);
+  PyDict_SetItemString(dict, "evictions", val);
+  Py_DECREF(val);
+  val = PyLong_FromLongLong($1->nDirtyFlushes);
+  PyDict_SetItemString(dict, "dirty_flushes", val);
+  Py_DECREF(val);
+  val = PyFloat_FromDouble($1->dfLockWaitTime);
+  PyDict_SetItemString(dict, "lock_wait_time", val);
+  Py_DECREF(val);
+  val = PyLong_FromLongLong($1->nCompressedHits);
+  PyDict_SetItemString(dict, "compressed_hits", val);
+  Py_DECREF(val);
+  $result = dict;
+}